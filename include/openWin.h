@@ -22,6 +22,26 @@
 #include "openWin/Win.h"
 #include "openWin/Cur.h"
 #include "openWin/Painter.h"
+#include "openWin/WinBatch.h"
+#include "openWin/WindowSnapshot.h"
+#include "openWin/WindowDiff.h"
+#include "openWin/WindowGrid.h"
+#include "openWin/WindowMatcher.h"
+#include "openWin/WindowTrigramIndex.h"
+#include "openWin/BulkFetcher.h"
+#include "openWin/WinEventStream.h"
+#include "openWin/WinPropertyCache.h"
+#include "openWin/FramePacer.h"
+#include "openWin/AnimationScheduler.h"
+#include "openWin/Profiler.h"
+#include "openWin/Tracer.h"
+#include "openWin/Journal.h"
+
+#if defined(OPENWIN_SIMULATED_BACKEND)
+#include "openWin/sim/WindowServer.h"
+#endif
+
+#include "openWin/ds/PoolAllocator.h"
 
 #include "openWin/pg/Linear.h"
 
@@ -0,0 +1,536 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* AnimationScheduler.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 21:20:04
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Runs the animations of many windows on a single frame clock instead of one blocked
+*        thread per animation, the changes of a window within a frame are folded into one
+*        update.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_ANIMATIONSCHEDULER_H
+#define OPENWIN_HEADER_ANIMATIONSCHEDULER_H
+
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <coroutine>
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <cstdint>
+
+#include "Win.h"
+
+#include "FramePacer.h"
+
+#include "pg/BasicPathGenerator.h"
+
+namespace win
+{
+
+/**
+ * @brief Refers to an animation added to an AnimationScheduler, copies refer
+ *        to the same animation.
+ * 
+ *        An animation can be joined, waited on through a std::future, or
+ *        awaited in a coroutine:
+ * 
+ * @code
+ * bool finished = co_await win.setPosAsync(Point(0, 0), pg::Linear<Point>(8.0F));
+ * @endcode
+ * 
+ *        The continuations run on the thread that completes the animation:
+ *        the frame thread of the scheduler after the last frame is written,
+ *        or the thread calling cancel(). They run in the order they were
+ *        added, and the animations completing in the same frame complete in
+ *        the order they were started.
+ */
+class Animation
+{
+public:
+
+    Animation() = default;
+
+    /**
+     * @brief Stops the animation, the window stays where the last frame put
+     *        it. A frame being written when this is called may still be
+     *        written.
+     */
+    void cancel() const;
+
+    /**
+     * @brief Waits until the animation finishes or is cancelled.
+     */
+    void join() const noexcept;
+
+    [[nodiscard]] bool done() const noexcept;
+    [[nodiscard]] bool cancelled() const noexcept;
+
+    /**
+     * @brief Calls the function with true if the animation finishes, or with
+     *        false if it is cancelled. Called at once if it is already done.
+     */
+    void then(std::function<void(bool __finished)> __continuation) const;
+
+    /**
+     * @return A future that becomes ready with the value then() would pass.
+     */
+    [[nodiscard]] std::future<bool> future() const;
+
+    [[nodiscard]] explicit operator bool() const noexcept
+    { return _M_state != nullptr; }
+
+    [[nodiscard]] bool await_ready() const noexcept
+    { return done(); }
+
+    /**
+     * @return false if the animation was done meanwhile, the coroutine is
+     *         then not suspended.
+     */
+    bool await_suspend(std::coroutine_handle<> __coroutine) const;
+
+    /**
+     * @return true if the animation finished, false if it was cancelled.
+     */
+    [[nodiscard]] bool await_resume() const noexcept
+    { return not cancelled(); }
+
+private:
+
+    friend class AnimationScheduler;
+
+    enum status : std::uint32_t
+    {
+        Running,
+        Finished,
+        Cancelled
+    };
+
+    struct state
+    {
+        /**
+         * @brief Moves from Running to the status and runs the continuations,
+         *        only the first call does anything.
+         */
+        void complete(status __status);
+
+        std::atomic<std::uint32_t> status = Running;
+
+        std::mutex mutex;
+
+        /// Set once the continuations are taken by complete(), under mutex.
+        bool completed = false;
+
+        std::vector<std::function<void(bool)>> continuations;
+    };
+
+    explicit Animation(std::shared_ptr<state> __state) noexcept
+        : _M_state(std::move(__state))
+    { }
+
+    /**
+     * @return false if the animation is done, the continuation is then
+     *         not kept.
+     */
+    bool _M_enqueue(std::function<void(bool)>&& __continuation) const;
+
+    std::shared_ptr<state> _M_state;
+};
+
+class AnimationScheduler
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    enum Channel : std::uint8_t
+    {
+        PositionChannel = 1 << 0,
+        SizeChannel     = 1 << 1,
+        OpacityChannel  = 1 << 2
+    };
+
+    using Channels = std::uint8_t;
+
+    /**
+     * @brief The values of a window for a frame, only the channels set are
+     *        meaningful. The position and the size are logical, as in
+     *        Win::setPos() and Win::setSize().
+     */
+    struct Frame
+    {
+        Channels channels = 0;
+
+        Point pos;
+        win::Size size;
+        int opacity = 0xff;
+    };
+
+    /**
+     * @brief Reads and writes the windows, Backend::system() uses Win32.
+     */
+    class Backend
+    {
+    public:
+
+        virtual ~Backend() = default;
+
+        /**
+         * @brief Called on the thread adding an animation, to find where it
+         *        starts from.
+         */
+        [[nodiscard]] virtual Frame read(Win::Handle __handle, Channels __channels) = 0;
+
+        /**
+         * @brief Called on the thread adding an animation, after read(), to
+         *        set up the window once for the channels, as the system
+         *        backend makes it layered for the opacity.
+         */
+        virtual void prepare(Win::Handle, Channels)
+        { }
+
+        /**
+         * @brief Called on the frame thread once per window and frame.
+         * 
+         * @return false if the window cannot be changed, its animations are
+         *         then cancelled.
+         */
+        virtual bool write(Win::Handle __handle, const Frame& __frame) = 0;
+
+        [[nodiscard]] static Backend& system() noexcept;
+    };
+
+    struct Options
+    {
+        /// The period of the frame clock, the generators without a waiting
+        /// time step once per frame, the waiting time of the others is
+        /// rounded to whole frames.
+        Clock::duration frameInterval = std::chrono::microseconds(16'667);
+    };
+
+    using Animation = win::Animation;
+
+    AnimationScheduler();
+    explicit AnimationScheduler(const Options& __options, Backend& __backend = Backend::system());
+
+    /**
+     * @return The scheduler of the asynchronous setters of Win, with the
+     *         default options and the system backend, never destroyed.
+     */
+    [[nodiscard]] static AnimationScheduler& shared();
+
+    /**
+     * @brief Cancels the remaining animations and stops the frame thread.
+     */
+    ~AnimationScheduler();
+
+    AnimationScheduler(const AnimationScheduler&) = delete;
+    AnimationScheduler& operator=(const AnimationScheduler&) = delete;
+
+    /**
+     * @brief Animates the window from where it is to the target, the generator
+     *        is copied. The animations of the same window that are still
+     *        running on one of the channels are cancelled.
+     */
+    template<typename _Generator>
+    Animation setPos(const Win& __win, const Point& __point, const _Generator& __pg)
+    { return _M_add<Point>(__win.handle(), PositionChannel, __point, std::make_shared<_Generator>(__pg)); }
+
+    template<typename _Generator>
+    Animation setSize(const Win& __win, const win::Size& __size, const _Generator& __pg)
+    { return _M_add<win::Size>(__win.handle(), SizeChannel, __size, std::make_shared<_Generator>(__pg)); }
+
+    template<typename _Generator>
+    Animation setOpacity(const Win& __win, int __value, const _Generator& __pg)
+    { return _M_add<int>(__win.handle(), OpacityChannel, __value, std::make_shared<_Generator>(__pg)); }
+
+    /**
+     * @brief Same as Win::setZoom(), the size grows from where it is by the
+     *        additional width and height, or is scaled.
+     */
+    template<typename _Generator>
+    Animation setZoom(const Win& __win, int __additionalWidth, int __additionalHeight, const _Generator& __pg)
+    {
+        const win::Size size = _M_backend.read(__win.handle(), SizeChannel).size;
+        return setSize(__win, win::Size(size.w() + __additionalWidth, size.h() + __additionalHeight), __pg);
+    }
+
+    template<typename _Generator>
+    Animation setZoom(const Win& __win, double __scaleX, double __scaleY, const _Generator& __pg)
+    {
+        const win::Size size = _M_backend.read(__win.handle(), SizeChannel).size;
+
+        return setSize(
+            __win,
+            win::Size(
+                static_cast<int>(static_cast<double>(size.w()) * __scaleX),
+                static_cast<int>(static_cast<double>(size.h()) * __scaleY)),
+            __pg);
+    }
+
+    /**
+     * @brief Same as Win::animateTo(), the three channels step together.
+     */
+    template<typename _Generator>
+    Animation animateTo(const Win& __win, const Rect& __rect, int __opacity, const _Generator& __pg)
+    {
+        return _M_add<Win::AnimationValue>(
+            __win.handle(),
+            PositionChannel | SizeChannel | OpacityChannel,
+            Win::AnimationValue{ __rect.x(), __rect.y(), __rect.w(), __rect.h(), __opacity },
+            std::make_shared<_Generator>(__pg));
+    }
+
+    /**
+     * @brief Cancels all animations of the window.
+     */
+    void cancel(const Win& __win);
+
+    void cancelAll();
+
+    /**
+     * @brief Waits until no animation is running.
+     */
+    void joinAll();
+
+    /**
+     * @return The number of running animations.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @return The number of frames in which at least one window was written.
+     */
+    [[nodiscard]] std::uint64_t frames() const noexcept
+    { return _M_frames.load(std::memory_order_relaxed); }
+
+    /**
+     * @return The number of Backend::write() calls.
+     */
+    [[nodiscard]] std::uint64_t writes() const noexcept
+    { return _M_writes.load(std::memory_order_relaxed); }
+
+    /**
+     * @return How late the frames started after their deadline, and the
+     *         number of frames skipped.
+     */
+    [[nodiscard]] FramePacer::Stats jitter() const;
+
+    [[nodiscard]] const Options& options() const noexcept
+    { return _M_options; }
+
+private:
+
+    /**
+     * @brief The steps of an animation of some channels, type-erased.
+     */
+    struct track
+    {
+        virtual ~track() = default;
+
+        /**
+         * @brief Puts the current value into the frame and steps forward.
+         * 
+         * @return false if there was no value left.
+         */
+        virtual bool step(Frame& __frame) = 0;
+
+        [[nodiscard]] virtual bool remains() = 0;
+
+        Win::Handle handle = nullptr;
+        Channels channels = 0;
+
+        /// In frames.
+        std::uint64_t interval = 1;
+        std::uint64_t due = 0;
+
+        std::shared_ptr<Animation::state> state;
+
+        /// The order of start.
+        std::uint64_t sequence = 0;
+    };
+
+    template<typename _Tp>
+    struct pathTrack : track
+    {
+        using generator_type = pg::BasicPathGenerator<_Tp>;
+
+        virtual bool step(Frame& __frame) override
+        {
+            if (not iterator->remains())
+            {
+                return false;
+            }
+
+            _S_assign(__frame, iterator->current());
+            iterator->step();
+
+            return true;
+        }
+
+        virtual bool remains() override
+        { return iterator->remains(); }
+
+        /// Kept alive for the iterator, which refers to it.
+        std::shared_ptr<const generator_type> generator;
+        std::unique_ptr<typename generator_type::ForwardIterator> iterator;
+    };
+
+    static void _S_assign(Frame& __frame, const Point& __value) noexcept
+    { __frame.pos = __value; }
+
+    static void _S_assign(Frame& __frame, const win::Size& __value) noexcept
+    { __frame.size = __value; }
+
+    static void _S_assign(Frame& __frame, int __value) noexcept
+    { __frame.opacity = __value; }
+
+    [[nodiscard]] static Point _S_value(const Frame& __frame, const Point*) noexcept
+    { return __frame.pos; }
+
+    [[nodiscard]] static win::Size _S_value(const Frame& __frame, const win::Size*) noexcept
+    { return __frame.size; }
+
+    [[nodiscard]] static int _S_value(const Frame& __frame, const int*) noexcept
+    { return __frame.opacity; }
+
+    static void _S_assign(Frame& __frame, const Win::AnimationValue& __value) noexcept
+    {
+        __frame.pos = Point(__value[0], __value[1]);
+        __frame.size = win::Size(__value[2], __value[3]);
+        __frame.opacity = __value[4];
+    }
+
+    [[nodiscard]] static Win::AnimationValue _S_value(const Frame& __frame, const Win::AnimationValue*) noexcept
+    { return { __frame.pos.x(), __frame.pos.y(), __frame.size.w(), __frame.size.h(), __frame.opacity }; }
+
+    template<typename _Tp>
+    Animation _M_add(
+        Win::Handle __handle,
+        Channels __channels,
+        const _Tp& __to,
+        std::shared_ptr<const pg::BasicPathGenerator<_Tp>> __generator)
+    {
+        auto t = std::make_unique<pathTrack<_Tp>>();
+
+        const _Tp from = _S_value(_M_backend.read(__handle, __channels), static_cast<const _Tp*>(nullptr));
+
+        _M_backend.prepare(__handle, __channels);
+
+        t->iterator = __generator->build(from, __to);
+        t->generator = std::move(__generator);
+
+        t->handle = __handle;
+        t->channels = __channels;
+
+        t->interval = _M_framesIn(std::chrono::milliseconds(t->generator->waitingTime()));
+
+        return _M_add(std::move(t));
+    }
+
+    Animation _M_add(std::unique_ptr<track> __track);
+
+    /**
+     * @return The number of whole frames nearest to the duration, at least 1.
+     */
+    [[nodiscard]] std::uint64_t _M_framesIn(Clock::duration __duration) const noexcept;
+
+    /**
+     * @return The index of the frame the time falls in.
+     */
+    [[nodiscard]] std::uint64_t _M_frameAt(Clock::time_point __time) const noexcept;
+
+    using completion = std::pair<std::shared_ptr<Animation::state>, Animation::status>;
+
+    void _M_run();
+
+    /**
+     * @brief Steps the tracks that are due and writes the folded frames,
+     *        called with the lock held, which is released while writing.
+     */
+    void _M_tick(std::unique_lock<std::mutex>& __lock, std::vector<completion>& __completions);
+
+    /**
+     * @brief Called without the lock held, as the continuations may use the
+     *        scheduler, in the order of start.
+     */
+    static void _S_complete(std::vector<completion>& __completions);
+
+    const Options _M_options;
+    Backend& _M_backend;
+
+    /// The start of frame 0.
+    const Clock::time_point _M_epoch;
+
+    mutable std::mutex _M_mutex;
+    std::condition_variable _M_wakeup;
+    std::condition_variable _M_idle;
+
+    std::vector<std::unique_ptr<track>> _M_tracks;
+
+    std::uint64_t _M_sequence = 0;
+
+    FramePacer::Stats _M_jitter;
+
+    bool _M_stop = false;
+
+    /// Set while the frame thread runs completions without the lock.
+    bool _M_completing = false;
+
+    std::atomic<std::uint64_t> _M_frames = 0;
+    std::atomic<std::uint64_t> _M_writes = 0;
+
+    std::thread _M_thread;
+};
+
+template<typename _Generator>
+Animation Win::setPosAsync(const Point& __point, const _Generator& __pg) const
+{ return AnimationScheduler::shared().setPos(*this, __point, __pg); }
+
+template<typename _Generator>
+Animation Win::setSizeAsync(const Size& __size, const _Generator& __pg) const
+{ return AnimationScheduler::shared().setSize(*this, __size, __pg); }
+
+template<typename _Generator>
+Animation Win::setOpacityAsync(int __value, const _Generator& __pg) const
+{ return AnimationScheduler::shared().setOpacity(*this, __value, __pg); }
+
+template<typename _Generator>
+Animation Win::setZoomAsync(int __additionalWidth, int __additionalHeight, const _Generator& __pg) const
+{ return AnimationScheduler::shared().setZoom(*this, __additionalWidth, __additionalHeight, __pg); }
+
+template<typename _Generator>
+Animation Win::setZoomAsync(int __additional, const _Generator& __pg) const
+{ return setZoomAsync(__additional, __additional, __pg); }
+
+template<typename _Generator>
+Animation Win::setZoomAsync(double __scaleX, double __scaleY, const _Generator& __pg) const
+{ return AnimationScheduler::shared().setZoom(*this, __scaleX, __scaleY, __pg); }
+
+template<typename _Generator>
+Animation Win::setZoomAsync(double __scale, const _Generator& __pg) const
+{ return setZoomAsync(__scale, __scale, __pg); }
+
+template<typename _Generator>
+Animation Win::animateToAsync(const Rect& __rect, int __opacity, const _Generator& __pg) const
+{ return AnimationScheduler::shared().animateTo(*this, __rect, __opacity, __pg); }
+
+}  // namespace win
+
+#endif  // OPENWIN_HEADER_ANIMATIONSCHEDULER_H
\ No newline at end of file
@@ -0,0 +1,129 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* BulkFetcher.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 17:40:12
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Fetches the fields of many windows on a pool of worker threads with a deadline per
+*        window, so that a hung window only costs its own deadline instead of stalling the scan.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_BULKFETCHER_H
+#define OPENWIN_HEADER_BULKFETCHER_H
+
+#include <vector>
+#include <memory>
+#include <chrono>
+
+#include "WindowSnapshot.h"
+
+namespace win
+{
+
+class BulkFetcher
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Options
+    {
+        std::size_t workers = 8;
+
+        /// The time a worker may spend on one window.
+        Clock::duration windowTimeout = std::chrono::milliseconds(250);
+
+        /// The time the whole fetch may take, the windows not fetched by then
+        /// are flagged as timed out.
+        Clock::duration totalTimeout = std::chrono::seconds(2);
+    };
+
+    struct Result
+    {
+        /// In the order of the windows requested, the fields of the windows
+        /// timed out are empty.
+        WindowSnapshot snapshot;
+
+        /// Non-zero at the indexes of the windows timed out.
+        std::vector<std::uint8_t> timedOut;
+
+        [[nodiscard]] bool complete() const noexcept;
+
+        [[nodiscard]] std::size_t timedOutCount() const noexcept;
+    };
+
+    BulkFetcher();
+
+    /**
+     * @param __source Must outlive the fetcher, and the workers abandoned on
+     *                 a hung window until their call returns.
+     */
+    explicit BulkFetcher(
+        const Options& __options,
+        WindowSnapshot::Source& __source = WindowSnapshot::Source::system());
+
+    /**
+     * @brief Stops the idle workers, the workers stuck on a window are left to
+     *        exit on their own.
+     */
+    ~BulkFetcher();
+
+    BulkFetcher(const BulkFetcher&) = delete;
+    BulkFetcher& operator=(const BulkFetcher&) = delete;
+
+    /**
+     * @brief Fetches the fields of the windows, one fetch at a time per
+     *        fetcher.
+     */
+    [[nodiscard]] Result fetch(
+        std::span<const Win::Handle> __handles,
+        WindowSnapshot::Fields __fields = WindowSnapshot::All);
+
+    [[nodiscard]] Result fetch(
+        const WinList& __wins,
+        WindowSnapshot::Fields __fields = WindowSnapshot::All);
+
+    /**
+     * @brief Enumerates the top-level windows with the source and fetches
+     *        them.
+     */
+    [[nodiscard]] Result fetch(WindowSnapshot::Fields __fields = WindowSnapshot::All);
+
+    [[nodiscard]] const Options& options() const noexcept
+    { return _M_options; }
+
+    /**
+     * @return The number of workers abandoned on a window so far, each one is
+     *         replaced by a new worker.
+     */
+    [[nodiscard]] std::size_t abandonedWorkers() const noexcept
+    { return _M_abandoned; }
+
+private:
+
+    struct job;
+    struct worker;
+    struct pool;
+
+    void _M_spawn();
+
+    Options _M_options;
+    WindowSnapshot::Source& _M_source;
+
+    std::shared_ptr<pool> _M_pool;
+
+    std::size_t _M_abandoned = 0;
+};
+
+}  // namespace win
+
+#endif  // OPENWIN_HEADER_BULKFETCHER_H
\ No newline at end of file
@@ -0,0 +1,92 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* CallSite.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 15:48:30
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Compile-time integer IDs of the guarded call sites, hashed from their function
+*        prototypes. The prototypes are kept in a registry and only looked up when an ID has
+*        to be printed.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_CALLSITE_H
+#define OPENWIN_HEADER_CALLSITE_H
+
+#include <string_view>
+
+#include <cstdint>
+
+namespace win
+{
+
+using CallSiteId = std::uint32_t;
+
+/**
+ * @return The 32-bit FNV-1a hash of the function prototype, never 0.
+ */
+[[nodiscard]] constexpr CallSiteId callSiteHash(std::string_view __prototype) noexcept
+{
+    CallSiteId hash = 2166136261u;
+
+    for (char ch : __prototype)
+    {
+        hash ^= static_cast<unsigned char>(ch);
+        hash *= 16777619u;
+    }
+
+    return hash ? hash : 1;
+}
+
+class CallSite
+{
+public:
+
+    /// The ID that no call site has.
+    static constexpr CallSiteId none = 0;
+
+    /**
+     * @brief Maps the ID to the prototype, if the ID is already taken by
+     *        another prototype the first one is kept.
+     * 
+     * @param __prototype Must have static storage duration.
+     * 
+     * @return false on such a collision.
+     */
+    static bool add(CallSiteId __id, const char* __prototype) noexcept;
+
+    /**
+     * @brief Registers a prototype only known at runtime.
+     */
+    static CallSiteId add(const char* __prototype) noexcept;
+
+    /**
+     * @return The prototype of the ID, or nullptr if it is not registered.
+     */
+    [[nodiscard]] static const char* name(CallSiteId __id) noexcept;
+};
+
+/**
+ * @brief Registers a call site once, as a function-local static object.
+ */
+class CallSiteRegistrar
+{
+public:
+
+    CallSiteRegistrar(CallSiteId __id, const char* __prototype) noexcept
+    {
+        CallSite::add(__id, __prototype);
+    }
+};
+
+}  // namespace win
+
+#endif  // OPENWIN_HEADER_CALLSITE_H
\ No newline at end of file
@@ -0,0 +1,189 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* ErrorSink.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 11:42:08
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Defines where the errors reported by ErrorStream go. The default sink hands the records
+*        to a background thread through a lock-free ring buffer, so a failing thread never waits
+*        for the console.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_ERRORSINK_H
+#define OPENWIN_HEADER_ERRORSINK_H
+
+#include <iostream>
+
+#include <array>
+#include <string>
+#include <chrono>
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+
+#include <cstdint>
+
+#include "ds/MpscRingBuffer.h"
+
+#include "CallSite.h"
+
+namespace win
+{
+
+struct ErrorRecord
+{
+    static constexpr std::size_t maxWorkpathDepth = 16;
+
+    using Clock = std::chrono::system_clock;
+
+    /// 0 if the error is only described by text.
+    std::uint32_t code = 0;
+
+    std::string text;
+
+    /// The call sites of the works, the outermost first, only the first
+    /// maxWorkpathDepth works are kept, depth is the real depth.
+    std::array<CallSiteId, maxWorkpathDepth> workpath{};
+    std::size_t depth = 0;
+
+    std::thread::id thread;
+
+    /// The time of the first occurrence, and of the last one if the record
+    /// collapses repeated occurrences.
+    Clock::time_point time;
+    Clock::time_point lastTime;
+
+    /// The number of occurrences collapsed into this record.
+    std::uint64_t count = 1;
+
+    /// The number of records discarded by the rate limit since the last
+    /// record that was let through.
+    std::uint64_t limited = 0;
+
+    /**
+     * @brief Outputs in the form "In work1/work2/: ( code ) text", followed by
+     *        the number of repeats and rate limited records if any.
+     */
+    friend std::ostream& operator<<(std::ostream& __os, const ErrorRecord& __record);
+};
+
+std::ostream& operator<<(std::ostream& __os, const ErrorRecord& __record);
+
+class ErrorSink
+{
+public:
+
+    virtual ~ErrorSink() = default;
+
+    /**
+     * @brief Called on the failing thread, may be called concurrently.
+     */
+    virtual void write(ErrorRecord&& __record) = 0;
+
+    /**
+     * @brief Waits until all records written before are output.
+     */
+    virtual void flush() { }
+
+    /**
+     * @return The sink used by all error streams, an AsyncErrorSink writing to
+     *         std::cerr unless another one is set.
+     */
+    [[nodiscard]] static ErrorSink* current() noexcept;
+
+    /**
+     * @brief Replaces the sink used by all error streams.
+     * 
+     * @param __sink Must outlive its use, nullptr restores the default sink.
+     * 
+     * @return The previous sink.
+     */
+    static ErrorSink* setCurrent(ErrorSink* __sink) noexcept;
+};
+
+/**
+ * @brief Writes records synchronously to an output stream under a mutex.
+ */
+class StreamErrorSink : public ErrorSink
+{
+public:
+
+    explicit StreamErrorSink(std::ostream& __os = std::cerr) noexcept
+        : _M_os(__os)
+    { }
+
+    virtual void write(ErrorRecord&& __record) override;
+    virtual void flush() override;
+
+private:
+
+    std::ostream& _M_os;
+    std::mutex _M_mutex;
+};
+
+/**
+ * @brief Pushes records into a bounded lock-free ring buffer, a background
+ *        thread drains them to an output stream.
+ * 
+ *        Records that do not fit into the buffer are dropped instead of
+ *        blocking the failing thread, the number of dropped records is
+ *        counted and reported to the output stream.
+ */
+class AsyncErrorSink : public ErrorSink
+{
+public:
+
+    explicit AsyncErrorSink(std::ostream& __os = std::cerr, std::size_t __capacity = 1024);
+
+    /**
+     * @brief Outputs the remaining records and stops the background thread.
+     */
+    virtual ~AsyncErrorSink();
+
+    virtual void write(ErrorRecord&& __record) override;
+    virtual void flush() override;
+
+    /**
+     * @return The number of records dropped because the buffer was full.
+     */
+    [[nodiscard]] std::uint64_t dropped() const noexcept;
+
+    [[nodiscard]] std::size_t capacity() const noexcept
+    { return _M_buffer.capacity(); }
+
+private:
+
+    void _M_run();
+    void _M_drain();
+
+    std::ostream& _M_os;
+
+    ds::MpscRingBuffer<ErrorRecord> _M_buffer;
+
+    /// Changed on every push and on stop, the background thread waits on it.
+    std::atomic<std::uint32_t> _M_signal = 0;
+
+    std::atomic<std::uint64_t> _M_pushed = 0;
+    std::atomic<std::uint64_t> _M_drained = 0;
+    std::atomic<std::uint64_t> _M_dropped = 0;
+
+    std::uint64_t _M_reportedDropped = 0;
+
+    std::atomic<bool> _M_stop = false;
+
+    std::thread _M_thread;
+};
+
+}  // namespace win
+
+#endif  // OPENWIN_HEADER_ERRORSINK_H
\ No newline at end of file
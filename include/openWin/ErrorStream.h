@@ -12,7 +12,7 @@
 * --- This file is a part of openWin ---
 * 
 * @brief Encapsulates an error stream to handle errors in layered work, which will output error
-*        information to std::cerr.
+*        information to the current ErrorSink (std::cerr by default).
 */
 
 #pragma once
@@ -24,9 +24,15 @@
 
 #include <forward_list>
 #include <vector>
+#include <chrono>
 
 #include "ds/ForwardList.h"
 #include "ds/LinkedList.h"
+#include "ds/InlineStack.h"
+
+#include "CallSite.h"
+#include "ErrorSink.h"
+#include "ErrorTextCache.h"
 
 namespace win
 {
@@ -43,15 +49,27 @@ public:
 
     ErrorStream() noexcept;
 
-    void begin(const char* __work);
+    void begin(CallSiteId __work);
     void end();
 
+    /**
+     * @brief Registers the work as a call site at runtime and begins it.
+     * 
+     * @param __work Must have static storage duration.
+     */
+    void begin(const char* __work);
+
+    /**
+     * @brief Sends a record of the error to ErrorSink::current().
+     */
     virtual void onFailed(std::uint32_t __code);
     virtual void onFailed(const std::string& __text);
 
     /**
     * @return The text corresponding to the error code, or returns null if
     *         there is no corresponding text.
+    * 
+    * @note   Looked up in ErrorTextCache::global().
     */
     [[nodiscard]] virtual const char* codeToText(std::uint32_t __code) const noexcept;
 
@@ -67,6 +85,11 @@ public:
     [[nodiscard]] bool success() const noexcept;
     [[nodiscard]] bool failed() const noexcept;
 
+    /**
+     * @return The number of nested works in progress, 0 means idle.
+     */
+    [[nodiscard]] std::size_t depth() const noexcept;
+
     /**
     * @return  The last error text if there is one, otherwise return nullptr.
     * 
@@ -92,18 +115,156 @@ public:
 
     [[nodiscard]] static ErrorStream* global() noexcept;
 
+    /**
+     * @brief Collapses the failures with the same code, text and work path
+     *        reported by the same thread within __window: the first one is
+     *        sent at once, the repeats are counted into one record.
+     * 
+     *        There is no timer: the record of the repeats is sent by the next
+     *        failure of the thread once the window is over, by flushRepeats(),
+     *        or when the thread exits.
+     * 
+     * @param __window 0 sends every failure, which is the default.
+     */
+    static void setRepeatWindow(std::chrono::milliseconds __window) noexcept;
+    [[nodiscard]] static std::chrono::milliseconds repeatWindow() noexcept;
+
+    /**
+     * @brief Sends the repeats collapsed so far by the calling thread without
+     *        waiting for their windows to be over, this is also done when the
+     *        thread exits.
+     */
+    static void flushRepeats();
+
+    /**
+     * @brief Limits the records sent to the sink by all threads with a token
+     *        bucket, the records over the limit are discarded and counted in
+     *        the next record sent.
+     * 
+     * @param __perSecond The rate the bucket is refilled at, 0 disables the
+     *                    limit, which is the default.
+     * @param __burst     The capacity of the bucket.
+     */
+    static void setRateLimit(double __perSecond, std::uint32_t __burst = 1) noexcept;
+
+    /**
+     * @return The number of records discarded by the rate limit so far.
+     */
+    [[nodiscard]] static std::uint64_t rateLimited() noexcept;
+
+protected:
+
+    /**
+     * @return A record filled with the current work path, thread and time.
+     */
+    [[nodiscard]] ErrorRecord _M_makeRecord() const;
+
+    /**
+     * @brief Sends the record to ErrorSink::current() through the repeat
+     *        window and the rate limit.
+     */
+    static void _S_report(ErrorRecord&& __record);
+
 private:
 
     ds::ForwardList<Item> _M_queue;
-    ds::LinkedList<const char*> _M_workpath;
+    /// The success path of a guarded call never allocates, unless the calls
+    /// are nested deeper than the inline capacity.
+    ds::InlineStack<CallSiteId, 16> _M_workpath;
 
     std::uint32_t _M_failed;
 };
 
+/**
+ * @brief The error state used by the guarded calls instead of ErrorStream when
+ *        openWin is built with OPENWIN_LEAN_ERRORS, it only keeps the last
+ *        error code of the calling thread: no work path is tracked and nothing
+ *        is printed.
+ */
+class LeanErrorStream
+{
+public:
+
+    void begin() noexcept;
+    void end() noexcept;
+
+    /**
+     * @brief  Check if there are any new errors.
+     * 
+     * @return false if an new error is found.
+     */
+    bool check() noexcept;
+
+    void setFail() noexcept;
+
+    [[nodiscard]] bool success() const noexcept;
+    [[nodiscard]] bool failed() const noexcept;
+
+    /**
+     * @return The last error code recorded by the outermost guarded call, or
+     *         0 if there is none.
+     */
+    [[nodiscard]] std::uint32_t code() const noexcept;
+
+    [[nodiscard]] static LeanErrorStream* local() noexcept;
+
+private:
+
+    std::uint32_t _M_code = 0;
+    std::uint32_t _M_depth = 0;
+
+    bool _M_failed = false;
+};
+
+class LeanErrorStreamGuard
+{
+public:
+
+    explicit LeanErrorStreamGuard(
+        LeanErrorStream& __ref,
+        bool __checkAtEnd = true) noexcept
+        : _M_ref(__ref)
+        , _M_checkAtEnd(__checkAtEnd)
+    {
+        _M_ref.begin();
+    }
+
+    ~LeanErrorStreamGuard()
+    {
+        if (_M_checkAtEnd)
+        {
+            _M_ref.check();
+        }
+
+        _M_ref.end();
+    }
+
+    LeanErrorStreamGuard(const LeanErrorStreamGuard&) = delete;
+    LeanErrorStreamGuard& operator=(const LeanErrorStreamGuard&) = delete;
+
+    inline void skipCheck() noexcept
+    { _M_checkAtEnd = false; }
+
+private:
+
+    LeanErrorStream& _M_ref;
+    bool _M_checkAtEnd;
+};
+
 class ErrorStreamGuard
 {
 public:
 
+    ErrorStreamGuard(
+        ErrorStream& __ref,
+        CallSiteId __work,
+        bool __checkAtEnd = true)
+        : _M_ref(__ref)
+        , _M_checkAtEnd(__checkAtEnd)
+    {
+        _M_ref.begin(__work);
+    }
+
     ErrorStreamGuard(
         ErrorStream& __ref,
         const char* __work,
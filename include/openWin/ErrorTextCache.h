@@ -0,0 +1,132 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* ErrorTextCache.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 13:05:21
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief A concurrent and bounded cache from error codes to their texts, so that the system is
+*        asked to format each error code only once.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_ERRORTEXTCACHE_H
+#define OPENWIN_HEADER_ERRORTEXTCACHE_H
+
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <functional>
+#include <span>
+
+#include <atomic>
+#include <shared_mutex>
+
+#include <cstdint>
+
+namespace win
+{
+
+class ErrorTextCache
+{
+public:
+
+    /**
+     * @brief Returns the text of the error code in the language, or an empty
+     *        string if there is none.
+     * 
+     * @note  Called without any lock held, may be called concurrently.
+     */
+    using Formatter = std::function<std::string(std::uint32_t __code, std::uint32_t __language)>;
+
+    /// Lets the formatter choose the language.
+    static constexpr std::uint32_t defaultLanguage = 0;
+
+    explicit ErrorTextCache(Formatter __formatter, std::size_t __capacity = 512);
+
+    ErrorTextCache(const ErrorTextCache&) = delete;
+    ErrorTextCache& operator=(const ErrorTextCache&) = delete;
+
+    /**
+     * @return  The text of the error code, or nullptr if there is none.
+     * 
+     * @warning The text is valid until clear() or setFormatter() is called,
+     *          except when the cache is full: then it is kept in a buffer of
+     *          the calling thread, valid until the next call in that thread.
+     */
+    [[nodiscard]] const char* text(std::uint32_t __code, std::uint32_t __language = defaultLanguage);
+
+    /**
+     * @brief Formats and caches the error codes in advance.
+     */
+    void preload(std::span<const std::uint32_t> __codes, std::uint32_t __language = defaultLanguage);
+    void preload(std::initializer_list<std::uint32_t> __codes, std::uint32_t __language = defaultLanguage)
+    { preload(std::span<const std::uint32_t>(__codes.begin(), __codes.size()), __language); }
+
+    /**
+     * @brief Replaces the formatter and clears the cache.
+     */
+    void setFormatter(Formatter __formatter);
+
+    void clear();
+
+    /**
+     * @return The number of cached texts, including the codes without text.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    [[nodiscard]] std::size_t capacity() const noexcept
+    { return _M_capacity; }
+
+    [[nodiscard]] std::uint64_t hits() const noexcept;
+    [[nodiscard]] std::uint64_t misses() const noexcept;
+
+    /**
+     * @return The cache used by ErrorStream::codeToText(), formatting with
+     *         FormatMessage.
+     */
+    [[nodiscard]] static ErrorTextCache& global() noexcept;
+
+private:
+
+    static constexpr std::size_t shardCount = 16;
+
+    struct alignas(64) shard
+    {
+        mutable std::shared_mutex mutex;
+
+        /// Keyed by language << 32 | code, an empty text means no text.
+        std::unordered_map<std::uint64_t, std::string> texts;
+
+        std::atomic<std::uint64_t> hits = 0;
+        std::atomic<std::uint64_t> misses = 0;
+    };
+
+    [[nodiscard]] static std::uint64_t _S_key(std::uint32_t __code, std::uint32_t __language) noexcept
+    { return static_cast<std::uint64_t>(__language) << 32 | __code; }
+
+    [[nodiscard]] shard& _M_shard(std::uint64_t __key) noexcept
+    { return _M_shards[(__key ^ __key >> 32) % shardCount]; }
+
+    [[nodiscard]] std::string _M_format(std::uint32_t __code, std::uint32_t __language) const;
+
+    std::array<shard, shardCount> _M_shards;
+
+    /// Guards _M_formatter against setFormatter().
+    mutable std::shared_mutex _M_formatterMutex;
+    Formatter _M_formatter;
+
+    const std::size_t _M_capacity;
+    std::atomic<std::size_t> _M_size = 0;
+};
+
+}  // namespace win
+
+#endif  // OPENWIN_HEADER_ERRORTEXTCACHE_H
\ No newline at end of file
@@ -0,0 +1,195 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* FramePacer.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 22:05:47
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Paces the steps of an animation by absolute deadlines instead of sleeping a period after
+*        each step, so the time spent by the steps does not add up, and the frames whose deadline
+*        has passed are skipped.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_FRAMEPACER_H
+#define OPENWIN_HEADER_FRAMEPACER_H
+
+#include <chrono>
+#include <algorithm>
+
+#include <cstdint>
+
+namespace win
+{
+
+class FramePacer
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Where the time comes from, replaced by a SimulatedTimeSource to
+     *        measure the pacing without waiting.
+     */
+    class TimeSource
+    {
+    public:
+
+        virtual ~TimeSource() = default;
+
+        [[nodiscard]] virtual Clock::time_point now() = 0;
+
+        /**
+         * @brief Returns at the deadline or soon after it.
+         */
+        virtual void sleepUntil(Clock::time_point __deadline) = 0;
+
+        /**
+         * @return The steady clock, sleeping with a high resolution timer and
+         *         spinning the last stretch before the deadline, as the sleep
+         *         of the system may overshoot by a tick.
+         */
+        [[nodiscard]] static TimeSource& system() noexcept;
+    };
+
+    class SimulatedTimeSource;
+
+    /**
+     * @brief The lateness of the frames, how long after its deadline each
+     *        frame started.
+     */
+    struct Stats
+    {
+        std::uint64_t frames = 0;
+
+        /// The frames not started because a later deadline had passed too.
+        std::uint64_t skipped = 0;
+
+        Clock::duration totalLateness{};
+        Clock::duration maxLateness{};
+
+        /// The sum of the squares of the lateness in microseconds.
+        double squares = 0.0;
+
+        [[nodiscard]] Clock::duration meanLateness() const noexcept
+        { return frames ? totalLateness / static_cast<Clock::rep>(frames) : Clock::duration(); }
+
+        /**
+         * @return The standard deviation of the lateness in microseconds.
+         */
+        [[nodiscard]] double jitter() const noexcept;
+
+        /**
+         * @brief Counts a frame that started late, after skipping some.
+         */
+        void record(Clock::duration __lateness, std::uint64_t __skipped = 0) noexcept;
+
+        void merge(const Stats& __other) noexcept;
+    };
+
+    /**
+     * @param __period The time between the deadlines of two frames, frame 0
+     *        starts on construction.
+     */
+    explicit FramePacer(Clock::duration __period, TimeSource& __source = TimeSource::system()) noexcept;
+
+    /**
+     * @brief Adds the statistics to the global ones.
+     */
+    ~FramePacer();
+
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    /**
+     * @brief Starts over from frame 0 now, the statistics are kept.
+     */
+    void restart() noexcept;
+
+    /**
+     * @brief Waits until the deadline of the next frame. If it has passed
+     *        already, returns at once with the last frame whose deadline has
+     *        passed, skipping the frames in between.
+     * 
+     * @return The index of the frame to present.
+     */
+    std::uint64_t next();
+
+    /**
+     * @return The index of the current frame.
+     */
+    [[nodiscard]] std::uint64_t frame() const noexcept
+    { return _M_frame; }
+
+    [[nodiscard]] Clock::time_point deadline(std::uint64_t __frame) const noexcept
+    { return _M_origin + _M_period * static_cast<Clock::rep>(__frame); }
+
+    [[nodiscard]] Clock::duration period() const noexcept
+    { return _M_period; }
+
+    [[nodiscard]] const Stats& stats() const noexcept
+    { return _M_stats; }
+
+    /**
+     * @return The statistics of all the pacers destroyed so far.
+     */
+    [[nodiscard]] static Stats globalStats();
+
+    static void resetGlobalStats();
+
+private:
+
+    TimeSource& _M_source;
+
+    const Clock::duration _M_period;
+
+    Clock::time_point _M_origin;
+    std::uint64_t _M_frame = 0;
+
+    Stats _M_stats;
+};
+
+/**
+ * @brief A clock that only moves when slept on or advanced by hand, every
+ *        sleep overshoots by a fixed time to play the slop of the system.
+ */
+class FramePacer::SimulatedTimeSource : public FramePacer::TimeSource
+{
+public:
+
+    explicit SimulatedTimeSource(Clock::duration __overshoot = Clock::duration()) noexcept
+        : _M_overshoot(__overshoot)
+    { }
+
+    virtual Clock::time_point now() override
+    { return _M_now; }
+
+    virtual void sleepUntil(Clock::time_point __deadline) override
+    { _M_now = std::max(_M_now, __deadline) + _M_overshoot; }
+
+    /**
+     * @brief Plays the time spent by a step.
+     */
+    void advance(Clock::duration __duration) noexcept
+    { _M_now += __duration; }
+
+    void setOvershoot(Clock::duration __overshoot) noexcept
+    { _M_overshoot = __overshoot; }
+
+private:
+
+    Clock::time_point _M_now{};
+    Clock::duration _M_overshoot;
+};
+
+}  // namespace win
+
+#endif  // OPENWIN_HEADER_FRAMEPACER_H
\ No newline at end of file
@@ -0,0 +1,378 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* Journal.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 17, 2026, 00:41:26
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Records the calls of Win that change windows, with their arguments and times, into a
+*        compact binary file written through a memory mapped append buffer, and replays them at
+*        the original or the maximum speed. The calls are recorded when openWin is built with
+*        OPENWIN_JOURNALING and a journal is started.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_JOURNAL_H
+#define OPENWIN_HEADER_JOURNAL_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <chrono>
+#include <atomic>
+#include <functional>
+#include <istream>
+#include <initializer_list>
+
+#include <cstdint>
+
+#include "Win.h"
+#include "FramePacer.h"
+
+namespace win
+{
+
+/**
+ * @brief The journal file starts with a 16 bytes header, the magic "OWJ1", the
+ *        version and the wall clock time of start() in nanoseconds. Each
+ *        record follows as
+ * 
+ *        | size u32 | op u16 | kind u8 | count u8 | time u64 | handle u64 |
+ * 
+ *        and its arguments, zigzag varints, a varint length and the bytes of
+ *        a narrow text, or a varint length and the varint code units of a
+ *        wide text. The numbers are in the byte order of the machine, and a
+ *        size of 0 ends the file, as the mapping is zero-filled.
+ * 
+ * @code
+ * Journal::start("run.journal");
+ * 
+ * win.setRect(Rect(0, 0, 800, 600));
+ * win.setTitle("Recorded");
+ * 
+ * Journal::stop();
+ * 
+ * std::ifstream file("run.journal", std::ios::binary);
+ * JournalReplayer(Journal::read(file)).replay(JournalReplayer::MaximumSpeed);
+ * @endcode
+ */
+class Journal
+{
+public:
+
+    /**
+     * @brief The calls recorded, each named after the Win function that
+     *        replays it. Only the outermost one is recorded when they call
+     *        each other, and the path generator overloads record their steps.
+     */
+    enum class Op : std::uint16_t
+    {
+        SetEnable = 1,
+        SetActive,
+        SetForeground,
+        LockSetForeground,
+        UnlockSetForeground,
+        SetFocus,
+        SetCapture,
+        SetParent,
+        SetTile,
+        SetTileIn,
+
+        SetZOrderTop,
+        SetZOrderBottom,
+        SetTopmost,
+
+        /// Win::_M_addStyle() and the like, used by becomePopup(), setBorder() and the like.
+        AddStyle,
+        DelStyle,
+        AddExtendStyle,
+        DelExtendStyle,
+
+        Show,
+        Hide,
+        ShowPopups,
+        HidePopups,
+        SetDisplayProtection,
+        Maximize,
+        Minimize,
+        Restore,
+
+        SetTitleA,
+        SetTitleW,
+
+        SetRect,
+        SetPos,
+        SetSize,
+        SetWidth,
+        SetHeight,
+        SetOpacity,
+
+        /// A step of Win::animateTo(), the rect and the opacity.
+        AnimationFrame,
+
+        SetTransparencyColor,
+        SetTitlebarButtons,
+        SetAcceptFiles,
+
+        Flash,
+        FlashCount,
+        FlashUntilIsForeground,
+
+        LockUpdate,
+        UnlockUpdate,
+
+        Close,
+        Destroy,
+        KillThread,
+        KillProcess,
+
+        /// The message, wParam, lParam, timeout, and 1 if the lParam may be
+        /// a pointer, which is then recorded as 0 and not replayed.
+        SendMessageA,
+        SendMessageW,
+
+        /// Win::post() of a char, a wchar_t and a Key.
+        PostChar,
+        PostWideChar,
+        PostKey,
+
+        SetShortcut
+    };
+
+    enum class Kind : std::uint8_t
+    {
+        Numbers,
+        Text,
+        WideText
+    };
+
+    static constexpr std::size_t maxArgs = 5;
+
+    struct Record
+    {
+        Op op{};
+        Kind kind = Kind::Numbers;
+
+        /// Since the journal was started.
+        std::chrono::nanoseconds time{};
+
+        Win::Handle handle = nullptr;
+
+        std::uint8_t count = 0;
+        std::array<std::int64_t, maxArgs> args{};
+
+        std::string text;
+        std::wstring wideText;
+
+        [[nodiscard]] std::int64_t arg(std::size_t __index) const noexcept
+        { return __index < count ? args[__index] : 0; }
+    };
+
+    /**
+     * @return true if openWin is built with OPENWIN_JOURNALING, otherwise
+     *         nothing is ever recorded.
+     */
+    [[nodiscard]] static constexpr bool available() noexcept
+    {
+#if defined(OPENWIN_JOURNALING)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Stops the current journal if any, and starts a new one written
+     *        to the file.
+     * 
+     * @return false if the file cannot be created or mapped.
+     */
+    static bool start(const std::string& __path);
+
+    /**
+     * @brief Truncates the file to the records written and closes it.
+     */
+    static void stop();
+
+    /**
+     * @brief Flushes the mapped records to the file.
+     */
+    static void flush();
+
+    [[nodiscard]] static bool active() noexcept
+    { return _S_active.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Appends a record with up to maxArgs numbers, those after are
+     *        dropped.
+     */
+    static void record(Op __op, Win::Handle __handle, std::initializer_list<std::int64_t> __args) noexcept;
+
+    static void record(Op __op, Win::Handle __handle, std::string_view __text) noexcept;
+    static void record(Op __op, Win::Handle __handle, std::wstring_view __text) noexcept;
+
+    /**
+     * @return The records read, up to the first one that is incomplete, or
+     *         none if the input is not a journal.
+     */
+    [[nodiscard]] static std::vector<Record> read(std::istream& __is);
+
+    [[nodiscard]] static const char* name(Op __op) noexcept;
+
+private:
+
+    static std::atomic<bool> _S_active;
+};
+
+/**
+ * @brief Records a call if a journal is active and no journaled call is on
+ *        the stack of the calling thread, used by the guarded calls of Win.
+ */
+class JournalScope
+{
+public:
+
+    JournalScope(Journal::Op __op, Win::Handle __handle, std::initializer_list<std::int64_t> __args) noexcept
+        : _M_state(_S_enter())
+    {
+        if (_M_state == Outermost)
+        {
+            Journal::record(__op, __handle, __args);
+        }
+    }
+
+    JournalScope(Journal::Op __op, Win::Handle __handle, std::string_view __text) noexcept
+        : _M_state(_S_enter())
+    {
+        if (_M_state == Outermost)
+        {
+            Journal::record(__op, __handle, __text);
+        }
+    }
+
+    JournalScope(Journal::Op __op, Win::Handle __handle, std::wstring_view __text) noexcept
+        : _M_state(_S_enter())
+    {
+        if (_M_state == Outermost)
+        {
+            Journal::record(__op, __handle, __text);
+        }
+    }
+
+    ~JournalScope()
+    {
+        if (_M_state != Inactive)
+        {
+            --_S_depth;
+        }
+    }
+
+    JournalScope(const JournalScope&) = delete;
+    JournalScope& operator=(const JournalScope&) = delete;
+
+    /**
+     * @brief Records a step of a path generator overload, which has no scope
+     *        of its own.
+     */
+    static void step(Journal::Op __op, Win::Handle __handle, std::initializer_list<std::int64_t> __args) noexcept
+    {
+        if (Journal::active() && _S_depth == 0)
+        {
+            Journal::record(__op, __handle, __args);
+        }
+    }
+
+private:
+
+    enum State : std::uint8_t
+    {
+        Inactive,
+        Nested,
+        Outermost
+    };
+
+    [[nodiscard]] static State _S_enter() noexcept
+    {
+        if (not Journal::active())
+        {
+            return Inactive;
+        }
+
+        return _S_depth++ == 0 ? Outermost : Nested;
+    }
+
+    State _M_state;
+
+    static thread_local std::uint32_t _S_depth;
+};
+
+/**
+ * @brief Replays the records of a journal by calling the Win functions they
+ *        are named after.
+ */
+class JournalReplayer
+{
+public:
+
+    enum Speed
+    {
+        /// Keeps the time between the records.
+        OriginalSpeed,
+
+        /// Issues the records one after another.
+        MaximumSpeed
+    };
+
+    /**
+     * @brief Maps a recorded handle to the window to replay it on, for
+     *        windows created again with other handles.
+     */
+    using Resolver = std::function<Win(Win::Handle)>;
+
+    explicit JournalReplayer(std::vector<Journal::Record> __records) noexcept
+        : _M_records(std::move(__records))
+    { }
+
+    [[nodiscard]] const std::vector<Journal::Record>& records() const noexcept
+    { return _M_records; }
+
+    /**
+     * @param __resolver nullptr to replay on the recorded handles.
+     */
+    void setResolver(Resolver __resolver) noexcept
+    { _M_resolver = std::move(__resolver); }
+
+    /**
+     * @brief Replays all records, the first one at once.
+     * 
+     * @param __source Where the time comes from with OriginalSpeed.
+     * 
+     * @return The time the replay took.
+     */
+    FramePacer::Clock::duration replay(
+        Speed __speed = OriginalSpeed,
+        FramePacer::TimeSource& __source = FramePacer::TimeSource::system()) const;
+
+    /**
+     * @brief Replays one record on the window.
+     */
+    static void apply(const Journal::Record& __record, const Win& __win, const Resolver& __resolver = nullptr);
+
+private:
+
+    std::vector<Journal::Record> _M_records;
+
+    Resolver _M_resolver;
+};
+
+}  // namespace win
+
+#endif  // OPENWIN_HEADER_JOURNAL_H
\ No newline at end of file
@@ -0,0 +1,193 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* Profiler.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 14:20:47
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Per-function call counts and latency histograms of the guarded calls, recorded when
+*        openWin is built with OPENWIN_PROFILING and the profiler is enabled at runtime.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_PROFILER_H
+#define OPENWIN_HEADER_PROFILER_H
+
+#include <array>
+#include <vector>
+#include <chrono>
+#include <atomic>
+
+#include <cstdint>
+
+#include "CallSite.h"
+
+namespace win
+{
+
+/**
+ * @brief A log-linear latency histogram in the style of HDR histograms: every
+ *        power of two is split into 16 linear sub-buckets, so a recorded value
+ *        is off by less than 1/16 of itself.
+ */
+class LatencyHistogram
+{
+public:
+
+    static constexpr std::size_t subBucketBits = 4;
+    static constexpr std::size_t subBucketCount = std::size_t(1) << subBucketBits;
+
+    /// Values from 2^maxExponent ns (about 18 minutes) on share the last bucket.
+    static constexpr std::size_t maxExponent = 40;
+
+    static constexpr std::size_t bucketCount = (maxExponent - subBucketBits + 1) * subBucketCount;
+
+    void record(std::uint64_t __nanoseconds) noexcept;
+    void merge(const LatencyHistogram& __other) noexcept;
+    void clear() noexcept;
+
+    [[nodiscard]] std::uint64_t count() const noexcept
+    { return _M_count; }
+
+    [[nodiscard]] std::chrono::nanoseconds total() const noexcept
+    { return std::chrono::nanoseconds(_M_total); }
+
+    [[nodiscard]] std::chrono::nanoseconds min() const noexcept
+    { return std::chrono::nanoseconds(_M_count ? _M_min : 0); }
+
+    [[nodiscard]] std::chrono::nanoseconds max() const noexcept
+    { return std::chrono::nanoseconds(_M_max); }
+
+    [[nodiscard]] std::chrono::nanoseconds mean() const noexcept
+    { return std::chrono::nanoseconds(_M_count ? _M_total / _M_count : 0); }
+
+    /**
+     * @param __percentile In [0, 100].
+     * 
+     * @return The upper bound of the bucket holding the percentile.
+     */
+    [[nodiscard]] std::chrono::nanoseconds percentile(double __percentile) const noexcept;
+
+    [[nodiscard]] static std::size_t bucketOf(std::uint64_t __nanoseconds) noexcept;
+
+    /**
+     * @return The largest value in the bucket.
+     */
+    [[nodiscard]] static std::uint64_t bucketUpperBound(std::size_t __bucket) noexcept;
+
+    [[nodiscard]] const std::array<std::uint64_t, bucketCount>& buckets() const noexcept
+    { return _M_buckets; }
+
+private:
+
+    std::array<std::uint64_t, bucketCount> _M_buckets{};
+
+    std::uint64_t _M_count = 0;
+    std::uint64_t _M_total = 0;
+    std::uint64_t _M_min = UINT64_MAX;
+    std::uint64_t _M_max = 0;
+};
+
+class Profiler
+{
+public:
+
+    struct Entry
+    {
+        CallSiteId site;
+
+        /// The function prototype of the guarded call, or nullptr if the call
+        /// site is not registered.
+        const char* function;
+
+        LatencyHistogram latency;
+    };
+
+    /**
+     * @return true if openWin is built with OPENWIN_PROFILING, otherwise
+     *         nothing is ever recorded.
+     */
+    [[nodiscard]] static constexpr bool available() noexcept
+    {
+#if defined(OPENWIN_PROFILING)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Starts or stops recording, stopped by default.
+     */
+    static void setEnabled(bool __enabled) noexcept;
+
+    [[nodiscard]] static bool enabled() noexcept
+    { return _S_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @return The histograms of all threads merged per function, including
+     *         the threads that have exited, sorted by total time descending.
+     */
+    [[nodiscard]] static std::vector<Entry> snapshot();
+
+    /**
+     * @brief Clears the histograms of all threads.
+     */
+    static void reset();
+
+    /**
+     * @brief Records one call into the histogram of the calling thread.
+     */
+    static void record(CallSiteId __site, std::chrono::nanoseconds __latency) noexcept;
+
+private:
+
+    static std::atomic<bool> _S_enabled;
+};
+
+/**
+ * @brief Records the time from its construction to its destruction if the
+ *        profiler is enabled, used by the guarded calls.
+ */
+class ProfilerScope
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    explicit ProfilerScope(CallSiteId __site) noexcept
+        : _M_site(Profiler::enabled() ? __site : CallSite::none)
+    {
+        if (_M_site != CallSite::none)
+        {
+            _M_start = Clock::now();
+        }
+    }
+
+    ~ProfilerScope()
+    {
+        if (_M_site != CallSite::none)
+        {
+            Profiler::record(_M_site, Clock::now() - _M_start);
+        }
+    }
+
+    ProfilerScope(const ProfilerScope&) = delete;
+    ProfilerScope& operator=(const ProfilerScope&) = delete;
+
+private:
+
+    CallSiteId _M_site;
+    Clock::time_point _M_start;
+};
+
+}  // namespace win
+
+#endif  // OPENWIN_HEADER_PROFILER_H
\ No newline at end of file
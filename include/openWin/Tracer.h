@@ -0,0 +1,134 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* Tracer.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 15:02:13
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Streams the begin and end of the guarded calls to a Chrome trace-event JSON file, which
+*        can be opened by chrome://tracing or Perfetto as a flame chart. The events are recorded
+*        when openWin is built with OPENWIN_TRACING and a trace is started.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_TRACER_H
+#define OPENWIN_HEADER_TRACER_H
+
+#include <string>
+#include <atomic>
+
+#include <cstdint>
+
+#include "CallSite.h"
+
+namespace win
+{
+
+class Tracer
+{
+public:
+
+    /**
+     * @return true if openWin is built with OPENWIN_TRACING, otherwise
+     *         nothing is ever recorded.
+     */
+    [[nodiscard]] static constexpr bool available() noexcept
+    {
+#if defined(OPENWIN_TRACING)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Stops the current trace if any, and starts a new one written to
+     *        the file.
+     * 
+     * @return false if the file cannot be opened.
+     */
+    static bool start(const std::string& __path);
+
+    /**
+     * @brief Writes the events recorded by all threads and closes the file.
+     */
+    static void stop();
+
+    /**
+     * @brief Writes the events recorded by all threads so far.
+     */
+    static void flush();
+
+    [[nodiscard]] static bool active() noexcept
+    { return _S_generation.load(std::memory_order_relaxed) & 1; }
+
+    /**
+     * @return An odd number while a trace is active, changed by every start()
+     *         and stop().
+     */
+    [[nodiscard]] static std::uint32_t generation() noexcept
+    { return _S_generation.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Records the begin of a call into the buffer of the calling thread.
+     * 
+     * @param __site   The call site, named by CallSite::name() in the file.
+     * @param __handle The window or other object the call works on, or
+     *                 nullptr.
+     */
+    static void begin(CallSiteId __site, const void* __handle) noexcept;
+
+    /**
+     * @brief Records the end of the last call begun by the calling thread.
+     */
+    static void end() noexcept;
+
+private:
+
+    static std::atomic<std::uint32_t> _S_generation;
+};
+
+/**
+ * @brief Records the begin and end of a call if a trace is active, used by the
+ *        guarded calls.
+ */
+class TraceScope
+{
+public:
+
+    TraceScope(CallSiteId __site, const void* __handle) noexcept
+        : _M_generation(Tracer::generation())
+    {
+        if (_M_generation & 1)
+        {
+            Tracer::begin(__site, __handle);
+        }
+    }
+
+    ~TraceScope()
+    {
+        /// The trace may be stopped or restarted in between.
+        if ((_M_generation & 1) && _M_generation == Tracer::generation())
+        {
+            Tracer::end();
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+
+    std::uint32_t _M_generation;
+};
+
+}  // namespace win
+
+#endif  // OPENWIN_HEADER_TRACER_H
\ No newline at end of file
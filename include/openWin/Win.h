@@ -19,8 +19,10 @@
 #ifndef OPENWIN_HEADER_WIN_H
 #define OPENWIN_HEADER_WIN_H
 
+#include <array>
 #include <vector>
 #include <string>
+#include <type_traits>
 
 #include <iostream>
 
@@ -43,6 +45,7 @@ namespace win
 {
 
 class Painter;
+class Animation;
 
 class [[nodiscard]] Win
 {
@@ -56,18 +59,22 @@ public:
     using ThreadId = std::uint32_t;
     using ProcessId = std::uint32_t;
 
-    Win() noexcept;
+    /**
+     * @note Win only holds the handle, copying a Win is as cheap as copying a
+     *       pointer.
+     */
+    Win() = default;
 
     Win(Handle __handle) noexcept;
     Win& operator=(Handle __handle) noexcept;
 
-    Win(const Win& __win) noexcept;
-    Win& operator=(const Win& __win) noexcept;
+    Win(const Win& __win) = default;
+    Win& operator=(const Win& __win) = default;
 
-    Win(Win&& __win) noexcept;
-    Win& operator=(Win&& __win) noexcept;
+    Win(Win&& __win) = default;
+    Win& operator=(Win&& __win) = default;
 
-    ~Win() noexcept;
+    ~Win() = default;
 
 
     void setHandle(Handle __handle) noexcept;
@@ -75,10 +82,37 @@ public:
 
     /* ================== error stream ================== */
 
+    /**
+     * @brief Error streams are attached to a window handle in the calling
+     *        thread, so all the Win objects with the same handle share one.
+     * 
+     *        A window has no error stream until one of its calls fails or one
+     *        is requested by errorStream() or setErrorStream(), the calls in
+     *        between are tracked by ErrorStream::global(). A stream attached
+     *        by a failure is released by the next call that succeeds, so the
+     *        reference from errorStream() const is valid until then; it is an
+     *        empty stream if none is attached.
+     * 
+     * @note  When openWin is built with OPENWIN_LEAN_ERRORS, the guarded calls
+     *        do not use error streams, success() and failed() report the last
+     *        call of the calling thread, see LeanErrorStream::local().
+     */
     void setErrorStream(const ErrorStream& __es);
     [[nodiscard]] ErrorStream& errorStream() noexcept;
     [[nodiscard]] const ErrorStream& errorStream() const noexcept;
 
+    /**
+     * @return true if an error stream is attached to the current window in the
+     *         calling thread.
+     */
+    [[nodiscard]] bool hasErrorStream() const noexcept;
+
+    /**
+     * @brief Releases the error stream attached to the current window in the
+     *        calling thread, if any.
+     */
+    void detachErrorStream() const noexcept;
+
     [[nodiscard]] bool success() const noexcept;
     [[nodiscard]] bool failed() const noexcept;
 
@@ -975,6 +1009,73 @@ public:
      */
     [[nodiscard]] int opacity() const noexcept;
 
+    /* ================== animation ================== */
+
+    /**
+     * @brief The channels animated together by animateTo(): x, y, width,
+     *        height and opacity.
+     */
+    using AnimationValue = std::array<int, 5>;
+
+    /**
+     * @brief Moves, resizes and fades the current window along one path, with
+     *        one SetWindowPos per frame. The frames that leave the rect and
+     *        the opacity as they are, after rounding, are skipped.
+     * 
+     * @param __rect    The new rect, in the same units as rect().
+     * @param __opacity [0, 255] The new opacity.
+     * @param __pg      For example pg::Linear<Win::AnimationValue>(8.0F, 16).
+     */
+    void animateTo(
+        const Rect& __rect,
+        int __opacity,
+        const pg::BasicPathGenerator<AnimationValue>& __pg) const noexcept;
+
+    /**
+     * @brief Same as animateTo() with the current opacity.
+     */
+    void animateTo(
+        const Rect& __rect,
+        const pg::BasicPathGenerator<AnimationValue>& __pg) const noexcept;
+
+    /**
+     * @brief Same as the animated setters, but returns at once, the frames are
+     *        written by AnimationScheduler::shared(). The returned Animation
+     *        can be awaited in a coroutine, joined, or turned into a future:
+     * 
+     * @code
+     * if (co_await win.setPosAsync(Point(0, 0), pg::Linear<Point>(8.0F, 16)))
+     * {
+     *     co_await win.setOpacityAsync(0, pg::Linear<int>(8.0F, 16));
+     * }
+     * @endcode
+     * 
+     * @param __pg A path generator, copied.
+     */
+    template<typename _Generator>
+    Animation setPosAsync(const Point& __point, const _Generator& __pg) const;
+
+    template<typename _Generator>
+    Animation setSizeAsync(const Size& __size, const _Generator& __pg) const;
+
+    template<typename _Generator>
+    Animation setZoomAsync(int __additionalWidth, int __additionalHeight, const _Generator& __pg) const;
+
+    template<typename _Generator>
+    Animation setZoomAsync(int __additional, const _Generator& __pg) const;
+
+    template<typename _Generator>
+    Animation setZoomAsync(double __scaleX, double __scaleY, const _Generator& __pg) const;
+
+    template<typename _Generator>
+    Animation setZoomAsync(double __scale, const _Generator& __pg) const;
+
+    template<typename _Generator>
+    Animation setOpacityAsync(int __value, const _Generator& __pg) const;
+
+    template<typename _Generator>
+    Animation animateToAsync(const Rect& __rect, int __opacity, const _Generator& __pg) const;
+
     /**
      * @brief Sets the transparency color key of the current window.
      * 
@@ -1540,10 +1641,18 @@ public:
 
 private:
 
-    Handle _M_handle;
-    ErrorStream* _M_errorStream;
+    Handle _M_handle = nullptr;
 };
 
+static_assert(std::is_trivially_copyable_v<Win>, "Win must be trivially copyable.");
+static_assert(sizeof(Win) == sizeof(Win::Handle), "Win must be the size of a handle.");
+
 }  // namespace win
 
+/// Defines Wins::beginBatch(), which needs a complete Win.
+#include "WinBatch.h"
+
+/// Defines the asynchronous setters of Win.
+#include "AnimationScheduler.h"
+
 #endif  // OPENWIN_HEADER_WIN_H
\ No newline at end of file
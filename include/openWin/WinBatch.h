@@ -0,0 +1,165 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WinBatch.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 20:41:16
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Queues the rect, z-order and visibility changes of many windows and applies them
+*        together with one deferred window positioning, so the desktop repaints once.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_WINBATCH_H
+#define OPENWIN_HEADER_WINBATCH_H
+
+#include <vector>
+#include <unordered_map>
+
+#include <cstdint>
+
+#include "Win.h"
+
+namespace win
+{
+
+/**
+ * @code
+ * WinBatch batch = Win::list().beginBatch();
+ * 
+ * batch.setRect(a, Rect(0, 0, 960, 1080)).setZOrderTop(a);
+ * batch.setRect(b, Rect(960, 0, 960, 1080));
+ * batch.hide(c);
+ * 
+ * batch.commit();
+ * @endcode
+ * 
+ * @note The changes queued for the same window are merged, the last one of
+ *       each kind wins. The positions and the sizes are converted the same
+ *       way as the setters of Win with the same name.
+ */
+class WinBatch
+{
+public:
+
+    WinBatch() = default;
+
+    /**
+     * @param __reserve The expected number of windows.
+     */
+    explicit WinBatch(std::size_t __reserve);
+
+    WinBatch& setRect(const Win& __win, const Rect& __rect);
+    WinBatch& setPos(const Win& __win, const Point& __point);
+    WinBatch& setSize(const Win& __win, const Size& __size);
+
+    WinBatch& setZOrderTop(const Win& __win);
+    WinBatch& setZOrderBottom(const Win& __win);
+    WinBatch& setTopmost(const Win& __win, bool __enable = true);
+
+    /**
+     * @brief Places the window right below another one in the Z-order.
+     */
+    WinBatch& setZOrderBelow(const Win& __win, const Win& __above);
+
+    WinBatch& show(const Win& __win)
+    { return setVisible(__win, true); }
+
+    WinBatch& hide(const Win& __win)
+    { return setVisible(__win, false); }
+
+    WinBatch& setVisible(const Win& __win, bool __enable = true);
+
+    /**
+     * @brief Drops the changes that would leave a window as it is, then applies
+     *        the others with BeginDeferWindowPos() and EndDeferWindowPos(),
+     *        without activating the windows. The batch is empty afterwards.
+     * 
+     * @return The number of windows changed.
+     */
+    std::size_t commit() noexcept;
+
+    /**
+     * @brief Drops the queued changes.
+     */
+    void cancel() noexcept;
+
+    /**
+     * @return The number of windows with queued changes.
+     */
+    [[nodiscard]] std::size_t size() const noexcept
+    { return _M_changes.size(); }
+
+    [[nodiscard]] bool empty() const noexcept
+    { return _M_changes.empty(); }
+
+    /**
+     * @return The number of windows left as they are by the last commit().
+     */
+    [[nodiscard]] std::size_t skipped() const noexcept
+    { return _M_skipped; }
+
+private:
+
+    enum part : std::uint8_t
+    {
+        PosPart        = 1 << 0,
+        SizePart       = 1 << 1,
+        ZOrderPart     = 1 << 2,
+        VisibilityPart = 1 << 3,
+
+        /// The position is logical, as in Win::setPos(), not physical as in
+        /// Win::setRect().
+        ScaledPosPart  = 1 << 4
+    };
+
+    enum class zorder : std::uint8_t
+    {
+        Top,
+        Bottom,
+        Topmost,
+        NoTopmost,
+        Below
+    };
+
+    struct change
+    {
+        Win::Handle handle;
+
+        Point pos;
+        Size size;
+
+        zorder order;
+        Win::Handle above;
+
+        bool visible;
+
+        std::uint8_t parts;
+    };
+
+    [[nodiscard]] change& _M_change(const Win& __win);
+
+    std::vector<change> _M_changes;
+
+    /// The index in _M_changes of each window.
+    std::unordered_map<Win::Handle, std::size_t> _M_indexes;
+
+    std::size_t _M_skipped = 0;
+};
+
+template<typename _Base>
+WinBatch Wins<_Base>::beginBatch() const
+{
+    return WinBatch(this->size());
+}
+
+}  // namespace win
+
+#endif  // OPENWIN_HEADER_WINBATCH_H
\ No newline at end of file
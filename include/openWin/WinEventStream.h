@@ -0,0 +1,283 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WinEventStream.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 19:12:27
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Pushes window changes to a callback instead of polling, the events are received by
+*        WinEvent hooks, passed through a lock-free queue, coalesced and delivered in batches by
+*        a dispatcher thread.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_WINEVENTSTREAM_H
+#define OPENWIN_HEADER_WINEVENTSTREAM_H
+
+#include <span>
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <chrono>
+#include <functional>
+
+#include <atomic>
+#include <thread>
+
+#include <cstdint>
+
+#include "Win.h"
+
+#include "ds/MpscRingBuffer.h"
+
+namespace win
+{
+
+struct WinEvent
+{
+    using Clock = std::chrono::steady_clock;
+
+    enum Kind : std::uint8_t
+    {
+        Created,
+        Destroyed,
+
+        /// Moved or resized.
+        Moved,
+
+        TitleChanged,
+
+        /// Became the foreground window.
+        Foreground
+    };
+
+    using Kinds = std::uint32_t;
+
+    static constexpr Kinds allKinds = (1 << Created) | (1 << Destroyed) | (1 << Moved) | (1 << TitleChanged) | (1 << Foreground);
+
+    [[nodiscard]] static constexpr Kinds bit(Kind __kind) noexcept
+    { return Kinds(1) << __kind; }
+
+    Kind kind;
+    Win::Handle handle;
+
+    /// The time of the last event coalesced into this one.
+    Clock::time_point time;
+
+    /// The number of events coalesced into this one.
+    std::uint32_t count = 1;
+};
+
+class WinEventStream
+{
+public:
+
+    using Clock = WinEvent::Clock;
+
+    /**
+     * @brief Called on the dispatcher thread with the events in the order they
+     *        were received.
+     */
+    using Callback = std::function<void(std::span<const WinEvent> __batch)>;
+
+    struct Options
+    {
+        WinEvent::Kinds kinds = WinEvent::allKinds;
+
+        /// Rounded up to a power of 2, the events that do not fit are dropped
+        /// and counted.
+        std::size_t capacity = 4096;
+
+        /// The time the dispatcher waits after the first event of a batch for
+        /// more events to come, 0 delivers at once.
+        Clock::duration batchInterval = std::chrono::milliseconds(16);
+
+        /// Merges the Moved, TitleChanged and Foreground events of the same
+        /// window within a batch into one, moved to the place of the last,
+        /// so that the order of the windows is the order of their last events.
+        bool coalesce = true;
+    };
+
+    /**
+     * @brief Where the events come from, Source::system() installs WinEvent
+     *        hooks, SyntheticSource is fed by hand.
+     */
+    class Source
+    {
+    public:
+
+        virtual ~Source() = default;
+
+        /**
+         * @brief Starts posting events to the stream with WinEventStream::post().
+         */
+        virtual bool start(WinEventStream& __stream) = 0;
+
+        /**
+         * @brief Stops posting events, returns after the last post.
+         */
+        virtual void stop() = 0;
+
+        /**
+         * @return A source that installs WinEvent hooks on a thread of its
+         *         own, running a message loop.
+         */
+        [[nodiscard]] static std::unique_ptr<Source> system();
+    };
+
+    class SyntheticSource;
+
+    explicit WinEventStream(Callback __callback);
+    WinEventStream(Callback __callback, const Options& __options, std::unique_ptr<Source> __source = Source::system());
+
+    /**
+     * @brief Stops the stream, the events received so far are delivered.
+     */
+    ~WinEventStream();
+
+    WinEventStream(const WinEventStream&) = delete;
+    WinEventStream& operator=(const WinEventStream&) = delete;
+
+    /**
+     * @brief Starts the dispatcher thread and the source.
+     * 
+     * @return false if the source cannot be started.
+     */
+    bool start();
+
+    /**
+     * @brief Stops the source and the dispatcher thread after delivering the
+     *        remaining events.
+     */
+    void stop();
+
+    [[nodiscard]] bool running() const noexcept
+    { return _M_thread.joinable(); }
+
+    /**
+     * @brief Queues an event for the dispatcher, called by the sources from
+     *        any thread without blocking.
+     */
+    void post(WinEvent::Kind __kind, Win::Handle __handle) noexcept;
+
+    [[nodiscard]] const Options& options() const noexcept
+    { return _M_options; }
+
+    [[nodiscard]] std::uint64_t received() const noexcept
+    { return _M_received.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] std::uint64_t dropped() const noexcept
+    { return _M_dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @return The number of events delivered, after coalescing.
+     */
+    [[nodiscard]] std::uint64_t delivered() const noexcept
+    { return _M_delivered.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] std::uint64_t batches() const noexcept
+    { return _M_batches.load(std::memory_order_relaxed); }
+
+private:
+
+    void _M_run();
+
+    /**
+     * @brief Drains the queue into the batch.
+     * 
+     * @return false if the queue was empty.
+     */
+    bool _M_drain();
+
+    void _M_dispatch();
+
+    Callback _M_callback;
+    Options _M_options;
+    std::unique_ptr<Source> _M_source;
+
+    ds::MpscRingBuffer<WinEvent> _M_queue;
+
+    std::vector<WinEvent> _M_batch;
+
+    /// The indexes in the batch of the Moved, TitleChanged and Foreground
+    /// events of each window, or UINT32_MAX. The events merged into a later
+    /// one are left with a count of 0 and removed before the dispatch.
+    std::unordered_map<Win::Handle, std::array<std::uint32_t, 3>> _M_coalesced;
+
+    /// Changed on every post and on stop, the dispatcher waits on it.
+    std::atomic<std::uint32_t> _M_signal = 0;
+    std::atomic<bool> _M_stop = false;
+
+    std::atomic<std::uint64_t> _M_received = 0;
+    std::atomic<std::uint64_t> _M_dropped = 0;
+    std::atomic<std::uint64_t> _M_delivered = 0;
+    std::atomic<std::uint64_t> _M_batches = 0;
+
+    std::thread _M_thread;
+};
+
+/**
+ * @brief A source fed by hand, to test the dispatch and coalescing without
+ *        WinEvent hooks.
+ */
+class WinEventStream::SyntheticSource : public WinEventStream::Source
+{
+public:
+
+    virtual bool start(WinEventStream& __stream) override
+    {
+        _M_stream.store(&__stream, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Waits for the emit() calls that have seen the stream.
+     */
+    virtual void stop() override
+    {
+        _M_stream.store(nullptr);
+
+        for (std::uint32_t emitting; (emitting = _M_emitting.load()) != 0; )
+        {
+            _M_emitting.wait(emitting);
+        }
+    }
+
+    /**
+     * @brief Posts the event to the stream if started, from any thread.
+     */
+    void emit(WinEvent::Kind __kind, Win::Handle __handle) noexcept
+    {
+        _M_emitting.fetch_add(1);
+
+        if (WinEventStream* stream = _M_stream.load())
+        {
+            stream->post(__kind, __handle);
+        }
+
+        if (_M_emitting.fetch_sub(1) == 1)
+        {
+            _M_emitting.notify_all();
+        }
+    }
+
+private:
+
+    std::atomic<WinEventStream*> _M_stream = nullptr;
+
+    /// The emit() calls in progress, sequentially consistent with _M_stream
+    /// so that stop() sees the ones that loaded it before it was cleared.
+    std::atomic<std::uint32_t> _M_emitting = 0;
+};
+
+}  // namespace win
+
+#endif  // OPENWIN_HEADER_WINEVENTSTREAM_H
\ No newline at end of file
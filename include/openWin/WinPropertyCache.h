@@ -0,0 +1,241 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WinPropertyCache.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 20:03:51
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief An opt-in cache of the window properties, the class name and the path never change
+*        and are kept for the life of the window, the title, the dpi and the rect are kept until
+*        a WinEvent invalidates them or their time to live runs out.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_WINPROPERTYCACHE_H
+#define OPENWIN_HEADER_WINPROPERTYCACHE_H
+
+#include <array>
+#include <span>
+#include <optional>
+#include <unordered_map>
+#include <chrono>
+
+#include <atomic>
+#include <shared_mutex>
+
+#include <cstdint>
+
+#include "Win.h"
+#include "WinEventStream.h"
+
+namespace win
+{
+
+class WinPropertyCache
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    enum Property : std::uint8_t
+    {
+        Title,
+        ClassName,
+        Path,
+        Dpi,
+        Rect,
+
+        PropertyCount
+    };
+
+    /**
+     * @return true if the property never changes for the life of a window.
+     */
+    [[nodiscard]] static constexpr bool isImmutable(Property __property) noexcept
+    { return __property == ClassName || __property == Path; }
+
+    /**
+     * @brief Where the properties come from when they are not cached,
+     *        Backend::system() asks the getters of Win.
+     * 
+     * @return std::nullopt if the property cannot be read, as for an invalid
+     *         or destroyed window, which is never cached.
+     * 
+     * @note  Called without any lock held, may be called concurrently.
+     */
+    class Backend
+    {
+    public:
+
+        virtual ~Backend() = default;
+
+        [[nodiscard]] virtual std::optional<Win::String> title(Win::Handle __handle) = 0;
+        [[nodiscard]] virtual std::optional<Win::String> className(Win::Handle __handle) = 0;
+        [[nodiscard]] virtual std::optional<Win::String> path(Win::Handle __handle) = 0;
+        [[nodiscard]] virtual std::optional<float> dpi(Win::Handle __handle) = 0;
+        [[nodiscard]] virtual std::optional<win::Rect> rect(Win::Handle __handle) = 0;
+
+        /**
+         * @brief The clock of the time to live, overridden to test the
+         *        expiration without waiting.
+         */
+        [[nodiscard]] virtual Clock::time_point now()
+        { return Clock::now(); }
+
+        [[nodiscard]] static Backend& system() noexcept;
+    };
+
+    struct Options
+    {
+        /// How long the mutable properties are kept without an event, 0 keeps
+        /// them until invalidated.
+        Clock::duration ttl = std::chrono::milliseconds(250);
+
+        /// The number of windows kept, an arbitrary window is forgotten to make
+        /// room for a new one.
+        std::size_t capacity = 4096;
+    };
+
+    struct Stats
+    {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+
+        /// The misses caused by the time to live, included in misses.
+        std::uint64_t expirations = 0;
+
+        /// The cached values dropped by invalidate() or by an event.
+        std::uint64_t invalidations = 0;
+
+        [[nodiscard]] double hitRate() const noexcept
+        { return hits + misses ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0; }
+    };
+
+    WinPropertyCache();
+    explicit WinPropertyCache(const Options& __options, Backend& __backend = Backend::system());
+
+    WinPropertyCache(const WinPropertyCache&) = delete;
+    WinPropertyCache& operator=(const WinPropertyCache&) = delete;
+
+    /**
+     * @return The property, or an empty value if it cannot be read.
+     */
+    [[nodiscard]] Win::String title(Win::Handle __handle);
+    [[nodiscard]] Win::String className(Win::Handle __handle);
+    [[nodiscard]] Win::String path(Win::Handle __handle);
+    [[nodiscard]] float dpi(Win::Handle __handle);
+    [[nodiscard]] win::Rect rect(Win::Handle __handle);
+
+    /**
+     * @brief Drops the cached value of a property of the window, a fetch in
+     *        progress will not cache the value it read before.
+     */
+    void invalidate(Win::Handle __handle, Property __property);
+
+    /**
+     * @brief Drops the cached mutable properties of the window.
+     */
+    void invalidate(Win::Handle __handle);
+
+    /**
+     * @brief Drops all cached properties of the window, including the
+     *        immutable ones, for a window that was destroyed.
+     */
+    void forget(Win::Handle __handle);
+
+    void clear();
+
+    /**
+     * @brief Invalidates the properties changed by the events, Created and
+     *        Destroyed forget the window, as its handle may be reused.
+     */
+    void apply(std::span<const WinEvent> __events);
+
+    /**
+     * @return A callback for WinEventStream that calls apply(), the cache must
+     *         outlive the stream.
+     */
+    [[nodiscard]] WinEventStream::Callback invalidator() noexcept
+    { return [this](std::span<const WinEvent> __events) { apply(__events); }; }
+
+    [[nodiscard]] Stats stats(Property __property) const noexcept;
+
+    /**
+     * @return The sum of the statistics of all properties.
+     */
+    [[nodiscard]] Stats stats() const noexcept;
+
+    void resetStats() noexcept;
+
+    /**
+     * @return The number of cached windows.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    [[nodiscard]] const Options& options() const noexcept
+    { return _M_options; }
+
+private:
+
+    struct entry
+    {
+        Win::String title;
+        Win::String className;
+        Win::String path;
+        float dpi = 0;
+        win::Rect rect{};
+
+        std::array<Clock::time_point, PropertyCount> fetched{};
+
+        /// A bit per cached property.
+        std::uint8_t valid = 0;
+
+        /// Taken from _M_generation when the entry is made and on every
+        /// invalidation, so a fetch that started before can tell its value
+        /// is stale, even if the entry was forgotten and made again.
+        std::uint64_t generation = 0;
+    };
+
+    struct counters
+    {
+        std::atomic<std::uint64_t> hits = 0;
+        std::atomic<std::uint64_t> misses = 0;
+        std::atomic<std::uint64_t> expirations = 0;
+        std::atomic<std::uint64_t> invalidations = 0;
+    };
+
+    [[nodiscard]] static constexpr std::uint8_t _S_bit(Property __property) noexcept
+    { return static_cast<std::uint8_t>(1 << __property); }
+
+    template<typename _Tp, typename _Fetch>
+    [[nodiscard]] _Tp _M_get(Win::Handle __handle, Property __property, _Tp entry::* __member, _Fetch __fetch);
+
+    /**
+     * @brief Called with the lock held.
+     */
+    void _M_invalidate(Win::Handle __handle, std::uint8_t __properties);
+    void _M_forget(Win::Handle __handle);
+
+    const Options _M_options;
+    Backend& _M_backend;
+
+    mutable std::shared_mutex _M_mutex;
+
+    std::unordered_map<Win::Handle, entry> _M_entries;
+
+    /// The last generation given to an entry.
+    std::uint64_t _M_generation = 0;
+
+    std::array<counters, PropertyCount> _M_counters;
+};
+
+}  // namespace win
+
+#endif  // OPENWIN_HEADER_WINPROPERTYCACHE_H
\ No newline at end of file
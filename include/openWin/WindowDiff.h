@@ -0,0 +1,120 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WindowDiff.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 18:36:52
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief The changes between two window snapshots, so that a monitoring loop can process the
+*        windows that changed instead of the full list.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_WINDOWDIFF_H
+#define OPENWIN_HEADER_WINDOWDIFF_H
+
+#include <vector>
+
+#include <cstdint>
+
+#include "WindowSnapshot.h"
+
+namespace win
+{
+
+class WindowDiff
+{
+public:
+
+    enum Change : std::uint32_t
+    {
+        Created       = 1 << 0,
+        Destroyed     = 1 << 1,
+
+        /// Moved or resized, only if both snapshots have rects.
+        Moved         = 1 << 2,
+
+        /// Only if both snapshots have titles.
+        Retitled      = 1 << 3,
+
+        /// Moved to another place in the z-order relative to the other windows
+        /// in both snapshots.
+        ZOrderChanged = 1 << 4
+    };
+
+    using Changes = std::uint32_t;
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    struct Entry
+    {
+        Win::Handle handle;
+        Changes changes;
+
+        /// The indexes of the window in the snapshots, npos if it is not in
+        /// the snapshot.
+        std::size_t before;
+        std::size_t after;
+
+        [[nodiscard]] bool has(Changes __changes) const noexcept
+        { return changes & __changes; }
+    };
+
+    WindowDiff() = default;
+
+    /**
+     * @brief Matches the windows of the snapshots through a hash map keyed by
+     *        their handles, in linear time.
+     * 
+     *        The z-order changes are the fewest windows whose moves explain the
+     *        new order: the windows that stay in the longest common subsequence
+     *        of both orders are not reported, which costs O(k log k) for
+     *        the k windows in both snapshots.
+     */
+    [[nodiscard]] static WindowDiff between(const WindowSnapshot& __before, const WindowSnapshot& __after);
+
+    /**
+     * @return The windows with any change: the windows of the after snapshot
+     *         in its order, then the destroyed windows in the order of the
+     *         before snapshot.
+     */
+    [[nodiscard]] const std::vector<Entry>& entries() const noexcept
+    { return _M_entries; }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    { return _M_entries.size(); }
+
+    [[nodiscard]] bool empty() const noexcept
+    { return _M_entries.empty(); }
+
+    [[nodiscard]] std::vector<Entry>::const_iterator begin() const noexcept
+    { return _M_entries.begin(); }
+
+    [[nodiscard]] std::vector<Entry>::const_iterator end() const noexcept
+    { return _M_entries.end(); }
+
+    /**
+     * @return The number of windows with any of the changes.
+     */
+    [[nodiscard]] std::size_t count(Changes __changes) const noexcept;
+
+    /**
+     * @return The windows with any of the changes.
+     */
+    [[nodiscard]] WinList wins(Changes __changes) const;
+
+private:
+
+    std::vector<Entry> _M_entries;
+};
+
+}  // namespace win
+
+#endif  // OPENWIN_HEADER_WINDOWDIFF_H
\ No newline at end of file
@@ -0,0 +1,166 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WindowGrid.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 17, 2026, 02:14:37
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief A uniform grid over the rects of a window snapshot, which finds the window at a
+*        point or the windows over a rect in z-order, without calling Win32.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_WINDOWGRID_H
+#define OPENWIN_HEADER_WINDOWGRID_H
+
+#include <vector>
+#include <span>
+
+#include <cstdint>
+
+#include "Geometry.h"
+#include "WindowSnapshot.h"
+
+namespace win
+{
+
+/**
+ * @brief Each cell lists the windows over it from the top, so that a point
+ *        is resolved by the first window of its cell that contains it. The
+ *        windows over most of the cells are listed once for all cells.
+ * 
+ *        Only the windows with a nonempty rect are indexed, and only the
+ *        visible ones if the snapshot has WindowSnapshot::Visible. Minimized
+ *        windows, parked at (-32000, -32000) by Windows, are left out.
+ * 
+ * @code
+ * WindowSnapshot snapshot = WindowSnapshot::capture(WindowSnapshot::Rect | WindowSnapshot::Visible);
+ * WindowGrid grid(snapshot);
+ * 
+ * std::size_t index = grid.findByPoint(Point(100, 100));
+ * 
+ * if (index != grid.size())
+ * {
+ *     std::cout << snapshot[index].win() << '\n';
+ * }
+ * @endcode
+ */
+class WindowGrid
+{
+public:
+
+    /// The most cells per side.
+    static constexpr std::uint32_t maxCells = 256;
+
+    WindowGrid() = default;
+
+    explicit WindowGrid(const WindowSnapshot& __snapshot);
+
+    /**
+     * @return The number of windows in the snapshot, returned by the finds
+     *         when no window is found.
+     */
+    [[nodiscard]] std::size_t size() const noexcept
+    { return _M_size; }
+
+    /**
+     * @return The number of windows indexed.
+     */
+    [[nodiscard]] std::size_t indexed() const noexcept
+    { return _M_indexed; }
+
+    /**
+     * @return The union of the rects indexed.
+     */
+    [[nodiscard]] const Rect& bounds() const noexcept
+    { return _M_bounds; }
+
+    [[nodiscard]] std::uint32_t columns() const noexcept
+    { return _M_columns; }
+
+    [[nodiscard]] std::uint32_t rows() const noexcept
+    { return _M_rows; }
+
+    /**
+     * @return The index in the snapshot of the topmost window containing the
+     *         point, or size() if none.
+     */
+    [[nodiscard]] std::size_t findByPoint(const Point& __point) const noexcept;
+
+    /**
+     * @brief Finds the window of each point.
+     * 
+     * @param __indexes At least as many as the points.
+     */
+    void findByPoint(std::span<const Point> __points, std::span<std::size_t> __indexes) const noexcept;
+
+    [[nodiscard]] std::vector<std::size_t> findByPoint(std::span<const Point> __points) const;
+
+    /**
+     * @return The indexes in the snapshot of the windows intersecting the
+     *         rect, in z-order from the top.
+     */
+    [[nodiscard]] std::vector<std::size_t> findByRect(const Rect& __rect) const;
+
+private:
+
+    struct _Box
+    {
+        int left;
+        int top;
+        int right;
+        int bottom;
+
+        [[nodiscard]] bool contains(int __x, int __y) const noexcept
+        { return __x >= left && __x < right && __y >= top && __y < bottom; }
+
+        [[nodiscard]] bool intersects(const _Box& __other) const noexcept
+        {
+            return left < __other.right && __other.left < right
+                && top < __other.bottom && __other.top < bottom;
+        }
+    };
+
+    /**
+     * @brief The cells covered, clamped to the grid.
+     */
+    void _M_cellRange(
+        const _Box& __box,
+        std::uint32_t& __firstColumn,
+        std::uint32_t& __firstRow,
+        std::uint32_t& __lastColumn,
+        std::uint32_t& __lastRow) const noexcept;
+
+    std::size_t _M_size = 0;
+    std::size_t _M_indexed = 0;
+
+    Rect _M_bounds;
+
+    std::uint32_t _M_columns = 0;
+    std::uint32_t _M_rows = 0;
+
+    int _M_cellWidth = 1;
+    int _M_cellHeight = 1;
+
+    /// The boxes of the snapshot, by index.
+    std::vector<_Box> _M_boxes;
+
+    /// The indexes of each cell, from _M_starts[cell] to _M_starts[cell + 1],
+    /// ascending, which is z-order from the top.
+    std::vector<std::uint32_t> _M_starts;
+    std::vector<std::uint32_t> _M_items;
+
+    /// The windows over most of the cells, ascending.
+    std::vector<std::uint32_t> _M_large;
+};
+
+}  // namespace win
+
+#endif  // OPENWIN_HEADER_WINDOWGRID_H
\ No newline at end of file
@@ -0,0 +1,191 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WindowMatcher.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 17, 2026, 02:51:19
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Matches the titles and class names of all top-level windows against many patterns
+*        at once, exact, case-insensitive, substring or regex, in one enumeration.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_WINDOWMATCHER_H
+#define OPENWIN_HEADER_WINDOWMATCHER_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <regex>
+#include <unordered_map>
+#include <functional>
+
+#include <cstdint>
+
+#include "Win.h"
+#include "Wins.h"
+#include "WindowSnapshot.h"
+
+namespace win
+{
+
+/**
+ * @brief The patterns are compiled once, the exact ones into hash tables,
+ *        the substrings into an Aho-Corasick automaton per field, so that a
+ *        text is matched against all of them in one pass over its bytes.
+ * 
+ * @code
+ * WindowMatcher matcher({
+ *     { "Notepad", WindowMatcher::Exact, WindowSnapshot::ClassName },
+ *     { "visual studio code", WindowMatcher::Substring },
+ *     { R"(^\d+ unread)", WindowMatcher::Regex } });
+ * 
+ * std::vector<WinList> found = matcher.find();
+ * @endcode
+ */
+class WindowMatcher
+{
+public:
+
+    enum Kind : std::uint8_t
+    {
+        Exact,
+
+        /// Exact but for the case of ASCII letters.
+        CaseInsensitive,
+
+        /// Anywhere in the text, case-sensitive.
+        Substring,
+
+        /// std::regex_search() with ECMAScript.
+        Regex
+    };
+
+    struct Pattern
+    {
+        std::string text;
+
+        Kind kind = Exact;
+
+        /// WindowSnapshot::Title or WindowSnapshot::ClassName.
+        WindowSnapshot::Field field = WindowSnapshot::Title;
+    };
+
+    using PatternId = std::uint32_t;
+
+    WindowMatcher() = default;
+
+    /**
+     * @throw std::regex_error if a regex is invalid.
+     */
+    explicit WindowMatcher(std::vector<Pattern> __patterns);
+
+    [[nodiscard]] std::size_t size() const noexcept
+    { return _M_patterns.size(); }
+
+    [[nodiscard]] const Pattern& pattern(PatternId __id) const noexcept
+    { return _M_patterns[__id]; }
+
+    /**
+     * @return The fields of the snapshot the patterns need.
+     */
+    [[nodiscard]] WindowSnapshot::Fields fields() const noexcept
+    { return _M_fields; }
+
+    /**
+     * @brief Appends the patterns of the field that match the text, in
+     *        ascending order.
+     */
+    void match(std::string_view __text, WindowSnapshot::Field __field, std::vector<PatternId>& __ids) const;
+
+    /**
+     * @return The indexes of the windows matched, by pattern.
+     */
+    [[nodiscard]] std::vector<std::vector<std::size_t>> match(const WindowSnapshot& __snapshot) const;
+
+    /**
+     * @brief Captures the fields needed in one enumeration and matches all
+     *        windows.
+     * 
+     * @return The windows matched, by pattern.
+     */
+    [[nodiscard]] std::vector<WinList> find() const;
+
+    [[nodiscard]] std::vector<WinList> find(WindowSnapshot::Source& __source) const;
+
+private:
+
+    struct _Hash
+    {
+        using is_transparent = void;
+
+        [[nodiscard]] std::size_t operator()(std::string_view __text) const noexcept
+        { return std::hash<std::string_view>()(__text); }
+    };
+
+    using _Table = std::unordered_map<std::string, std::vector<PatternId>, _Hash, std::equal_to<>>;
+
+    /**
+     * @brief A deterministic automaton over the bytes used by the patterns,
+     *        the others share one class.
+     */
+    struct _Automaton
+    {
+        std::uint16_t classes[256] = {};
+        std::uint32_t classCount = 1;
+
+        /// By state * classCount + class, state 0 is the root.
+        std::vector<std::uint32_t> next;
+
+        /// The patterns ending at each state, from outputStarts[state] to
+        /// outputStarts[state + 1].
+        std::vector<std::uint32_t> outputStarts;
+        std::vector<PatternId> outputs;
+
+        [[nodiscard]] bool empty() const noexcept
+        { return next.empty(); }
+
+        void build(const std::vector<std::pair<std::string_view, PatternId>>& __patterns);
+
+        void match(std::string_view __text, std::vector<PatternId>& __ids) const;
+    };
+
+    struct _FieldPatterns
+    {
+        _Table exact;
+        _Table folded;
+
+        _Automaton substrings;
+
+        /// The empty substrings, matching every text.
+        std::vector<PatternId> everywhere;
+
+        std::vector<std::pair<PatternId, std::regex>> regexes;
+    };
+
+    [[nodiscard]] _FieldPatterns& _M_of(WindowSnapshot::Field __field) noexcept
+    { return __field == WindowSnapshot::ClassName ? _M_classNames : _M_titles; }
+
+    [[nodiscard]] const _FieldPatterns& _M_of(WindowSnapshot::Field __field) const noexcept
+    { return __field == WindowSnapshot::ClassName ? _M_classNames : _M_titles; }
+
+    [[nodiscard]] std::vector<WinList> _M_wins(const WindowSnapshot& __snapshot) const;
+
+    std::vector<Pattern> _M_patterns;
+
+    WindowSnapshot::Fields _M_fields = 0;
+
+    _FieldPatterns _M_titles;
+    _FieldPatterns _M_classNames;
+};
+
+}  // namespace win
+
+#endif  // OPENWIN_HEADER_WINDOWMATCHER_H
\ No newline at end of file
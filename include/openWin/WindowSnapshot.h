@@ -0,0 +1,406 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WindowSnapshot.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 16:31:05
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Collects the requested fields of all top-level windows in one enumeration, and stores
+*        them as parallel arrays with the texts packed into one string arena.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_WINDOWSNAPSHOT_H
+#define OPENWIN_HEADER_WINDOWSNAPSHOT_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <span>
+#include <unordered_map>
+
+#include <iostream>
+
+#include <cstdint>
+
+#include "Win.h"
+
+namespace win
+{
+
+class WindowSnapshot
+{
+public:
+
+    enum Field : std::uint32_t
+    {
+        Title     = 1 << 0,
+        ClassName = 1 << 1,
+        Rect      = 1 << 2,
+        ProcessId = 1 << 3,
+        ThreadId  = 1 << 4,
+        Visible   = 1 << 5,
+
+        All = Title | ClassName | Rect | ProcessId | ThreadId | Visible
+    };
+
+    using Fields = std::uint32_t;
+
+    /**
+     * @brief Where the windows and their fields come from, Source::system()
+     *        asks Win32, other sources can replay a recorded desktop.
+     * 
+     *        Only the functions of the requested fields are called, once per
+     *        window.
+     */
+    class Source
+    {
+    public:
+
+        virtual ~Source() = default;
+
+        /**
+         * @brief Appends the top-level windows, in z-order from the top.
+         */
+        virtual void enumerate(std::vector<Win::Handle>& __handles) = 0;
+
+        virtual void appendTitle(Win::Handle __handle, std::string& __arena) = 0;
+        virtual void appendClassName(Win::Handle __handle, std::string& __arena) = 0;
+
+        [[nodiscard]] virtual win::Rect rect(Win::Handle __handle) = 0;
+
+        /**
+         * @brief Fetches the process and thread IDs together.
+         */
+        virtual void ids(Win::Handle __handle, Win::ProcessId& __processId, Win::ThreadId& __threadId) = 0;
+
+        [[nodiscard]] virtual bool isVisible(Win::Handle __handle) = 0;
+
+        /**
+         * @return The source that asks Win32.
+         */
+        [[nodiscard]] static Source& system() noexcept;
+    };
+
+    class ReplaySource;
+
+    /**
+     * @brief The fields of one window, used to build a snapshot window by
+     *        window.
+     */
+    struct Record
+    {
+        Win::Handle handle = nullptr;
+
+        std::string title;
+        std::string className;
+
+        win::Rect rect;
+
+        Win::ProcessId processId = 0;
+        Win::ThreadId threadId = 0;
+
+        bool visible = false;
+    };
+
+    /**
+     * @brief A view of one window in the snapshot.
+     */
+    class Entry
+    {
+    public:
+
+        Entry(const WindowSnapshot& __snapshot, std::size_t __index) noexcept
+            : _M_snapshot(&__snapshot), _M_index(__index)
+        { }
+
+        [[nodiscard]] std::size_t index() const noexcept
+        { return _M_index; }
+
+        [[nodiscard]] Win::Handle handle() const noexcept
+        { return _M_snapshot->handle(_M_index); }
+
+        [[nodiscard]] Win win() const noexcept
+        { return Win(handle()); }
+
+        [[nodiscard]] std::string_view title() const noexcept
+        { return _M_snapshot->title(_M_index); }
+
+        [[nodiscard]] std::string_view className() const noexcept
+        { return _M_snapshot->className(_M_index); }
+
+        [[nodiscard]] win::Rect rect() const noexcept
+        { return _M_snapshot->rect(_M_index); }
+
+        [[nodiscard]] Win::ProcessId processId() const noexcept
+        { return _M_snapshot->processId(_M_index); }
+
+        [[nodiscard]] Win::ThreadId threadId() const noexcept
+        { return _M_snapshot->threadId(_M_index); }
+
+        [[nodiscard]] bool isVisible() const noexcept
+        { return _M_snapshot->isVisible(_M_index); }
+
+    private:
+
+        const WindowSnapshot* _M_snapshot;
+        std::size_t _M_index;
+    };
+
+    class const_iterator
+    {
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Entry;
+
+        const_iterator() = default;
+
+        const_iterator(const WindowSnapshot* __snapshot, std::size_t __index) noexcept
+            : _M_snapshot(__snapshot), _M_index(__index)
+        { }
+
+        [[nodiscard]] Entry operator*() const noexcept
+        { return Entry(*_M_snapshot, _M_index); }
+
+        const_iterator& operator++() noexcept
+        {
+            ++_M_index;
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept
+        {
+            const_iterator result = *this;
+            ++_M_index;
+            return result;
+        }
+
+        [[nodiscard]] bool operator==(const const_iterator& __other) const noexcept
+        { return _M_index == __other._M_index; }
+
+        [[nodiscard]] bool operator!=(const const_iterator& __other) const noexcept
+        { return _M_index != __other._M_index; }
+
+    private:
+
+        const WindowSnapshot* _M_snapshot = nullptr;
+        std::size_t _M_index = 0;
+    };
+
+    WindowSnapshot() = default;
+
+    /**
+     * @brief An empty snapshot to be filled by append().
+     */
+    explicit WindowSnapshot(Fields __fields) noexcept
+        : _M_fields(__fields & All)
+    { }
+
+    /**
+     * @brief Enumerates the top-level windows with Win32 and fetches the
+     *        fields of each window, with one error stream guard for the whole
+     *        capture instead of one per call.
+     */
+    [[nodiscard]] static WindowSnapshot capture(Fields __fields = All) noexcept;
+
+    [[nodiscard]] static WindowSnapshot capture(Source& __source, Fields __fields = All);
+
+    /**
+     * @return The requested fields of one window.
+     */
+    [[nodiscard]] static Record fetch(Source& __source, Win::Handle __handle, Fields __fields = All);
+
+    /**
+     * @brief Appends a window, only the fields of the snapshot are kept.
+     */
+    void append(const Record& __record);
+
+    [[nodiscard]] std::size_t size() const noexcept
+    { return _M_handles.size(); }
+
+    [[nodiscard]] bool empty() const noexcept
+    { return _M_handles.empty(); }
+
+    /**
+     * @return The fields collected, the others read as empty or 0.
+     */
+    [[nodiscard]] Fields fields() const noexcept
+    { return _M_fields; }
+
+    [[nodiscard]] bool has(Fields __fields) const noexcept
+    { return (_M_fields & __fields) == __fields; }
+
+    [[nodiscard]] Win::Handle handle(std::size_t __index) const noexcept
+    { return _M_handles[__index]; }
+
+    [[nodiscard]] std::string_view title(std::size_t __index) const noexcept
+    { return _M_text(_M_titles, __index); }
+
+    [[nodiscard]] std::string_view className(std::size_t __index) const noexcept
+    { return _M_text(_M_classNames, __index); }
+
+    [[nodiscard]] win::Rect rect(std::size_t __index) const noexcept
+    { return _M_rects.empty() ? win::Rect() : _M_rects[__index]; }
+
+    [[nodiscard]] Win::ProcessId processId(std::size_t __index) const noexcept
+    { return _M_processIds.empty() ? 0 : _M_processIds[__index]; }
+
+    [[nodiscard]] Win::ThreadId threadId(std::size_t __index) const noexcept
+    { return _M_threadIds.empty() ? 0 : _M_threadIds[__index]; }
+
+    [[nodiscard]] bool isVisible(std::size_t __index) const noexcept
+    { return _M_visible.empty() ? false : _M_visible[__index]; }
+
+    [[nodiscard]] Entry operator[](std::size_t __index) const noexcept
+    { return Entry(*this, __index); }
+
+    /**
+     * @return The index of the window, or size() if it is not in the snapshot.
+     */
+    [[nodiscard]] std::size_t indexOf(Win::Handle __handle) const noexcept;
+
+    /*
+     * The columns, empty if the field is not collected.
+     */
+
+    [[nodiscard]] std::span<const Win::Handle> handles() const noexcept
+    { return _M_handles; }
+
+    [[nodiscard]] std::span<const win::Rect> rects() const noexcept
+    { return _M_rects; }
+
+    [[nodiscard]] std::span<const Win::ProcessId> processIds() const noexcept
+    { return _M_processIds; }
+
+    [[nodiscard]] std::span<const Win::ThreadId> threadIds() const noexcept
+    { return _M_threadIds; }
+
+    /**
+     * @return The arena holding all the titles and class names.
+     */
+    [[nodiscard]] std::string_view arena() const noexcept
+    { return _M_arena; }
+
+    [[nodiscard]] const_iterator begin() const noexcept
+    { return const_iterator(this, 0); }
+
+    [[nodiscard]] const_iterator end() const noexcept
+    { return const_iterator(this, size()); }
+
+    /**
+     * @return The indexes of the windows that satisfy the predicate, called
+     *         with an Entry.
+     */
+    template<typename _Pred>
+    [[nodiscard]] std::vector<std::size_t> select(_Pred __pred) const
+    {
+        std::vector<std::size_t> result;
+
+        for (std::size_t i = 0; i < size(); ++i)
+        {
+            if (__pred(Entry(*this, i)))
+            {
+                result.push_back(i);
+            }
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] WinList wins() const;
+    [[nodiscard]] WinList wins(std::span<const std::size_t> __indexes) const;
+
+    /**
+     * @brief Writes the snapshot in a line based text format, which can be
+     *        read back by read() and replayed by ReplaySource.
+     */
+    void write(std::ostream& __os) const;
+
+    /**
+     * @return The snapshot read, or an empty snapshot if the input is not in
+     *         the format written by write().
+     */
+    [[nodiscard]] static WindowSnapshot read(std::istream& __is);
+
+private:
+
+    struct textspan
+    {
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    [[nodiscard]] std::string_view _M_text(const std::vector<textspan>& __spans, std::size_t __index) const noexcept
+    {
+        return __spans.empty()
+            ? std::string_view()
+            : std::string_view(_M_arena).substr(__spans[__index].offset, __spans[__index].length);
+    }
+
+    void _M_appendText(std::vector<textspan>& __spans, std::string_view __text);
+
+    Fields _M_fields = 0;
+
+    std::vector<Win::Handle> _M_handles;
+
+    std::string _M_arena;
+    std::vector<textspan> _M_titles;
+    std::vector<textspan> _M_classNames;
+
+    std::vector<win::Rect> _M_rects;
+    std::vector<Win::ProcessId> _M_processIds;
+    std::vector<Win::ThreadId> _M_threadIds;
+    std::vector<std::uint8_t> _M_visible;
+
+    friend class ReplaySource;
+};
+
+/**
+ * @brief Replays a recorded snapshot as a source, so that captures can be
+ *        tested and benchmarked without a desktop.
+ */
+class WindowSnapshot::ReplaySource : public WindowSnapshot::Source
+{
+public:
+
+    explicit ReplaySource(WindowSnapshot __snapshot);
+
+    virtual void enumerate(std::vector<Win::Handle>& __handles) override;
+
+    virtual void appendTitle(Win::Handle __handle, std::string& __arena) override;
+    virtual void appendClassName(Win::Handle __handle, std::string& __arena) override;
+
+    [[nodiscard]] virtual win::Rect rect(Win::Handle __handle) override;
+
+    virtual void ids(Win::Handle __handle, Win::ProcessId& __processId, Win::ThreadId& __threadId) override;
+
+    [[nodiscard]] virtual bool isVisible(Win::Handle __handle) override;
+
+    [[nodiscard]] const WindowSnapshot& snapshot() const noexcept
+    { return _M_snapshot; }
+
+    /**
+     * @brief Replaces the recorded snapshot.
+     */
+    void setSnapshot(WindowSnapshot __snapshot);
+
+private:
+
+    WindowSnapshot _M_snapshot;
+    std::unordered_map<Win::Handle, std::size_t> _M_indexes;
+};
+
+}  // namespace win
+
+#endif  // OPENWIN_HEADER_WINDOWSNAPSHOT_H
\ No newline at end of file
@@ -0,0 +1,219 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WindowTrigramIndex.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 17, 2026, 03:27:52
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief An index of the trigrams of the titles, class names and process paths of windows,
+*        updated in place from window diffs, for fuzzy lookups on every keystroke.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_WINDOWTRIGRAMINDEX_H
+#define OPENWIN_HEADER_WINDOWTRIGRAMINDEX_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <unordered_map>
+
+#include <cstdint>
+
+#include "Win.h"
+#include "WindowSnapshot.h"
+#include "WindowDiff.h"
+
+namespace win
+{
+
+/**
+ * @brief Each window is a document of three texts, folded to lower case for
+ *        ASCII. A query gathers the windows sharing any of its trigrams from
+ *        the posting lists, and ranks them by a scorer; queries shorter than a
+ *        trigram gather the windows with a word starting with them.
+ * 
+ * @code
+ * WindowSnapshot before = WindowSnapshot::capture(WindowSnapshot::Title | WindowSnapshot::ClassName);
+ * 
+ * WindowTrigramIndex index;
+ * index.assign(before);
+ * 
+ * for (const WindowTrigramIndex::Result& result : index.search("vs cod"))
+ * {
+ *     std::cout << Win(result.handle) << '\n';
+ * }
+ * 
+ * WindowSnapshot after = WindowSnapshot::capture(WindowSnapshot::Title | WindowSnapshot::ClassName);
+ * index.apply(WindowDiff::between(before, after), after);
+ * @endcode
+ */
+class WindowTrigramIndex
+{
+public:
+
+    /**
+     * @brief A window gathered by a query, with its texts folded.
+     */
+    struct Candidate
+    {
+        Win::Handle handle;
+
+        std::string_view title;
+        std::string_view className;
+        std::string_view path;
+
+        /// The folded query.
+        std::string_view query;
+
+        /// The distinct trigrams of the query found in the window, and their
+        /// number in the query.
+        std::uint32_t hits;
+        std::uint32_t trigrams;
+
+        /// Whether the words of the query may match with typos, search() only
+        /// allows it for the windows with the most hits.
+        bool typos = true;
+    };
+
+    /**
+     * @return A score, the windows scored 0 or below are left out.
+     */
+    using Scorer = std::function<double(const Candidate&)>;
+
+    /**
+     * @brief The process path of a window, which the snapshot does not hold.
+     */
+    using PathProvider = std::function<std::string(const WindowSnapshot::Entry&)>;
+
+    struct Result
+    {
+        Win::Handle handle;
+        double score;
+    };
+
+    WindowTrigramIndex() = default;
+
+    /**
+     * @brief Ranks a prefix above a substring above a subsequence above the
+     *        words with typos, the title above the path above the class name,
+     *        and adds the share of the trigrams found. A subsequence ranks by
+     *        the letters at the starts of words, so "vscode" matches "Visual
+     *        Studio Code".
+     */
+    [[nodiscard]] static double defaultScore(const Candidate& __candidate) noexcept;
+
+    /**
+     * @param __scorer nullptr for defaultScore().
+     */
+    void setScorer(Scorer __scorer) noexcept
+    { _M_scorer = std::move(__scorer); }
+
+    /**
+     * @brief Called for the windows added by assign() and apply(), the path
+     *        is empty without one.
+     */
+    void setPathProvider(PathProvider __provider) noexcept
+    { _M_pathProvider = std::move(__provider); }
+
+    /**
+     * @brief Indexes the windows of the snapshot instead of the current ones.
+     */
+    void assign(const WindowSnapshot& __snapshot);
+
+    /**
+     * @brief Adds the windows created, removes the ones destroyed and updates
+     *        the titles retitled.
+     * 
+     * @param __after The snapshot the diff ends at.
+     */
+    void apply(const WindowDiff& __diff, const WindowSnapshot& __after);
+
+    /**
+     * @brief Adds a window or replaces its texts.
+     */
+    void insert(Win::Handle __handle, std::string_view __title, std::string_view __className, std::string_view __path = {});
+
+    void setTitle(Win::Handle __handle, std::string_view __title);
+
+    void erase(Win::Handle __handle);
+
+    void clear() noexcept;
+
+    [[nodiscard]] std::size_t size() const noexcept
+    { return _M_slots.size(); }
+
+    [[nodiscard]] bool contains(Win::Handle __handle) const noexcept
+    { return _M_slots.contains(__handle); }
+
+    /**
+     * @return The windows scored above 0, the best first, at most __limit.
+     * 
+     * @note With defaultScore(), the windows are scored by their hits, the
+     *       most first, and the search stops once __limit of them score above
+     *       what the windows with fewer hits can score.
+     */
+    [[nodiscard]] std::vector<Result> search(std::string_view __query, std::size_t __limit = 10) const;
+
+private:
+
+    struct _Document
+    {
+        Win::Handle handle = nullptr;
+
+        std::string title;
+        std::string className;
+        std::string path;
+
+        /// The trigrams and the word prefixes, sorted, to be removed from the
+        /// postings.
+        std::vector<std::uint32_t> trigrams;
+
+        /// Where the document is in the posting of each trigram.
+        std::vector<std::uint32_t> positions;
+
+        [[nodiscard]] bool empty() const noexcept
+        { return handle == nullptr; }
+    };
+
+    [[nodiscard]] static std::string _S_fold(std::string_view __text);
+
+    static void _S_trigrams(std::string_view __folded, std::vector<std::uint32_t>& __trigrams);
+
+    /**
+     * @return The key of the first one or two bytes of a word, above the 24
+     *         bits of the trigrams.
+     */
+    [[nodiscard]] static std::uint32_t _S_prefixKey(std::string_view __prefix) noexcept;
+
+    static void _S_prefixes(std::string_view __folded, std::vector<std::uint32_t>& __keys);
+
+    void _M_index(std::uint32_t __slot);
+    void _M_unindex(std::uint32_t __slot);
+
+    std::vector<_Document> _M_documents;
+
+    /// The documents erased, reused first.
+    std::vector<std::uint32_t> _M_free;
+
+    std::unordered_map<Win::Handle, std::uint32_t> _M_slots;
+
+    /// The documents of each trigram and word prefix, unordered, removed by
+    /// swapping with the last one.
+    std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> _M_postings;
+
+    Scorer _M_scorer;
+    PathProvider _M_pathProvider;
+};
+
+}  // namespace win
+
+#endif  // OPENWIN_HEADER_WINDOWTRIGRAMINDEX_H
\ No newline at end of file
@@ -25,6 +25,7 @@ namespace win
 {
 
 class Win;
+class WinBatch;
 
 template<typename _Base>
 class Wins : public _Base
@@ -36,6 +37,12 @@ public:
         "_Base::value_type must be derived from Win.");
     
     using _Base::_Base;
+
+    /**
+     * @return An empty batch to queue the changes of the windows in, defined
+     *         in WinBatch.h.
+     */
+    [[nodiscard]] WinBatch beginBatch() const;
 };
 
 using WinList = Wins<std::vector<Win>>;
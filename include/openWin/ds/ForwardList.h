@@ -22,6 +22,7 @@
 #include <utility>
 #include <iterator>
 #include <optional>
+#include <memory>
 
 namespace win::ds
 {
@@ -32,12 +33,13 @@ enum class ForwardListTag
     FastAppend
 };
 
-template<typename _Tp, ForwardListTag = ForwardListTag::Base>
+template<typename _Tp, ForwardListTag = ForwardListTag::Base, typename _Alloc = std::allocator<_Tp>>
 class ForwardList
 {
 public:
 
     using value_type = _Tp;
+    using allocator_type = _Alloc;
 
     using pointer = _Tp*;
     using const_pointer = const _Tp*;
@@ -51,6 +53,15 @@ public:
         mutable node* next;
     };
 
+protected:
+
+    using node_allocator_type =
+        typename std::allocator_traits<_Alloc>::template rebind_alloc<node>;
+
+    using node_allocator_traits = std::allocator_traits<node_allocator_type>;
+
+public:
+
     class iterator
     {
     public:
@@ -125,12 +136,17 @@ public:
 
     ForwardList() = default;
 
+    explicit ForwardList(const allocator_type& __alloc) noexcept
+        : _M_alloc(__alloc)
+    { }
+
     ForwardList(const ForwardList& __other)
         : ForwardList(__other.clone())
     { }
 
     ForwardList(ForwardList&& __other) noexcept
-        : _M_root(__other._M_root)
+        : _M_alloc(std::move(__other._M_alloc))
+        , _M_root(__other._M_root)
     { __other._M_root = nullptr; }
 
     ~ForwardList()
@@ -145,6 +161,7 @@ public:
     {
         clear();
 
+        _M_alloc = std::move(__other._M_alloc);
         _M_root = std::exchange(__other._M_root, nullptr);
 
         return *this;
@@ -172,21 +189,24 @@ public:
     [[nodiscard]] bool empty() const noexcept
     { return _M_root == nullptr; }
 
+    [[nodiscard]] allocator_type get_allocator() const noexcept
+    { return allocator_type(_M_alloc); }
+
 
     [[nodiscard]] ForwardList clone() const
     {
-        ForwardList result;
+        ForwardList result(get_allocator());
 
         if (empty())
         {
             return result;
         }
 
-        result._M_root = new node{ _M_root->element, nullptr };
+        result._M_root = result._M_createNode(nullptr, _M_root->element);
 
         for (node* cp = result._M_root,* self_cp = _M_root->next; self_cp; self_cp = self_cp->next)
         {
-            cp = cp->next = new node{ self_cp->element, nullptr };
+            cp = cp->next = result._M_createNode(nullptr, self_cp->element);
         }
 
         return result;
@@ -216,7 +236,7 @@ public:
      */
     void insert(const value_type& __value)
     {
-        _M_root = new node{ __value, _M_root };
+        _M_root = _M_createNode(_M_root, __value);
     }
 
     /**
@@ -224,7 +244,7 @@ public:
      */
     void insert(value_type&& __value)
     {
-        _M_root = new node{ std::move(__value), _M_root };
+        _M_root = _M_createNode(_M_root, std::move(__value));
     }
 
     /**
@@ -233,7 +253,7 @@ public:
     template<typename... _Args>
     void emplace(_Args&& ...__args)
     {
-        _M_root = new node{ value_type(std::forward<_Args>(__args)...), _M_root };
+        _M_root = _M_createNode(_M_root, std::forward<_Args>(__args)...);
     }
 
     /**
@@ -241,7 +261,7 @@ public:
      */
     void insertAfter(const_iterator __iter, const value_type& __value)
     {
-        __iter.current()->next = new node{ __value, __iter.current()->next };
+        __iter.current()->next = _M_createNode(__iter.current()->next, __value);
     }
 
     /**
@@ -249,13 +269,13 @@ public:
      */
     void insertAfter(const_iterator __iter, value_type&& __value)
     {
-        __iter.current()->next = new node{ std::move(__value), __iter.current()->next };
+        __iter.current()->next = _M_createNode(__iter.current()->next, std::move(__value));
     }
 
     template<typename... _Args>
     void emplaceAfter(const_iterator __iter, _Args&& ...__args)
     {
-        __iter.current()->next = new node{ value_type(std::forward<_Args>(__args)...), __iter.current()->next };
+        __iter.current()->next = _M_createNode(__iter.current()->next, std::forward<_Args>(__args)...);
     }
 
 
@@ -264,7 +284,7 @@ public:
      */
     void remove()
     {
-        delete std::exchange(_M_root, _M_root->next);
+        _M_destroyNode(std::exchange(_M_root, _M_root->next));
     }
 
     /**
@@ -291,11 +311,15 @@ public:
             return;
         }
 
-        for (node* cp = _M_root; cp->next; cp = cp->next)
+        for (node* cp = _M_root; cp->next; )
         {
-            while (cp->next && __pred(cp->next->element))
+            if (__pred(cp->next->element))
+            {
+                remove(const_iterator(cp));
+            }
+            else
             {
-                remove(cp);
+                cp = cp->next;
             }
         }
     }
@@ -305,7 +329,7 @@ public:
      */
     void remove(const_iterator __prevIter)
     {
-        delete std::exchange(__prevIter.current()->next, __prevIter.current()->next->next);
+        _M_destroyNode(std::exchange(__prevIter.current()->next, __prevIter.current()->next->next));
     }
 
     /**
@@ -407,17 +431,45 @@ public:
 
 protected:
 
+    template<typename... _Args>
+    [[nodiscard]] node* _M_createNode(node* __next, _Args&& ...__args)
+    {
+        node* result = node_allocator_traits::allocate(_M_alloc, 1);
+
+        try
+        {
+            ::new (static_cast<void*>(result)) node{ value_type(std::forward<_Args>(__args)...), __next };
+        }
+        catch (...)
+        {
+            node_allocator_traits::deallocate(_M_alloc, result, 1);
+            throw;
+        }
+
+        return result;
+    }
+
+    void _M_destroyNode(node* __node) noexcept
+    {
+        node_allocator_traits::destroy(_M_alloc, __node);
+        node_allocator_traits::deallocate(_M_alloc, __node, 1);
+    }
+
+    [[no_unique_address]] node_allocator_type _M_alloc;
+
     node* _M_root = nullptr;
 };
 
-template<typename _Tp>
-class ForwardList<_Tp, ForwardListTag::FastAppend> : public ForwardList<_Tp, ForwardListTag::Base>
+template<typename _Tp, typename _Alloc>
+class ForwardList<_Tp, ForwardListTag::FastAppend, _Alloc>
+    : public ForwardList<_Tp, ForwardListTag::Base, _Alloc>
 {
-    using Base = ForwardList<_Tp, ForwardListTag::Base>;
+    using Base = ForwardList<_Tp, ForwardListTag::Base, _Alloc>;
 
 public:
 
     using typename Base::value_type;
+    using typename Base::allocator_type;
     using typename Base::node;
 
     using typename Base::pointer;
@@ -431,13 +483,17 @@ public:
 
     ForwardList() = default;
 
+    explicit ForwardList(const allocator_type& __alloc) noexcept
+        : Base(__alloc)
+    { }
+
     ForwardList(const ForwardList& __other)
         : ForwardList(__other.clone())
     { }
 
     ForwardList(ForwardList&& __other) noexcept
-        : Base(__other), _M_last(__other._M_last)
-    { _M_last = nullptr; }
+        : Base(std::move(__other)), _M_last(std::exchange(__other._M_last, nullptr))
+    { }
 
 
     ForwardList& operator=(const ForwardList& __other)
@@ -462,7 +518,7 @@ public:
 
     [[nodiscard]] ForwardList clone() const
     {
-        ForwardList result;
+        ForwardList result(this->get_allocator());
 
         for (auto it = this->cbegin(); it != this->cend(); ++it)
         {
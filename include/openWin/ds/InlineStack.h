@@ -0,0 +1,188 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* InlineStack.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 10:05:12
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief A stack that keeps its first elements in an inline array and only spills the rest to
+*        the heap.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_DS_INLINESTACK_H
+#define OPENWIN_HEADER_DS_INLINESTACK_H
+
+#include <vector>
+#include <iterator>
+
+#include <cstddef>
+
+namespace win::ds
+{
+
+template<typename _Tp, std::size_t _Capacity>
+class InlineStack
+{
+public:
+
+    static_assert(_Capacity > 0, "_Capacity must be greater than 0.");
+
+    using value_type = _Tp;
+
+    using pointer = _Tp*;
+    using const_pointer = const _Tp*;
+
+    using reference = _Tp&;
+    using const_reference = const _Tp&;
+
+    class const_iterator
+    {
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = _Tp;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const _Tp*;
+        using reference = const _Tp&;
+
+        const_iterator() = default;
+
+        const_iterator(const InlineStack* __parent, std::size_t __index) noexcept
+            : _M_parent(__parent), _M_index(__index)
+        { }
+
+        reference operator*() const noexcept
+        { return (*_M_parent)[_M_index]; }
+
+        pointer operator->() const noexcept
+        { return &(*_M_parent)[_M_index]; }
+
+        [[nodiscard]] bool operator==(const const_iterator& __other) const noexcept
+        { return _M_index == __other._M_index; }
+
+        [[nodiscard]] bool operator!=(const const_iterator& __other) const noexcept
+        { return _M_index != __other._M_index; }
+
+        const_iterator& operator++() noexcept
+        {
+            ++_M_index;
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept
+        {
+            return const_iterator(_M_parent, _M_index++);
+        }
+
+    private:
+
+        const InlineStack* _M_parent = nullptr;
+        std::size_t _M_index = 0;
+    };
+
+    using iterator = const_iterator;
+
+    InlineStack() = default;
+
+    [[nodiscard]] bool empty() const noexcept
+    { return _M_size == 0; }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    { return _M_size; }
+
+    /**
+     * @return The number of elements that can be stored without touching the
+     *         heap.
+     */
+    [[nodiscard]] static constexpr std::size_t inlineCapacity() noexcept
+    { return _Capacity; }
+
+    /**
+     * @return true if some elements are stored on the heap.
+     */
+    [[nodiscard]] bool spilled() const noexcept
+    { return _M_size > _Capacity; }
+
+    /**
+     * @time O(1), the heap is only touched when size() reaches
+     *       inlineCapacity() for the first time.
+     */
+    void push(const value_type& __value)
+    {
+        if (_M_size < _Capacity)
+        {
+            _M_inline[_M_size] = __value;
+        }
+        else
+        {
+            _M_overflow.push_back(__value);
+        }
+
+        ++_M_size;
+    }
+
+    /**
+     * @brief Removes the top element.
+     * 
+     * @note  The storage of the spilled part is kept for reuse.
+     */
+    void pop() noexcept
+    {
+        if (--_M_size >= _Capacity)
+        {
+            _M_overflow.pop_back();
+        }
+    }
+
+    /**
+     * @brief Removes all elements.
+     */
+    void clear() noexcept
+    {
+        _M_overflow.clear();
+        _M_size = 0;
+    }
+
+    [[nodiscard]] reference top() noexcept
+    { return (*this)[_M_size - 1]; }
+
+    [[nodiscard]] const_reference top() const noexcept
+    { return (*this)[_M_size - 1]; }
+
+    /**
+     * @param __n 0 means the bottom element.
+     */
+    [[nodiscard]] reference operator[](std::size_t __n) noexcept
+    { return __n < _Capacity ? _M_inline[__n] : _M_overflow[__n - _Capacity]; }
+
+    [[nodiscard]] const_reference operator[](std::size_t __n) const noexcept
+    { return __n < _Capacity ? _M_inline[__n] : _M_overflow[__n - _Capacity]; }
+
+    /**
+     * @brief Iterates from the bottom to the top.
+     */
+    [[nodiscard]] const_iterator begin() const noexcept
+    { return const_iterator(this, 0); }
+
+    [[nodiscard]] const_iterator end() const noexcept
+    { return const_iterator(this, _M_size); }
+
+private:
+
+    value_type _M_inline[_Capacity]{};
+    std::vector<value_type> _M_overflow;
+
+    std::size_t _M_size = 0;
+};
+
+}  // namespace win::ds
+
+#endif  // OPENWIN_HEADER_DS_INLINESTACK_H
\ No newline at end of file
@@ -31,12 +31,13 @@
 namespace win::ds
 {
 
-template<typename _Tp>
+template<typename _Tp, typename _Alloc = std::allocator<_Tp>>
 class LinkedList
 {
 public:
 
     using value_type = _Tp;
+    using allocator_type = _Alloc;
 
     using pointer = _Tp*;
     using const_pointer = const _Tp*;
@@ -69,8 +70,39 @@ protected:
         mutable node* next;
     };
 
+    using node_allocator_type =
+        typename std::allocator_traits<_Alloc>::template rebind_alloc<node>;
+
+    using node_allocator_traits = std::allocator_traits<node_allocator_type>;
+
 public:
 
+    /**
+     * @brief Returns an extracted node to the allocator of its list.
+     */
+    class node_deleter
+    {
+    public:
+
+        node_deleter() = default;
+
+        node_deleter(const node_allocator_type& __alloc) noexcept
+            : _M_alloc(__alloc)
+        { }
+
+        void operator()(node* __node) noexcept
+        {
+            node_allocator_traits::destroy(_M_alloc, __node);
+            node_allocator_traits::deallocate(_M_alloc, __node, 1);
+        }
+
+    private:
+
+        [[no_unique_address]] node_allocator_type _M_alloc;
+    };
+
+    using node_handle = std::unique_ptr<node, node_deleter>;
+
     class iterator
     {
     public:
@@ -171,14 +203,18 @@ public:
 
     LinkedList() = default;
 
+    explicit LinkedList(const allocator_type& __alloc) noexcept
+        : _M_alloc(__alloc)
+    { }
+
     LinkedList(const LinkedList& __other)
         : LinkedList(__other.clone())
     { }
 
     LinkedList(LinkedList&& __other) noexcept
+        : _M_alloc(std::move(__other._M_alloc))
     {
-        std::swap(_M_root, __other._M_root);
-        std::swap(_M_last, __other._M_last);
+        _M_steal(__other);
     }
 
     LinkedList(std::initializer_list<value_type> __init)
@@ -192,8 +228,6 @@ public:
     ~LinkedList()
     {
         clear();
-
-        delete _M_last;
     }
 
     LinkedList& operator=(const LinkedList& __other)
@@ -204,9 +238,9 @@ public:
     LinkedList& operator=(LinkedList&& __other)
     {
         clear();
-        
-        std::swap(_M_root, __other._M_root);
-        std::swap(_M_last, __other._M_last);
+
+        _M_alloc = std::move(__other._M_alloc);
+        _M_steal(__other);
 
         return *this;
     }
@@ -231,11 +265,14 @@ public:
 
 
     [[nodiscard]] bool empty() const noexcept
-    { return reinterpret_cast<endnode*>(_M_root) == _M_last; }
+    { return _M_root == _M_endNode(); }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept
+    { return allocator_type(_M_alloc); }
 
     [[nodiscard]] LinkedList clone() const
     {
-        LinkedList result;
+        LinkedList result(get_allocator());
 
         for (auto it = begin(); it != end(); ++it)
         {
@@ -250,19 +287,19 @@ public:
     { return iterator(_M_root); }
 
     [[nodiscard]] iterator end() noexcept
-    { return iterator(_M_last); }
+    { return iterator(_M_endNode()); }
 
     [[nodiscard]] const_iterator begin() const noexcept
     { return const_iterator(_M_root); }
 
     [[nodiscard]] const_iterator end() const noexcept
-    { return const_iterator(_M_last); }
+    { return const_iterator(_M_endNode()); }
 
     [[nodiscard]] const_iterator cbegin() const noexcept
     { return const_iterator(_M_root); }
 
     [[nodiscard]] const_iterator cend() const noexcept
-    { return const_iterator(_M_last); }
+    { return const_iterator(_M_endNode()); }
 
     
     /**
@@ -284,7 +321,7 @@ public:
     /**
      * @brief Inserts __node at the beginning.
      */
-    void insert(std::unique_ptr<node> __node)
+    void insert(node_handle __node)
     {
         __node->prev = nullptr;
         __node->next = _M_root;
@@ -299,7 +336,7 @@ public:
     template<typename... _Args>
     void emplace(_Args&& ...__args)
     {
-        _M_root = new node(nullptr, _M_root, std::forward<_Args>(__args)...);
+        _M_root = _M_createNode(nullptr, _M_root, std::forward<_Args>(__args)...);
 
         // if (_M_root->next)
 
@@ -325,7 +362,7 @@ public:
     /**
      * @brief Inserts __node before __iter.
      */
-    void insert(const_iterator __iter, std::unique_ptr<node> __node)
+    void insert(const_iterator __iter, node_handle __node)
     {
         if (__iter == begin())
         {
@@ -356,7 +393,7 @@ public:
             return;
         }
 
-        __iter.current()->prev = new node(
+        __iter.current()->prev = _M_createNode(
             __iter.current()->prev,
             __iter.current(),
             std::forward<_Args>(__args)...);
@@ -378,7 +415,7 @@ public:
         insert(end(), std::move(__value));
     }
 
-    void append(std::unique_ptr<node> __node)
+    void append(node_handle __node)
     {
         insert(end(), std::move(__node));
     }
@@ -390,7 +427,7 @@ public:
     }
 
 
-    std::unique_ptr<node> extract(const_iterator __iter) noexcept
+    node_handle extract(const_iterator __iter) noexcept
     {
         if (__iter.current()->prev)
         {
@@ -408,7 +445,7 @@ public:
         // if (__iter.current()->next)
         __iter.current()->next->prev = __iter.current()->prev;
         
-        return std::unique_ptr<node>(const_cast<node*>(__iter.current()));
+        return node_handle(const_cast<node*>(__iter.current()), node_deleter(_M_alloc));
     }
 
     /**
@@ -421,7 +458,7 @@ public:
         //     return;
         // }
 
-        delete std::exchange(_M_root, _M_root->next);
+        _M_destroyNode(std::exchange(_M_root, _M_root->next));
 
         _M_root->prev = nullptr;
     }
@@ -445,11 +482,15 @@ public:
     template<typename _Predicate>
     void remove(_Predicate __pred)
     {
-        for (auto it = begin(); it != end(); ++it)
+        for (auto it = begin(); it != end(); )
         {
             if (__pred(*it))
             {
-                remove(it);
+                remove(it++);
+            }
+            else
+            {
+                ++it;
             }
         }
     }
@@ -467,7 +508,7 @@ public:
         //     return;
         // }
 
-        remove(const_iterator(_M_last->prev));
+        remove(const_iterator(_M_end.prev));
     }
 
     
@@ -496,10 +537,10 @@ public:
      * @time O(1)
      */
     [[nodiscard]] reference back() noexcept
-    { return _M_last->prev->element; }
+    { return _M_end.prev->element; }
 
     [[nodiscard]] const_reference back() const noexcept
-    { return _M_last->prev->element; }
+    { return _M_end.prev->element; }
 
 
     /**
@@ -625,8 +666,57 @@ public:
 
 protected:
 
-    node* _M_root = reinterpret_cast<node*>(new endnode{ nullptr, nullptr });
-    endnode* _M_last = reinterpret_cast<endnode*>(_M_root);
+    [[nodiscard]] node* _M_endNode() const noexcept
+    { return reinterpret_cast<node*>(const_cast<endnode*>(&_M_end)); }
+
+    template<typename... _Args>
+    [[nodiscard]] node* _M_createNode(_Args&& ...__args)
+    {
+        node* result = node_allocator_traits::allocate(_M_alloc, 1);
+
+        try
+        {
+            node_allocator_traits::construct(_M_alloc, result, std::forward<_Args>(__args)...);
+        }
+        catch (...)
+        {
+            node_allocator_traits::deallocate(_M_alloc, result, 1);
+            throw;
+        }
+
+        return result;
+    }
+
+    void _M_destroyNode(node* __node) noexcept
+    {
+        node_allocator_traits::destroy(_M_alloc, __node);
+        node_allocator_traits::deallocate(_M_alloc, __node, 1);
+    }
+
+    /**
+     * @brief Takes over all nodes of __other and relinks them to the end node
+     *        of the current list, which must be empty before the call.
+     */
+    void _M_steal(LinkedList& __other) noexcept
+    {
+        if (__other.empty())
+        {
+            return;
+        }
+
+        _M_root = std::exchange(__other._M_root, __other._M_endNode());
+        _M_end.prev = std::exchange(__other._M_end.prev, nullptr);
+
+        _M_end.prev->next = _M_endNode();
+    }
+
+    [[no_unique_address]] node_allocator_type _M_alloc;
+
+    /// The end node lives inside the list, so an empty list never touches the
+    /// allocator.
+    endnode _M_end{ nullptr, nullptr };
+
+    node* _M_root = _M_endNode();
 };
 
 }  // namespace win::ds
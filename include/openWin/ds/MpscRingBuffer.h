@@ -0,0 +1,158 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* MpscRingBuffer.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 11:20:31
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief A bounded lock-free ring buffer with many producers and a single consumer.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_DS_MPSCRINGBUFFER_H
+#define OPENWIN_HEADER_DS_MPSCRINGBUFFER_H
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace win::ds
+{
+
+template<typename _Tp>
+class MpscRingBuffer
+{
+public:
+
+    using value_type = _Tp;
+
+    /**
+     * @param __capacity Rounded up to a power of 2.
+     */
+    explicit MpscRingBuffer(std::size_t __capacity)
+        : _M_mask(_S_roundUp(__capacity) - 1)
+        , _M_cells(new cell[_M_mask + 1])
+    {
+        for (std::size_t i = 0; i <= _M_mask; ++i)
+        {
+            _M_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    [[nodiscard]] std::size_t capacity() const noexcept
+    { return _M_mask + 1; }
+
+    /**
+     * @brief  Can be called from any thread.
+     * 
+     * @return false if the buffer is full, __value is left untouched.
+     */
+    template<typename _Up>
+    bool tryPush(_Up&& __value)
+    {
+        std::size_t pos = _M_enqueuePos.load(std::memory_order_relaxed);
+        cell* target;
+
+        for (;;)
+        {
+            target = &_M_cells[pos & _M_mask];
+
+            std::size_t seq = target->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                if (_M_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = _M_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        target->value = std::forward<_Up>(__value);
+        target->sequence.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * @brief  Must only be called from the consumer thread.
+     * 
+     * @return false if the buffer is empty.
+     */
+    bool tryPop(value_type& __out)
+    {
+        cell& target = _M_cells[_M_dequeuePos & _M_mask];
+
+        if (target.sequence.load(std::memory_order_acquire) != _M_dequeuePos + 1)
+        {
+            return false;
+        }
+
+        __out = std::move(target.value);
+        target.sequence.store(_M_dequeuePos + _M_mask + 1, std::memory_order_release);
+
+        ++_M_dequeuePos;
+        return true;
+    }
+
+    /**
+     * @note  Exact only when called from the consumer thread.
+     */
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _M_cells[_M_dequeuePos & _M_mask].sequence.load(std::memory_order_acquire)
+            != _M_dequeuePos + 1;
+    }
+
+private:
+
+    struct cell
+    {
+        std::atomic<std::size_t> sequence;
+        value_type value;
+    };
+
+    static std::size_t _S_roundUp(std::size_t __n) noexcept
+    {
+        std::size_t result = 2;
+
+        while (result < __n)
+        {
+            result <<= 1;
+        }
+
+        return result;
+    }
+
+    const std::size_t _M_mask;
+    std::unique_ptr<cell[]> _M_cells;
+
+    alignas(64) std::atomic<std::size_t> _M_enqueuePos = 0;
+    alignas(64) std::size_t _M_dequeuePos = 0;
+};
+
+}  // namespace win::ds
+
+#endif  // OPENWIN_HEADER_DS_MPSCRINGBUFFER_H
\ No newline at end of file
@@ -0,0 +1,225 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* PoolAllocator.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 09:12:40
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief A fixed-size node pool and an allocator adapter for the containers in ds, nodes are
+*        carved from contiguous blocks and recycled through a free list instead of going back
+*        to the global heap.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_DS_POOLALLOCATOR_H
+#define OPENWIN_HEADER_DS_POOLALLOCATOR_H
+
+#include <atomic>
+#include <thread>
+#include <new>
+#include <memory>
+
+#include <cstddef>
+
+namespace win::ds
+{
+
+template<std::size_t _Size, std::size_t _Align, std::size_t _SlotsPerBlock = 64>
+class MemoryPool
+{
+public:
+
+    static_assert(_SlotsPerBlock > 0, "_SlotsPerBlock must be greater than 0.");
+
+    static constexpr std::size_t alignment =
+        _Align > alignof(void*) ? _Align : alignof(void*);
+
+    static constexpr std::size_t slotSize =
+        ((_Size > sizeof(void*) ? _Size : sizeof(void*)) + alignment - 1) / alignment * alignment;
+
+    MemoryPool() = default;
+
+    ~MemoryPool()
+    {
+        for (block* cp = _M_blocks; cp; )
+        {
+            ::operator delete(std::exchange(cp, cp->next), std::align_val_t(alignment));
+        }
+    }
+
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
+    /**
+     * @brief The pool shared by all the allocators of the same slot size.
+     * 
+     * @note  The pool is never destroyed, so that containers with static
+     *        storage duration can still release their nodes during shutdown.
+     */
+    [[nodiscard]] static MemoryPool& instance() noexcept
+    {
+        static MemoryPool* const _S_pool = new MemoryPool;
+        return *_S_pool;
+    }
+
+    [[nodiscard]] void* allocate()
+    {
+        _M_lock();
+
+        if (_M_free == nullptr)
+        {
+            try
+            {
+                _M_grow();
+            }
+            catch (...)
+            {
+                _M_unlock();
+                throw;
+            }
+        }
+
+        slot* result = std::exchange(_M_free, _M_free->next);
+
+        _M_unlock();
+        return result;
+    }
+
+    void deallocate(void* __ptr) noexcept
+    {
+        _M_lock();
+
+        _M_free = ::new (__ptr) slot{ _M_free };
+
+        _M_unlock();
+    }
+
+    /**
+     * @return The number of blocks requested from the global heap so far.
+     */
+    [[nodiscard]] std::size_t blockCount() const noexcept
+    { return _M_blockCount; }
+
+private:
+
+    struct slot
+    {
+        slot* next;
+    };
+
+    struct block
+    {
+        block* next;
+    };
+
+    static constexpr std::size_t headerSize =
+        (sizeof(block) + alignment - 1) / alignment * alignment;
+
+    void _M_grow()
+    {
+        std::byte* raw = static_cast<std::byte*>(
+            ::operator new(headerSize + slotSize * _SlotsPerBlock, std::align_val_t(alignment)));
+
+        _M_blocks = ::new (raw) block{ _M_blocks };
+        ++_M_blockCount;
+
+        /// Thread the new slots in address order.
+
+        for (std::size_t i = _SlotsPerBlock; i--; )
+        {
+            _M_free = ::new (raw + headerSize + slotSize * i) slot{ _M_free };
+        }
+    }
+
+    void _M_lock() noexcept
+    {
+        while (_M_flag.test_and_set(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void _M_unlock() noexcept
+    {
+        _M_flag.clear(std::memory_order_release);
+    }
+
+    std::atomic_flag _M_flag = ATOMIC_FLAG_INIT;
+
+    slot* _M_free = nullptr;
+    block* _M_blocks = nullptr;
+
+    std::size_t _M_blockCount = 0;
+};
+
+/**
+ * @brief A stateless allocator that serves single-object requests from
+ *        MemoryPool, all instances compare equal.
+ * 
+ * @note  Requests of more than one object fall back to the global heap.
+ */
+template<typename _Tp, std::size_t _SlotsPerBlock = 64>
+class PoolAllocator
+{
+public:
+
+    using value_type = _Tp;
+
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    template<typename _Up>
+    struct rebind
+    { using other = PoolAllocator<_Up, _SlotsPerBlock>; };
+
+    using pool_type = MemoryPool<sizeof(_Tp), alignof(_Tp), _SlotsPerBlock>;
+
+    PoolAllocator() = default;
+
+    template<typename _Up>
+    PoolAllocator(const PoolAllocator<_Up, _SlotsPerBlock>&) noexcept
+    { }
+
+    [[nodiscard]] _Tp* allocate(std::size_t __n)
+    {
+        if (__n == 1)
+        {
+            return static_cast<_Tp*>(pool_type::instance().allocate());
+        }
+
+        return std::allocator<_Tp>().allocate(__n);
+    }
+
+    void deallocate(_Tp* __ptr, std::size_t __n) noexcept
+    {
+        if (__n == 1)
+        {
+            pool_type::instance().deallocate(__ptr);
+            return;
+        }
+
+        std::allocator<_Tp>().deallocate(__ptr, __n);
+    }
+
+    template<typename _Up>
+    [[nodiscard]] bool operator==(const PoolAllocator<_Up, _SlotsPerBlock>&) const noexcept
+    { return true; }
+
+    template<typename _Up>
+    [[nodiscard]] bool operator!=(const PoolAllocator<_Up, _SlotsPerBlock>&) const noexcept
+    { return false; }
+};
+
+}  // namespace win::ds
+
+#endif  // OPENWIN_HEADER_DS_POOLALLOCATOR_H
\ No newline at end of file
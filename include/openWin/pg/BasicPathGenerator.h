@@ -26,9 +26,11 @@
 #include <type_traits>
 #include <utility>
 #include <memory>
+#include <optional>
 #include <thread>
 
 #include "../Tools.h"
+#include "../FramePacer.h"
 
 namespace win::pg
 {
@@ -80,6 +82,16 @@ public:
     [[nodiscard]] std::uint32_t waitingTime() const noexcept
     { return _M_waitingTime; }
 
+    /**
+     * @brief Replaces the clock the iterators are paced by, to measure the
+     *        pacing with a FramePacer::SimulatedTimeSource.
+     */
+    void setTimeSource(FramePacer::TimeSource& __source) noexcept
+    { _M_timeSource = &__source; }
+
+    [[nodiscard]] FramePacer::TimeSource& timeSource() const noexcept
+    { return *_M_timeSource; }
+
     void wait() const noexcept
     {
         if (_M_waitingTime)
@@ -133,7 +145,14 @@ public:
             : _M_parent(__parent)
             , _M_starting(__from)
             , _M_end(__to)
-        { }
+        {
+            if (__parent->waitingTime())
+            {
+                _M_pacer.emplace(std::chrono::milliseconds(__parent->waitingTime()), __parent->timeSource());
+            }
+        }
+
+        virtual ~ForwardIterator() = default;
 
         [[nodiscard]] const BasicPathGenerator* parent() const noexcept
         { return _M_parent; }
@@ -148,8 +167,39 @@ public:
         [[nodiscard]] container_type current()
         { return _V_current(); }
 
+        /**
+         * @brief Steps forward at the deadline of the next frame, a frame lasts
+         *        the waiting time of the generator. The deadlines are counted
+         *        from the construction of the iterator, so the time spent
+         *        between the steps does not add up; when a deadline is missed,
+         *        the steps of the frames passed meanwhile are skipped.
+         */
         void advance()
-        { _V_advance(); parent()->wait(); }
+        {
+            if (_M_pacer)
+            {
+                const std::uint64_t frame = _M_pacer->frame();
+                _V_skip(_M_pacer->next() - frame);
+            }
+            else
+            {
+                _V_advance();
+            }
+        }
+
+        /**
+         * @brief Same as advance() but without waiting, for the callers that
+         *        pace the steps themselves.
+         */
+        void step()
+        { _V_advance(); }
+
+        /**
+         * @return The pacer of the steps, nullptr if the generator has no
+         *         waiting time.
+         */
+        [[nodiscard]] const FramePacer* pacer() const noexcept
+        { return _M_pacer ? &*_M_pacer : nullptr; }
 
         [[nodiscard]] bool remains()
         { return _V_remains(); }
@@ -173,12 +223,21 @@ public:
         virtual void _V_advance() = 0;
         virtual bool _V_remains() = 0;
 
+        /**
+         * @brief Steps forward __n steps but not past the last one, unless
+         *        already there. The generators that cannot skip steps one.
+         */
+        virtual void _V_skip(std::uint64_t)
+        { _V_advance(); }
+
     private:
 
         const BasicPathGenerator* const _M_parent;
 
         container_type _M_starting;
         container_type _M_end;
+
+        std::optional<FramePacer> _M_pacer;
     };
 
     [[nodiscard]]
@@ -189,6 +248,8 @@ public:
 private:
 
     std::uint32_t _M_waitingTime = 0;
+
+    FramePacer::TimeSource* _M_timeSource = &FramePacer::TimeSource::system();
 };
 
 }  // namespace win::pg
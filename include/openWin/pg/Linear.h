@@ -25,6 +25,7 @@
 
 #include <array>
 #include <algorithm>
+#include <cmath>
 
 namespace win::pg
 {
@@ -96,6 +97,13 @@ public:
         virtual bool _V_remains() override
         { return _M_pos <= static_cast<decltype(_M_pos)>(std::ceil(_M_block)); }
 
+        virtual void _V_skip(std::uint64_t __n) override
+        {
+            const auto last = static_cast<decltype(_M_pos)>(std::ceil(_M_block));
+
+            _M_pos = _M_pos >= last ? _M_pos + 1 : std::min(_M_pos + std::max<std::uint64_t>(__n, 1), last);
+        }
+
     private:
 
         std::uint64_t _M_pos;
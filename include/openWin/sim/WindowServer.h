@@ -0,0 +1,672 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WindowServer.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 23:05:41
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief An in-process model of the window system: windows with their z-order, rects, titles
+*        and styles, threads with message queues, processes, hot keys, WinEvent hooks and a
+*        screen framebuffer. Built with OPENWIN_SIMULATED_BACKEND, the Win32 functions used by
+*        openWin are implemented on it, so the whole library runs headless, and every call can
+*        be counted and given a fixed latency for reproducible benchmarks.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_HEADER_SIM_WINDOWSERVER_H
+#define OPENWIN_HEADER_SIM_WINDOWSERVER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <optional>
+#include <memory>
+#include <chrono>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+
+#include <cstdint>
+
+#include "../Geometry.h"
+
+namespace win::sim
+{
+
+/**
+ * @brief Holds the state of a simulated window system, thread-safe.
+ * 
+ *        The windows are stored in screen coordinates, child windows too.
+ *        The values of the styles, messages and events are those of Win32,
+ *        the server itself looks only at the bits named below.
+ * 
+ *        Threads are identified per server: an operating system thread gets
+ *        a simulated thread ID on its first call, and createThread() makes
+ *        threads without one, to own the windows of other applications.
+ *        Their posted messages wait in their queues, and messages sent to
+ *        their windows are handled on the sending thread.
+ * 
+ * @code
+ * sim::WindowServer server;
+ * sim::WindowServer::setCurrent(&server);
+ * 
+ * server.setLatency("SetWindowPos", std::chrono::microseconds(50));
+ * 
+ * Win notepad(server.create({ .title = L"Untitled - Notepad", .rect = Rect(0, 0, 800, 600) }));
+ * notepad.setPos(100, 100);
+ * 
+ * assert(server.calls("SetWindowPos") == 1);
+ * @endcode
+ */
+class WindowServer
+{
+public:
+
+    using Handle = void*;
+
+    using ThreadId = std::uint32_t;
+    using ProcessId = std::uint32_t;
+
+    using Clock = std::chrono::steady_clock;
+
+    /// WS_POPUP, WS_CHILD, WS_MINIMIZE, WS_VISIBLE, WS_DISABLED, WS_MAXIMIZE.
+    static constexpr std::uint32_t popupStyle = 0x80000000;
+    static constexpr std::uint32_t childStyle = 0x40000000;
+    static constexpr std::uint32_t minimizedStyle = 0x20000000;
+    static constexpr std::uint32_t visibleStyle = 0x10000000;
+    static constexpr std::uint32_t disabledStyle = 0x08000000;
+    static constexpr std::uint32_t maximizedStyle = 0x01000000;
+
+    /// WS_OVERLAPPEDWINDOW | WS_VISIBLE
+    static constexpr std::uint32_t defaultStyle = 0x10CF0000;
+
+    /// WS_EX_TOPMOST
+    static constexpr std::uint32_t topmostExStyle = 0x00000008;
+
+    /// The WinEvent events raised by the server.
+    enum Event : std::uint32_t
+    {
+        ForegroundEvent     = 0x0003,
+        CreateEvent         = 0x8000,
+        DestroyEvent        = 0x8001,
+        ShowEvent           = 0x8002,
+        HideEvent           = 0x8003,
+        LocationChangeEvent = 0x800B,
+        NameChangeEvent     = 0x800C
+    };
+
+    struct Options
+    {
+        Size screen = Size(1920, 1080);
+
+        std::uint32_t dpi = 96;
+
+        /// The color the framebuffer is cleared to, 0x00bbggrr.
+        std::uint32_t background = 0x00000000;
+
+        /// The latency of the calls that have none set by setLatency().
+        std::chrono::nanoseconds latency = std::chrono::nanoseconds::zero();
+
+        /// The executable path of the current process.
+        std::wstring processPath = L"C:\\openWin\\simulated.exe";
+    };
+
+    /**
+     * @brief Handles a message sent or dispatched to a window, returns the
+     *        result of the message.
+     */
+    using Procedure = std::function<std::intptr_t(Handle, std::uint32_t, std::uintptr_t, std::intptr_t)>;
+
+    struct Window
+    {
+        /// Set by create().
+        Handle handle = nullptr;
+
+        Handle parent = nullptr;
+        Handle owner = nullptr;
+
+        std::wstring title;
+        std::wstring className = L"openWin.Simulated";
+
+        /// In screen coordinates.
+        Rect rect = Rect(0, 0, 640, 480);
+
+        /// The rect to restore to while minimized or maximized.
+        Rect normalRect;
+
+        std::uint32_t style = defaultStyle;
+        std::uint32_t exStyle = 0;
+
+        /// Set by SetLayeredWindowAttributes().
+        std::uint8_t alpha = 0xff;
+        std::uint32_t colorKey = 0;
+        std::uint32_t layeredFlags = 0;
+
+        std::uint32_t displayAffinity = 0;
+
+        /// 0 for the DPI of the server.
+        std::uint32_t dpi = 0;
+
+        /// 0 for the calling thread and its process.
+        ThreadId threadId = 0;
+        ProcessId processId = 0;
+
+        bool unicode = true;
+
+        /// A hung window fails SendMessageTimeout() and IsHungAppWindow() is
+        /// true for it.
+        bool hung = false;
+
+        /// The SC_CLOSE item of the system menu.
+        bool closeEnabled = true;
+
+        /// The default procedure is used if empty.
+        Procedure procedure;
+
+        [[nodiscard]] bool visible() const noexcept
+        { return style & visibleStyle; }
+
+        [[nodiscard]] bool topmost() const noexcept
+        { return exStyle & topmostExStyle; }
+    };
+
+    struct Message
+    {
+        /// nullptr for a message posted to a thread.
+        Handle window = nullptr;
+
+        std::uint32_t message = 0;
+
+        std::uintptr_t wParam = 0;
+        std::intptr_t lParam = 0;
+
+        Clock::time_point time;
+    };
+
+    /**
+     * @brief The focus, active and capture windows of a thread.
+     */
+    struct Input
+    {
+        Handle focus = nullptr;
+        Handle active = nullptr;
+        Handle capture = nullptr;
+    };
+
+    /**
+     * @brief Called with the event and the window, on the thread that set
+     *        the hook, while it gets or peeks messages.
+     */
+    using EventHook = std::function<void(std::uint32_t __event, Handle __window)>;
+
+    /**
+     * @brief The framebuffer passed to paint(), 0x00bbggrr pixels row by row.
+     */
+    struct Surface
+    {
+        std::uint32_t* pixels;
+        Size size;
+
+        [[nodiscard]] bool contains(int __x, int __y) const noexcept
+        { return __x >= 0 && __y >= 0 && __x < size.w() && __y < size.h(); }
+
+        [[nodiscard]] std::uint32_t& at(int __x, int __y) noexcept
+        { return pixels[static_cast<std::size_t>(__y) * size.w() + __x]; }
+    };
+
+    WindowServer();
+    explicit WindowServer(const Options& __options);
+
+    ~WindowServer();
+
+    WindowServer(const WindowServer&) = delete;
+    WindowServer& operator=(const WindowServer&) = delete;
+
+    /**
+     * @return The server the simulated system functions use, a server with
+     *         the default options unless another one is set.
+     */
+    [[nodiscard]] static WindowServer& current() noexcept;
+
+    /**
+     * @brief Replaces the server used by the simulated system functions, the
+     *        handles of the previous server are not valid on the new one.
+     * 
+     * @param __server Must outlive its use, nullptr restores the default.
+     * 
+     * @return The previous server.
+     */
+    static WindowServer* setCurrent(WindowServer* __server) noexcept;
+
+    [[nodiscard]] const Options& options() const noexcept
+    { return _M_options; }
+
+    /* ================== windows ================== */
+
+    /**
+     * @brief Creates a window on top of its siblings, below the topmost ones
+     *        unless it is topmost too.
+     * 
+     * @return The handle of the new window, nullptr if the parent does not
+     *         exist.
+     */
+    Handle create(Window __window);
+
+    Handle create()
+    { return create(Window()); }
+
+    /**
+     * @brief Destroys the window with its children and owned windows.
+     */
+    bool destroy(Handle __handle);
+
+    [[nodiscard]] bool contains(Handle __handle) const;
+
+    /**
+     * @return A copy of the window, with its texts and procedure.
+     */
+    [[nodiscard]] std::optional<Window> window(Handle __handle) const;
+
+    /**
+     * @brief Calls the function with the window under the shared lock, without
+     *        copying it.
+     * 
+     * @note The function must not call the server.
+     * 
+     * @return The result of the function, std::nullopt if there is no such
+     *         window.
+     */
+    template<typename _Func>
+    auto with(Handle __handle, _Func&& __func) const -> std::optional<std::invoke_result_t<_Func, const Window&>>
+    {
+        std::shared_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+        if (const Window* w = _M_find(__handle))
+        {
+            return std::invoke(std::forward<_Func>(__func), *w);
+        }
+
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Changes the window, children follow when it moves, and the
+     *        events of the changes are raised.
+     * 
+     * @return false if there is no such window.
+     */
+    bool update(Handle __handle, const std::function<void(Window&)>& __change);
+
+    /**
+     * @param __parent nullptr for the desktop.
+     */
+    bool setParent(Handle __handle, Handle __parent);
+
+    /**
+     * @return The children of the window, or the top-level windows for
+     *         nullptr, from top to bottom.
+     */
+    [[nodiscard]] std::vector<Handle> windows(Handle __parent = nullptr) const;
+
+    /**
+     * @brief Moves the window below another one of its siblings.
+     * 
+     * @param __after nullptr to move it to the top, it stays within the
+     *                topmost or the non-topmost windows.
+     */
+    bool place(Handle __handle, Handle __after);
+
+    /**
+     * @brief Moves the window to the bottom, a topmost one loses it.
+     */
+    bool placeBottom(Handle __handle);
+
+    /**
+     * @brief Makes the window topmost or not, and moves it to the top of its
+     *        new group.
+     */
+    bool setTopmost(Handle __handle, bool __topmost);
+
+    /**
+     * @return The deepest visible window containing the point, nullptr if
+     *         there is none.
+     */
+    [[nodiscard]] Handle windowAt(const Point& __point) const;
+
+    /**
+     * @return The top-level window with the class name and title, nullptr
+     *         matches any.
+     */
+    [[nodiscard]] Handle find(const std::wstring* __className, const std::wstring* __title) const;
+
+    /* ================== input ================== */
+
+    [[nodiscard]] Handle foreground() const;
+
+    /**
+     * @return false if the window does not exist or the foreground is
+     *         locked by another thread.
+     */
+    bool setForeground(Handle __handle);
+
+    void lockForeground(bool __lock);
+
+    [[nodiscard]] Input input(ThreadId __threadId) const;
+
+    /**
+     * @brief Sets the focus, active or capture window of the thread of the
+     *        window.
+     */
+    bool setFocus(Handle __handle);
+    bool setActive(Handle __handle);
+    bool setCapture(Handle __handle);
+
+    void releaseCapture();
+
+    [[nodiscard]] Point cursor() const;
+    void setCursor(const Point& __point);
+
+    /* ================== threads and processes ================== */
+
+    /**
+     * @return The ID of the calling thread, assigned on its first call.
+     */
+    [[nodiscard]] ThreadId currentThread();
+
+    [[nodiscard]] ProcessId currentProcess() const noexcept
+    { return _M_currentProcess; }
+
+    ProcessId createProcess(std::wstring __path);
+
+    /**
+     * @brief Creates a thread that no operating system thread runs.
+     * 
+     * @param __processId 0 for the current process.
+     */
+    ThreadId createThread(ProcessId __processId = 0);
+
+    [[nodiscard]] std::optional<std::wstring> processPath(ProcessId __processId) const;
+    [[nodiscard]] std::optional<ProcessId> processOf(ThreadId __threadId) const;
+
+    /**
+     * @brief Destroys the windows of the process or thread, the operating
+     *        system threads are not stopped.
+     */
+    bool terminateProcess(ProcessId __processId);
+    bool terminateThread(ThreadId __threadId);
+
+    /* ================== messages ================== */
+
+    /**
+     * @brief Posts to the thread of the window.
+     */
+    bool post(Handle __handle, std::uint32_t __message, std::uintptr_t __wParam, std::intptr_t __lParam);
+
+    bool postThread(ThreadId __threadId, std::uint32_t __message, std::uintptr_t __wParam, std::intptr_t __lParam);
+
+    /**
+     * @brief Waits for a message in the queue of the calling thread, running
+     *        the event hooks of the thread meanwhile. WM_QUIT is taken
+     *        whatever the filter.
+     * 
+     * @param __filter nullptr for any message, (Handle)-1 for the messages
+     *                 posted to the thread, otherwise the window.
+     * @param __min    The range of the messages, 0 and 0 for all.
+     * 
+     * @return false for WM_QUIT.
+     */
+    bool get(Message& __message, Handle __filter = nullptr, std::uint32_t __min = 0, std::uint32_t __max = 0);
+
+    /**
+     * @brief Same as get() without waiting.
+     * 
+     * @return false if there is no message.
+     */
+    bool peek(
+        Message& __message,
+        Handle __filter = nullptr,
+        std::uint32_t __min = 0,
+        std::uint32_t __max = 0,
+        bool __remove = true);
+
+    /**
+     * @brief Calls the procedure of the window on the calling thread.
+     * 
+     * @return std::nullopt if the window does not exist, or is hung and
+     *         __failIfHung is set.
+     */
+    std::optional<std::intptr_t> send(
+        Handle __handle,
+        std::uint32_t __message,
+        std::uintptr_t __wParam,
+        std::intptr_t __lParam,
+        bool __failIfHung = false);
+
+    std::intptr_t dispatch(const Message& __message);
+
+    /**
+     * @brief Handles WM_SETTEXT, WM_GETTEXT, WM_GETTEXTLENGTH and WM_CLOSE,
+     *        other messages return 0.
+     */
+    std::intptr_t defaultProcedure(Handle __handle, std::uint32_t __message, std::uintptr_t __wParam, std::intptr_t __lParam);
+
+    /* ================== hot keys and events ================== */
+
+    /**
+     * @param __handle nullptr to post WM_HOTKEY to the calling thread.
+     * 
+     * @return false if the key combination is registered already.
+     */
+    bool registerHotKey(Handle __handle, int __id, std::uint32_t __modifiers, std::uint32_t __key);
+    bool unregisterHotKey(Handle __handle, int __id);
+
+    /**
+     * @brief Simulates pressing a hot key, MOD_NOREPEAT is ignored.
+     * 
+     * @return false if no hot key is registered for it.
+     */
+    bool pressHotKey(std::uint32_t __modifiers, std::uint32_t __key);
+
+    /**
+     * @brief Hooks the events in [__min, __max] for the calling thread.
+     * 
+     * @return The ID of the hook, never 0.
+     */
+    std::uint64_t hook(std::uint32_t __min, std::uint32_t __max, EventHook __hook, bool __skipOwnThread = false);
+    bool unhook(std::uint64_t __id);
+
+    /* ================== framebuffer ================== */
+
+    /**
+     * @brief Calls the function with the framebuffer locked.
+     */
+    template<typename _Fn>
+    void paint(_Fn&& __fn)
+    {
+        std::lock_guard<std::mutex> _L_lock(_M_framebufferMutex);
+
+        Surface surface{ _M_framebuffer.data(), _M_options.screen };
+        __fn(surface);
+    }
+
+    [[nodiscard]] std::uint32_t pixel(const Point& __point) const;
+
+    /**
+     * @return The pixels of the rect row by row, those off the screen are 0.
+     */
+    [[nodiscard]] std::vector<std::uint32_t> capture(const Rect& __rect) const;
+
+    /* ================== latency and call counts ================== */
+
+    /**
+     * @return The ID of the call with the name, the same for every server.
+     */
+    [[nodiscard]] static std::size_t callId(std::string_view __call);
+
+    /**
+     * @brief Called by every simulated system function, counts the call and
+     *        spins out its latency.
+     */
+    void enter(std::size_t __callId) noexcept;
+
+    /**
+     * @brief Sets the latency of all calls without one of their own.
+     */
+    void setLatency(std::chrono::nanoseconds __latency) noexcept;
+
+    /**
+     * @brief Sets the latency of one call, a negative one restores the
+     *        default.
+     * 
+     * @param __call The name of the system function, such as "SetWindowPos".
+     */
+    void setLatency(std::string_view __call, std::chrono::nanoseconds __latency);
+
+    [[nodiscard]] std::uint64_t calls(std::string_view __call) const;
+
+    /**
+     * @return The number of calls to all system functions.
+     */
+    [[nodiscard]] std::uint64_t calls() const noexcept;
+
+    void resetCalls() noexcept;
+
+private:
+
+    static constexpr std::size_t maxCalls = 512;
+
+    struct thread
+    {
+        ProcessId process = 0;
+
+        Input input;
+
+        struct entry
+        {
+            Message message;
+
+            /// Runs instead of being returned, for the event hooks.
+            std::function<void()> call;
+        };
+
+        std::deque<entry> queue;
+        std::condition_variable_any arrived;
+    };
+
+    struct hotKey
+    {
+        Handle handle;
+        int id;
+
+        std::uint32_t modifiers;
+        std::uint32_t key;
+
+        ThreadId thread;
+    };
+
+    struct eventHook
+    {
+        std::uint64_t id;
+
+        std::uint32_t min;
+        std::uint32_t max;
+
+        EventHook hook;
+
+        ThreadId thread;
+        bool skipOwnThread;
+    };
+
+    struct raised
+    {
+        std::uint32_t event;
+        Handle handle;
+    };
+
+    thread& _M_thread(ThreadId __threadId);
+
+    [[nodiscard]] Window* _M_find(Handle __handle) noexcept;
+    [[nodiscard]] const Window* _M_find(Handle __handle) const noexcept;
+
+    [[nodiscard]] std::vector<Handle>& _M_siblings(const Window& __window);
+
+    /**
+     * @brief Inserts into the siblings at the top of its group.
+     */
+    void _M_insert(std::vector<Handle>& __siblings, const Window& __window);
+
+    void _M_offset(Handle __handle, int __dx, int __dy);
+
+    void _M_destroy(Handle __handle, std::vector<raised>& __events);
+
+    void _M_erase(Handle __handle);
+
+    /**
+     * @brief Queues the events to the hooking threads, called with the lock
+     *        held.
+     */
+    void _M_raise(const std::vector<raised>& __events, ThreadId __from);
+
+    [[nodiscard]] static bool _S_matches(
+        const Message& __message, Handle __filter, std::uint32_t __min, std::uint32_t __max) noexcept;
+
+    const Options _M_options;
+
+    mutable std::shared_mutex _M_mutex;
+
+    std::unordered_map<Handle, Window> _M_windows;
+
+    /// The children of each window from top to bottom, nullptr for the desktop.
+    std::unordered_map<Handle, std::vector<Handle>> _M_children;
+
+    std::uintptr_t _M_nextHandle;
+
+    /// Never erased, the threads keep their IDs.
+    std::unordered_map<ThreadId, std::unique_ptr<thread>> _M_threads;
+    std::unordered_map<ProcessId, std::wstring> _M_processes;
+
+    const ProcessId _M_currentProcess = 1'000;
+
+    /// The next thread or process ID, they do not overlap as in Win32.
+    std::uint32_t _M_nextId = 1'004;
+
+    Handle _M_foreground = nullptr;
+    ThreadId _M_foregroundLock = 0;
+
+    Point _M_cursor;
+
+    std::vector<hotKey> _M_hotKeys;
+    std::vector<eventHook> _M_hooks;
+
+    std::uint64_t _M_nextHook = 1;
+
+    /// Tells the threads apart from those of a previous server at the same address.
+    const std::uint64_t _M_generation;
+
+    mutable std::mutex _M_framebufferMutex;
+    std::vector<std::uint32_t> _M_framebuffer;
+
+    std::atomic<std::int64_t> _M_latency;
+
+    /// In nanoseconds, negative for the default latency.
+    std::unique_ptr<std::atomic<std::int64_t>[]> _M_latencies;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> _M_calls;
+};
+
+}  // namespace win::sim
+
+#endif  // OPENWIN_HEADER_SIM_WINDOWSERVER_H
\ No newline at end of file
@@ -0,0 +1,444 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* AnimationScheduler.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 21:20:09
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Implement AnimationScheduler.h, except the Win32 backend which is in
+*        AnimationSchedulerSystem.cpp.
+*/
+
+#include <openWin/AnimationScheduler.h>
+
+#include <algorithm>
+
+using namespace win;
+
+void Animation::state::complete(Animation::status __status)
+{
+    std::uint32_t expected = Running;
+
+    if (not status.compare_exchange_strong(expected, __status, std::memory_order_acq_rel))
+    {
+        return;
+    }
+
+    status.notify_all();
+
+    std::vector<std::function<void(bool)>> taken;
+
+    {
+        std::lock_guard<std::mutex> _L_lock(mutex);
+
+        completed = true;
+        taken.swap(continuations);
+    }
+
+    for (auto& continuation : taken)
+    {
+        continuation(__status == Finished);
+    }
+}
+
+void Animation::cancel() const
+{
+    if (_M_state)
+    {
+        _M_state->complete(Cancelled);
+    }
+}
+
+void Animation::join() const noexcept
+{
+    if (_M_state == nullptr)
+    {
+        return;
+    }
+
+    while (_M_state->status.load(std::memory_order_acquire) == Running)
+    {
+        _M_state->status.wait(Running, std::memory_order_acquire);
+    }
+}
+
+bool Animation::done() const noexcept
+{
+    return _M_state == nullptr || _M_state->status.load(std::memory_order_acquire) != Running;
+}
+
+bool Animation::cancelled() const noexcept
+{
+    return _M_state && _M_state->status.load(std::memory_order_acquire) == Cancelled;
+}
+
+bool Animation::_M_enqueue(std::function<void(bool)>&& __continuation) const
+{
+    if (_M_state == nullptr)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> _L_lock(_M_state->mutex);
+
+    if (_M_state->completed)
+    {
+        return false;
+    }
+
+    _M_state->continuations.push_back(std::move(__continuation));
+    return true;
+}
+
+void Animation::then(std::function<void(bool __finished)> __continuation) const
+{
+    if (not _M_enqueue(std::move(__continuation)))
+    {
+        /// Not moved from when it is not enqueued.
+        __continuation(not cancelled());
+    }
+}
+
+std::future<bool> Animation::future() const
+{
+    auto promise = std::make_shared<std::promise<bool>>();
+    std::future<bool> result = promise->get_future();
+
+    then([promise](bool __finished) { promise->set_value(__finished); });
+
+    return result;
+}
+
+bool Animation::await_suspend(std::coroutine_handle<> __coroutine) const
+{
+    return _M_enqueue([__coroutine](bool) { __coroutine.resume(); });
+}
+
+
+AnimationScheduler::AnimationScheduler()
+    : AnimationScheduler(Options())
+{ }
+
+AnimationScheduler::AnimationScheduler(const Options& __options, Backend& __backend)
+    : _M_options(__options)
+    , _M_backend(__backend)
+    , _M_epoch(Clock::now())
+    , _M_thread(&AnimationScheduler::_M_run, this)
+{ }
+
+AnimationScheduler::~AnimationScheduler()
+{
+    {
+        std::lock_guard<std::mutex> _L_lock(_M_mutex);
+        _M_stop = true;
+    }
+
+    _M_wakeup.notify_all();
+    _M_thread.join();
+
+    cancelAll();
+}
+
+AnimationScheduler& AnimationScheduler::shared()
+{
+    static AnimationScheduler* const _S_scheduler = new AnimationScheduler;
+    return *_S_scheduler;
+}
+
+void AnimationScheduler::_S_complete(std::vector<completion>& __completions)
+{
+    for (auto& [state, status] : __completions)
+    {
+        state->complete(status);
+    }
+
+    __completions.clear();
+}
+
+std::uint64_t AnimationScheduler::_M_framesIn(Clock::duration __duration) const noexcept
+{
+    const auto period = std::max(_M_options.frameInterval.count(), Clock::duration::rep(1));
+
+    return std::max<std::uint64_t>(1, static_cast<std::uint64_t>((__duration.count() + period / 2) / period));
+}
+
+std::uint64_t AnimationScheduler::_M_frameAt(Clock::time_point __time) const noexcept
+{
+    const auto period = std::max(_M_options.frameInterval.count(), Clock::duration::rep(1));
+
+    return static_cast<std::uint64_t>((__time - _M_epoch).count() / period);
+}
+
+Animation AnimationScheduler::_M_add(std::unique_ptr<track> __track)
+{
+    auto state = std::make_shared<Animation::state>();
+
+    std::vector<completion> completions;
+
+    {
+        std::lock_guard<std::mutex> _L_lock(_M_mutex);
+
+        /// Starts on the next frame, together with the animations added in
+        /// the same frame.
+        __track->state = state;
+        __track->due = _M_frameAt(Clock::now()) + 1;
+        __track->sequence = _M_sequence++;
+
+        std::erase_if(_M_tracks, [&](const std::unique_ptr<track>& __t) {
+            if (__t->handle == __track->handle && (__t->channels & __track->channels))
+            {
+                completions.emplace_back(__t->state, Animation::Cancelled);
+                return true;
+            }
+
+            return false;
+        });
+
+        _M_tracks.push_back(std::move(__track));
+    }
+
+    _M_wakeup.notify_one();
+
+    _S_complete(completions);
+
+    return Animation(std::move(state));
+}
+
+void AnimationScheduler::cancel(const Win& __win)
+{
+    std::vector<completion> completions;
+
+    {
+        std::lock_guard<std::mutex> _L_lock(_M_mutex);
+
+        std::erase_if(_M_tracks, [&](const std::unique_ptr<track>& __t) {
+            if (__t->handle == __win.handle())
+            {
+                completions.emplace_back(__t->state, Animation::Cancelled);
+                return true;
+            }
+
+            return false;
+        });
+    }
+
+    _S_complete(completions);
+    _M_idle.notify_all();
+}
+
+void AnimationScheduler::cancelAll()
+{
+    std::vector<completion> completions;
+
+    {
+        std::lock_guard<std::mutex> _L_lock(_M_mutex);
+
+        std::sort(_M_tracks.begin(), _M_tracks.end(), [](const auto& __a, const auto& __b) {
+            return __a->sequence < __b->sequence;
+        });
+
+        for (const auto& t : _M_tracks)
+        {
+            completions.emplace_back(t->state, Animation::Cancelled);
+        }
+
+        _M_tracks.clear();
+    }
+
+    _S_complete(completions);
+    _M_idle.notify_all();
+}
+
+void AnimationScheduler::joinAll()
+{
+    std::unique_lock<std::mutex> _L_lock(_M_mutex);
+    _M_idle.wait(_L_lock, [this] { return _M_tracks.empty() && not _M_completing; });
+}
+
+FramePacer::Stats AnimationScheduler::jitter() const
+{
+    std::lock_guard<std::mutex> _L_lock(_M_mutex);
+    return _M_jitter;
+}
+
+std::size_t AnimationScheduler::size() const
+{
+    std::lock_guard<std::mutex> _L_lock(_M_mutex);
+    return _M_tracks.size();
+}
+
+void AnimationScheduler::_M_run()
+{
+    std::unique_lock<std::mutex> _L_lock(_M_mutex);
+
+    std::vector<completion> completions;
+
+    while (not _M_stop)
+    {
+        /// Drops the animations cancelled through their handles.
+        std::erase_if(_M_tracks, [](const std::unique_ptr<track>& __t) {
+            return __t->state->status.load(std::memory_order_acquire) != Animation::Running;
+        });
+
+        if (_M_tracks.empty())
+        {
+            _M_idle.notify_all();
+            _M_wakeup.wait(_L_lock, [this] { return _M_stop || not _M_tracks.empty(); });
+            continue;
+        }
+
+        std::uint64_t next = UINT64_MAX;
+
+        for (const auto& t : _M_tracks)
+        {
+            next = std::min(next, t->due);
+        }
+
+        if (_M_frameAt(Clock::now()) < next)
+        {
+            const Clock::time_point deadline = _M_epoch + _M_options.frameInterval * next;
+
+            /// Waits on the condition variable to wake up early for a new
+            /// animation, which may be due sooner, but it may overshoot by a
+            /// timer tick, so the last frame before the deadline is slept by
+            /// the time source of FramePacer.
+            if (_M_wakeup.wait_until(_L_lock, deadline - _M_options.frameInterval) == std::cv_status::timeout)
+            {
+                _L_lock.unlock();
+                FramePacer::TimeSource::system().sleepUntil(deadline);
+                _L_lock.lock();
+            }
+
+            continue;
+        }
+
+        _M_tick(_L_lock, completions);
+
+        if (not completions.empty())
+        {
+            _M_completing = true;
+            _L_lock.unlock();
+
+            _S_complete(completions);
+
+            _L_lock.lock();
+            _M_completing = false;
+        }
+    }
+}
+
+void AnimationScheduler::_M_tick(std::unique_lock<std::mutex>& __lock, std::vector<completion>& __completions)
+{
+    const Clock::time_point time = Clock::now();
+    const std::uint64_t now = _M_frameAt(time);
+
+    std::uint64_t earliest = now;
+
+    std::vector<std::pair<Win::Handle, Frame>> frames;
+    std::vector<std::unique_ptr<track>> finished;
+
+    for (std::size_t i = 0; i < _M_tracks.size(); )
+    {
+        track& t = *_M_tracks[i];
+
+        if (t.state->status.load(std::memory_order_acquire) != Animation::Running)
+        {
+            _M_tracks[i] = std::move(_M_tracks.back());
+            _M_tracks.pop_back();
+            continue;
+        }
+
+        if (t.due > now)
+        {
+            ++i;
+            continue;
+        }
+
+        earliest = std::min(earliest, t.due);
+
+        /// Folds the channels of the same window into one frame.
+        auto it = std::find_if(frames.begin(), frames.end(), [&](const auto& __f) { return __f.first == t.handle; });
+
+        if (it == frames.end())
+        {
+            it = frames.emplace(frames.end(), t.handle, Frame());
+        }
+
+        if (t.step(it->second))
+        {
+            it->second.channels |= t.channels;
+        }
+
+        /// A late frame is not made up for, the next step waits a whole
+        /// interval from now.
+        t.due = now + t.interval;
+
+        if (not t.remains())
+        {
+            finished.push_back(std::move(_M_tracks[i]));
+
+            _M_tracks[i] = std::move(_M_tracks.back());
+            _M_tracks.pop_back();
+            continue;
+        }
+
+        ++i;
+    }
+
+    std::erase_if(frames, [](const auto& __f) { return __f.second.channels == 0; });
+
+    _M_jitter.record(time - (_M_epoch + _M_options.frameInterval * earliest), now - earliest);
+
+    std::vector<Win::Handle> failed;
+
+    if (not frames.empty())
+    {
+        __lock.unlock();
+
+        for (const auto& [handle, frame] : frames)
+        {
+            if (not _M_backend.write(handle, frame))
+            {
+                failed.push_back(handle);
+            }
+        }
+
+        __lock.lock();
+
+        _M_writes.fetch_add(frames.size(), std::memory_order_relaxed);
+        _M_frames.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const auto hasFailed = [&](Win::Handle __handle) {
+        return std::find(failed.begin(), failed.end(), __handle) != failed.end();
+    };
+
+    if (not failed.empty())
+    {
+        std::erase_if(_M_tracks, [&](std::unique_ptr<track>& __t) {
+            if (hasFailed(__t->handle))
+            {
+                finished.push_back(std::move(__t));
+                return true;
+            }
+
+            return false;
+        });
+    }
+
+    /// Completed after their last frame is written, in the order of start.
+    std::sort(finished.begin(), finished.end(), [](const auto& __a, const auto& __b) {
+        return __a->sequence < __b->sequence;
+    });
+
+    for (const auto& t : finished)
+    {
+        __completions.emplace_back(t->state, hasFailed(t->handle) ? Animation::Cancelled : Animation::Finished);
+    }
+}
\ No newline at end of file
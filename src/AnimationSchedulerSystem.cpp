@@ -0,0 +1,117 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* AnimationSchedulerSystem.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 21:20:13
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief The Win32 backend of AnimationScheduler.
+*/
+
+#include <openWin/AnimationScheduler.h>
+
+#include <algorithm>
+
+#include "Built-in/_Windows.h"
+#include "Built-in/_MacrosForErrorHandling.h"
+
+using namespace win;
+
+static inline HWND $(Win::Handle __handle) noexcept
+{ return reinterpret_cast<HWND>(__handle); }
+
+/**
+ * @brief Writes the position and the size of a frame with one SetWindowPos,
+ *        converted the same way as Win::setPos() and Win::setSize().
+ */
+class _SystemAnimationBackend : public AnimationScheduler::Backend
+{
+public:
+
+    virtual AnimationScheduler::Frame read(Win::Handle __handle, AnimationScheduler::Channels __channels) override
+    {
+        const Win win(__handle);
+
+        AnimationScheduler::Frame frame;
+        frame.channels = __channels;
+
+        if (__channels & AnimationScheduler::PositionChannel)
+        {
+            frame.pos = win.pos();
+        }
+
+        if (__channels & AnimationScheduler::SizeChannel)
+        {
+            frame.size = win.size();
+        }
+
+        if (__channels & AnimationScheduler::OpacityChannel)
+        {
+            frame.opacity = win.opacity();
+        }
+
+        return frame;
+    }
+
+    virtual void prepare(Win::Handle __handle, AnimationScheduler::Channels __channels) override
+    {
+        if (__channels & AnimationScheduler::OpacityChannel)
+        {
+            Win(__handle).becomeLayered();
+        }
+    }
+
+    virtual bool write(Win::Handle __handle, const AnimationScheduler::Frame& __frame) override
+    {
+        _Win_Static_Begin_
+
+        if (__frame.channels & (AnimationScheduler::PositionChannel | AnimationScheduler::SizeChannel))
+        {
+            const UINT dpi = GetDpiForWindow($(__handle));
+            const float scale = dpi ? dpi / 96.0F : 1.00F;
+
+            UINT flags = SWP_NOZORDER | SWP_NOACTIVATE;
+
+            const Point p(__frame.pos.physics(scale));
+            const Size sz(__frame.size.physics(scale));
+
+            if (not (__frame.channels & AnimationScheduler::PositionChannel))
+            {
+                flags |= SWP_NOMOVE;
+            }
+
+            if (not (__frame.channels & AnimationScheduler::SizeChannel))
+            {
+                flags |= SWP_NOSIZE;
+            }
+
+            _Win_Test_(SetWindowPos($(__handle), nullptr, p.x(), p.y(), sz.width(), sz.height(), flags), false)
+        }
+
+        /// Made layered by prepare().
+        if (__frame.channels & AnimationScheduler::OpacityChannel)
+        {
+            const bool ret = SetLayeredWindowAttributes(
+                $(__handle),
+                0,
+                static_cast<BYTE>(std::max(0, std::min(0xff, __frame.opacity))),
+                LWA_ALPHA);
+
+            _Win_Test_(ret, false)
+        }
+
+        return true;
+    }
+};
+
+AnimationScheduler::Backend& AnimationScheduler::Backend::system() noexcept
+{
+    static _SystemAnimationBackend* const _S_backend = new _SystemAnimationBackend;
+    return *_S_backend;
+}
\ No newline at end of file
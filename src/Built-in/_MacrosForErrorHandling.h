@@ -8,21 +8,106 @@
 #   define __FUNCTION_PROTOTYPE__ __func__
 #endif
 
+/// Gives the guarded function a compile-time ID, registered once with its prototype.
+#define _Win_Call_Site_ \
+    static constexpr ::CallSiteId _L_callSiteId = ::callSiteHash(__FUNCTION_PROTOTYPE__); \
+    static const ::CallSiteRegistrar _L_callSiteRegistrar(_L_callSiteId, __FUNCTION_PROTOTYPE__);
+
+#if defined(OPENWIN_PROFILING)
+#   include <openWin/Profiler.h>
+
+/// Declared first so that the time of the check at the end is included.
+#   define _Win_Profile_ \
+        ::ProfilerScope _L_profilerScope(_L_callSiteId);
+#else
+#   define _Win_Profile_
+#endif  // OPENWIN_PROFILING
+
+#if defined(OPENWIN_TRACING)
+#   include <openWin/Tracer.h>
+
+#   define _Win_Trace_(handle) \
+        ::TraceScope _L_traceScope(_L_callSiteId, handle);
+#else
+#   define _Win_Trace_(handle)
+#endif  // OPENWIN_TRACING
+
+#if defined(OPENWIN_JOURNALING)
+#   include <openWin/Journal.h>
+
+/// Placed after _Win_Begin_ in the calls that change windows, and records
+/// them with the arguments to replay them.
+#   define _Win_Journal_(op, ...) \
+        ::JournalScope _L_journalScope(::Journal::Op::op, this->_M_handle, { __VA_ARGS__ });
+
+#   define _Win_Static_Journal_(op, ...) \
+        ::JournalScope _L_journalScope(::Journal::Op::op, nullptr, { __VA_ARGS__ });
+
+/// A step of a path generator loop.
+#   define _Win_Journal_Step_(op, ...) \
+        ::JournalScope::step(::Journal::Op::op, this->_M_handle, { __VA_ARGS__ });
+#else
+#   define _Win_Journal_(op, ...)
+#   define _Win_Static_Journal_(op, ...)
+#   define _Win_Journal_Step_(op, ...)
+#endif  // OPENWIN_JOURNALING
+
+#if defined(OPENWIN_LEAN_ERRORS)
+
+/// Only the last error code of the calling thread is recorded.
+
 #define _Win_Begin_ \
-    ::ErrorStream* const _L_currentErrorStream = this->_M_errorStream; \
-    ::ErrorStreamGuard _L_errorStreamGuard(*_L_currentErrorStream, __FUNCTION_PROTOTYPE__);
+    _Win_Call_Site_ \
+    _Win_Profile_ \
+    _Win_Trace_(nullptr) \
+    ::LeanErrorStream* const _L_currentErrorStream = ::LeanErrorStream::local(); \
+    ::LeanErrorStreamGuard _L_errorStreamGuard(*_L_currentErrorStream);
 
 #define _Win_Begin_Nocheck_ \
-    ::ErrorStream* const _L_currentErrorStream = this->_M_errorStream; \
-    ::ErrorStreamGuard _L_errorStreamGuard(*_L_currentErrorStream, __FUNCTION_PROTOTYPE__, false);
+    _Win_Call_Site_ \
+    _Win_Profile_ \
+    _Win_Trace_(nullptr) \
+    ::LeanErrorStream* const _L_currentErrorStream = ::LeanErrorStream::local(); \
+    ::LeanErrorStreamGuard _L_errorStreamGuard(*_L_currentErrorStream, false);
+
+#define _Win_Static_Begin_ _Win_Begin_
+#define _Win_Static_Begin_Nocheck_ _Win_Begin_Nocheck_
+
+#else
+
+/// @see _WinErrorStreamBinder in Win.cpp, it must outlive the guard.
+
+#define _Win_Begin_ \
+    _Win_Call_Site_ \
+    _Win_Profile_ \
+    _Win_Trace_(this->_M_handle) \
+    ::_WinErrorStreamBinder _L_errorStreamBinder(this->_M_handle); \
+    ::ErrorStream* const _L_currentErrorStream = _L_errorStreamBinder.stream(); \
+    ::ErrorStreamGuard _L_errorStreamGuard(*_L_currentErrorStream, _L_callSiteId);
+
+#define _Win_Begin_Nocheck_ \
+    _Win_Call_Site_ \
+    _Win_Profile_ \
+    _Win_Trace_(this->_M_handle) \
+    ::_WinErrorStreamBinder _L_errorStreamBinder(this->_M_handle); \
+    ::ErrorStream* const _L_currentErrorStream = _L_errorStreamBinder.stream(); \
+    ::ErrorStreamGuard _L_errorStreamGuard(*_L_currentErrorStream, _L_callSiteId, false);
 
 #define _Win_Static_Begin_ \
+    _Win_Call_Site_ \
+    _Win_Profile_ \
+    _Win_Trace_(nullptr) \
     ::ErrorStream* const _L_currentErrorStream = ::ErrorStream::global(); \
-    ::ErrorStreamGuard _L_errorStreamGuard(*_L_currentErrorStream, __FUNCTION_PROTOTYPE__);
+    ::ErrorStreamGuard _L_errorStreamGuard(*_L_currentErrorStream, _L_callSiteId);
 
 #define _Win_Static_Begin_Nocheck_ \
+    _Win_Call_Site_ \
+    _Win_Profile_ \
+    _Win_Trace_(nullptr) \
     ::ErrorStream* const _L_currentErrorStream = ::ErrorStream::global(); \
-    ::ErrorStreamGuard _L_errorStreamGuard(*_L_currentErrorStream, __FUNCTION_PROTOTYPE__, false);
+    ::ErrorStreamGuard _L_errorStreamGuard(*_L_currentErrorStream, _L_callSiteId, false);
+
+#endif  // OPENWIN_LEAN_ERRORS
 
 
 #define _Win_Return_Nocheck_ \
@@ -0,0 +1,680 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* _SimulatedWindows.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 23:31:02
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief The subset of Windows.h and Psapi.h used by openWin, with the values of the Windows SDK,
+*        for the builds with OPENWIN_SIMULATED_BACKEND. The functions are implemented in
+*        SimulatedWindows.cpp on sim::WindowServer.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cwchar>
+#include <cstring>
+
+#define WINAPI
+#define CALLBACK
+
+/* ================== types ================== */
+
+typedef int BOOL;
+typedef unsigned char BYTE;
+typedef unsigned short WORD;
+typedef std::uint32_t DWORD;
+typedef std::int32_t LONG;
+typedef std::uint32_t ULONG;
+typedef std::int64_t LONGLONG;
+typedef unsigned int UINT;
+
+typedef char CHAR;
+typedef wchar_t WCHAR;
+
+typedef char* LPSTR;
+typedef const char* LPCSTR;
+typedef wchar_t* LPWSTR;
+typedef const wchar_t* LPCWSTR;
+
+typedef std::intptr_t LONG_PTR;
+typedef std::uintptr_t ULONG_PTR;
+typedef std::uintptr_t DWORD_PTR;
+
+typedef std::uintptr_t WPARAM;
+typedef std::intptr_t LPARAM;
+typedef std::intptr_t LRESULT;
+
+typedef DWORD COLORREF;
+
+typedef void* HANDLE;
+typedef void* LPVOID;
+typedef void* HGDIOBJ;
+
+#define DECLARE_HANDLE(name) struct name##__ { int unused; }; typedef struct name##__* name
+
+DECLARE_HANDLE(HWND);
+DECLARE_HANDLE(HDC);
+DECLARE_HANDLE(HMENU);
+DECLARE_HANDLE(HINSTANCE);
+DECLARE_HANDLE(HWINEVENTHOOK);
+DECLARE_HANDLE(HPEN);
+DECLARE_HANDLE(HBRUSH);
+DECLARE_HANDLE(HFONT);
+
+typedef HINSTANCE HMODULE;
+typedef HANDLE HDWP;
+
+typedef std::intptr_t (WINAPI *FARPROC)();
+
+struct POINT
+{
+    LONG x;
+    LONG y;
+};
+
+struct RECT
+{
+    LONG left;
+    LONG top;
+    LONG right;
+    LONG bottom;
+};
+
+union LARGE_INTEGER
+{
+    struct
+    {
+        DWORD LowPart;
+        LONG HighPart;
+    } u;
+
+    LONGLONG QuadPart;
+};
+
+struct MSG
+{
+    HWND hwnd;
+    UINT message;
+    WPARAM wParam;
+    LPARAM lParam;
+    DWORD time;
+    POINT pt;
+};
+
+struct GUITHREADINFO
+{
+    DWORD cbSize;
+    DWORD flags;
+    HWND hwndActive;
+    HWND hwndFocus;
+    HWND hwndCapture;
+    HWND hwndMenuOwner;
+    HWND hwndMoveSize;
+    HWND hwndCaret;
+    RECT rcCaret;
+};
+
+struct FLASHWINFO
+{
+    UINT cbSize;
+    HWND hwnd;
+    DWORD dwFlags;
+    UINT uCount;
+    DWORD dwTimeout;
+};
+
+struct LOGPEN
+{
+    UINT lopnStyle;
+    POINT lopnWidth;
+    COLORREF lopnColor;
+};
+
+struct EXTLOGPEN
+{
+    DWORD elpPenStyle;
+    DWORD elpWidth;
+    UINT elpBrushStyle;
+    COLORREF elpColor;
+    ULONG_PTR elpHatch;
+    DWORD elpNumEntries;
+    DWORD elpStyleEntry[1];
+};
+
+struct LOGBRUSH
+{
+    UINT lbStyle;
+    COLORREF lbColor;
+    ULONG_PTR lbHatch;
+};
+
+#define LF_FACESIZE 32
+
+struct LOGFONTA
+{
+    LONG lfHeight;
+    LONG lfWidth;
+    LONG lfEscapement;
+    LONG lfOrientation;
+    LONG lfWeight;
+    BYTE lfItalic;
+    BYTE lfUnderline;
+    BYTE lfStrikeOut;
+    BYTE lfCharSet;
+    BYTE lfOutPrecision;
+    BYTE lfClipPrecision;
+    BYTE lfQuality;
+    BYTE lfPitchAndFamily;
+    CHAR lfFaceName[LF_FACESIZE];
+};
+
+struct TEXTMETRICA
+{
+    LONG tmHeight;
+    LONG tmAscent;
+    LONG tmDescent;
+    LONG tmInternalLeading;
+    LONG tmExternalLeading;
+    LONG tmAveCharWidth;
+    LONG tmMaxCharWidth;
+    LONG tmWeight;
+    LONG tmOverhang;
+    LONG tmDigitizedAspectX;
+    LONG tmDigitizedAspectY;
+    BYTE tmFirstChar;
+    BYTE tmLastChar;
+    BYTE tmDefaultChar;
+    BYTE tmBreakChar;
+    BYTE tmItalic;
+    BYTE tmUnderlined;
+    BYTE tmStruckOut;
+    BYTE tmPitchAndFamily;
+    BYTE tmCharSet;
+};
+
+typedef BOOL (CALLBACK *WNDENUMPROC)(HWND, LPARAM);
+typedef void (CALLBACK *WINEVENTPROC)(HWINEVENTHOOK, DWORD, HWND, LONG, LONG, DWORD, DWORD);
+typedef int (CALLBACK *FONTENUMPROCA)(const LOGFONTA*, const TEXTMETRICA*, DWORD, LPARAM);
+
+/* ================== macros ================== */
+
+#define RGB(r, g, b) ((COLORREF)(((BYTE)(r) | ((WORD)((BYTE)(g)) << 8)) | (((DWORD)(BYTE)(b)) << 16)))
+
+#define GetRValue(rgb) ((BYTE)(rgb))
+#define GetGValue(rgb) ((BYTE)(((WORD)(rgb)) >> 8))
+#define GetBValue(rgb) ((BYTE)((rgb) >> 16))
+
+#define MAKELANGID(p, s) ((((WORD)(s)) << 10) | (WORD)(p))
+
+#define LANG_NEUTRAL    0x00
+#define SUBLANG_DEFAULT 0x01
+
+#define MAX_PATH 260
+#define INFINITE 0xFFFFFFFF
+
+#define CP_ACP 0
+
+#define ERROR_SUCCESS                    0L
+#define ERROR_ACCESS_DENIED              5L
+#define ERROR_INVALID_HANDLE             6L
+#define ERROR_NOT_SUPPORTED              50L
+#define ERROR_INVALID_PARAMETER          87L
+#define ERROR_MOD_NOT_FOUND              126L
+#define ERROR_PROC_NOT_FOUND             127L
+#define ERROR_MR_MID_NOT_FOUND           317L
+#define ERROR_INVALID_WINDOW_HANDLE      1400L
+#define ERROR_HOTKEY_ALREADY_REGISTERED  1409L
+#define ERROR_INVALID_INDEX              1413L
+#define ERROR_HOTKEY_NOT_REGISTERED      1419L
+#define ERROR_INVALID_THREAD_ID          1444L
+#define ERROR_TIMEOUT                    1460L
+
+#define FORMAT_MESSAGE_ALLOCATE_BUFFER 0x00000100
+#define FORMAT_MESSAGE_IGNORE_INSERTS  0x00000200
+#define FORMAT_MESSAGE_FROM_SYSTEM     0x00001000
+
+#define PROCESS_TERMINATE  0x0001
+#define PROCESS_ALL_ACCESS 0x001FFFFF
+#define THREAD_TERMINATE   0x0001
+#define TIMER_ALL_ACCESS   0x001F0003
+
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+
+/// Windows
+
+#define HWND_TOP       ((HWND)0)
+#define HWND_BOTTOM    ((HWND)1)
+#define HWND_TOPMOST   ((HWND)-1)
+#define HWND_NOTOPMOST ((HWND)-2)
+
+#define SWP_NOSIZE       0x0001
+#define SWP_NOMOVE       0x0002
+#define SWP_NOZORDER     0x0004
+#define SWP_NOACTIVATE   0x0010
+#define SWP_SHOWWINDOW   0x0040
+#define SWP_HIDEWINDOW   0x0080
+
+#define SW_HIDE          0
+#define SW_SHOWNORMAL    1
+#define SW_MAXIMIZE      3
+#define SW_SHOW          5
+#define SW_MINIMIZE      6
+#define SW_RESTORE       9
+#define SW_FORCEMINIMIZE 11
+
+#define GWL_STYLE   (-16)
+#define GWL_EXSTYLE (-20)
+
+#define GW_HWNDFIRST 0
+#define GW_HWNDLAST  1
+#define GW_HWNDNEXT  2
+#define GW_HWNDPREV  3
+#define GW_OWNER     4
+#define GW_CHILD     5
+
+#define GA_PARENT    1
+#define GA_ROOT      2
+#define GA_ROOTOWNER 3
+
+#define WS_POPUP       0x80000000L
+#define WS_CHILD       0x40000000L
+#define WS_MINIMIZE    0x20000000L
+#define WS_VISIBLE     0x10000000L
+#define WS_DISABLED    0x08000000L
+#define WS_MAXIMIZE    0x01000000L
+#define WS_CAPTION     0x00C00000L
+#define WS_BORDER      0x00800000L
+#define WS_VSCROLL     0x00200000L
+#define WS_HSCROLL     0x00100000L
+#define WS_SYSMENU     0x00080000L
+#define WS_SIZEBOX     0x00040000L
+#define WS_MINIMIZEBOX 0x00020000L
+#define WS_MAXIMIZEBOX 0x00010000L
+
+#define WS_EX_TOPMOST     0x00000008L
+#define WS_EX_ACCEPTFILES 0x00000010L
+#define WS_EX_MDICHILD    0x00000040L
+#define WS_EX_TOOLWINDOW  0x00000080L
+#define WS_EX_WINDOWEDGE  0x00000100L
+#define WS_EX_CLIENTEDGE  0x00000200L
+#define WS_EX_CONTEXTHELP 0x00000400L
+#define WS_EX_STATICEDGE  0x00020000L
+#define WS_EX_APPWINDOW   0x00040000L
+#define WS_EX_LAYERED     0x00080000L
+#define WS_EX_COMPOSITED  0x02000000L
+#define WS_EX_NOACTIVATE  0x08000000L
+
+#define LWA_COLORKEY 0x00000001
+#define LWA_ALPHA    0x00000002
+
+#define WDA_NONE               0x00000000
+#define WDA_MONITOR            0x00000001
+#define WDA_EXCLUDEFROMCAPTURE 0x00000011
+
+#define MDITILE_VERTICAL   0x0000
+#define MDITILE_HORIZONTAL 0x0001
+
+#define LSFW_LOCK   1
+#define LSFW_UNLOCK 2
+
+#define SC_CLOSE    0xF060
+#define MF_ENABLED  0x00000000L
+#define MF_GRAYED   0x00000001L
+#define MF_DISABLED 0x00000002L
+
+#define FLASHW_STOP      0
+#define FLASHW_CAPTION   0x00000001
+#define FLASHW_TRAY      0x00000002
+#define FLASHW_ALL       (FLASHW_CAPTION | FLASHW_TRAY)
+#define FLASHW_TIMER     0x00000004
+#define FLASHW_TIMERNOFG 0x0000000C
+
+#define IDOK       1
+#define IDCANCEL   2
+#define IDABORT    3
+#define IDRETRY    4
+#define IDIGNORE   5
+#define IDYES      6
+#define IDNO       7
+#define IDTRYAGAIN 10
+#define IDCONTINUE 11
+
+#define MB_OK                0x00000000L
+#define MB_OKCANCEL          0x00000001L
+#define MB_ABORTRETRYIGNORE  0x00000002L
+#define MB_YESNOCANCEL       0x00000003L
+#define MB_YESNO             0x00000004L
+#define MB_RETRYCANCEL       0x00000005L
+#define MB_CANCELTRYCONTINUE 0x00000006L
+#define MB_ICONERROR         0x00000010L
+#define MB_ICONQUESTION      0x00000020L
+#define MB_ICONWARNING       0x00000030L
+#define MB_ICONINFORMATION   0x00000040L
+#define MB_DEFBUTTON1        0x00000000L
+#define MB_DEFBUTTON2        0x00000100L
+#define MB_SYSTEMMODAL       0x00001000L
+#define MB_HELP              0x00004000L
+#define MB_SETFOREGROUND     0x00010000L
+#define MB_TOPMOST           0x00040000L
+
+/// Messages
+
+#define WM_SETTEXT       0x000C
+#define WM_GETTEXT       0x000D
+#define WM_GETTEXTLENGTH 0x000E
+#define WM_CLOSE         0x0010
+#define WM_QUIT          0x0012
+#define WM_KEYDOWN       0x0100
+#define WM_KEYUP         0x0101
+#define WM_CHAR          0x0102
+#define WM_CUT           0x0300
+#define WM_COPY          0x0301
+#define WM_PASTE         0x0302
+#define WM_CLEAR         0x0303
+#define WM_UNDO          0x0304
+#define WM_HOTKEY        0x0312
+#define WM_USER          0x0400
+
+#define PM_NOREMOVE 0x0000
+#define PM_REMOVE   0x0001
+
+#define SMTO_NORMAL        0x0000
+#define SMTO_ABORTIFHUNG   0x0002
+#define SMTO_ERRORONEXIT   0x0020
+
+#define MOD_NOREPEAT 0x4000
+
+#define MAPVK_VK_TO_VSC 0
+
+/// WinEvents
+
+#define EVENT_SYSTEM_FOREGROUND      0x0003
+#define EVENT_OBJECT_CREATE          0x8000
+#define EVENT_OBJECT_DESTROY         0x8001
+#define EVENT_OBJECT_SHOW            0x8002
+#define EVENT_OBJECT_HIDE            0x8003
+#define EVENT_OBJECT_LOCATIONCHANGE  0x800B
+#define EVENT_OBJECT_NAMECHANGE      0x800C
+
+#define WINEVENT_OUTOFCONTEXT  0x0000
+#define WINEVENT_SKIPOWNTHREAD 0x0001
+
+#define OBJID_WINDOW 0
+#define CHILDID_SELF 0
+
+/// GDI
+
+#define OBJ_PEN   1
+#define OBJ_BRUSH 2
+#define OBJ_FONT  6
+
+#define PS_SOLID     0
+#define PS_NULL      5
+#define PS_USERSTYLE 7
+#define PS_GEOMETRIC 0x00010000
+
+#define BS_SOLID   0
+#define BS_NULL    1
+#define BS_HATCHED 2
+
+#define TRANSPARENT 1
+#define OPAQUE      2
+
+#define R2_COPYPEN 13
+
+#define CLR_INVALID 0xFFFFFFFF
+
+#define TRUETYPE_FONTTYPE 0x0004
+
+#define DEFAULT_CHARSET 1
+
+#define DESKTOPVERTRES 117
+#define DESKTOPHORZRES 118
+
+#define DT_WORDBREAK     0x00000010
+#define DT_SINGLELINE    0x00000020
+#define DT_NOPREFIX      0x00000800
+#define DT_PATH_ELLIPSIS 0x00004000
+#define DT_MODIFYSTRING  0x00010000
+#define DT_HIDEPREFIX    0x00100000
+
+/* ================== functions ================== */
+
+/// Kernel
+
+DWORD GetLastError();
+void SetLastError(DWORD __code);
+
+DWORD GetCurrentThreadId();
+DWORD GetCurrentProcessId();
+
+HANDLE OpenProcess(DWORD __access, BOOL __inherit, DWORD __processId);
+HANDLE OpenThread(DWORD __access, BOOL __inherit, DWORD __threadId);
+BOOL TerminateProcess(HANDLE __process, UINT __exitCode);
+BOOL TerminateThread(HANDLE __handle, DWORD __exitCode);
+BOOL CloseHandle(HANDLE __handle);
+
+DWORD GetModuleFileNameExA(HANDLE __process, HMODULE __module, LPSTR __buffer, DWORD __size);
+DWORD GetModuleFileNameExW(HANDLE __process, HMODULE __module, LPWSTR __buffer, DWORD __size);
+
+HMODULE LoadLibraryA(LPCSTR __name);
+FARPROC GetProcAddress(HMODULE __module, LPCSTR __name);
+BOOL FreeLibrary(HMODULE __module);
+
+HANDLE CreateWaitableTimerExW(void* __attributes, LPCWSTR __name, DWORD __flags, DWORD __access);
+BOOL SetWaitableTimerEx(HANDLE __timer, const LARGE_INTEGER* __due, LONG __period, void* __routine, void* __argument, void* __reason, ULONG __delay);
+DWORD WaitForSingleObject(HANDLE __handle, DWORD __milliseconds);
+
+DWORD FormatMessageA(DWORD __flags, const void* __source, DWORD __code, DWORD __language, LPSTR __buffer, DWORD __size, void* __arguments);
+void* LocalFree(void* __memory);
+
+int WideCharToMultiByte(UINT __codePage, DWORD __flags, LPCWSTR __wide, int __wideLength, LPSTR __buffer, int __size, LPCSTR __default, BOOL* __usedDefault);
+
+HWND GetConsoleWindow();
+
+/// Windows
+
+BOOL IsWindow(HWND __hwnd);
+BOOL DestroyWindow(HWND __hwnd);
+
+HWND WindowFromPoint(POINT __point);
+HWND FindWindowA(LPCSTR __className, LPCSTR __title);
+HWND FindWindowW(LPCWSTR __className, LPCWSTR __title);
+
+HWND GetForegroundWindow();
+HWND GetShellWindow();
+HWND GetDesktopWindow();
+HWND GetFocus();
+HWND GetActiveWindow();
+HWND GetCapture();
+BOOL GetGUIThreadInfo(DWORD __threadId, GUITHREADINFO* __info);
+
+BOOL SetForegroundWindow(HWND __hwnd);
+BOOL LockSetForegroundWindow(UINT __lockCode);
+HWND SetActiveWindow(HWND __hwnd);
+HWND SetFocus(HWND __hwnd);
+HWND SetCapture(HWND __hwnd);
+BOOL ReleaseCapture();
+
+BOOL IsHungAppWindow(HWND __hwnd);
+BOOL EnableWindow(HWND __hwnd, BOOL __enable);
+BOOL IsWindowEnabled(HWND __hwnd);
+BOOL IsWindowUnicode(HWND __hwnd);
+BOOL IsWindowVisible(HWND __hwnd);
+BOOL IsZoomed(HWND __hwnd);
+BOOL IsIconic(HWND __hwnd);
+BOOL IsChild(HWND __parent, HWND __hwnd);
+BOOL AnyPopup();
+
+UINT GetDpiForWindow(HWND __hwnd);
+UINT GetDpiForSystem();
+
+LONG GetWindowLongA(HWND __hwnd, int __index);
+LONG SetWindowLongA(HWND __hwnd, int __index, LONG __value);
+LONG_PTR GetWindowLongPtrW(HWND __hwnd, int __index);
+
+#define GetWindowLong GetWindowLongA
+#define SetWindowLong SetWindowLongA
+
+HWND SetParent(HWND __hwnd, HWND __parent);
+HWND GetParent(HWND __hwnd);
+HWND GetAncestor(HWND __hwnd, UINT __flags);
+HWND GetWindow(HWND __hwnd, UINT __command);
+HWND GetTopWindow(HWND __hwnd);
+HWND GetLastActivePopup(HWND __hwnd);
+
+BOOL EnumWindows(WNDENUMPROC __proc, LPARAM __lParam);
+BOOL EnumChildWindows(HWND __parent, WNDENUMPROC __proc, LPARAM __lParam);
+BOOL EnumThreadWindows(DWORD __threadId, WNDENUMPROC __proc, LPARAM __lParam);
+
+BOOL SetWindowPos(HWND __hwnd, HWND __after, int __x, int __y, int __cx, int __cy, UINT __flags);
+HDWP BeginDeferWindowPos(int __count);
+HDWP DeferWindowPos(HDWP __info, HWND __hwnd, HWND __after, int __x, int __y, int __cx, int __cy, UINT __flags);
+BOOL EndDeferWindowPos(HDWP __info);
+WORD TileWindows(HWND __parent, UINT __how, const RECT* __rect, UINT __count, const HWND* __kids);
+
+BOOL ShowWindow(HWND __hwnd, int __command);
+BOOL ShowOwnedPopups(HWND __hwnd, BOOL __show);
+
+BOOL GetWindowRect(HWND __hwnd, RECT* __rect);
+BOOL GetClientRect(HWND __hwnd, RECT* __rect);
+BOOL ClientToScreen(HWND __hwnd, POINT* __point);
+BOOL ScreenToClient(HWND __hwnd, POINT* __point);
+
+BOOL SetWindowTextA(HWND __hwnd, LPCSTR __text);
+BOOL SetWindowTextW(HWND __hwnd, LPCWSTR __text);
+int GetWindowTextLengthA(HWND __hwnd);
+int GetWindowTextLengthW(HWND __hwnd);
+int GetWindowTextA(HWND __hwnd, LPSTR __buffer, int __size);
+int GetWindowTextW(HWND __hwnd, LPWSTR __buffer, int __size);
+int InternalGetWindowText(HWND __hwnd, LPWSTR __buffer, int __size);
+UINT RealGetWindowClassA(HWND __hwnd, LPSTR __buffer, UINT __size);
+UINT RealGetWindowClassW(HWND __hwnd, LPWSTR __buffer, UINT __size);
+
+BOOL SetLayeredWindowAttributes(HWND __hwnd, COLORREF __key, BYTE __alpha, DWORD __flags);
+BOOL GetLayeredWindowAttributes(HWND __hwnd, COLORREF* __key, BYTE* __alpha, DWORD* __flags);
+BOOL SetWindowDisplayAffinity(HWND __hwnd, DWORD __affinity);
+BOOL GetWindowDisplayAffinity(HWND __hwnd, DWORD* __affinity);
+
+HMENU GetSystemMenu(HWND __hwnd, BOOL __revert);
+BOOL EnableMenuItem(HMENU __menu, UINT __item, UINT __enable);
+BOOL DrawMenuBar(HWND __hwnd);
+
+void DragAcceptFiles(HWND __hwnd, BOOL __accept);
+BOOL FlashWindow(HWND __hwnd, BOOL __invert);
+BOOL FlashWindowEx(const FLASHWINFO* __info);
+
+BOOL InvalidateRect(HWND __hwnd, const RECT* __rect, BOOL __erase);
+BOOL UpdateWindow(HWND __hwnd);
+BOOL LockWindowUpdate(HWND __hwnd);
+
+DWORD GetWindowThreadProcessId(HWND __hwnd, DWORD* __processId);
+
+int MessageBoxA(HWND __hwnd, LPCSTR __text, LPCSTR __caption, UINT __type);
+int MessageBoxW(HWND __hwnd, LPCWSTR __text, LPCWSTR __caption, UINT __type);
+BOOL MessageBeep(UINT __type);
+
+BOOL GetCursorPos(POINT* __point);
+
+/// Messages
+
+BOOL PostMessageA(HWND __hwnd, UINT __message, WPARAM __wParam, LPARAM __lParam);
+BOOL PostMessageW(HWND __hwnd, UINT __message, WPARAM __wParam, LPARAM __lParam);
+BOOL PostThreadMessageA(DWORD __threadId, UINT __message, WPARAM __wParam, LPARAM __lParam);
+BOOL PostThreadMessageW(DWORD __threadId, UINT __message, WPARAM __wParam, LPARAM __lParam);
+
+LRESULT SendMessageA(HWND __hwnd, UINT __message, WPARAM __wParam, LPARAM __lParam);
+LRESULT SendMessageW(HWND __hwnd, UINT __message, WPARAM __wParam, LPARAM __lParam);
+LRESULT SendMessageTimeoutA(HWND __hwnd, UINT __message, WPARAM __wParam, LPARAM __lParam, UINT __flags, UINT __timeout, DWORD_PTR* __result);
+LRESULT SendMessageTimeoutW(HWND __hwnd, UINT __message, WPARAM __wParam, LPARAM __lParam, UINT __flags, UINT __timeout, DWORD_PTR* __result);
+
+BOOL GetMessageA(MSG* __msg, HWND __hwnd, UINT __min, UINT __max);
+BOOL GetMessageW(MSG* __msg, HWND __hwnd, UINT __min, UINT __max);
+BOOL PeekMessageW(MSG* __msg, HWND __hwnd, UINT __min, UINT __max, UINT __remove);
+LRESULT DispatchMessageW(const MSG* __msg);
+
+#define PostMessage PostMessageA
+#define PostThreadMessage PostThreadMessageA
+#define GetMessage GetMessageA
+
+BOOL RegisterHotKey(HWND __hwnd, int __id, UINT __modifiers, UINT __key);
+BOOL UnregisterHotKey(HWND __hwnd, int __id);
+
+UINT MapVirtualKeyA(UINT __code, UINT __type);
+UINT MapVirtualKeyW(UINT __code, UINT __type);
+int GetKeyNameTextA(LONG __lParam, LPSTR __buffer, int __size);
+
+#define MapVirtualKey MapVirtualKeyA
+
+HWINEVENTHOOK SetWinEventHook(
+    DWORD __min, DWORD __max, HMODULE __module, WINEVENTPROC __proc, DWORD __processId, DWORD __threadId, DWORD __flags);
+BOOL UnhookWinEvent(HWINEVENTHOOK __hook);
+
+/// GDI
+
+HDC GetDC(HWND __hwnd);
+int ReleaseDC(HWND __hwnd, HDC __hdc);
+HWND WindowFromDC(HDC __hdc);
+int GetDeviceCaps(HDC __hdc, int __index);
+
+HGDIOBJ SelectObject(HDC __hdc, HGDIOBJ __object);
+HGDIOBJ GetCurrentObject(HDC __hdc, UINT __type);
+BOOL DeleteObject(HGDIOBJ __object);
+int GetObjectA(HANDLE __object, int __size, LPVOID __buffer);
+
+#define GetObject GetObjectA
+
+HPEN CreatePen(int __style, int __width, COLORREF __color);
+HPEN ExtCreatePen(DWORD __style, DWORD __width, const LOGBRUSH* __brush, DWORD __count, const DWORD* __styles);
+HBRUSH CreateSolidBrush(COLORREF __color);
+HBRUSH CreateHatchBrush(int __hatch, COLORREF __color);
+HBRUSH CreateBrushIndirect(const LOGBRUSH* __brush);
+HFONT CreateFontIndirectA(const LOGFONTA* __font);
+HFONT CreateFontA(
+    int __height, int __width, int __escapement, int __orientation, int __weight,
+    DWORD __italic, DWORD __underline, DWORD __strikeOut, DWORD __charSet,
+    DWORD __outPrecision, DWORD __clipPrecision, DWORD __quality, DWORD __pitchAndFamily, LPCSTR __faceName);
+int EnumFontFamiliesExA(HDC __hdc, LOGFONTA* __font, FONTENUMPROCA __proc, LPARAM __lParam, DWORD __flags);
+
+COLORREF SetPixel(HDC __hdc, int __x, int __y, COLORREF __color);
+COLORREF GetPixel(HDC __hdc, int __x, int __y);
+
+COLORREF SetTextColor(HDC __hdc, COLORREF __color);
+COLORREF GetTextColor(HDC __hdc);
+COLORREF SetBkColor(HDC __hdc, COLORREF __color);
+COLORREF GetBkColor(HDC __hdc);
+int SetBkMode(HDC __hdc, int __mode);
+int GetBkMode(HDC __hdc);
+int SetROP2(HDC __hdc, int __mode);
+int GetROP2(HDC __hdc);
+BOOL SetMiterLimit(HDC __hdc, float __limit, float* __old);
+BOOL GetMiterLimit(HDC __hdc, float* __limit);
+
+BOOL TextOutA(HDC __hdc, int __x, int __y, LPCSTR __text, int __length);
+BOOL TextOutW(HDC __hdc, int __x, int __y, LPCWSTR __text, int __length);
+int DrawTextA(HDC __hdc, LPCSTR __text, int __length, RECT* __rect, UINT __format);
+int DrawTextW(HDC __hdc, LPCWSTR __text, int __length, RECT* __rect, UINT __format);
+
+BOOL MoveToEx(HDC __hdc, int __x, int __y, POINT* __old);
+BOOL GetCurrentPositionEx(HDC __hdc, POINT* __point);
+BOOL LineTo(HDC __hdc, int __x, int __y);
+BOOL Polyline(HDC __hdc, const POINT* __points, int __count);
+BOOL Polygon(HDC __hdc, const POINT* __points, int __count);
+BOOL PolyBezier(HDC __hdc, const POINT* __points, DWORD __count);
+BOOL Rectangle(HDC __hdc, int __left, int __top, int __right, int __bottom);
+BOOL RoundRect(HDC __hdc, int __left, int __top, int __right, int __bottom, int __width, int __height);
+BOOL Ellipse(HDC __hdc, int __left, int __top, int __right, int __bottom);
+BOOL AngleArc(HDC __hdc, int __x, int __y, DWORD __radius, float __start, float __sweep);
+BOOL Arc(HDC __hdc, int __left, int __top, int __right, int __bottom, int __x1, int __y1, int __x2, int __y2);
+BOOL Chord(HDC __hdc, int __left, int __top, int __right, int __bottom, int __x1, int __y1, int __x2, int __y2);
+BOOL Pie(HDC __hdc, int __left, int __top, int __right, int __bottom, int __x1, int __y1, int __x2, int __y2);
+BOOL InvertRect(HDC __hdc, const RECT* __rect);
\ No newline at end of file
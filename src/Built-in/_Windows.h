@@ -1,5 +1,13 @@
+#if defined(OPENWIN_SIMULATED_BACKEND)
+
+#include "_SimulatedWindows.h"
+
+#else
+
 #include <Windows.h>
 #include <Psapi.h>
 
 #undef min
-#undef max
\ No newline at end of file
+#undef max
+
+#endif
\ No newline at end of file
@@ -0,0 +1,383 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* BulkFetcher.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 17:40:15
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Implement BulkFetcher.h
+*/
+
+#include <openWin/BulkFetcher.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace win;
+
+enum _FetchState : std::uint8_t
+{
+    _Pending,
+    _Running,
+    _Done,
+
+    /// Timed out, the result is dropped even if the worker returns later.
+    _Abandoned
+};
+
+struct BulkFetcher::job
+{
+    job(std::span<const Win::Handle> __handles, WindowSnapshot::Fields __fields)
+        : handles(__handles.begin(), __handles.end())
+        , fields(__fields)
+        , records(__handles.size())
+        , states(new std::atomic<std::uint8_t>[__handles.size()])
+        , started(new std::atomic<Clock::rep>[__handles.size()])
+        , owners(new std::atomic<worker*>[__handles.size()])
+    {
+        for (std::size_t i = 0; i < handles.size(); ++i)
+        {
+            states[i].store(_Pending, std::memory_order_relaxed);
+            started[i].store(0, std::memory_order_relaxed);
+            owners[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    const std::vector<Win::Handle> handles;
+    const WindowSnapshot::Fields fields;
+
+    /// Each record is only written by the worker that runs it.
+    std::vector<WindowSnapshot::Record> records;
+
+    std::unique_ptr<std::atomic<std::uint8_t>[]> states;
+    std::unique_ptr<std::atomic<Clock::rep>[]> started;
+    std::unique_ptr<std::atomic<worker*>[]> owners;
+
+    std::atomic<std::size_t> next = 0;
+
+    /// Guarded by pool::mutex.
+    std::size_t done = 0;
+};
+
+struct BulkFetcher::worker
+{
+    std::thread thread;
+
+    /// Set when the worker is abandoned on a window, it exits once the call
+    /// returns.
+    std::atomic<bool> retired = false;
+};
+
+struct BulkFetcher::pool
+{
+    std::mutex mutex;
+
+    /// Wakes the workers when a job is posted or the pool stops.
+    std::condition_variable posted;
+
+    /// Wakes the fetching thread when a window is done.
+    std::condition_variable progressed;
+
+    std::shared_ptr<job> current;
+    std::vector<std::shared_ptr<worker>> workers;
+
+    bool stop = false;
+};
+
+static WindowSnapshot::Record _S_emptyRecord(Win::Handle __handle)
+{
+    WindowSnapshot::Record record;
+    record.handle = __handle;
+
+    return record;
+}
+
+bool BulkFetcher::Result::complete() const noexcept
+{
+    return std::none_of(timedOut.begin(), timedOut.end(), [](std::uint8_t __flag) { return __flag; });
+}
+
+std::size_t BulkFetcher::Result::timedOutCount() const noexcept
+{
+    return static_cast<std::size_t>(std::count_if(
+        timedOut.begin(), timedOut.end(), [](std::uint8_t __flag) { return __flag; }));
+}
+
+BulkFetcher::BulkFetcher()
+    : BulkFetcher(Options())
+{ }
+
+BulkFetcher::BulkFetcher(const Options& __options, WindowSnapshot::Source& __source)
+    : _M_options(__options)
+    , _M_source(__source)
+    , _M_pool(std::make_shared<pool>())
+{
+    _M_options.workers = std::max<std::size_t>(_M_options.workers, 1);
+
+    std::lock_guard<std::mutex> _L_guard(_M_pool->mutex);
+
+    for (std::size_t i = 0; i < _M_options.workers; ++i)
+    {
+        _M_spawn();
+    }
+}
+
+BulkFetcher::~BulkFetcher()
+{
+    std::vector<std::shared_ptr<worker>> workers;
+
+    {
+        std::lock_guard<std::mutex> _L_guard(_M_pool->mutex);
+
+        _M_pool->stop = true;
+        workers.swap(_M_pool->workers);
+    }
+
+    _M_pool->posted.notify_all();
+
+    for (auto& w : workers)
+    {
+        w->thread.join();
+    }
+}
+
+void BulkFetcher::_M_spawn()
+{
+    auto w = std::make_shared<worker>();
+
+    w->thread = std::thread([p = _M_pool, w, source = &_M_source]() mutable {
+
+        for (;;)
+        {
+            std::shared_ptr<job> j;
+
+            {
+                std::unique_lock<std::mutex> _L_lock(p->mutex);
+
+                p->posted.wait(_L_lock, [&] {
+                    return p->stop
+                        || w->retired.load(std::memory_order_relaxed)
+                        || (p->current && p->current->next.load(std::memory_order_relaxed) < p->current->handles.size());
+                });
+
+                if (p->stop || w->retired.load(std::memory_order_relaxed))
+                {
+                    return;
+                }
+
+                j = p->current;
+            }
+
+            for (;;)
+            {
+                const std::size_t i = j->next.fetch_add(1, std::memory_order_relaxed);
+
+                if (i >= j->handles.size())
+                {
+                    break;
+                }
+
+                std::uint8_t state = _Pending;
+
+                j->owners[i].store(w.get(), std::memory_order_relaxed);
+                j->started[i].store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+
+                /// The job may be closed in between, then the window is
+                /// already abandoned.
+                if (not j->states[i].compare_exchange_strong(state, _Running, std::memory_order_acq_rel))
+                {
+                    continue;
+                }
+
+                try
+                {
+                    j->records[i] = WindowSnapshot::fetch(*source, j->handles[i], j->fields);
+                }
+                catch (...)
+                {
+                    j->records[i] = _S_emptyRecord(j->handles[i]);
+                }
+
+                state = _Running;
+
+                const bool won = j->states[i].compare_exchange_strong(state, _Done, std::memory_order_acq_rel);
+
+                if (won)
+                {
+                    {
+                        std::lock_guard<std::mutex> _L_guard(p->mutex);
+                        ++j->done;
+                    }
+
+                    p->progressed.notify_all();
+                }
+
+                if (w->retired.load(std::memory_order_relaxed))
+                {
+                    return;
+                }
+            }
+        }
+    });
+
+    _M_pool->workers.push_back(std::move(w));
+}
+
+BulkFetcher::Result BulkFetcher::fetch(std::span<const Win::Handle> __handles, WindowSnapshot::Fields __fields)
+{
+    auto j = std::make_shared<job>(__handles, __fields);
+
+    const std::size_t count = j->handles.size();
+    const Clock::time_point deadline = Clock::now() + _M_options.totalTimeout;
+
+    std::size_t abandoned = 0;
+
+    /// Gives up the window, the worker stuck on it is detached and replaced.
+    /// Called with the pool locked.
+    auto abandon = [&](std::size_t __index, std::uint8_t __from) {
+
+        std::uint8_t state = __from;
+
+        if (not j->states[__index].compare_exchange_strong(state, _Abandoned, std::memory_order_acq_rel))
+        {
+            return false;
+        }
+
+        ++abandoned;
+
+        if (__from != _Running)
+        {
+            return true;
+        }
+
+        worker* owner = j->owners[__index].load(std::memory_order_relaxed);
+
+        auto it = std::find_if(_M_pool->workers.begin(), _M_pool->workers.end(),
+            [owner](const std::shared_ptr<worker>& __w) { return __w.get() == owner; });
+
+        if (it != _M_pool->workers.end())
+        {
+            (*it)->retired.store(true, std::memory_order_relaxed);
+            (*it)->thread.detach();
+
+            _M_pool->workers.erase(it);
+            ++_M_abandoned;
+
+            _M_spawn();
+        }
+
+        return true;
+    };
+
+    std::unique_lock<std::mutex> _L_lock(_M_pool->mutex);
+
+    _M_pool->current = j;
+    _M_pool->posted.notify_all();
+
+    for (;;)
+    {
+        if (j->done + abandoned >= count)
+        {
+            break;
+        }
+
+        const Clock::time_point now = Clock::now();
+
+        if (now >= deadline)
+        {
+            break;
+        }
+
+        Clock::time_point wakeup = deadline;
+        bool progressed = false;
+
+        const std::size_t started = std::min(j->next.load(std::memory_order_relaxed), count);
+
+        for (std::size_t i = 0; i < started; ++i)
+        {
+            if (j->states[i].load(std::memory_order_acquire) != _Running)
+            {
+                continue;
+            }
+
+            const Clock::time_point windowDeadline =
+                Clock::time_point(Clock::duration(j->started[i].load(std::memory_order_relaxed)))
+                    + _M_options.windowTimeout;
+
+            if (now >= windowDeadline)
+            {
+                progressed |= abandon(i, _Running);
+            }
+            else
+            {
+                wakeup = std::min(wakeup, windowDeadline);
+            }
+        }
+
+        if (not progressed)
+        {
+            _M_pool->progressed.wait_until(_L_lock, wakeup);
+        }
+    }
+
+    /// Closes the job, what is not done by now times out.
+
+    _M_pool->current = nullptr;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        abandon(i, _Pending);
+        abandon(i, _Running);
+    }
+
+    _L_lock.unlock();
+
+    Result result;
+    result.snapshot = WindowSnapshot(__fields);
+    result.timedOut.resize(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (j->states[i].load(std::memory_order_acquire) == _Done)
+        {
+            result.snapshot.append(j->records[i]);
+        }
+        else
+        {
+            result.snapshot.append(_S_emptyRecord(j->handles[i]));
+            result.timedOut[i] = true;
+        }
+    }
+
+    return result;
+}
+
+BulkFetcher::Result BulkFetcher::fetch(const WinList& __wins, WindowSnapshot::Fields __fields)
+{
+    std::vector<Win::Handle> handles;
+    handles.reserve(__wins.size());
+
+    for (const Win& win : __wins)
+    {
+        handles.push_back(win.handle());
+    }
+
+    return fetch(handles, __fields);
+}
+
+BulkFetcher::Result BulkFetcher::fetch(WindowSnapshot::Fields __fields)
+{
+    std::vector<Win::Handle> handles;
+    _M_source.enumerate(handles);
+
+    return fetch(handles, __fields);
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* CallSite.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 15:48:33
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Implement CallSite.h
+*/
+
+#include <openWin/CallSite.h>
+
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+using namespace win;
+
+/**
+ * @note Never destroyed, IDs may be looked up during shutdown.
+ */
+struct _CallSiteRegistry
+{
+    std::shared_mutex mutex;
+    std::unordered_map<CallSiteId, const char*> names;
+
+    [[nodiscard]] static _CallSiteRegistry& instance() noexcept
+    {
+        static _CallSiteRegistry* const _S_registry = new _CallSiteRegistry;
+        return *_S_registry;
+    }
+};
+
+bool CallSite::add(CallSiteId __id, const char* __prototype) noexcept
+{
+    _CallSiteRegistry& registry = _CallSiteRegistry::instance();
+
+    try
+    {
+        std::unique_lock<std::shared_mutex> _L_guard(registry.mutex);
+
+        auto [it, inserted] = registry.names.try_emplace(__id, __prototype);
+
+        return inserted || it->second == __prototype
+            || std::string_view(it->second) == std::string_view(__prototype);
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+CallSiteId CallSite::add(const char* __prototype) noexcept
+{
+    const CallSiteId id = callSiteHash(__prototype);
+
+    add(id, __prototype);
+    return id;
+}
+
+const char* CallSite::name(CallSiteId __id) noexcept
+{
+    _CallSiteRegistry& registry = _CallSiteRegistry::instance();
+
+    std::shared_lock<std::shared_mutex> _L_guard(registry.mutex);
+
+    auto it = registry.names.find(__id);
+    return it != registry.names.end() ? it->second : nullptr;
+}
\ No newline at end of file
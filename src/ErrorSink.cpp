@@ -0,0 +1,196 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* ErrorSink.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 11:42:10
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Implement ErrorSink.h
+*/
+
+#include <openWin/ErrorSink.h>
+
+#include <algorithm>
+
+using namespace win;
+
+std::ostream& win::operator<<(std::ostream& __os, const ErrorRecord& __record)
+{
+    if (__record.depth)
+    {
+        __os << "In ";
+
+        for (std::size_t i = 0; i < std::min(__record.depth, ErrorRecord::maxWorkpathDepth); ++i)
+        {
+            if (const char* name = CallSite::name(__record.workpath[i]))
+            {
+                __os << name << '/';
+            }
+            else
+            {
+                __os << '#' << std::hex << __record.workpath[i] << std::dec << '/';
+            }
+        }
+
+        if (__record.depth > ErrorRecord::maxWorkpathDepth)
+        {
+            __os << ".../";
+        }
+
+        __os << ": ";
+    }
+
+    if (__record.code)
+    {
+        __os << "( " << __record.code << " ) ";
+    }
+
+    __os << __record.text;
+
+    if (__record.count > 1)
+    {
+        __os << " [repeated " << __record.count << " times in "
+             << std::chrono::duration_cast<std::chrono::milliseconds>(
+                    __record.lastTime - __record.time).count()
+             << " ms]";
+    }
+
+    if (__record.limited)
+    {
+        __os << " [" << __record.limited << " records before were rate limited]";
+    }
+
+    return __os;
+}
+
+
+static std::atomic<ErrorSink*> _S_currentSink = nullptr;
+
+ErrorSink* ErrorSink::current() noexcept
+{
+    if (ErrorSink* sink = _S_currentSink.load(std::memory_order_acquire))
+    {
+        return sink;
+    }
+
+    static AsyncErrorSink _S_defaultSink;
+    return &_S_defaultSink;
+}
+
+ErrorSink* ErrorSink::setCurrent(ErrorSink* __sink) noexcept
+{
+    return _S_currentSink.exchange(__sink, std::memory_order_acq_rel);
+}
+
+
+void StreamErrorSink::write(ErrorRecord&& __record)
+{
+    std::lock_guard<std::mutex> _L_guard(_M_mutex);
+    _M_os << __record << '\n';
+}
+
+void StreamErrorSink::flush()
+{
+    std::lock_guard<std::mutex> _L_guard(_M_mutex);
+    _M_os.flush();
+}
+
+
+AsyncErrorSink::AsyncErrorSink(std::ostream& __os, std::size_t __capacity)
+    : _M_os(__os)
+    , _M_buffer(__capacity)
+    , _M_thread(&AsyncErrorSink::_M_run, this)
+{ }
+
+AsyncErrorSink::~AsyncErrorSink()
+{
+    _M_stop.store(true, std::memory_order_release);
+
+    _M_signal.fetch_add(1, std::memory_order_release);
+    _M_signal.notify_one();
+
+    _M_thread.join();
+}
+
+void AsyncErrorSink::write(ErrorRecord&& __record)
+{
+    if (not _M_buffer.tryPush(std::move(__record)))
+    {
+        _M_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    _M_pushed.fetch_add(1, std::memory_order_release);
+
+    _M_signal.fetch_add(1, std::memory_order_release);
+    _M_signal.notify_one();
+}
+
+void AsyncErrorSink::flush()
+{
+    std::uint64_t target = _M_pushed.load(std::memory_order_acquire);
+
+    for (std::uint64_t drained; (drained = _M_drained.load(std::memory_order_acquire)) < target; )
+    {
+        _M_drained.wait(drained, std::memory_order_acquire);
+    }
+}
+
+std::uint64_t AsyncErrorSink::dropped() const noexcept
+{
+    return _M_dropped.load(std::memory_order_relaxed);
+}
+
+void AsyncErrorSink::_M_run()
+{
+    for (;;)
+    {
+        std::uint32_t signal = _M_signal.load(std::memory_order_acquire);
+
+        _M_drain();
+
+        if (_M_stop.load(std::memory_order_acquire))
+        {
+            _M_drain();
+            break;
+        }
+
+        _M_signal.wait(signal, std::memory_order_acquire);
+    }
+}
+
+void AsyncErrorSink::_M_drain()
+{
+    ErrorRecord record;
+    std::uint64_t count = 0;
+
+    while (_M_buffer.tryPop(record))
+    {
+        _M_os << record << '\n';
+        ++count;
+    }
+
+    std::uint64_t dropped = _M_dropped.load(std::memory_order_relaxed);
+
+    if (dropped != _M_reportedDropped)
+    {
+        _M_os << "openWin: " << dropped - _M_reportedDropped
+              << " error records dropped, the error sink is overloaded.\n";
+
+        _M_reportedDropped = dropped;
+    }
+
+    if (count)
+    {
+        _M_os.flush();
+
+        _M_drained.fetch_add(count, std::memory_order_release);
+        _M_drained.notify_all();
+    }
+}
\ No newline at end of file
@@ -18,17 +18,221 @@
 
 #include "Built-in/_Windows.h"
 
-#include <mutex>
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
+#include <functional>
 
 using namespace win;
 
-static std::mutex _S_cerrMutex;
+
+static std::atomic<std::int64_t> _S_repeatWindow = 0;
+
+/**
+ * @brief The state of the rate limit, kept as a theoretical arrival time so
+ *        that the token bucket can be updated with a single CAS: a record is
+ *        let through if the bucket would not run over __burst tokens.
+ */
+static std::atomic<std::int64_t> _S_rateInterval = 0;
+static std::atomic<std::int64_t> _S_rateTolerance = 0;
+static std::atomic<std::int64_t> _S_rateArrival = 0;
+
+static std::atomic<std::uint64_t> _S_rateLimited = 0;
+static std::atomic<std::uint64_t> _S_rateLimitedPending = 0;
+
+static bool _S_takeToken() noexcept
+{
+    const std::int64_t interval = _S_rateInterval.load(std::memory_order_relaxed);
+
+    if (interval == 0)
+    {
+        return true;
+    }
+
+    const std::int64_t tolerance = _S_rateTolerance.load(std::memory_order_relaxed);
+    const std::int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    std::int64_t arrival = _S_rateArrival.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        const std::int64_t start = std::max(arrival, now);
+
+        if (start - now > tolerance)
+        {
+            return false;
+        }
+
+        if (_S_rateArrival.compare_exchange_weak(arrival, start + interval, std::memory_order_relaxed))
+        {
+            return true;
+        }
+    }
+}
+
+static void _S_send(ErrorRecord&& __record)
+{
+    if (not _S_takeToken())
+    {
+        _S_rateLimited.fetch_add(1, std::memory_order_relaxed);
+        _S_rateLimitedPending.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    __record.limited = _S_rateLimitedPending.exchange(0, std::memory_order_relaxed);
+
+    ErrorSink::current()->write(std::move(__record));
+}
+
+/**
+ * @brief The failures collapsed by the calling thread, keyed by code, text and
+ *        work path.
+ */
+class _RepeatTable
+{
+public:
+
+    _RepeatTable() = default;
+
+    ~_RepeatTable()
+    {
+        flush();
+    }
+
+    _RepeatTable(const _RepeatTable&) = delete;
+    _RepeatTable& operator=(const _RepeatTable&) = delete;
+
+    void report(ErrorRecord&& __record, ErrorRecord::Clock::duration __window)
+    {
+        const auto now = __record.time;
+
+        if (now - _M_lastSweep >= __window)
+        {
+            _M_sweep(now, __window);
+        }
+
+        auto [it, inserted] = _M_entries.try_emplace(key{ __record });
+        entry& e = it->second;
+
+        if (not inserted && now - e.windowStart < __window)
+        {
+            if (e.repeats.count++ == 0)
+            {
+                e.repeats.time = now;
+            }
+
+            e.repeats.lastTime = now;
+            return;
+        }
+
+        if (not inserted)
+        {
+            _M_sendRepeats(e);
+        }
+
+        e.windowStart = now;
+        e.repeats = __record;
+        e.repeats.count = 0;
+
+        _S_send(std::move(__record));
+    }
+
+    void flush()
+    {
+        for (auto& [k, e] : _M_entries)
+        {
+            _M_sendRepeats(e);
+        }
+
+        _M_entries.clear();
+    }
+
+private:
+
+    struct key
+    {
+        std::uint32_t code;
+        std::string text;
+
+        std::array<CallSiteId, ErrorRecord::maxWorkpathDepth> workpath;
+        std::size_t depth;
+
+        explicit key(const ErrorRecord& __record)
+            : code(__record.code)
+            , text(__record.text)
+            , workpath(__record.workpath)
+            , depth(__record.depth)
+        { }
+
+        [[nodiscard]] bool operator==(const key&) const = default;
+    };
+
+    struct hash
+    {
+        [[nodiscard]] std::size_t operator()(const key& __key) const noexcept
+        {
+            std::size_t h = std::hash<std::string>()(__key.text) * 31 + __key.code;
+
+            for (std::size_t i = 0; i < std::min(__key.depth, ErrorRecord::maxWorkpathDepth); ++i)
+            {
+                h = h * 31 + __key.workpath[i];
+            }
+
+            return h;
+        }
+    };
+
+    struct entry
+    {
+        ErrorRecord::Clock::time_point windowStart;
+
+        /// The repeats seen in the current window, count is 0 if none.
+        ErrorRecord repeats;
+    };
+
+    void _M_sendRepeats(entry& __e)
+    {
+        if (__e.repeats.count)
+        {
+            _S_send(std::move(__e.repeats));
+            __e.repeats.count = 0;
+        }
+    }
+
+    void _M_sweep(ErrorRecord::Clock::time_point __now, ErrorRecord::Clock::duration __window)
+    {
+        for (auto it = _M_entries.begin(); it != _M_entries.end(); )
+        {
+            if (__now - it->second.windowStart >= __window)
+            {
+                _M_sendRepeats(it->second);
+                it = _M_entries.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        _M_lastSweep = __now;
+    }
+
+    std::unordered_map<key, entry, hash> _M_entries;
+    ErrorRecord::Clock::time_point _M_lastSweep;
+};
+
+static _RepeatTable& _S_repeatTable()
+{
+    thread_local _RepeatTable _S_table;
+    return _S_table;
+}
 
 ErrorStream::ErrorStream() noexcept
     : _M_failed(false)
 { }
 
-void ErrorStream::begin(const char* __work)
+void ErrorStream::begin(CallSiteId __work)
 {
     if (_M_workpath.empty())
     {
@@ -36,7 +240,12 @@ void ErrorStream::begin(const char* __work)
         SetLastError(ERROR_SUCCESS);
     }
 
-    _M_workpath.append(__work);
+    _M_workpath.push(__work);
+}
+
+void ErrorStream::begin(const char* __work)
+{
+    begin(CallSite::add(__work));
 }
 
 void ErrorStream::end()
@@ -46,71 +255,121 @@ void ErrorStream::end()
         onFailed("Failed in this work!");
     }
 
-    _M_workpath.removeLast();
+    _M_workpath.pop();
 }
 
 void ErrorStream::onFailed(std::uint32_t __code)
 {
-    std::lock_guard<std::mutex> _L_guard(_S_cerrMutex);
-
-    if (not _M_workpath.empty())
-    {
-        std::cerr << "In ";
-        
-        for (auto work : _M_workpath)
-        {
-            std::cerr << work << '/';
-        }
+    ErrorRecord record = _M_makeRecord();
 
-        std::cerr << ": ";
-    }
-
-    std::cerr << "( " << __code << " ) ";
+    record.code = __code;
 
     const char* text = codeToText(__code);
 
     if (text)
     {
-        std::cerr << text;
+        record.text = text;
     }
 
-    std::cerr.put('\n');
+    _S_report(std::move(record));
 }
 
 void ErrorStream::onFailed(const std::string& __text)
 {
-    std::lock_guard<std::mutex> _L_guard(_S_cerrMutex);
+    ErrorRecord record = _M_makeRecord();
+
+    record.text = __text;
 
-    if (not _M_workpath.empty())
+    _S_report(std::move(record));
+}
+
+ErrorRecord ErrorStream::_M_makeRecord() const
+{
+    ErrorRecord record;
+
+    record.depth = _M_workpath.size();
+
+    for (std::size_t i = 0; i < std::min(record.depth, ErrorRecord::maxWorkpathDepth); ++i)
     {
-        std::cerr << "In ";
+        record.workpath[i] = _M_workpath[i];
+    }
 
-        for (auto work : _M_workpath)
-        {
-            std::cerr << work << '/';
-        }
+    record.thread = std::this_thread::get_id();
+    record.time = record.lastTime = ErrorRecord::Clock::now();
+
+    return record;
+}
 
-        std::cerr << ": ";
+void ErrorStream::_S_report(ErrorRecord&& __record)
+{
+    const std::chrono::milliseconds window(_S_repeatWindow.load(std::memory_order_relaxed));
+
+    if (window.count() == 0)
+    {
+        _S_send(std::move(__record));
+        return;
     }
 
-    std::cerr << __text << '\n';
+    _S_repeatTable().report(std::move(__record), window);
 }
 
 const char* ErrorStream::codeToText(std::uint32_t __code) const noexcept
 {
+    try
+    {
+        return ErrorTextCache::global().text(__code);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+static std::string _S_formatMessage(std::uint32_t __code, std::uint32_t __language)
+{
+    if (__language == ErrorTextCache::defaultLanguage)
+    {
+        __language = MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT);
+    }
+
     char* buffer = nullptr;
-    FormatMessageA(
+
+    DWORD length = FormatMessageA(
         FORMAT_MESSAGE_ALLOCATE_BUFFER |
             FORMAT_MESSAGE_FROM_SYSTEM |
             FORMAT_MESSAGE_IGNORE_INSERTS,
         nullptr,
         __code,
-        MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT),
+        __language,
         reinterpret_cast<LPSTR>(&buffer),
         0,
         nullptr
     );
-    return buffer;
+
+    if (buffer == nullptr)
+    {
+        return std::string();
+    }
+
+    /// Drops the trailing line break added by the system.
+
+    while (length && (buffer[length - 1] == '\n' || buffer[length - 1] == '\r'))
+    {
+        --length;
+    }
+
+    std::string result(buffer, length);
+
+    LocalFree(buffer);
+    return result;
+}
+
+ErrorTextCache& ErrorTextCache::global() noexcept
+{
+    /// Never destroyed, the texts may still be used by the error sink
+    /// during shutdown.
+    static ErrorTextCache* const _S_cache = new ErrorTextCache(&_S_formatMessage);
+    return *_S_cache;
 }
 
 bool ErrorStream::check() noexcept
@@ -141,6 +400,11 @@ bool ErrorStream::failed() const noexcept
     return _M_failed || !_M_queue.empty();
 }
 
+std::size_t ErrorStream::depth() const noexcept
+{
+    return _M_workpath.size();
+}
+
 const char* ErrorStream::last() const noexcept
 {
     if (!_M_queue.empty())
@@ -203,4 +467,94 @@ ErrorStream* ErrorStream::global() noexcept
 {
     thread_local ErrorStream _S_errorStream;
     return &_S_errorStream;
+}
+
+void ErrorStream::setRepeatWindow(std::chrono::milliseconds __window) noexcept
+{
+    _S_repeatWindow.store(std::max<std::int64_t>(__window.count(), 0), std::memory_order_relaxed);
+}
+
+std::chrono::milliseconds ErrorStream::repeatWindow() noexcept
+{
+    return std::chrono::milliseconds(_S_repeatWindow.load(std::memory_order_relaxed));
+}
+
+void ErrorStream::flushRepeats()
+{
+    _S_repeatTable().flush();
+}
+
+void ErrorStream::setRateLimit(double __perSecond, std::uint32_t __burst) noexcept
+{
+    if (__perSecond <= 0)
+    {
+        _S_rateInterval.store(0, std::memory_order_relaxed);
+        return;
+    }
+
+    const std::int64_t interval = std::max<std::int64_t>(static_cast<std::int64_t>(1e9 / __perSecond), 1);
+
+    _S_rateTolerance.store(interval * (std::max<std::uint32_t>(__burst, 1) - 1), std::memory_order_relaxed);
+    _S_rateInterval.store(interval, std::memory_order_relaxed);
+}
+
+std::uint64_t ErrorStream::rateLimited() noexcept
+{
+    return _S_rateLimited.load(std::memory_order_relaxed);
+}
+
+
+void LeanErrorStream::begin() noexcept
+{
+    if (_M_depth++ == 0)
+    {
+        _M_code = 0;
+        _M_failed = false;
+
+        SetLastError(ERROR_SUCCESS);
+    }
+}
+
+void LeanErrorStream::end() noexcept
+{
+    --_M_depth;
+}
+
+bool LeanErrorStream::check() noexcept
+{
+    std::uint32_t code = GetLastError();
+
+    if (code)
+    {
+        _M_code = code;
+        return false;
+    }
+
+    return true;
+}
+
+void LeanErrorStream::setFail() noexcept
+{
+    _M_failed = true;
+}
+
+bool LeanErrorStream::success() const noexcept
+{
+    return !_M_failed && _M_code == 0;
+}
+
+bool LeanErrorStream::failed() const noexcept
+{
+    return _M_failed || _M_code != 0;
+}
+
+std::uint32_t LeanErrorStream::code() const noexcept
+{
+    return _M_code;
+}
+
+LeanErrorStream* LeanErrorStream::local() noexcept
+{
+    thread_local LeanErrorStream _S_errorStream;
+    return &_S_errorStream;
 }
\ No newline at end of file
@@ -0,0 +1,141 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* ErrorTextCache.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 13:05:24
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Implement ErrorTextCache.h, except ErrorTextCache::global() which is in ErrorStream.cpp
+*        along with the FormatMessage formatter.
+*/
+
+#include <openWin/ErrorTextCache.h>
+
+#include <mutex>
+
+using namespace win;
+
+ErrorTextCache::ErrorTextCache(Formatter __formatter, std::size_t __capacity)
+    : _M_formatter(std::move(__formatter))
+    , _M_capacity(__capacity)
+{ }
+
+const char* ErrorTextCache::text(std::uint32_t __code, std::uint32_t __language)
+{
+    const std::uint64_t key = _S_key(__code, __language);
+    shard& s = _M_shard(key);
+
+    {
+        std::shared_lock<std::shared_mutex> _L_guard(s.mutex);
+
+        if (auto it = s.texts.find(key); it != s.texts.end())
+        {
+            s.hits.fetch_add(1, std::memory_order_relaxed);
+            return it->second.empty() ? nullptr : it->second.c_str();
+        }
+    }
+
+    s.misses.fetch_add(1, std::memory_order_relaxed);
+
+    /// Formats without holding the lock of the shard, another thread may
+    /// format the same code meanwhile, the first text inserted wins.
+
+    std::string text = _M_format(__code, __language);
+
+    if (_M_size.fetch_add(1, std::memory_order_relaxed) < _M_capacity)
+    {
+        std::unique_lock<std::shared_mutex> _L_guard(s.mutex);
+
+        auto [it, inserted] = s.texts.try_emplace(key, std::move(text));
+
+        if (not inserted)
+        {
+            _M_size.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        return it->second.empty() ? nullptr : it->second.c_str();
+    }
+
+    _M_size.fetch_sub(1, std::memory_order_relaxed);
+
+    if (text.empty())
+    {
+        return nullptr;
+    }
+
+    thread_local std::string _S_overflow;
+
+    _S_overflow = std::move(text);
+    return _S_overflow.c_str();
+}
+
+void ErrorTextCache::preload(std::span<const std::uint32_t> __codes, std::uint32_t __language)
+{
+    for (std::uint32_t code : __codes)
+    {
+        void(text(code, __language));
+    }
+}
+
+void ErrorTextCache::setFormatter(Formatter __formatter)
+{
+    {
+        std::unique_lock<std::shared_mutex> _L_guard(_M_formatterMutex);
+        _M_formatter = std::move(__formatter);
+    }
+
+    clear();
+}
+
+void ErrorTextCache::clear()
+{
+    for (shard& s : _M_shards)
+    {
+        std::unique_lock<std::shared_mutex> _L_guard(s.mutex);
+
+        _M_size.fetch_sub(s.texts.size(), std::memory_order_relaxed);
+        s.texts.clear();
+    }
+}
+
+std::size_t ErrorTextCache::size() const noexcept
+{
+    return _M_size.load(std::memory_order_relaxed);
+}
+
+std::uint64_t ErrorTextCache::hits() const noexcept
+{
+    std::uint64_t result = 0;
+
+    for (const shard& s : _M_shards)
+    {
+        result += s.hits.load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+std::uint64_t ErrorTextCache::misses() const noexcept
+{
+    std::uint64_t result = 0;
+
+    for (const shard& s : _M_shards)
+    {
+        result += s.misses.load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+std::string ErrorTextCache::_M_format(std::uint32_t __code, std::uint32_t __language) const
+{
+    std::shared_lock<std::shared_mutex> _L_guard(_M_formatterMutex);
+
+    return _M_formatter ? _M_formatter(__code, __language) : std::string();
+}
\ No newline at end of file
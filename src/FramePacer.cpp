@@ -0,0 +1,136 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* FramePacer.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 22:05:52
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Implement FramePacer.h, except the system time source which is in
+*        FramePacerSystem.cpp.
+*/
+
+#include <openWin/FramePacer.h>
+
+#include <mutex>
+#include <cmath>
+
+using namespace win;
+
+double FramePacer::Stats::jitter() const noexcept
+{
+    if (frames == 0)
+    {
+        return 0.0;
+    }
+
+    const double n = static_cast<double>(frames);
+    const double mean = std::chrono::duration<double, std::micro>(totalLateness).count() / n;
+
+    return std::sqrt(std::max(0.0, squares / n - mean * mean));
+}
+
+void FramePacer::Stats::record(Clock::duration __lateness, std::uint64_t __skipped) noexcept
+{
+    const double us = std::chrono::duration<double, std::micro>(__lateness).count();
+
+    ++frames;
+    skipped += __skipped;
+    totalLateness += __lateness;
+    maxLateness = std::max(maxLateness, __lateness);
+    squares += us * us;
+}
+
+void FramePacer::Stats::merge(const Stats& __other) noexcept
+{
+    frames += __other.frames;
+    skipped += __other.skipped;
+    totalLateness += __other.totalLateness;
+    maxLateness = std::max(maxLateness, __other.maxLateness);
+    squares += __other.squares;
+}
+
+struct _FramePacerGlobalStats
+{
+    std::mutex mutex;
+    FramePacer::Stats stats;
+};
+
+static _FramePacerGlobalStats& _S_globalStats() noexcept
+{
+    static _FramePacerGlobalStats* const _S_stats = new _FramePacerGlobalStats;
+    return *_S_stats;
+}
+
+FramePacer::FramePacer(Clock::duration __period, TimeSource& __source) noexcept
+    : _M_source(__source)
+    , _M_period(std::max(__period, Clock::duration(1)))
+    , _M_origin(__source.now())
+{ }
+
+FramePacer::~FramePacer()
+{
+    if (_M_stats.frames == 0)
+    {
+        return;
+    }
+
+    _FramePacerGlobalStats& global = _S_globalStats();
+
+    std::lock_guard<std::mutex> _L_lock(global.mutex);
+    global.stats.merge(_M_stats);
+}
+
+void FramePacer::restart() noexcept
+{
+    _M_origin = _M_source.now();
+    _M_frame = 0;
+}
+
+std::uint64_t FramePacer::next()
+{
+    Clock::time_point now = _M_source.now();
+
+    std::uint64_t target = _M_frame + 1;
+
+    /// The last frame whose deadline has passed.
+    const std::uint64_t passed = now < _M_origin ? 0 : static_cast<std::uint64_t>((now - _M_origin) / _M_period);
+
+    std::uint64_t skipped = 0;
+
+    if (passed >= target)
+    {
+        skipped = passed - target;
+        target = passed;
+    }
+    else
+    {
+        _M_source.sleepUntil(deadline(target));
+        now = _M_source.now();
+    }
+
+    _M_stats.record(std::max(now - deadline(target), Clock::duration()), skipped);
+
+    return _M_frame = target;
+}
+
+FramePacer::Stats FramePacer::globalStats()
+{
+    _FramePacerGlobalStats& global = _S_globalStats();
+
+    std::lock_guard<std::mutex> _L_lock(global.mutex);
+    return global.stats;
+}
+
+void FramePacer::resetGlobalStats()
+{
+    _FramePacerGlobalStats& global = _S_globalStats();
+
+    std::lock_guard<std::mutex> _L_lock(global.mutex);
+    global.stats = Stats();
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* FramePacerSystem.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 22:05:58
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief The system time source of FramePacer.
+*/
+
+#include <openWin/FramePacer.h>
+
+#include <thread>
+
+#include "Built-in/_Windows.h"
+
+using namespace win;
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#   define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+/**
+ * @brief Sleeps on a high resolution waitable timer where there is one
+ *        (Windows 10, version 1803), otherwise on std::this_thread, which
+ *        may wake up a whole timer tick late. The last stretch before the
+ *        deadline is spun to cover the wake-up latency.
+ */
+class _SystemTimeSource : public FramePacer::TimeSource
+{
+public:
+
+    /// The stretch before the deadline that is spun instead of slept.
+    static constexpr FramePacer::Clock::duration spinThreshold = std::chrono::microseconds(1'500);
+
+    virtual FramePacer::Clock::time_point now() override
+    { return FramePacer::Clock::now(); }
+
+    virtual void sleepUntil(FramePacer::Clock::time_point __deadline) override
+    {
+        const FramePacer::Clock::time_point wakeup = __deadline - spinThreshold;
+
+        if (FramePacer::Clock::now() < wakeup)
+        {
+            _S_sleepUntil(wakeup);
+        }
+
+        while (FramePacer::Clock::now() < __deadline)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+
+    /**
+     * @brief Keeps the last-error code of the caller, the sleeps run inside
+     *        guarded Win calls that would report a failure of the timer as
+     *        their own.
+     */
+    static void _S_sleepUntil(FramePacer::Clock::time_point __time)
+    {
+        const DWORD lastError = GetLastError();
+
+        _S_sleepOnTimer(__time);
+
+        SetLastError(lastError);
+    }
+
+    static void _S_sleepOnTimer(FramePacer::Clock::time_point __time)
+    {
+        thread_local _Timer _S_timer;
+
+        const auto remaining = __time - FramePacer::Clock::now();
+
+        if (remaining <= FramePacer::Clock::duration::zero())
+        {
+            return;
+        }
+
+        if (_S_timer.handle)
+        {
+            /// Relative, in units of 100 ns.
+            LARGE_INTEGER due;
+            due.QuadPart = -static_cast<LONGLONG>(std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count() / 100);
+
+            if (SetWaitableTimerEx(_S_timer.handle, &due, 0, nullptr, nullptr, nullptr, 0))
+            {
+                WaitForSingleObject(_S_timer.handle, INFINITE);
+                return;
+            }
+        }
+
+        std::this_thread::sleep_until(__time);
+    }
+
+    struct _Timer
+    {
+        _Timer() noexcept
+            : handle(CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS))
+        { }
+
+        ~_Timer()
+        {
+            if (handle)
+            {
+                CloseHandle(handle);
+            }
+        }
+
+        HANDLE handle;
+    };
+};
+
+FramePacer::TimeSource& FramePacer::TimeSource::system() noexcept
+{
+    static _SystemTimeSource* const _S_source = new _SystemTimeSource;
+    return *_S_source;
+}
\ No newline at end of file
@@ -0,0 +1,900 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* Journal.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 17, 2026, 01:26:03
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Implement Journal.h
+*/
+
+#include <openWin/Journal.h>
+#include <openWin/pg/Linear.h>
+
+#if defined(_WIN32)
+/// The file mapping is not a part of the simulated window system.
+#   if defined(OPENWIN_SIMULATED_BACKEND)
+#       include <Windows.h>
+#       undef min
+#       undef max
+#   else
+#       include "Built-in/_Windows.h"
+#   endif
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <mutex>
+
+using namespace win;
+
+std::atomic<bool> Journal::_S_active = false;
+
+thread_local std::uint32_t JournalScope::_S_depth = 0;
+
+/**
+ * @brief A file written through a shared mapping of it, doubled when full.
+ *        The file is as large as the mapping until close() cuts it to the
+ *        bytes appended.
+ */
+class _MappedFile
+{
+public:
+
+    static constexpr std::size_t initialCapacity = std::size_t(1) << 20;
+
+    _MappedFile() = default;
+
+    _MappedFile(const _MappedFile&) = delete;
+    _MappedFile& operator=(const _MappedFile&) = delete;
+
+    [[nodiscard]] bool isOpen() const noexcept
+    { return _M_data != nullptr; }
+
+    bool open(const std::string& __path) noexcept
+    {
+#if defined(_WIN32)
+        _M_file = CreateFileA(
+            __path.c_str(),
+            GENERIC_READ | GENERIC_WRITE,
+            FILE_SHARE_READ,
+            nullptr,
+            CREATE_ALWAYS,
+            FILE_ATTRIBUTE_NORMAL,
+            nullptr);
+
+        if (_M_file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+#else
+        _M_file = ::open(__path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+        if (_M_file == -1)
+        {
+            return false;
+        }
+#endif
+
+        _M_size = 0;
+
+        if (not _M_map(initialCapacity))
+        {
+            _M_closeFile();
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @return Where to write the __size bytes appended, nullptr if the
+     *         mapping cannot grow.
+     */
+    [[nodiscard]] char* append(std::size_t __size) noexcept
+    {
+        if (_M_size + __size > _M_capacity)
+        {
+            std::size_t capacity = _M_capacity;
+
+            while (_M_size + __size > capacity)
+            {
+                capacity *= 2;
+            }
+
+            _M_unmap();
+
+            if (not _M_map(capacity))
+            {
+                /// The old size is still in the file, map it back to keep
+                /// what is written.
+                if (not _M_map(_M_capacity))
+                {
+                    _M_closeFile();
+                }
+
+                return nullptr;
+            }
+        }
+
+        char* const data = _M_data + _M_size;
+        _M_size += __size;
+
+        return data;
+    }
+
+    void flush() noexcept
+    {
+        if (_M_data == nullptr)
+        {
+            return;
+        }
+
+#if defined(_WIN32)
+        FlushViewOfFile(_M_data, _M_size);
+        FlushFileBuffers(_M_file);
+#else
+        ::msync(_M_data, _M_size, MS_SYNC);
+#endif
+    }
+
+    void close() noexcept
+    {
+        if (_M_data == nullptr)
+        {
+            return;
+        }
+
+        _M_unmap();
+
+#if defined(_WIN32)
+        LARGE_INTEGER size;
+        size.QuadPart = static_cast<LONGLONG>(_M_size);
+
+        SetFilePointerEx(_M_file, size, nullptr, FILE_BEGIN);
+        SetEndOfFile(_M_file);
+#else
+        void (::ftruncate(_M_file, static_cast<off_t>(_M_size)));
+#endif
+
+        _M_closeFile();
+    }
+
+private:
+
+    bool _M_map(std::size_t __capacity) noexcept
+    {
+#if defined(_WIN32)
+        _M_mapping = CreateFileMappingA(
+            _M_file,
+            nullptr,
+            PAGE_READWRITE,
+            static_cast<DWORD>(static_cast<std::uint64_t>(__capacity) >> 32),
+            static_cast<DWORD>(__capacity),
+            nullptr);
+
+        if (_M_mapping == nullptr)
+        {
+            return false;
+        }
+
+        _M_data = static_cast<char*>(MapViewOfFile(_M_mapping, FILE_MAP_WRITE, 0, 0, __capacity));
+
+        if (_M_data == nullptr)
+        {
+            CloseHandle(_M_mapping);
+            _M_mapping = nullptr;
+
+            return false;
+        }
+#else
+        if (::ftruncate(_M_file, static_cast<off_t>(__capacity)) != 0)
+        {
+            return false;
+        }
+
+        void* const data = ::mmap(nullptr, __capacity, PROT_READ | PROT_WRITE, MAP_SHARED, _M_file, 0);
+
+        if (data == MAP_FAILED)
+        {
+            return false;
+        }
+
+        _M_data = static_cast<char*>(data);
+#endif
+
+        _M_capacity = __capacity;
+        return true;
+    }
+
+    void _M_unmap() noexcept
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(_M_data);
+        CloseHandle(_M_mapping);
+
+        _M_mapping = nullptr;
+#else
+        ::munmap(_M_data, _M_capacity);
+#endif
+
+        _M_data = nullptr;
+    }
+
+    void _M_closeFile() noexcept
+    {
+#if defined(_WIN32)
+        CloseHandle(_M_file);
+        _M_file = INVALID_HANDLE_VALUE;
+#else
+        ::close(_M_file);
+        _M_file = -1;
+#endif
+
+        _M_data = nullptr;
+        _M_size = 0;
+        _M_capacity = 0;
+    }
+
+    char* _M_data = nullptr;
+
+    std::size_t _M_size = 0;
+    std::size_t _M_capacity = 0;
+
+#if defined(_WIN32)
+    HANDLE _M_file = INVALID_HANDLE_VALUE;
+    HANDLE _M_mapping = nullptr;
+#else
+    int _M_file = -1;
+#endif
+};
+
+struct _JournalHeader
+{
+    char magic[4];
+
+    std::uint16_t version;
+    std::uint16_t reserved;
+
+    std::int64_t wallClock;
+};
+
+static_assert(sizeof(_JournalHeader) == 16);
+
+struct _RecordHeader
+{
+    /// Including this header.
+    std::uint32_t size;
+
+    std::uint16_t op;
+    std::uint8_t kind;
+    std::uint8_t count;
+
+    std::uint64_t time;
+    std::uint64_t handle;
+};
+
+static_assert(sizeof(_RecordHeader) == 24);
+
+static constexpr char _S_magic[4] = { 'O', 'W', 'J', '1' };
+static constexpr std::uint16_t _S_version = 1;
+
+/**
+ * @note  Never destroyed, windows may be changed during shutdown.
+ */
+struct _JournalWriter
+{
+    /// Guards everything below.
+    std::mutex mutex;
+
+    _MappedFile file;
+
+    std::chrono::steady_clock::time_point epoch;
+
+    [[nodiscard]] static _JournalWriter& instance() noexcept
+    {
+        static _JournalWriter* const _S_writer = new _JournalWriter;
+        return *_S_writer;
+    }
+};
+
+static void _S_putVarint(std::string& __buffer, std::uint64_t __value)
+{
+    while (__value >= 0x80)
+    {
+        __buffer += static_cast<char>((__value & 0x7f) | 0x80);
+        __value >>= 7;
+    }
+
+    __buffer += static_cast<char>(__value);
+}
+
+static void _S_putZigzag(std::string& __buffer, std::int64_t __value)
+{
+    _S_putVarint(__buffer,
+        (static_cast<std::uint64_t>(__value) << 1) ^ static_cast<std::uint64_t>(__value >> 63));
+}
+
+/**
+ * @return false if __data ends before the varint does.
+ */
+static bool _S_getVarint(std::string_view& __data, std::uint64_t& __value) noexcept
+{
+    __value = 0;
+
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+        if (__data.empty())
+        {
+            return false;
+        }
+
+        const auto byte = static_cast<unsigned char>(__data.front());
+        __data.remove_prefix(1);
+
+        __value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool _S_getZigzag(std::string_view& __data, std::int64_t& __value) noexcept
+{
+    std::uint64_t value;
+
+    if (not _S_getVarint(__data, value))
+    {
+        return false;
+    }
+
+    __value = static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    return true;
+}
+
+/**
+ * @brief Appends the record encoded in the thread local buffer, whose first
+ *        bytes are left for the header.
+ */
+static void _S_append(
+    Journal::Op __op,
+    Journal::Kind __kind,
+    Win::Handle __handle,
+    std::size_t __count,
+    const std::string& __buffer) noexcept
+{
+    _JournalWriter& writer = _JournalWriter::instance();
+
+    std::lock_guard<std::mutex> _L_guard(writer.mutex);
+
+    if (not writer.file.isOpen() || __buffer.size() > std::numeric_limits<std::uint32_t>::max())
+    {
+        return;
+    }
+
+    /// Taken under the lock, so that the times grow with the file.
+    const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - writer.epoch);
+
+    _RecordHeader header;
+
+    header.size = static_cast<std::uint32_t>(__buffer.size());
+    header.op = static_cast<std::uint16_t>(__op);
+    header.kind = static_cast<std::uint8_t>(__kind);
+    header.count = static_cast<std::uint8_t>(__count);
+    header.time = static_cast<std::uint64_t>(time.count());
+    header.handle = reinterpret_cast<std::uintptr_t>(__handle);
+
+    char* const data = writer.file.append(__buffer.size());
+
+    if (data == nullptr)
+    {
+        return;
+    }
+
+    std::memcpy(data, &header, sizeof(header));
+    std::memcpy(data + sizeof(header), __buffer.data() + sizeof(header), __buffer.size() - sizeof(header));
+}
+
+[[nodiscard]] static std::string& _S_localBuffer() noexcept
+{
+    thread_local std::string _S_buffer;
+
+    _S_buffer.assign(sizeof(_RecordHeader), '\0');
+    return _S_buffer;
+}
+
+bool Journal::start(const std::string& __path)
+{
+    stop();
+
+    _JournalWriter& writer = _JournalWriter::instance();
+
+    std::lock_guard<std::mutex> _L_guard(writer.mutex);
+
+    if (not writer.file.open(__path))
+    {
+        return false;
+    }
+
+    writer.epoch = std::chrono::steady_clock::now();
+
+    _JournalHeader header;
+
+    std::memcpy(header.magic, _S_magic, sizeof(_S_magic));
+
+    header.version = _S_version;
+    header.reserved = 0;
+    header.wallClock = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    std::memcpy(writer.file.append(sizeof(header)), &header, sizeof(header));
+
+    _S_active.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+void Journal::stop()
+{
+    _JournalWriter& writer = _JournalWriter::instance();
+
+    std::lock_guard<std::mutex> _L_guard(writer.mutex);
+
+    _S_active.store(false, std::memory_order_relaxed);
+
+    writer.file.close();
+}
+
+void Journal::flush()
+{
+    _JournalWriter& writer = _JournalWriter::instance();
+
+    std::lock_guard<std::mutex> _L_guard(writer.mutex);
+
+    writer.file.flush();
+}
+
+void Journal::record(Op __op, Win::Handle __handle, std::initializer_list<std::int64_t> __args) noexcept
+{
+    try
+    {
+        std::string& buffer = _S_localBuffer();
+
+        const std::size_t count = std::min(__args.size(), maxArgs);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            _S_putZigzag(buffer, __args.begin()[i]);
+        }
+
+        _S_append(__op, Kind::Numbers, __handle, count, buffer);
+    }
+    catch (...)
+    {
+        /// Out of memory, the record is lost.
+    }
+}
+
+void Journal::record(Op __op, Win::Handle __handle, std::string_view __text) noexcept
+{
+    try
+    {
+        std::string& buffer = _S_localBuffer();
+
+        _S_putVarint(buffer, __text.size());
+        buffer += __text;
+
+        _S_append(__op, Kind::Text, __handle, 0, buffer);
+    }
+    catch (...)
+    { }
+}
+
+void Journal::record(Op __op, Win::Handle __handle, std::wstring_view __text) noexcept
+{
+    try
+    {
+        std::string& buffer = _S_localBuffer();
+
+        _S_putVarint(buffer, __text.size());
+
+        for (wchar_t c : __text)
+        {
+            _S_putVarint(buffer, static_cast<std::uint32_t>(c));
+        }
+
+        _S_append(__op, Kind::WideText, __handle, 0, buffer);
+    }
+    catch (...)
+    { }
+}
+
+std::vector<Journal::Record> Journal::read(std::istream& __is)
+{
+    std::vector<Record> records;
+
+    _JournalHeader header;
+
+    if (not __is.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || std::memcmp(header.magic, _S_magic, sizeof(_S_magic)) != 0
+        || header.version != _S_version)
+    {
+        return records;
+    }
+
+    std::string payload;
+
+    for (;;)
+    {
+        _RecordHeader recordHeader;
+
+        if (not __is.read(reinterpret_cast<char*>(&recordHeader), sizeof(recordHeader))
+            || recordHeader.size < sizeof(recordHeader))
+        {
+            break;
+        }
+
+        payload.resize(recordHeader.size - sizeof(recordHeader));
+
+        if (not __is.read(payload.data(), static_cast<std::streamsize>(payload.size())))
+        {
+            break;
+        }
+
+        Record record;
+
+        record.op = static_cast<Op>(recordHeader.op);
+        record.kind = static_cast<Kind>(recordHeader.kind);
+        record.time = std::chrono::nanoseconds(static_cast<std::int64_t>(recordHeader.time));
+        record.handle = reinterpret_cast<Win::Handle>(static_cast<std::uintptr_t>(recordHeader.handle));
+
+        std::string_view data(payload);
+        bool complete = true;
+
+        switch (record.kind)
+        {
+        case Kind::Numbers:
+        {
+            record.count = static_cast<std::uint8_t>(std::min<std::size_t>(recordHeader.count, maxArgs));
+
+            for (std::size_t i = 0; i < record.count && complete; ++i)
+            {
+                complete = _S_getZigzag(data, record.args[i]);
+            }
+            break;
+        }
+
+        case Kind::Text:
+        {
+            std::uint64_t size;
+            complete = _S_getVarint(data, size) && size <= data.size();
+
+            if (complete)
+            {
+                record.text.assign(data.substr(0, static_cast<std::size_t>(size)));
+            }
+            break;
+        }
+
+        case Kind::WideText:
+        {
+            std::uint64_t size;
+            complete = _S_getVarint(data, size) && size <= data.size();
+
+            if (complete)
+            {
+                record.wideText.reserve(static_cast<std::size_t>(size));
+
+                for (std::uint64_t i = 0; i < size && complete; ++i)
+                {
+                    std::uint64_t c;
+                    complete = _S_getVarint(data, c);
+
+                    record.wideText += static_cast<wchar_t>(c);
+                }
+            }
+            break;
+        }
+
+        default:
+            complete = false;
+            break;
+        }
+
+        if (not complete)
+        {
+            break;
+        }
+
+        records.push_back(std::move(record));
+    }
+
+    return records;
+}
+
+const char* Journal::name(Op __op) noexcept
+{
+    switch (__op)
+    {
+    case Op::SetEnable:              return "setEnable";
+    case Op::SetActive:              return "setActive";
+    case Op::SetForeground:          return "setForeground";
+    case Op::LockSetForeground:      return "lockSetForeground";
+    case Op::UnlockSetForeground:    return "unlockSetForeground";
+    case Op::SetFocus:               return "setFocus";
+    case Op::SetCapture:             return "setCapture";
+    case Op::SetParent:              return "setParent";
+    case Op::SetTile:                return "setTile";
+    case Op::SetTileIn:              return "setTile";
+    case Op::SetZOrderTop:           return "setZOrderTop";
+    case Op::SetZOrderBottom:        return "setZOrderBottom";
+    case Op::SetTopmost:             return "setTopmost";
+    case Op::AddStyle:               return "_M_addStyle";
+    case Op::DelStyle:               return "_M_delStyle";
+    case Op::AddExtendStyle:         return "_M_addExtendStyle";
+    case Op::DelExtendStyle:         return "_M_delExtendStyle";
+    case Op::Show:                   return "show";
+    case Op::Hide:                   return "hide";
+    case Op::ShowPopups:             return "showPopups";
+    case Op::HidePopups:             return "hidePopups";
+    case Op::SetDisplayProtection:   return "setDisplayProtection";
+    case Op::Maximize:               return "maximize";
+    case Op::Minimize:               return "minimize";
+    case Op::Restore:                return "restore";
+    case Op::SetTitleA:              return "setTitle";
+    case Op::SetTitleW:              return "setTitle";
+    case Op::SetRect:                return "setRect";
+    case Op::SetPos:                 return "setPos";
+    case Op::SetSize:                return "setSize";
+    case Op::SetWidth:               return "setWidth";
+    case Op::SetHeight:              return "setHeight";
+    case Op::SetOpacity:             return "setOpacity";
+    case Op::AnimationFrame:         return "animateTo";
+    case Op::SetTransparencyColor:   return "setTransparencyColor";
+    case Op::SetTitlebarButtons:     return "setTitlebarButtons";
+    case Op::SetAcceptFiles:         return "setAcceptFiles";
+    case Op::Flash:                  return "flash";
+    case Op::FlashCount:             return "flash";
+    case Op::FlashUntilIsForeground: return "flash";
+    case Op::LockUpdate:             return "lockUpdate";
+    case Op::UnlockUpdate:           return "unlockUpdate";
+    case Op::Close:                  return "close";
+    case Op::Destroy:                return "destroy";
+    case Op::KillThread:             return "killThread";
+    case Op::KillProcess:            return "killProcess";
+    case Op::SendMessageA:           return "_M_sendMessageA";
+    case Op::SendMessageW:           return "_M_sendMessageW";
+    case Op::PostChar:               return "post";
+    case Op::PostWideChar:           return "post";
+    case Op::PostKey:                return "post";
+    case Op::SetShortcut:            return "setShortcut";
+    }
+
+    return "unknown";
+}
+
+FramePacer::Clock::duration JournalReplayer::replay(Speed __speed, FramePacer::TimeSource& __source) const
+{
+    const FramePacer::Clock::time_point begin = __source.now();
+
+    for (const Journal::Record& record : _M_records)
+    {
+        if (__speed == OriginalSpeed)
+        {
+            const FramePacer::Clock::time_point deadline = begin +
+                std::chrono::duration_cast<FramePacer::Clock::duration>(record.time - _M_records.front().time);
+
+            if (__source.now() < deadline)
+            {
+                __source.sleepUntil(deadline);
+            }
+        }
+
+        apply(record, _M_resolver ? _M_resolver(record.handle) : Win(record.handle), _M_resolver);
+    }
+
+    return __source.now() - begin;
+}
+
+/**
+ * @brief Opens the protected calls of Win that are journaled.
+ */
+struct _JournaledWin : Win
+{
+    using Win::Win;
+
+    using Win::_M_addStyle;
+    using Win::_M_delStyle;
+    using Win::_M_addExtendStyle;
+    using Win::_M_delExtendStyle;
+
+    using Win::_M_sendMessageA;
+    using Win::_M_sendMessageW;
+};
+
+void JournalReplayer::apply(const Journal::Record& __record, const Win& __win, const Resolver& __resolver)
+{
+    using Op = Journal::Op;
+
+    const _JournaledWin win(__win.handle());
+
+    const auto arg = [&__record](std::size_t __index) noexcept -> std::int64_t
+    { return __record.arg(__index); };
+
+    const auto number = [&arg](std::size_t __index) noexcept -> int
+    { return static_cast<int>(arg(__index)); };
+
+    switch (__record.op)
+    {
+    case Op::SetEnable:            win.setEnable(arg(0)); break;
+    case Op::SetActive:            win.setActive(); break;
+    case Op::SetForeground:        win.setForeground(arg(0)); break;
+    case Op::LockSetForeground:    Win::lockSetForeground(); break;
+    case Op::UnlockSetForeground:  Win::unlockSetForeground(); break;
+    case Op::SetFocus:             win.setFocus(); break;
+    case Op::SetCapture:           win.setCapture(arg(0)); break;
+
+    case Op::SetParent:
+    {
+        const auto parent = reinterpret_cast<Win::Handle>(static_cast<std::uintptr_t>(arg(0)));
+
+        if (parent == nullptr)
+        {
+            win.setParent(nullptr);
+        }
+        else
+        {
+            win.setParent(__resolver ? __resolver(parent) : Win(parent));
+        }
+        break;
+    }
+
+    case Op::SetTile:
+        void (win.setTile(static_cast<Win::Orientation>(arg(0))));
+        break;
+
+    case Op::SetTileIn:
+        void (win.setTile(static_cast<Win::Orientation>(arg(0)), Rect(number(1), number(2), number(3), number(4))));
+        break;
+
+    case Op::SetZOrderTop:         win.setZOrderTop(); break;
+    case Op::SetZOrderBottom:      win.setZOrderBottom(); break;
+    case Op::SetTopmost:           win.setTopmost(arg(0)); break;
+
+    case Op::AddStyle:             win._M_addStyle(static_cast<std::int32_t>(arg(0))); break;
+    case Op::DelStyle:             win._M_delStyle(static_cast<std::int32_t>(arg(0))); break;
+    case Op::AddExtendStyle:       win._M_addExtendStyle(static_cast<std::int32_t>(arg(0))); break;
+    case Op::DelExtendStyle:       win._M_delExtendStyle(static_cast<std::int32_t>(arg(0))); break;
+
+    case Op::Show:                 win.show(); break;
+    case Op::Hide:                 win.hide(); break;
+    case Op::ShowPopups:           win.showPopups(); break;
+    case Op::HidePopups:           win.hidePopups(); break;
+    case Op::SetDisplayProtection: win.setDisplayProtection(arg(0)); break;
+    case Op::Maximize:             win.maximize(); break;
+    case Op::Minimize:             win.minimize(); break;
+    case Op::Restore:              win.restore(); break;
+
+    case Op::SetTitleA:            win.setTitle(__record.text); break;
+    case Op::SetTitleW:            win.setTitle(__record.wideText); break;
+
+    case Op::SetRect:              win.setRect(Rect(number(0), number(1), number(2), number(3))); break;
+    case Op::SetPos:               win.setPos(Point(number(0), number(1))); break;
+    case Op::SetSize:              win.setSize(Size(number(0), number(1))); break;
+    case Op::SetWidth:             win.setWidth(number(0)); break;
+    case Op::SetHeight:            win.setHeight(number(0)); break;
+    case Op::SetOpacity:           win.setOpacity(number(0)); break;
+
+    case Op::AnimationFrame:
+    {
+        /// Goes to the frame in one step.
+        win.animateTo(
+            Rect(number(0), number(1), number(2), number(3)),
+            number(4),
+            pg::Linear<Win::AnimationValue>(std::numeric_limits<float>::max()));
+        break;
+    }
+
+    case Op::SetTransparencyColor:
+        win.setTransparencyColor(Color(
+            static_cast<Color::Channel>(arg(0)),
+            static_cast<Color::Channel>(arg(1)),
+            static_cast<Color::Channel>(arg(2))));
+        break;
+
+    case Op::SetTitlebarButtons:
+        win.setTitlebarButtons(static_cast<Win::TitlebarButtons>(arg(0)), arg(1));
+        break;
+
+    case Op::SetAcceptFiles:       win.setAcceptFiles(arg(0)); break;
+
+    case Op::Flash:                win.flash(static_cast<bool>(arg(0))); break;
+
+    case Op::FlashCount:
+        win.flash(number(0), static_cast<Win::Timeout>(arg(1)), arg(2));
+        break;
+
+    case Op::FlashUntilIsForeground:
+        win.flash(Win::UntilIsForeground, static_cast<Win::Timeout>(arg(0)), arg(1));
+        break;
+
+    case Op::LockUpdate:           win.lockUpdate(); break;
+    case Op::UnlockUpdate:         Win::unlockUpdate(); break;
+
+    case Op::Close:                win.close(static_cast<Win::Timeout>(arg(0))); break;
+    case Op::Destroy:              win.destroy(); break;
+    case Op::KillThread:
+        /// Replays what was called, deprecated or not.
+#if defined(_MSC_VER)
+#   pragma warning(push)
+#   pragma warning(disable: 4996)
+#elif defined(__GNUC__) or defined(__clang__)
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+        win.killThread(number(0));
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#elif defined(__GNUC__) or defined(__clang__)
+#   pragma GCC diagnostic pop
+#endif
+        break;
+
+    case Op::KillProcess:          win.killProcess(number(0)); break;
+
+    case Op::SendMessageA:
+        /// The address it pointed to is gone.
+        if (arg(4))
+        {
+            break;
+        }
+
+        win._M_sendMessageA(
+            static_cast<Win::Message::msg_type>(arg(0)),
+            static_cast<Win::Message::wparam_type>(arg(1)),
+            static_cast<Win::Message::lparam_type>(arg(2)),
+            static_cast<Win::Timeout>(arg(3)));
+        break;
+
+    case Op::SendMessageW:
+        /// The address it pointed to is gone.
+        if (arg(4))
+        {
+            break;
+        }
+
+        win._M_sendMessageW(
+            static_cast<Win::Message::msg_type>(arg(0)),
+            static_cast<Win::Message::wparam_type>(arg(1)),
+            static_cast<Win::Message::lparam_type>(arg(2)),
+            static_cast<Win::Timeout>(arg(3)));
+        break;
+
+    case Op::PostChar:             win.post(static_cast<char>(arg(0))); break;
+    case Op::PostWideChar:         win.post(static_cast<wchar_t>(arg(0))); break;
+
+    case Op::PostKey:
+        win.post(static_cast<Key>(arg(0)), static_cast<Win::KeyAction>(arg(1)));
+        break;
+
+    case Op::SetShortcut:
+        win.setShortcut(Shortcut(static_cast<Modifiers>(arg(0)), static_cast<Key>(arg(1))), arg(2));
+        break;
+    }
+}
\ No newline at end of file
@@ -624,7 +624,7 @@ Painter::GeometricPen::GeometricPen(
 
 template<
     std::size_t _Size,
-    std::enable_if_t<tools::is_within_range(_Size, 1ULL, 16ULL), int>>
+    std::enable_if_t<tools::is_within_range<std::size_t>(_Size, 1, 16), int>>
 Painter::GeometricPen::GeometricPen(
         const std::array<std::uint32_t, _Size>& __custom,
         std::uint32_t __width,
@@ -0,0 +1,281 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* Profiler.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 14:20:50
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Implement Profiler.h
+*/
+
+#include <openWin/Profiler.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+using namespace win;
+
+std::size_t LatencyHistogram::bucketOf(std::uint64_t __nanoseconds) noexcept
+{
+    if (__nanoseconds < subBucketCount)
+    {
+        return static_cast<std::size_t>(__nanoseconds);
+    }
+
+    const std::size_t exponent = std::bit_width(__nanoseconds) - 1;
+
+    if (exponent >= maxExponent)
+    {
+        return bucketCount - 1;
+    }
+
+    const std::size_t sub = (__nanoseconds >> (exponent - subBucketBits)) & (subBucketCount - 1);
+
+    return (exponent - subBucketBits + 1) * subBucketCount + sub;
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(std::size_t __bucket) noexcept
+{
+    if (__bucket < subBucketCount)
+    {
+        return __bucket;
+    }
+
+    const std::size_t exponent = __bucket / subBucketCount + subBucketBits - 1;
+    const std::uint64_t sub = __bucket % subBucketCount;
+
+    const std::uint64_t width = std::uint64_t(1) << (exponent - subBucketBits);
+
+    return ((subBucketCount + sub) << (exponent - subBucketBits)) + width - 1;
+}
+
+void LatencyHistogram::record(std::uint64_t __nanoseconds) noexcept
+{
+    ++_M_buckets[bucketOf(__nanoseconds)];
+
+    ++_M_count;
+    _M_total += __nanoseconds;
+
+    _M_min = std::min(_M_min, __nanoseconds);
+    _M_max = std::max(_M_max, __nanoseconds);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& __other) noexcept
+{
+    for (std::size_t i = 0; i < bucketCount; ++i)
+    {
+        _M_buckets[i] += __other._M_buckets[i];
+    }
+
+    _M_count += __other._M_count;
+    _M_total += __other._M_total;
+
+    _M_min = std::min(_M_min, __other._M_min);
+    _M_max = std::max(_M_max, __other._M_max);
+}
+
+void LatencyHistogram::clear() noexcept
+{
+    *this = LatencyHistogram();
+}
+
+std::chrono::nanoseconds LatencyHistogram::percentile(double __percentile) const noexcept
+{
+    if (_M_count == 0)
+    {
+        return std::chrono::nanoseconds(0);
+    }
+
+    const double clamped = std::clamp(__percentile, 0.0, 100.0);
+
+    const std::uint64_t rank = std::max<std::uint64_t>(
+        static_cast<std::uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(_M_count))), 1);
+
+    std::uint64_t seen = 0;
+
+    for (std::size_t i = 0; i < bucketCount; ++i)
+    {
+        seen += _M_buckets[i];
+
+        if (seen >= rank)
+        {
+            return std::chrono::nanoseconds(std::min(bucketUpperBound(i), _M_max));
+        }
+    }
+
+    return std::chrono::nanoseconds(_M_max);
+}
+
+
+std::atomic<bool> Profiler::_S_enabled = false;
+
+using _ProfilerHistograms = std::unordered_map<CallSiteId, LatencyHistogram>;
+
+/**
+ * @brief The histograms of one thread. Only the owner thread records into it,
+ *        the spinlock is only contended while a snapshot or reset is taken.
+ */
+class _ProfilerShard
+{
+public:
+
+    _ProfilerShard();
+    ~_ProfilerShard();
+
+    _ProfilerShard(const _ProfilerShard&) = delete;
+    _ProfilerShard& operator=(const _ProfilerShard&) = delete;
+
+    void lock() noexcept
+    {
+        while (_M_flag.test_and_set(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void unlock() noexcept
+    {
+        _M_flag.clear(std::memory_order_release);
+    }
+
+    _ProfilerHistograms histograms;
+
+private:
+
+    std::atomic_flag _M_flag = ATOMIC_FLAG_INIT;
+};
+
+/**
+ * @brief All the live shards, and the histograms of the exited threads.
+ * 
+ * @note  Never destroyed, threads may exit during shutdown.
+ */
+struct _ProfilerRegistry
+{
+    std::mutex mutex;
+
+    std::vector<_ProfilerShard*> shards;
+    _ProfilerHistograms retired;
+
+    [[nodiscard]] static _ProfilerRegistry& instance() noexcept
+    {
+        static _ProfilerRegistry* const _S_registry = new _ProfilerRegistry;
+        return *_S_registry;
+    }
+};
+
+_ProfilerShard::_ProfilerShard()
+{
+    _ProfilerRegistry& registry = _ProfilerRegistry::instance();
+
+    std::lock_guard<std::mutex> _L_guard(registry.mutex);
+    registry.shards.push_back(this);
+}
+
+_ProfilerShard::~_ProfilerShard()
+{
+    _ProfilerRegistry& registry = _ProfilerRegistry::instance();
+
+    std::lock_guard<std::mutex> _L_guard(registry.mutex);
+
+    for (auto& [site, histogram] : histograms)
+    {
+        registry.retired[site].merge(histogram);
+    }
+
+    std::erase(registry.shards, this);
+}
+
+void Profiler::setEnabled(bool __enabled) noexcept
+{
+    _S_enabled.store(__enabled, std::memory_order_relaxed);
+}
+
+void Profiler::record(CallSiteId __site, std::chrono::nanoseconds __latency) noexcept
+{
+    thread_local _ProfilerShard _S_shard;
+
+    const auto latency = static_cast<std::uint64_t>(std::max<std::int64_t>(__latency.count(), 0));
+
+    _S_shard.lock();
+
+    try
+    {
+        _S_shard.histograms[__site].record(latency);
+    }
+    catch (...)
+    {
+        /// Out of memory, the call is not recorded.
+    }
+
+    _S_shard.unlock();
+}
+
+std::vector<Profiler::Entry> Profiler::snapshot()
+{
+    _ProfilerRegistry& registry = _ProfilerRegistry::instance();
+
+    _ProfilerHistograms merged;
+
+    {
+        std::lock_guard<std::mutex> _L_guard(registry.mutex);
+
+        merged = registry.retired;
+
+        for (_ProfilerShard* shard : registry.shards)
+        {
+            std::lock_guard<_ProfilerShard> _L_shardGuard(*shard);
+
+            for (auto& [site, histogram] : shard->histograms)
+            {
+                merged[site].merge(histogram);
+            }
+        }
+    }
+
+    std::vector<Entry> result;
+    result.reserve(merged.size());
+
+    for (auto& [site, histogram] : merged)
+    {
+        if (histogram.count())
+        {
+            result.push_back({ site, CallSite::name(site), histogram });
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](const Entry& __lhs, const Entry& __rhs) {
+        return __lhs.latency.total() > __rhs.latency.total();
+    });
+
+    return result;
+}
+
+void Profiler::reset()
+{
+    _ProfilerRegistry& registry = _ProfilerRegistry::instance();
+
+    std::lock_guard<std::mutex> _L_guard(registry.mutex);
+
+    registry.retired.clear();
+
+    for (_ProfilerShard* shard : registry.shards)
+    {
+        std::lock_guard<_ProfilerShard> _L_shardGuard(*shard);
+
+        for (auto& [site, histogram] : shard->histograms)
+        {
+            histogram.clear();
+        }
+    }
+}
\ No newline at end of file
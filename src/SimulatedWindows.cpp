@@ -0,0 +1,3538 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* SimulatedWindows.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 23:48:19
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Implement the functions declared by Built-in/_SimulatedWindows.h on
+*        sim::WindowServer::current(), for the builds with OPENWIN_SIMULATED_BACKEND.
+*/
+
+#if defined(OPENWIN_SIMULATED_BACKEND)
+
+#include "Built-in/_Windows.h"
+
+#include <openWin/sim/WindowServer.h>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <optional>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <utility>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <cstddef>
+
+using namespace win;
+using namespace win::sim;
+
+using _Window = WindowServer::Window;
+
+/**
+ * @brief Declares the server as `server`, counts the call under the name of
+ *        the function and spins out its latency.
+ */
+#define _Sim_Begin_ \
+    static const std::size_t _S_callId = WindowServer::callId(__func__); \
+    WindowServer& server = WindowServer::current(); \
+    server.enter(_S_callId);
+
+static thread_local DWORD _S_lastError = ERROR_SUCCESS;
+
+/// Not a window of the server, only its top-level windows are its children.
+static const HWND _S_desktop = reinterpret_cast<HWND>(0x10000);
+
+/// OpenProcess() and OpenThread() return the ID with a tag.
+static constexpr std::uintptr_t _S_processTag = 0x10000000;
+static constexpr std::uintptr_t _S_threadTag = 0x20000000;
+
+static const HMODULE _S_user32 = reinterpret_cast<HMODULE>(0x7ff00000);
+
+static WindowServer::Handle _S_handle(HWND __hwnd) noexcept
+{
+    return __hwnd == _S_desktop ? nullptr : reinterpret_cast<WindowServer::Handle>(__hwnd);
+}
+
+static HWND _S_hwnd(WindowServer::Handle __handle) noexcept
+{
+    return reinterpret_cast<HWND>(__handle);
+}
+
+/**
+ * @brief The fields of a window but its texts and procedure, so that reading
+ *        a window does not allocate.
+ */
+struct _State
+{
+    explicit _State(const _Window& __w) noexcept
+        : handle(__w.handle), parent(__w.parent), owner(__w.owner)
+        , rect(__w.rect), normalRect(__w.normalRect)
+        , style(__w.style), exStyle(__w.exStyle)
+        , alpha(__w.alpha), colorKey(__w.colorKey), layeredFlags(__w.layeredFlags)
+        , displayAffinity(__w.displayAffinity), dpi(__w.dpi)
+        , threadId(__w.threadId), processId(__w.processId)
+        , unicode(__w.unicode), hung(__w.hung), closeEnabled(__w.closeEnabled)
+    { }
+
+    WindowServer::Handle handle;
+    WindowServer::Handle parent;
+    WindowServer::Handle owner;
+
+    Rect rect;
+    Rect normalRect;
+
+    std::uint32_t style;
+    std::uint32_t exStyle;
+
+    std::uint8_t alpha;
+    std::uint32_t colorKey;
+    std::uint32_t layeredFlags;
+
+    std::uint32_t displayAffinity;
+    std::uint32_t dpi;
+
+    WindowServer::ThreadId threadId;
+    WindowServer::ProcessId processId;
+
+    bool unicode;
+    bool hung;
+    bool closeEnabled;
+
+    [[nodiscard]] bool visible() const noexcept
+    { return style & WindowServer::visibleStyle; }
+};
+
+static std::optional<_State> _S_state(const WindowServer& __server, WindowServer::Handle __handle)
+{
+    return __server.with(__handle, [](const _Window& __w) { return _State(__w); });
+}
+
+/**
+ * @brief Calls the function with the window under the lock of the server,
+ *        sets ERROR_INVALID_WINDOW_HANDLE if there is no such window.
+ */
+template<typename _Func>
+static auto _S_with(WindowServer& __server, HWND __hwnd, _Func&& __func)
+{
+    auto result = __server.with(__hwnd == _S_desktop ? nullptr : _S_handle(__hwnd), std::forward<_Func>(__func));
+
+    if (not result)
+    {
+        _S_lastError = ERROR_INVALID_WINDOW_HANDLE;
+    }
+
+    return result;
+}
+
+static std::optional<_State> _S_window(WindowServer& __server, HWND __hwnd)
+{
+    return _S_with(__server, __hwnd, [](const _Window& __w) { return _State(__w); });
+}
+
+/// Whether the window exists, sets ERROR_INVALID_WINDOW_HANDLE if not.
+static bool _S_exists(WindowServer& __server, HWND __hwnd)
+{
+    if (__hwnd && __hwnd != _S_desktop && __server.contains(_S_handle(__hwnd)))
+    {
+        return true;
+    }
+
+    _S_lastError = ERROR_INVALID_WINDOW_HANDLE;
+    return false;
+}
+
+static RECT _S_rect(const Rect& __rect) noexcept
+{
+    return RECT{ __rect.x(), __rect.y(), __rect.x() + __rect.w(), __rect.y() + __rect.h() };
+}
+
+static Rect _S_rect(const RECT& __rect) noexcept
+{
+    return Rect(
+        std::min(__rect.left, __rect.right),
+        std::min(__rect.top, __rect.bottom),
+        std::abs(__rect.right - __rect.left),
+        std::abs(__rect.bottom - __rect.top));
+}
+
+static DWORD _S_tickCount() noexcept
+{
+    return static_cast<DWORD>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        WindowServer::Clock::now().time_since_epoch()).count());
+}
+
+/// The code page of the narrow strings is Latin-1.
+
+static std::wstring _S_widen(std::string_view __text)
+{
+    std::wstring result(__text.size(), L'\0');
+    std::transform(__text.begin(), __text.end(), result.begin(), [](char __c) {
+        return static_cast<wchar_t>(static_cast<unsigned char>(__c));
+    });
+
+    return result;
+}
+
+static std::string _S_narrow(std::wstring_view __text)
+{
+    std::string result(__text.size(), '\0');
+    std::transform(__text.begin(), __text.end(), result.begin(), [](wchar_t __c) {
+        return __c <= 0xff ? static_cast<char>(__c) : '?';
+    });
+
+    return result;
+}
+
+/**
+ * @brief Copies as much of the text as fits with the terminating null.
+ * 
+ * @return The number of characters copied, without the null.
+ */
+template<typename _Char>
+static int _S_copy(std::basic_string_view<_Char> __text, _Char* __buffer, int __size) noexcept
+{
+    if (__buffer == nullptr || __size <= 0)
+    {
+        return 0;
+    }
+
+    const std::size_t length = std::min<std::size_t>(__text.size(), static_cast<std::size_t>(__size) - 1);
+
+    std::copy_n(__text.data(), length, __buffer);
+    __buffer[length] = _Char();
+
+    return static_cast<int>(length);
+}
+
+/// Walks up the parents, and the owners too if __owners is set.
+static WindowServer::Handle _S_root(WindowServer& __server, WindowServer::Handle __handle, bool __owners)
+{
+    for (std::optional<_State> w = _S_state(__server, __handle); w; w = _S_state(__server, __handle))
+    {
+        const WindowServer::Handle up = w->parent ? w->parent : (__owners ? w->owner : nullptr);
+
+        if (up == nullptr)
+        {
+            break;
+        }
+
+        __handle = up;
+    }
+
+    return __handle;
+}
+
+/* ================== kernel ================== */
+
+DWORD GetLastError()
+{
+    return _S_lastError;
+}
+
+void SetLastError(DWORD __code)
+{
+    _S_lastError = __code;
+}
+
+DWORD GetCurrentThreadId()
+{
+    _Sim_Begin_
+    return server.currentThread();
+}
+
+DWORD GetCurrentProcessId()
+{
+    _Sim_Begin_
+    return server.currentProcess();
+}
+
+HANDLE OpenProcess(DWORD, BOOL, DWORD __processId)
+{
+    _Sim_Begin_
+
+    if (not server.processPath(__processId))
+    {
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return nullptr;
+    }
+
+    return reinterpret_cast<HANDLE>(_S_processTag | __processId);
+}
+
+HANDLE OpenThread(DWORD, BOOL, DWORD __threadId)
+{
+    _Sim_Begin_
+
+    if (not server.processOf(__threadId))
+    {
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return nullptr;
+    }
+
+    return reinterpret_cast<HANDLE>(_S_threadTag | __threadId);
+}
+
+static std::optional<DWORD> _S_id(HANDLE __handle, std::uintptr_t __tag) noexcept
+{
+    constexpr std::uintptr_t mask = _S_processTag - 1;
+
+    const std::uintptr_t value = reinterpret_cast<std::uintptr_t>(__handle);
+
+    if ((value & ~mask) != __tag)
+    {
+        _S_lastError = ERROR_INVALID_HANDLE;
+        return std::nullopt;
+    }
+
+    return static_cast<DWORD>(value & mask);
+}
+
+BOOL TerminateProcess(HANDLE __process, UINT)
+{
+    _Sim_Begin_
+
+    std::optional<DWORD> id = _S_id(__process, _S_processTag);
+    return id && server.terminateProcess(*id);
+}
+
+BOOL TerminateThread(HANDLE __handle, DWORD)
+{
+    _Sim_Begin_
+
+    std::optional<DWORD> id = _S_id(__handle, _S_threadTag);
+    return id && server.terminateThread(*id);
+}
+
+BOOL CloseHandle(HANDLE __handle)
+{
+    _Sim_Begin_
+
+    if (__handle == nullptr)
+    {
+        _S_lastError = ERROR_INVALID_HANDLE;
+        return false;
+    }
+
+    return true;
+}
+
+template<typename _Char>
+static DWORD _S_moduleFileName(WindowServer& __server, HANDLE __process, _Char* __buffer, DWORD __size)
+{
+    std::optional<DWORD> id = _S_id(__process, _S_processTag);
+    std::optional<std::wstring> path = id ? __server.processPath(*id) : std::nullopt;
+
+    if (not path)
+    {
+        _S_lastError = ERROR_INVALID_HANDLE;
+        return 0;
+    }
+
+    if constexpr (std::is_same_v<_Char, char>)
+    {
+        return _S_copy<char>(_S_narrow(*path), __buffer, static_cast<int>(__size));
+    }
+    else
+    {
+        return _S_copy<wchar_t>(*path, __buffer, static_cast<int>(__size));
+    }
+}
+
+DWORD GetModuleFileNameExA(HANDLE __process, HMODULE, LPSTR __buffer, DWORD __size)
+{
+    _Sim_Begin_
+    return _S_moduleFileName(server, __process, __buffer, __size);
+}
+
+DWORD GetModuleFileNameExW(HANDLE __process, HMODULE, LPWSTR __buffer, DWORD __size)
+{
+    _Sim_Begin_
+    return _S_moduleFileName(server, __process, __buffer, __size);
+}
+
+/// Windows 11 24H2, false for every simulated window.
+static BOOL WINAPI _S_isWindowArranged(HWND)
+{
+    return false;
+}
+
+HMODULE LoadLibraryA(LPCSTR __name)
+{
+    _Sim_Begin_
+
+    std::string name(__name ? __name : "");
+    std::transform(name.begin(), name.end(), name.begin(), [](char __c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(__c))); });
+
+    if (name == "user32.dll" || name == "user32")
+    {
+        return _S_user32;
+    }
+
+    _S_lastError = ERROR_MOD_NOT_FOUND;
+    return nullptr;
+}
+
+FARPROC GetProcAddress(HMODULE __module, LPCSTR __name)
+{
+    _Sim_Begin_
+
+    if (__module != _S_user32)
+    {
+        _S_lastError = ERROR_MOD_NOT_FOUND;
+        return nullptr;
+    }
+
+    /// The names are case-sensitive.
+    if (__name && std::strcmp(__name, "IsWindowArranged") == 0)
+    {
+        return reinterpret_cast<FARPROC>(reinterpret_cast<void*>(&_S_isWindowArranged));
+    }
+
+    _S_lastError = ERROR_PROC_NOT_FOUND;
+    return nullptr;
+}
+
+BOOL FreeLibrary(HMODULE __module)
+{
+    _Sim_Begin_
+
+    if (__module != _S_user32)
+    {
+        _S_lastError = ERROR_INVALID_HANDLE;
+        return false;
+    }
+
+    return true;
+}
+
+/// There are no waitable timers, FramePacer sleeps instead.
+
+HANDLE CreateWaitableTimerExW(void*, LPCWSTR, DWORD, DWORD)
+{
+    _Sim_Begin_
+
+    _S_lastError = ERROR_NOT_SUPPORTED;
+    return nullptr;
+}
+
+BOOL SetWaitableTimerEx(HANDLE, const LARGE_INTEGER*, LONG, void*, void*, void*, ULONG)
+{
+    _Sim_Begin_
+
+    _S_lastError = ERROR_INVALID_HANDLE;
+    return false;
+}
+
+DWORD WaitForSingleObject(HANDLE, DWORD)
+{
+    _Sim_Begin_
+
+    _S_lastError = ERROR_INVALID_HANDLE;
+    return 0xFFFFFFFF;
+}
+
+DWORD FormatMessageA(DWORD __flags, const void*, DWORD __code, DWORD, LPSTR __buffer, DWORD __size, void*)
+{
+    _Sim_Begin_
+
+    static const std::unordered_map<DWORD, std::string_view> _S_texts = {
+        { ERROR_SUCCESS,                   "The operation completed successfully." },
+        { ERROR_ACCESS_DENIED,             "Access is denied." },
+        { ERROR_INVALID_HANDLE,            "The handle is invalid." },
+        { ERROR_NOT_SUPPORTED,             "The request is not supported." },
+        { ERROR_INVALID_PARAMETER,         "The parameter is incorrect." },
+        { ERROR_MOD_NOT_FOUND,             "The specified module could not be found." },
+        { ERROR_PROC_NOT_FOUND,            "The specified procedure could not be found." },
+        { ERROR_INVALID_WINDOW_HANDLE,     "Invalid window handle." },
+        { ERROR_HOTKEY_ALREADY_REGISTERED, "Hot key is already registered." },
+        { ERROR_INVALID_INDEX,             "Invalid index." },
+        { ERROR_HOTKEY_NOT_REGISTERED,     "Hot key is not registered." },
+        { ERROR_INVALID_THREAD_ID,         "Invalid thread identifier." },
+        { ERROR_TIMEOUT,                   "This operation returned because the timeout period expired." }
+    };
+
+    auto it = _S_texts.find(__code);
+
+    if (it == _S_texts.end())
+    {
+        _S_lastError = ERROR_MR_MID_NOT_FOUND;
+        return 0;
+    }
+
+    const std::string text = std::string(it->second) + "\r\n";
+
+    if (__flags & FORMAT_MESSAGE_ALLOCATE_BUFFER)
+    {
+        char* buffer = static_cast<char*>(std::malloc(text.size() + 1));
+        std::memcpy(buffer, text.c_str(), text.size() + 1);
+
+        *reinterpret_cast<char**>(__buffer) = buffer;
+        return static_cast<DWORD>(text.size());
+    }
+
+    return _S_copy<char>(text, __buffer, static_cast<int>(__size));
+}
+
+void* LocalFree(void* __memory)
+{
+    std::free(__memory);
+    return nullptr;
+}
+
+int WideCharToMultiByte(UINT, DWORD, LPCWSTR __wide, int __wideLength, LPSTR __buffer, int __size, LPCSTR, BOOL* __usedDefault)
+{
+    _Sim_Begin_
+
+    if (__wide == nullptr)
+    {
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return 0;
+    }
+
+    /// -1 converts the terminating null too.
+    const std::size_t length = __wideLength < 0 ? std::wcslen(__wide) + 1 : static_cast<std::size_t>(__wideLength);
+    const std::wstring_view wide(__wide, length);
+
+    if (__usedDefault)
+    {
+        *__usedDefault = std::any_of(wide.begin(), wide.end(), [](wchar_t __c) { return __c > 0xff; });
+    }
+
+    if (__size == 0)
+    {
+        return static_cast<int>(length);
+    }
+
+    const std::string narrow = _S_narrow(wide);
+    const std::size_t count = std::min<std::size_t>(narrow.size(), static_cast<std::size_t>(__size));
+
+    std::copy_n(narrow.data(), count, __buffer);
+    return static_cast<int>(count);
+}
+
+HWND GetConsoleWindow()
+{
+    _Sim_Begin_
+    return nullptr;
+}
+
+/* ================== windows ================== */
+
+BOOL IsWindow(HWND __hwnd)
+{
+    _Sim_Begin_
+    return __hwnd == _S_desktop || (__hwnd && server.contains(_S_handle(__hwnd)));
+}
+
+BOOL DestroyWindow(HWND __hwnd)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_window(server, __hwnd);
+
+    if (not w)
+    {
+        return false;
+    }
+
+    /// Only the thread of the window may destroy it.
+    if (w->threadId != server.currentThread())
+    {
+        _S_lastError = ERROR_ACCESS_DENIED;
+        return false;
+    }
+
+    return server.destroy(w->handle);
+}
+
+HWND WindowFromPoint(POINT __point)
+{
+    _Sim_Begin_
+    return _S_hwnd(server.windowAt(Point(__point.x, __point.y)));
+}
+
+static HWND _S_find(WindowServer& __server, const std::optional<std::wstring>& __className, const std::optional<std::wstring>& __title)
+{
+    return _S_hwnd(__server.find(__className ? &*__className : nullptr, __title ? &*__title : nullptr));
+}
+
+HWND FindWindowA(LPCSTR __className, LPCSTR __title)
+{
+    _Sim_Begin_
+
+    return _S_find(
+        server,
+        __className ? std::optional(_S_widen(__className)) : std::nullopt,
+        __title ? std::optional(_S_widen(__title)) : std::nullopt);
+}
+
+HWND FindWindowW(LPCWSTR __className, LPCWSTR __title)
+{
+    _Sim_Begin_
+
+    return _S_find(
+        server,
+        __className ? std::optional<std::wstring>(__className) : std::nullopt,
+        __title ? std::optional<std::wstring>(__title) : std::nullopt);
+}
+
+HWND GetForegroundWindow()
+{
+    _Sim_Begin_
+    return _S_hwnd(server.foreground());
+}
+
+HWND GetShellWindow()
+{
+    _Sim_Begin_
+    return nullptr;
+}
+
+HWND GetDesktopWindow()
+{
+    _Sim_Begin_
+    return _S_desktop;
+}
+
+HWND GetFocus()
+{
+    _Sim_Begin_
+    return _S_hwnd(server.input(server.currentThread()).focus);
+}
+
+HWND GetActiveWindow()
+{
+    _Sim_Begin_
+    return _S_hwnd(server.input(server.currentThread()).active);
+}
+
+HWND GetCapture()
+{
+    _Sim_Begin_
+    return _S_hwnd(server.input(server.currentThread()).capture);
+}
+
+BOOL GetGUIThreadInfo(DWORD __threadId, GUITHREADINFO* __info)
+{
+    _Sim_Begin_
+
+    if (__info == nullptr || __info->cbSize != sizeof(GUITHREADINFO))
+    {
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return false;
+    }
+
+    /// 0 for the thread of the foreground window.
+    if (__threadId == 0)
+    {
+        std::optional<_State> w = _S_state(server, server.foreground());
+        __threadId = w ? w->threadId : 0;
+    }
+
+    if (not server.processOf(__threadId))
+    {
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return false;
+    }
+
+    const WindowServer::Input input = server.input(__threadId);
+
+    *__info = GUITHREADINFO{};
+    __info->cbSize = sizeof(GUITHREADINFO);
+
+    __info->hwndActive = _S_hwnd(input.active);
+    __info->hwndFocus = _S_hwnd(input.focus);
+    __info->hwndCapture = _S_hwnd(input.capture);
+
+    return true;
+}
+
+BOOL SetForegroundWindow(HWND __hwnd)
+{
+    _Sim_Begin_
+    return server.setForeground(_S_handle(__hwnd));
+}
+
+BOOL LockSetForegroundWindow(UINT __lockCode)
+{
+    _Sim_Begin_
+
+    if (__lockCode != LSFW_LOCK && __lockCode != LSFW_UNLOCK)
+    {
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return false;
+    }
+
+    server.lockForeground(__lockCode == LSFW_LOCK);
+    return true;
+}
+
+/// Returns the previous window of the slot of the calling thread.
+template<typename _Set>
+static HWND _S_setInput(WindowServer& __server, HWND __hwnd, WindowServer::Handle WindowServer::Input::* __slot, _Set&& __set)
+{
+    const WindowServer::Handle previous = __server.input(__server.currentThread()).*__slot;
+
+    if (__hwnd && not _S_exists(__server, __hwnd))
+    {
+        return nullptr;
+    }
+
+    __set(_S_handle(__hwnd));
+    return _S_hwnd(previous);
+}
+
+HWND SetActiveWindow(HWND __hwnd)
+{
+    _Sim_Begin_
+    return _S_setInput(server, __hwnd, &WindowServer::Input::active, [&](WindowServer::Handle __h) { server.setActive(__h); });
+}
+
+HWND SetFocus(HWND __hwnd)
+{
+    _Sim_Begin_
+    return _S_setInput(server, __hwnd, &WindowServer::Input::focus, [&](WindowServer::Handle __h) { server.setFocus(__h); });
+}
+
+HWND SetCapture(HWND __hwnd)
+{
+    _Sim_Begin_
+    return _S_setInput(server, __hwnd, &WindowServer::Input::capture, [&](WindowServer::Handle __h) { server.setCapture(__h); });
+}
+
+BOOL ReleaseCapture()
+{
+    _Sim_Begin_
+
+    server.releaseCapture();
+    return true;
+}
+
+BOOL IsHungAppWindow(HWND __hwnd)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_state(server, _S_handle(__hwnd));
+    return w && w->hung;
+}
+
+BOOL EnableWindow(HWND __hwnd, BOOL __enable)
+{
+    _Sim_Begin_
+
+    bool wasDisabled = false;
+
+    server.update(_S_handle(__hwnd), [&](_Window& __w) {
+        wasDisabled = __w.style & WindowServer::disabledStyle;
+
+        if (__enable)
+        {
+            __w.style &= ~WindowServer::disabledStyle;
+        }
+        else
+        {
+            __w.style |= WindowServer::disabledStyle;
+        }
+    });
+
+    return wasDisabled;
+}
+
+BOOL IsWindowEnabled(HWND __hwnd)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_state(server, _S_handle(__hwnd));
+    return w && not (w->style & WindowServer::disabledStyle);
+}
+
+BOOL IsWindowUnicode(HWND __hwnd)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_state(server, _S_handle(__hwnd));
+    return w && w->unicode;
+}
+
+BOOL IsWindowVisible(HWND __hwnd)
+{
+    _Sim_Begin_
+
+    /// Visible only if all its parents are too.
+    for (std::optional<_State> w = _S_state(server, _S_handle(__hwnd)); w; w = _S_state(server, w->parent))
+    {
+        if (not w->visible())
+        {
+            return false;
+        }
+
+        if (w->parent == nullptr)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+BOOL IsZoomed(HWND __hwnd)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_state(server, _S_handle(__hwnd));
+    return w && (w->style & WindowServer::maximizedStyle);
+}
+
+BOOL IsIconic(HWND __hwnd)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_state(server, _S_handle(__hwnd));
+    return w && (w->style & WindowServer::minimizedStyle);
+}
+
+BOOL IsChild(HWND __parent, HWND __hwnd)
+{
+    _Sim_Begin_
+
+    for (std::optional<_State> w = _S_state(server, _S_handle(__hwnd)); w && w->parent; w = _S_state(server, w->parent))
+    {
+        if (w->parent == _S_handle(__parent))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+BOOL AnyPopup()
+{
+    _Sim_Begin_
+
+    for (WindowServer::Handle h : server.windows())
+    {
+        std::optional<_State> w = _S_state(server, h);
+
+        if (w && w->visible() && w->owner)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+UINT GetDpiForWindow(HWND __hwnd)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_window(server, __hwnd);
+
+    if (not w)
+    {
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return 0;
+    }
+
+    return w->dpi ? w->dpi : server.options().dpi;
+}
+
+UINT GetDpiForSystem()
+{
+    _Sim_Begin_
+    return server.options().dpi;
+}
+
+static std::optional<LONG> _S_getLong(WindowServer& __server, HWND __hwnd, int __index)
+{
+    std::optional<_State> w = _S_window(__server, __hwnd);
+
+    if (not w)
+    {
+        return std::nullopt;
+    }
+
+    switch (__index)
+    {
+    case GWL_STYLE:   return static_cast<LONG>(w->style);
+    case GWL_EXSTYLE: return static_cast<LONG>(w->exStyle);
+
+    default:
+        _S_lastError = ERROR_INVALID_INDEX;
+        return std::nullopt;
+    }
+}
+
+LONG GetWindowLongA(HWND __hwnd, int __index)
+{
+    _Sim_Begin_
+    return _S_getLong(server, __hwnd, __index).value_or(0);
+}
+
+LONG_PTR GetWindowLongPtrW(HWND __hwnd, int __index)
+{
+    _Sim_Begin_
+    return _S_getLong(server, __hwnd, __index).value_or(0);
+}
+
+LONG SetWindowLongA(HWND __hwnd, int __index, LONG __value)
+{
+    _Sim_Begin_
+
+    if (__index != GWL_STYLE && __index != GWL_EXSTYLE)
+    {
+        _S_lastError = ERROR_INVALID_INDEX;
+        return 0;
+    }
+
+    LONG previous = 0;
+
+    const bool found = server.update(_S_handle(__hwnd), [&](_Window& __w) {
+        std::uint32_t& value = __index == GWL_STYLE ? __w.style : __w.exStyle;
+
+        previous = static_cast<LONG>(value);
+        value = static_cast<std::uint32_t>(__value);
+    });
+
+    if (not found)
+    {
+        _S_lastError = ERROR_INVALID_WINDOW_HANDLE;
+    }
+
+    return previous;
+}
+
+HWND SetParent(HWND __hwnd, HWND __parent)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_window(server, __hwnd);
+
+    if (not w || not server.setParent(w->handle, _S_handle(__parent)))
+    {
+        _S_lastError = ERROR_INVALID_WINDOW_HANDLE;
+        return nullptr;
+    }
+
+    return w->parent ? _S_hwnd(w->parent) : _S_desktop;
+}
+
+HWND GetParent(HWND __hwnd)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_window(server, __hwnd);
+
+    if (not w)
+    {
+        return nullptr;
+    }
+
+    /// The owner for a top-level window.
+    return _S_hwnd(w->parent ? w->parent : w->owner);
+}
+
+HWND GetAncestor(HWND __hwnd, UINT __flags)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_window(server, __hwnd);
+
+    if (not w)
+    {
+        return nullptr;
+    }
+
+    switch (__flags)
+    {
+    case GA_PARENT:    return w->parent ? _S_hwnd(w->parent) : _S_desktop;
+    case GA_ROOT:      return _S_hwnd(_S_root(server, w->handle, false));
+    case GA_ROOTOWNER: return _S_hwnd(_S_root(server, w->handle, true));
+
+    default:
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return nullptr;
+    }
+}
+
+HWND GetWindow(HWND __hwnd, UINT __command)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_window(server, __hwnd);
+
+    if (not w)
+    {
+        return nullptr;
+    }
+
+    if (__command == GW_OWNER)
+    {
+        return _S_hwnd(w->owner);
+    }
+
+    if (__command == GW_CHILD)
+    {
+        const std::vector<WindowServer::Handle> children = server.windows(w->handle);
+        return children.empty() ? nullptr : _S_hwnd(children.front());
+    }
+
+    const std::vector<WindowServer::Handle> siblings = server.windows(w->parent);
+    auto it = std::find(siblings.begin(), siblings.end(), w->handle);
+
+    switch (__command)
+    {
+    case GW_HWNDFIRST: return _S_hwnd(siblings.front());
+    case GW_HWNDLAST:  return _S_hwnd(siblings.back());
+    case GW_HWNDNEXT:  return it + 1 != siblings.end() ? _S_hwnd(*(it + 1)) : nullptr;
+    case GW_HWNDPREV:  return it != siblings.begin() ? _S_hwnd(*(it - 1)) : nullptr;
+
+    default:
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return nullptr;
+    }
+}
+
+HWND GetTopWindow(HWND __hwnd)
+{
+    _Sim_Begin_
+
+    const std::vector<WindowServer::Handle> children = server.windows(_S_handle(__hwnd));
+    return children.empty() ? nullptr : _S_hwnd(children.front());
+}
+
+HWND GetLastActivePopup(HWND __hwnd)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_window(server, __hwnd);
+
+    if (not w)
+    {
+        return nullptr;
+    }
+
+    std::optional<_State> active = _S_state(server, server.input(w->threadId).active);
+    return active && active->owner == w->handle ? _S_hwnd(active->handle) : __hwnd;
+}
+
+BOOL EnumWindows(WNDENUMPROC __proc, LPARAM __lParam)
+{
+    _Sim_Begin_
+
+    for (WindowServer::Handle h : server.windows())
+    {
+        if (not __proc(_S_hwnd(h), __lParam))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool _S_enumChildren(WindowServer& __server, WindowServer::Handle __parent, WNDENUMPROC __proc, LPARAM __lParam)
+{
+    for (WindowServer::Handle h : __server.windows(__parent))
+    {
+        if (not __proc(_S_hwnd(h), __lParam) || not _S_enumChildren(__server, h, __proc, __lParam))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+BOOL EnumChildWindows(HWND __parent, WNDENUMPROC __proc, LPARAM __lParam)
+{
+    _Sim_Begin_
+    return _S_enumChildren(server, _S_handle(__parent), __proc, __lParam);
+}
+
+BOOL EnumThreadWindows(DWORD __threadId, WNDENUMPROC __proc, LPARAM __lParam)
+{
+    _Sim_Begin_
+
+    for (WindowServer::Handle h : server.windows())
+    {
+        std::optional<_State> w = _S_state(server, h);
+
+        if (w && w->threadId == __threadId && not __proc(_S_hwnd(h), __lParam))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief SetWindowPos() without counting the call, for the deferred
+ *        positions too.
+ */
+static bool _S_setWindowPos(WindowServer& __server, HWND __hwnd, HWND __after, int __x, int __y, int __cx, int __cy, UINT __flags)
+{
+    std::optional<_State> w = _S_window(__server, __hwnd);
+
+    if (not w)
+    {
+        return false;
+    }
+
+    /// The position of a child window is relative to its parent.
+    Point origin;
+
+    if (std::optional<_State> parent = _S_state(__server, w->parent))
+    {
+        origin = parent->rect.point();
+    }
+
+    __server.update(w->handle, [&](_Window& __w) {
+        Rect rect = __w.rect;
+
+        if (not (__flags & SWP_NOMOVE))
+        {
+            rect = Rect(origin.x() + __x, origin.y() + __y, rect.w(), rect.h());
+        }
+
+        if (not (__flags & SWP_NOSIZE))
+        {
+            rect = Rect(rect.x(), rect.y(), std::max(0, __cx), std::max(0, __cy));
+        }
+
+        __w.rect = rect;
+
+        if (__flags & SWP_SHOWWINDOW)
+        {
+            __w.style |= WindowServer::visibleStyle;
+        }
+        else if (__flags & SWP_HIDEWINDOW)
+        {
+            __w.style &= ~WindowServer::visibleStyle;
+        }
+    });
+
+    if (__flags & SWP_NOZORDER)
+    {
+        return true;
+    }
+
+    if (__after == HWND_TOPMOST || __after == HWND_NOTOPMOST)
+    {
+        return __server.setTopmost(w->handle, __after == HWND_TOPMOST);
+    }
+
+    if (__after == HWND_BOTTOM)
+    {
+        return __server.placeBottom(w->handle);
+    }
+
+    if (not __server.place(w->handle, _S_handle(__after)))
+    {
+        _S_lastError = ERROR_INVALID_WINDOW_HANDLE;
+        return false;
+    }
+
+    return true;
+}
+
+BOOL SetWindowPos(HWND __hwnd, HWND __after, int __x, int __y, int __cx, int __cy, UINT __flags)
+{
+    _Sim_Begin_
+    return _S_setWindowPos(server, __hwnd, __after, __x, __y, __cx, __cy, __flags);
+}
+
+struct _DeferredPosition
+{
+    HWND hwnd;
+    HWND after;
+
+    int x;
+    int y;
+    int cx;
+    int cy;
+
+    UINT flags;
+};
+
+HDWP BeginDeferWindowPos(int __count)
+{
+    _Sim_Begin_
+
+    if (__count < 0)
+    {
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return nullptr;
+    }
+
+    auto* positions = new std::vector<_DeferredPosition>;
+    positions->reserve(static_cast<std::size_t>(__count));
+
+    return positions;
+}
+
+HDWP DeferWindowPos(HDWP __info, HWND __hwnd, HWND __after, int __x, int __y, int __cx, int __cy, UINT __flags)
+{
+    _Sim_Begin_
+
+    auto* positions = static_cast<std::vector<_DeferredPosition>*>(__info);
+
+    if (positions == nullptr)
+    {
+        _S_lastError = ERROR_INVALID_HANDLE;
+        return nullptr;
+    }
+
+    /// As in Win32, a failure abandons the whole batch.
+    if (not _S_exists(server, __hwnd))
+    {
+        delete positions;
+        return nullptr;
+    }
+
+    positions->push_back({ __hwnd, __after, __x, __y, __cx, __cy, __flags });
+    return positions;
+}
+
+BOOL EndDeferWindowPos(HDWP __info)
+{
+    _Sim_Begin_
+
+    std::unique_ptr<std::vector<_DeferredPosition>> positions(static_cast<std::vector<_DeferredPosition>*>(__info));
+
+    if (positions == nullptr)
+    {
+        _S_lastError = ERROR_INVALID_HANDLE;
+        return false;
+    }
+
+    bool result = true;
+
+    for (const _DeferredPosition& p : *positions)
+    {
+        result = _S_setWindowPos(server, p.hwnd, p.after, p.x, p.y, p.cx, p.cy, p.flags) && result;
+    }
+
+    return result;
+}
+
+WORD TileWindows(HWND __parent, UINT __how, const RECT* __rect, UINT __count, const HWND* __kids)
+{
+    _Sim_Begin_
+
+    const WindowServer::Handle parent = _S_handle(__parent);
+
+    Rect area(Point(), server.options().screen);
+
+    if (parent)
+    {
+        std::optional<_State> w = _S_window(server, __parent);
+
+        if (not w)
+        {
+            return 0;
+        }
+
+        area = w->rect;
+    }
+
+    /// Relative to the parent.
+    if (__rect)
+    {
+        const Rect r = _S_rect(*__rect);
+        area = Rect(area.x() + r.x(), area.y() + r.y(), r.w(), r.h());
+    }
+
+    std::vector<WindowServer::Handle> windows;
+
+    if (__kids)
+    {
+        std::transform(__kids, __kids + __count, std::back_inserter(windows), &_S_handle);
+    }
+    else
+    {
+        for (WindowServer::Handle h : server.windows(parent))
+        {
+            std::optional<_State> w = _S_state(server, h);
+
+            if (w && w->visible() && not (w->style & WindowServer::minimizedStyle))
+            {
+                windows.push_back(h);
+            }
+        }
+    }
+
+    const int n = static_cast<int>(windows.size());
+
+    for (int i = 0; i < n; ++i)
+    {
+        /// MDITILE_VERTICAL puts the windows side by side.
+        const Rect tile = __how & MDITILE_HORIZONTAL
+            ? Rect(area.x(), area.y() + area.h() * i / n, area.w(), area.h() / n)
+            : Rect(area.x() + area.w() * i / n, area.y(), area.w() / n, area.h());
+
+        server.update(windows[i], [&](_Window& __w) { __w.rect = tile; });
+    }
+
+    return static_cast<WORD>(n);
+}
+
+BOOL ShowWindow(HWND __hwnd, int __command)
+{
+    _Sim_Begin_
+
+    bool wasVisible = false;
+
+    const Rect screen(Point(), server.options().screen);
+
+    const bool found = server.update(_S_handle(__hwnd), [&](_Window& __w) {
+        constexpr std::uint32_t placed = WindowServer::minimizedStyle | WindowServer::maximizedStyle;
+
+        wasVisible = __w.visible();
+
+        if (__command == SW_MAXIMIZE || __command == SW_MINIMIZE || __command == SW_FORCEMINIMIZE)
+        {
+            if (not (__w.style & placed))
+            {
+                __w.normalRect = __w.rect;
+            }
+
+            __w.style &= ~placed;
+        }
+
+        switch (__command)
+        {
+        case SW_HIDE:
+            __w.style &= ~WindowServer::visibleStyle;
+            break;
+
+        case SW_MAXIMIZE:
+            __w.rect = screen;
+            __w.style |= WindowServer::maximizedStyle | WindowServer::visibleStyle;
+            break;
+
+        case SW_MINIMIZE:
+        case SW_FORCEMINIMIZE:
+            __w.rect = Rect(-32000, -32000, 160, 28);
+            __w.style |= WindowServer::minimizedStyle | WindowServer::visibleStyle;
+            break;
+
+        case SW_SHOWNORMAL:
+        case SW_RESTORE:
+            if (__w.style & placed)
+            {
+                __w.rect = __w.normalRect;
+                __w.style &= ~placed;
+            }
+
+            __w.style |= WindowServer::visibleStyle;
+            break;
+
+        default:
+            __w.style |= WindowServer::visibleStyle;
+            break;
+        }
+    });
+
+    if (not found)
+    {
+        _S_lastError = ERROR_INVALID_WINDOW_HANDLE;
+    }
+
+    return wasVisible;
+}
+
+BOOL ShowOwnedPopups(HWND __hwnd, BOOL __show)
+{
+    _Sim_Begin_
+
+    if (not _S_exists(server, __hwnd))
+    {
+        return false;
+    }
+
+    for (WindowServer::Handle h : server.windows())
+    {
+        server.update(h, [&](_Window& __w) {
+            if (__w.owner != _S_handle(__hwnd))
+            {
+                return;
+            }
+
+            if (__show)
+            {
+                __w.style |= WindowServer::visibleStyle;
+            }
+            else
+            {
+                __w.style &= ~WindowServer::visibleStyle;
+            }
+        });
+    }
+
+    return true;
+}
+
+BOOL GetWindowRect(HWND __hwnd, RECT* __rect)
+{
+    _Sim_Begin_
+
+    if (__hwnd == _S_desktop)
+    {
+        *__rect = _S_rect(Rect(Point(), server.options().screen));
+        return true;
+    }
+
+    std::optional<_State> w = _S_window(server, __hwnd);
+
+    if (not w)
+    {
+        return false;
+    }
+
+    *__rect = _S_rect(w->rect);
+    return true;
+}
+
+/// The client area is the whole window, there are no frames.
+
+BOOL GetClientRect(HWND __hwnd, RECT* __rect)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_window(server, __hwnd);
+
+    if (not w)
+    {
+        return false;
+    }
+
+    *__rect = RECT{ 0, 0, w->rect.w(), w->rect.h() };
+    return true;
+}
+
+BOOL ClientToScreen(HWND __hwnd, POINT* __point)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_window(server, __hwnd);
+
+    if (not w)
+    {
+        return false;
+    }
+
+    __point->x += w->rect.x();
+    __point->y += w->rect.y();
+
+    return true;
+}
+
+BOOL ScreenToClient(HWND __hwnd, POINT* __point)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_window(server, __hwnd);
+
+    if (not w)
+    {
+        return false;
+    }
+
+    __point->x -= w->rect.x();
+    __point->y -= w->rect.y();
+
+    return true;
+}
+
+BOOL SetWindowTextA(HWND __hwnd, LPCSTR __text)
+{
+    _Sim_Begin_
+
+    const std::wstring text = _S_widen(__text ? __text : "");
+    return server.send(_S_handle(__hwnd), WM_SETTEXT, 0, reinterpret_cast<LPARAM>(text.c_str())).value_or(false);
+}
+
+BOOL SetWindowTextW(HWND __hwnd, LPCWSTR __text)
+{
+    _Sim_Begin_
+    return server.send(_S_handle(__hwnd), WM_SETTEXT, 0, reinterpret_cast<LPARAM>(__text ? __text : L"")).value_or(false);
+}
+
+int GetWindowTextLengthA(HWND __hwnd)
+{
+    _Sim_Begin_
+
+    return _S_with(server, __hwnd, [](const _Window& __w) { return static_cast<int>(__w.title.size()); }).value_or(0);
+}
+
+int GetWindowTextLengthW(HWND __hwnd)
+{
+    _Sim_Begin_
+
+    return _S_with(server, __hwnd, [](const _Window& __w) { return static_cast<int>(__w.title.size()); }).value_or(0);
+}
+
+int GetWindowTextA(HWND __hwnd, LPSTR __buffer, int __size)
+{
+    _Sim_Begin_
+
+    std::optional<std::string> title = _S_with(server, __hwnd, [](const _Window& __w) { return _S_narrow(__w.title); });
+    return title ? _S_copy<char>(*title, __buffer, __size) : 0;
+}
+
+int GetWindowTextW(HWND __hwnd, LPWSTR __buffer, int __size)
+{
+    _Sim_Begin_
+
+    return _S_with(server, __hwnd, [&](const _Window& __w) { return _S_copy<wchar_t>(__w.title, __buffer, __size); }).value_or(0);
+}
+
+int InternalGetWindowText(HWND __hwnd, LPWSTR __buffer, int __size)
+{
+    _Sim_Begin_
+
+    return _S_with(server, __hwnd, [&](const _Window& __w) { return _S_copy<wchar_t>(__w.title, __buffer, __size); }).value_or(0);
+}
+
+UINT RealGetWindowClassA(HWND __hwnd, LPSTR __buffer, UINT __size)
+{
+    _Sim_Begin_
+
+    std::optional<std::string> className = _S_with(server, __hwnd, [](const _Window& __w) { return _S_narrow(__w.className); });
+    return className ? _S_copy<char>(*className, __buffer, static_cast<int>(__size)) : 0;
+}
+
+UINT RealGetWindowClassW(HWND __hwnd, LPWSTR __buffer, UINT __size)
+{
+    _Sim_Begin_
+
+    return _S_with(server, __hwnd, [&](const _Window& __w) { return _S_copy<wchar_t>(__w.className, __buffer, static_cast<int>(__size)); }).value_or(0);
+}
+
+BOOL SetLayeredWindowAttributes(HWND __hwnd, COLORREF __key, BYTE __alpha, DWORD __flags)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_window(server, __hwnd);
+
+    if (not w)
+    {
+        return false;
+    }
+
+    if (not (w->exStyle & WS_EX_LAYERED))
+    {
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return false;
+    }
+
+    return server.update(w->handle, [&](_Window& __w) {
+        if (__flags & LWA_ALPHA)
+        {
+            __w.alpha = __alpha;
+        }
+
+        if (__flags & LWA_COLORKEY)
+        {
+            __w.colorKey = __key;
+        }
+
+        __w.layeredFlags = __flags;
+    });
+}
+
+BOOL GetLayeredWindowAttributes(HWND __hwnd, COLORREF* __key, BYTE* __alpha, DWORD* __flags)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_window(server, __hwnd);
+
+    if (not w)
+    {
+        return false;
+    }
+
+    if (not (w->exStyle & WS_EX_LAYERED))
+    {
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return false;
+    }
+
+    if (__key)
+    {
+        *__key = w->colorKey;
+    }
+
+    if (__alpha)
+    {
+        *__alpha = w->alpha;
+    }
+
+    if (__flags)
+    {
+        *__flags = w->layeredFlags;
+    }
+
+    return true;
+}
+
+BOOL SetWindowDisplayAffinity(HWND __hwnd, DWORD __affinity)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_window(server, __hwnd);
+
+    if (not w)
+    {
+        return false;
+    }
+
+    /// Only for the top-level windows of the calling process.
+    if (w->parent || w->processId != server.currentProcess())
+    {
+        _S_lastError = ERROR_ACCESS_DENIED;
+        return false;
+    }
+
+    return server.update(w->handle, [&](_Window& __w) { __w.displayAffinity = __affinity; });
+}
+
+BOOL GetWindowDisplayAffinity(HWND __hwnd, DWORD* __affinity)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_window(server, __hwnd);
+
+    if (not w)
+    {
+        return false;
+    }
+
+    *__affinity = w->displayAffinity;
+    return true;
+}
+
+/// The system menu of a window is its handle, only SC_CLOSE is modelled.
+
+HMENU GetSystemMenu(HWND __hwnd, BOOL __revert)
+{
+    _Sim_Begin_
+
+    if (not _S_exists(server, __hwnd))
+    {
+        return nullptr;
+    }
+
+    if (__revert)
+    {
+        server.update(_S_handle(__hwnd), [](_Window& __w) { __w.closeEnabled = true; });
+        return nullptr;
+    }
+
+    return reinterpret_cast<HMENU>(__hwnd);
+}
+
+BOOL EnableMenuItem(HMENU __menu, UINT __item, UINT __enable)
+{
+    _Sim_Begin_
+
+    if (__item != SC_CLOSE)
+    {
+        return -1;
+    }
+
+    bool wasEnabled = true;
+
+    const bool found = server.update(reinterpret_cast<WindowServer::Handle>(__menu), [&](_Window& __w) {
+        wasEnabled = __w.closeEnabled;
+        __w.closeEnabled = not (__enable & (MF_GRAYED | MF_DISABLED));
+    });
+
+    if (not found)
+    {
+        return -1;
+    }
+
+    return wasEnabled ? MF_ENABLED : MF_GRAYED;
+}
+
+BOOL DrawMenuBar(HWND __hwnd)
+{
+    _Sim_Begin_
+    return _S_exists(server, __hwnd);
+}
+
+void DragAcceptFiles(HWND __hwnd, BOOL __accept)
+{
+    _Sim_Begin_
+
+    server.update(_S_handle(__hwnd), [&](_Window& __w) {
+        if (__accept)
+        {
+            __w.exStyle |= WS_EX_ACCEPTFILES;
+        }
+        else
+        {
+            __w.exStyle &= ~WS_EX_ACCEPTFILES;
+        }
+    });
+}
+
+/// Flashing changes nothing, the result is whether the window is active.
+
+BOOL FlashWindow(HWND __hwnd, BOOL)
+{
+    _Sim_Begin_
+    return _S_exists(server, __hwnd) && server.foreground() == _S_handle(__hwnd);
+}
+
+BOOL FlashWindowEx(const FLASHWINFO* __info)
+{
+    _Sim_Begin_
+
+    if (__info == nullptr || __info->cbSize != sizeof(FLASHWINFO))
+    {
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return false;
+    }
+
+    return _S_exists(server, __info->hwnd) && server.foreground() == _S_handle(__info->hwnd);
+}
+
+/// Nothing is repainted, the painters draw into the framebuffer directly.
+
+BOOL InvalidateRect(HWND __hwnd, const RECT*, BOOL)
+{
+    _Sim_Begin_
+    return __hwnd == nullptr || _S_exists(server, __hwnd);
+}
+
+BOOL UpdateWindow(HWND __hwnd)
+{
+    _Sim_Begin_
+    return _S_exists(server, __hwnd);
+}
+
+BOOL LockWindowUpdate(HWND __hwnd)
+{
+    _Sim_Begin_
+    return __hwnd == nullptr || _S_exists(server, __hwnd);
+}
+
+DWORD GetWindowThreadProcessId(HWND __hwnd, DWORD* __processId)
+{
+    _Sim_Begin_
+
+    std::optional<_State> w = _S_window(server, __hwnd);
+
+    if (not w)
+    {
+        return 0;
+    }
+
+    if (__processId)
+    {
+        *__processId = w->processId;
+    }
+
+    return w->threadId;
+}
+
+/**
+ * @brief Nobody answers, returns the default button as if Enter was pressed.
+ */
+static int _S_messageBox(UINT __type) noexcept
+{
+    static const std::vector<int> _S_buttons[] = {
+        { IDOK },
+        { IDOK, IDCANCEL },
+        { IDABORT, IDRETRY, IDIGNORE },
+        { IDYES, IDNO, IDCANCEL },
+        { IDYES, IDNO },
+        { IDRETRY, IDCANCEL },
+        { IDCANCEL, IDTRYAGAIN, IDCONTINUE }
+    };
+
+    const std::vector<int>& buttons = _S_buttons[std::min<UINT>(__type & 0xF, std::size(_S_buttons) - 1)];
+    return buttons[std::min<std::size_t>((__type >> 8) & 0xF, buttons.size() - 1)];
+}
+
+int MessageBoxA(HWND, LPCSTR, LPCSTR, UINT __type)
+{
+    _Sim_Begin_
+    return _S_messageBox(__type);
+}
+
+int MessageBoxW(HWND, LPCWSTR, LPCWSTR, UINT __type)
+{
+    _Sim_Begin_
+    return _S_messageBox(__type);
+}
+
+BOOL MessageBeep(UINT)
+{
+    _Sim_Begin_
+    return true;
+}
+
+BOOL GetCursorPos(POINT* __point)
+{
+    _Sim_Begin_
+
+    const Point cursor = server.cursor();
+    *__point = POINT{ cursor.x(), cursor.y() };
+
+    return true;
+}
+
+/* ================== messages ================== */
+
+static BOOL _S_post(WindowServer& __server, HWND __hwnd, UINT __message, WPARAM __wParam, LPARAM __lParam)
+{
+    /// nullptr posts to the calling thread.
+    const bool posted = __hwnd
+        ? __server.post(_S_handle(__hwnd), __message, __wParam, __lParam)
+        : __server.postThread(__server.currentThread(), __message, __wParam, __lParam);
+
+    if (not posted)
+    {
+        _S_lastError = ERROR_INVALID_WINDOW_HANDLE;
+    }
+
+    return posted;
+}
+
+BOOL PostMessageA(HWND __hwnd, UINT __message, WPARAM __wParam, LPARAM __lParam)
+{
+    _Sim_Begin_
+    return _S_post(server, __hwnd, __message, __wParam, __lParam);
+}
+
+BOOL PostMessageW(HWND __hwnd, UINT __message, WPARAM __wParam, LPARAM __lParam)
+{
+    _Sim_Begin_
+    return _S_post(server, __hwnd, __message, __wParam, __lParam);
+}
+
+static BOOL _S_postThread(WindowServer& __server, DWORD __threadId, UINT __message, WPARAM __wParam, LPARAM __lParam)
+{
+    if (not __server.postThread(__threadId, __message, __wParam, __lParam))
+    {
+        _S_lastError = ERROR_INVALID_THREAD_ID;
+        return false;
+    }
+
+    return true;
+}
+
+BOOL PostThreadMessageA(DWORD __threadId, UINT __message, WPARAM __wParam, LPARAM __lParam)
+{
+    _Sim_Begin_
+    return _S_postThread(server, __threadId, __message, __wParam, __lParam);
+}
+
+BOOL PostThreadMessageW(DWORD __threadId, UINT __message, WPARAM __wParam, LPARAM __lParam)
+{
+    _Sim_Begin_
+    return _S_postThread(server, __threadId, __message, __wParam, __lParam);
+}
+
+/**
+ * @brief Sends with the text of WM_SETTEXT and WM_GETTEXT converted, the
+ *        procedures take wide strings only.
+ */
+static std::optional<LRESULT> _S_sendA(WindowServer& __server, HWND __hwnd, UINT __message, WPARAM __wParam, LPARAM __lParam, bool __failIfHung)
+{
+    const WindowServer::Handle handle = _S_handle(__hwnd);
+
+    if (__message == WM_SETTEXT && __lParam)
+    {
+        const std::wstring text = _S_widen(reinterpret_cast<const char*>(__lParam));
+        return __server.send(handle, __message, __wParam, reinterpret_cast<LPARAM>(text.c_str()), __failIfHung);
+    }
+
+    if (__message == WM_GETTEXT && __lParam && __wParam)
+    {
+        std::wstring text(__wParam, L'\0');
+        std::optional<LRESULT> result = __server.send(handle, __message, __wParam, reinterpret_cast<LPARAM>(text.data()), __failIfHung);
+
+        if (result)
+        {
+            text.resize(static_cast<std::size_t>(*result));
+            return _S_copy<char>(_S_narrow(text), reinterpret_cast<char*>(__lParam), static_cast<int>(__wParam));
+        }
+
+        return result;
+    }
+
+    return __server.send(handle, __message, __wParam, __lParam, __failIfHung);
+}
+
+static std::optional<LRESULT> _S_sendW(WindowServer& __server, HWND __hwnd, UINT __message, WPARAM __wParam, LPARAM __lParam, bool __failIfHung)
+{
+    return __server.send(_S_handle(__hwnd), __message, __wParam, __lParam, __failIfHung);
+}
+
+LRESULT SendMessageA(HWND __hwnd, UINT __message, WPARAM __wParam, LPARAM __lParam)
+{
+    _Sim_Begin_
+
+    std::optional<LRESULT> result = _S_sendA(server, __hwnd, __message, __wParam, __lParam, false);
+
+    if (not result)
+    {
+        _S_lastError = ERROR_INVALID_WINDOW_HANDLE;
+    }
+
+    return result.value_or(0);
+}
+
+LRESULT SendMessageW(HWND __hwnd, UINT __message, WPARAM __wParam, LPARAM __lParam)
+{
+    _Sim_Begin_
+
+    std::optional<LRESULT> result = _S_sendW(server, __hwnd, __message, __wParam, __lParam, false);
+
+    if (not result)
+    {
+        _S_lastError = ERROR_INVALID_WINDOW_HANDLE;
+    }
+
+    return result.value_or(0);
+}
+
+/// A hung window always times out, the timeout itself is not waited.
+template<typename _Send>
+static LRESULT _S_sendTimeout(WindowServer& __server, HWND __hwnd, DWORD_PTR* __result, _Send&& __send)
+{
+    if (not _S_exists(__server, __hwnd))
+    {
+        return 0;
+    }
+
+    std::optional<LRESULT> result = __send();
+
+    if (not result)
+    {
+        _S_lastError = ERROR_TIMEOUT;
+        return 0;
+    }
+
+    if (__result)
+    {
+        *__result = static_cast<DWORD_PTR>(*result);
+    }
+
+    return 1;
+}
+
+LRESULT SendMessageTimeoutA(HWND __hwnd, UINT __message, WPARAM __wParam, LPARAM __lParam, UINT, UINT, DWORD_PTR* __result)
+{
+    _Sim_Begin_
+
+    return _S_sendTimeout(server, __hwnd, __result, [&] {
+        return _S_sendA(server, __hwnd, __message, __wParam, __lParam, true);
+    });
+}
+
+LRESULT SendMessageTimeoutW(HWND __hwnd, UINT __message, WPARAM __wParam, LPARAM __lParam, UINT, UINT, DWORD_PTR* __result)
+{
+    _Sim_Begin_
+
+    return _S_sendTimeout(server, __hwnd, __result, [&] {
+        return _S_sendW(server, __hwnd, __message, __wParam, __lParam, true);
+    });
+}
+
+static void _S_message(WindowServer& __server, const WindowServer::Message& __from, MSG* __to)
+{
+    const Point cursor = __server.cursor();
+
+    __to->hwnd = _S_hwnd(__from.window);
+    __to->message = __from.message;
+    __to->wParam = __from.wParam;
+    __to->lParam = __from.lParam;
+    __to->time = static_cast<DWORD>(std::chrono::duration_cast<std::chrono::milliseconds>(__from.time.time_since_epoch()).count());
+    __to->pt = POINT{ cursor.x(), cursor.y() };
+}
+
+/// (HWND)-1 stays as is, it filters the messages posted to the thread.
+static bool _S_validFilter(WindowServer& __server, HWND __hwnd)
+{
+    return __hwnd == nullptr || __hwnd == reinterpret_cast<HWND>(-1) || _S_exists(__server, __hwnd);
+}
+
+static BOOL _S_get(WindowServer& __server, MSG* __msg, HWND __hwnd, UINT __min, UINT __max)
+{
+    if (not _S_validFilter(__server, __hwnd))
+    {
+        return -1;
+    }
+
+    WindowServer::Message message;
+    const bool result = __server.get(message, reinterpret_cast<WindowServer::Handle>(__hwnd), __min, __max);
+
+    _S_message(__server, message, __msg);
+    return result;
+}
+
+BOOL GetMessageA(MSG* __msg, HWND __hwnd, UINT __min, UINT __max)
+{
+    _Sim_Begin_
+    return _S_get(server, __msg, __hwnd, __min, __max);
+}
+
+BOOL GetMessageW(MSG* __msg, HWND __hwnd, UINT __min, UINT __max)
+{
+    _Sim_Begin_
+    return _S_get(server, __msg, __hwnd, __min, __max);
+}
+
+BOOL PeekMessageW(MSG* __msg, HWND __hwnd, UINT __min, UINT __max, UINT __remove)
+{
+    _Sim_Begin_
+
+    if (not _S_validFilter(server, __hwnd))
+    {
+        return false;
+    }
+
+    WindowServer::Message message;
+
+    if (not server.peek(message, reinterpret_cast<WindowServer::Handle>(__hwnd), __min, __max, __remove & PM_REMOVE))
+    {
+        return false;
+    }
+
+    _S_message(server, message, __msg);
+    return true;
+}
+
+LRESULT DispatchMessageW(const MSG* __msg)
+{
+    _Sim_Begin_
+    return server.dispatch({ __msg->hwnd, __msg->message, __msg->wParam, __msg->lParam, WindowServer::Clock::now() });
+}
+
+BOOL RegisterHotKey(HWND __hwnd, int __id, UINT __modifiers, UINT __key)
+{
+    _Sim_Begin_
+
+    if (__hwnd && not _S_exists(server, __hwnd))
+    {
+        return false;
+    }
+
+    if (not server.registerHotKey(_S_handle(__hwnd), __id, __modifiers, __key))
+    {
+        _S_lastError = ERROR_HOTKEY_ALREADY_REGISTERED;
+        return false;
+    }
+
+    return true;
+}
+
+BOOL UnregisterHotKey(HWND __hwnd, int __id)
+{
+    _Sim_Begin_
+
+    if (not server.unregisterHotKey(_S_handle(__hwnd), __id))
+    {
+        _S_lastError = ERROR_HOTKEY_NOT_REGISTERED;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief The scan codes of a US keyboard, and the names of the keys by scan
+ *        code, the extended name for the keys with the extended bit set.
+ */
+struct _ScanCode
+{
+    UINT key;
+    UINT scan;
+};
+
+struct _KeyName
+{
+    UINT scan;
+
+    std::string_view name;
+    std::string_view extendedName;
+};
+
+static const _ScanCode _S_scanCodes[] = {
+    { 0x08, 0x0E }, { 0x09, 0x0F }, { 0x0C, 0x4C }, { 0x0D, 0x1C }, { 0x10, 0x2A }, { 0x11, 0x1D },
+    { 0x12, 0x38 }, { 0x13, 0x45 }, { 0x14, 0x3A }, { 0x1B, 0x01 }, { 0x20, 0x39 }, { 0x21, 0x49 },
+    { 0x22, 0x51 }, { 0x23, 0x4F }, { 0x24, 0x47 }, { 0x25, 0x4B }, { 0x26, 0x48 }, { 0x27, 0x4D },
+    { 0x28, 0x50 }, { 0x2C, 0x54 }, { 0x2D, 0x52 }, { 0x2E, 0x53 },
+
+    { '0', 0x0B }, { '1', 0x02 }, { '2', 0x03 }, { '3', 0x04 }, { '4', 0x05 },
+    { '5', 0x06 }, { '6', 0x07 }, { '7', 0x08 }, { '8', 0x09 }, { '9', 0x0A },
+
+    { 'A', 0x1E }, { 'B', 0x30 }, { 'C', 0x2E }, { 'D', 0x20 }, { 'E', 0x12 }, { 'F', 0x21 }, { 'G', 0x22 },
+    { 'H', 0x23 }, { 'I', 0x17 }, { 'J', 0x24 }, { 'K', 0x25 }, { 'L', 0x26 }, { 'M', 0x32 }, { 'N', 0x31 },
+    { 'O', 0x18 }, { 'P', 0x19 }, { 'Q', 0x10 }, { 'R', 0x13 }, { 'S', 0x1F }, { 'T', 0x14 }, { 'U', 0x16 },
+    { 'V', 0x2F }, { 'W', 0x11 }, { 'X', 0x2D }, { 'Y', 0x15 }, { 'Z', 0x2C },
+
+    { 0x5B, 0x5B }, { 0x5C, 0x5C }, { 0x5D, 0x5D },
+
+    { 0x60, 0x52 }, { 0x61, 0x4F }, { 0x62, 0x50 }, { 0x63, 0x51 }, { 0x64, 0x4B }, { 0x65, 0x4C },
+    { 0x66, 0x4D }, { 0x67, 0x47 }, { 0x68, 0x48 }, { 0x69, 0x49 }, { 0x6A, 0x37 }, { 0x6B, 0x4E },
+    { 0x6D, 0x4A }, { 0x6E, 0x53 }, { 0x6F, 0x35 },
+
+    { 0x70, 0x3B }, { 0x71, 0x3C }, { 0x72, 0x3D }, { 0x73, 0x3E }, { 0x74, 0x3F }, { 0x75, 0x40 },
+    { 0x76, 0x41 }, { 0x77, 0x42 }, { 0x78, 0x43 }, { 0x79, 0x44 }, { 0x7A, 0x57 }, { 0x7B, 0x58 },
+
+    { 0x90, 0x45 }, { 0x91, 0x46 },
+    { 0xA0, 0x2A }, { 0xA1, 0x36 }, { 0xA2, 0x1D }, { 0xA3, 0x1D }, { 0xA4, 0x38 }, { 0xA5, 0x38 },
+
+    { 0xBA, 0x27 }, { 0xBB, 0x0D }, { 0xBC, 0x33 }, { 0xBD, 0x0C }, { 0xBE, 0x34 }, { 0xBF, 0x35 },
+    { 0xC0, 0x29 }, { 0xDB, 0x1A }, { 0xDC, 0x2B }, { 0xDD, 0x1B }, { 0xDE, 0x28 }
+};
+
+static const _KeyName _S_keyNames[] = {
+    { 0x01, "Esc", "" },
+    { 0x02, "1", "" }, { 0x03, "2", "" }, { 0x04, "3", "" }, { 0x05, "4", "" }, { 0x06, "5", "" },
+    { 0x07, "6", "" }, { 0x08, "7", "" }, { 0x09, "8", "" }, { 0x0A, "9", "" }, { 0x0B, "0", "" },
+    { 0x0C, "-", "" }, { 0x0D, "=", "" }, { 0x0E, "Backspace", "" }, { 0x0F, "Tab", "" },
+    { 0x10, "Q", "" }, { 0x11, "W", "" }, { 0x12, "E", "" }, { 0x13, "R", "" }, { 0x14, "T", "" },
+    { 0x15, "Y", "" }, { 0x16, "U", "" }, { 0x17, "I", "" }, { 0x18, "O", "" }, { 0x19, "P", "" },
+    { 0x1A, "[", "" }, { 0x1B, "]", "" }, { 0x1C, "Enter", "Num Enter" }, { 0x1D, "Ctrl", "Right Ctrl" },
+    { 0x1E, "A", "" }, { 0x1F, "S", "" }, { 0x20, "D", "" }, { 0x21, "F", "" }, { 0x22, "G", "" },
+    { 0x23, "H", "" }, { 0x24, "J", "" }, { 0x25, "K", "" }, { 0x26, "L", "" }, { 0x27, ";", "" },
+    { 0x28, "'", "" }, { 0x29, "`", "" }, { 0x2A, "Shift", "" }, { 0x2B, "\\", "" },
+    { 0x2C, "Z", "" }, { 0x2D, "X", "" }, { 0x2E, "C", "" }, { 0x2F, "V", "" }, { 0x30, "B", "" },
+    { 0x31, "N", "" }, { 0x32, "M", "" }, { 0x33, ",", "" }, { 0x34, ".", "" }, { 0x35, "/", "Num /" },
+    { 0x36, "Right Shift", "" }, { 0x37, "Num *", "Prnt Scrn" }, { 0x38, "Alt", "Right Alt" },
+    { 0x39, "Space", "" }, { 0x3A, "Caps Lock", "" },
+    { 0x3B, "F1", "" }, { 0x3C, "F2", "" }, { 0x3D, "F3", "" }, { 0x3E, "F4", "" }, { 0x3F, "F5", "" },
+    { 0x40, "F6", "" }, { 0x41, "F7", "" }, { 0x42, "F8", "" }, { 0x43, "F9", "" }, { 0x44, "F10", "" },
+    { 0x45, "Pause", "Num Lock" }, { 0x46, "Scroll Lock", "Break" },
+    { 0x47, "Num 7", "Home" }, { 0x48, "Num 8", "Up" }, { 0x49, "Num 9", "Page Up" }, { 0x4A, "Num -", "" },
+    { 0x4B, "Num 4", "Left" }, { 0x4C, "Num 5", "" }, { 0x4D, "Num 6", "Right" }, { 0x4E, "Num +", "" },
+    { 0x4F, "Num 1", "End" }, { 0x50, "Num 2", "Down" }, { 0x51, "Num 3", "Page Down" },
+    { 0x52, "Num 0", "Insert" }, { 0x53, "Num Del", "Delete" }, { 0x54, "Sys Req", "" },
+    { 0x57, "F11", "" }, { 0x58, "F12", "" },
+    { 0x5B, "", "Left Windows" }, { 0x5C, "", "Right Windows" }, { 0x5D, "", "Application" }
+};
+
+static UINT _S_mapVirtualKey(UINT __code, UINT __type) noexcept
+{
+    if (__type != MAPVK_VK_TO_VSC)
+    {
+        return 0;
+    }
+
+    auto it = std::find_if(std::begin(_S_scanCodes), std::end(_S_scanCodes), [&](const _ScanCode& __s) { return __s.key == __code; });
+    return it != std::end(_S_scanCodes) ? it->scan : 0;
+}
+
+UINT MapVirtualKeyA(UINT __code, UINT __type)
+{
+    _Sim_Begin_
+    return _S_mapVirtualKey(__code, __type);
+}
+
+UINT MapVirtualKeyW(UINT __code, UINT __type)
+{
+    _Sim_Begin_
+    return _S_mapVirtualKey(__code, __type);
+}
+
+int GetKeyNameTextA(LONG __lParam, LPSTR __buffer, int __size)
+{
+    _Sim_Begin_
+
+    const UINT scan = (static_cast<std::uint32_t>(__lParam) >> 16) & 0xff;
+    const bool extended = __lParam & 0x01000000;
+
+    auto it = std::find_if(std::begin(_S_keyNames), std::end(_S_keyNames), [&](const _KeyName& __k) { return __k.scan == scan; });
+
+    if (it == std::end(_S_keyNames))
+    {
+        return 0;
+    }
+
+    const std::string_view name = extended && not it->extendedName.empty() ? it->extendedName : it->name;
+    return _S_copy<char>(name.empty() ? it->extendedName : name, __buffer, __size);
+}
+
+HWINEVENTHOOK SetWinEventHook(
+    DWORD __min, DWORD __max, HMODULE, WINEVENTPROC __proc, DWORD __processId, DWORD __threadId, DWORD __flags)
+{
+    _Sim_Begin_
+
+    if (__proc == nullptr || __min > __max)
+    {
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return nullptr;
+    }
+
+    /// Known once the hook is set, before any event runs on this thread.
+    auto id = std::make_shared<std::uint64_t>(0);
+
+    *id = server.hook(
+        __min,
+        __max,
+        [&server, __proc, __processId, __threadId, id](std::uint32_t __event, WindowServer::Handle __handle) {
+            std::optional<_State> w = _S_state(server, __handle);
+
+            if (w && ((__processId && w->processId != __processId) || (__threadId && w->threadId != __threadId)))
+            {
+                return;
+            }
+
+            __proc(
+                reinterpret_cast<HWINEVENTHOOK>(*id),
+                __event,
+                _S_hwnd(__handle),
+                OBJID_WINDOW,
+                CHILDID_SELF,
+                w ? w->threadId : 0,
+                _S_tickCount());
+        },
+        __flags & WINEVENT_SKIPOWNTHREAD);
+
+    return reinterpret_cast<HWINEVENTHOOK>(*id);
+}
+
+BOOL UnhookWinEvent(HWINEVENTHOOK __hook)
+{
+    _Sim_Begin_
+    return server.unhook(reinterpret_cast<std::uint64_t>(__hook));
+}
+
+/* ================== GDI ================== */
+
+struct _GdiObject
+{
+    explicit _GdiObject(UINT __type, bool __stock = false) noexcept
+        : type(__type), stock(__stock)
+    { }
+
+    UINT type;
+
+    /// Never deleted.
+    bool stock = false;
+
+    /// Created by ExtCreatePen().
+    bool extended = false;
+
+    LOGPEN pen{};
+
+    EXTLOGPEN extendedPen{};
+    std::vector<DWORD> styleEntries;
+
+    LOGBRUSH brush{};
+
+    LOGFONTA font{};
+};
+
+struct _DeviceContext
+{
+    /// nullptr for the screen.
+    HWND hwnd;
+
+    HGDIOBJ pen;
+    HGDIOBJ brush;
+    HGDIOBJ font;
+
+    COLORREF textColor = 0x00000000;
+    COLORREF bkColor = 0x00ffffff;
+
+    int bkMode = OPAQUE;
+    int rop2 = R2_COPYPEN;
+
+    float miterLimit = 10.0f;
+
+    POINT position{ 0, 0 };
+};
+
+/**
+ * @brief The GDI objects and device contexts, shared by all servers.
+ */
+class _Gdi
+{
+public:
+
+    _Gdi()
+    {
+        _GdiObject pen{ OBJ_PEN, true };
+        pen.pen = LOGPEN{ PS_SOLID, POINT{ 1, 0 }, RGB(0, 0, 0) };
+
+        _GdiObject brush{ OBJ_BRUSH, true };
+        brush.brush = LOGBRUSH{ BS_SOLID, RGB(255, 255, 255), 0 };
+
+        _GdiObject font{ OBJ_FONT, true };
+        font.font.lfHeight = 16;
+        std::strcpy(font.font.lfFaceName, "System");
+
+        _M_defaultPen = create(std::move(pen));
+        _M_defaultBrush = create(std::move(brush));
+        _M_defaultFont = create(std::move(font));
+    }
+
+    HGDIOBJ create(_GdiObject&& __object)
+    {
+        std::lock_guard<std::mutex> _L_lock(_M_mutex);
+
+        HGDIOBJ handle = _M_next();
+        _M_objects.emplace(handle, std::move(__object));
+
+        return handle;
+    }
+
+    std::optional<_GdiObject> object(HGDIOBJ __handle) const
+    {
+        std::lock_guard<std::mutex> _L_lock(_M_mutex);
+
+        auto it = _M_objects.find(__handle);
+        return it != _M_objects.end() ? std::optional(it->second) : std::nullopt;
+    }
+
+    bool remove(HGDIOBJ __handle)
+    {
+        std::lock_guard<std::mutex> _L_lock(_M_mutex);
+
+        auto it = _M_objects.find(__handle);
+
+        if (it == _M_objects.end())
+        {
+            return false;
+        }
+
+        if (not it->second.stock)
+        {
+            _M_objects.erase(it);
+        }
+
+        return true;
+    }
+
+    HDC open(HWND __hwnd)
+    {
+        std::lock_guard<std::mutex> _L_lock(_M_mutex);
+
+        HDC handle = static_cast<HDC>(_M_next());
+        _M_dcs.emplace(handle, _DeviceContext{ __hwnd, _M_defaultPen, _M_defaultBrush, _M_defaultFont });
+
+        return handle;
+    }
+
+    bool close(HDC __hdc)
+    {
+        std::lock_guard<std::mutex> _L_lock(_M_mutex);
+        return _M_dcs.erase(__hdc);
+    }
+
+    /**
+     * @brief Calls the function with the device context locked.
+     * 
+     * @return false if there is no such device context.
+     */
+    template<typename _Fn>
+    bool with(HDC __hdc, _Fn&& __fn)
+    {
+        std::lock_guard<std::mutex> _L_lock(_M_mutex);
+
+        auto it = _M_dcs.find(__hdc);
+
+        if (it == _M_dcs.end())
+        {
+            _S_lastError = ERROR_INVALID_HANDLE;
+            return false;
+        }
+
+        __fn(it->second);
+        return true;
+    }
+
+    /**
+     * @brief Selects the object into the device context.
+     * 
+     * @return The object of the same type selected before, nullptr if either
+     *         does not exist.
+     */
+    HGDIOBJ select(HDC __hdc, HGDIOBJ __object)
+    {
+        std::lock_guard<std::mutex> _L_lock(_M_mutex);
+
+        auto dc = _M_dcs.find(__hdc);
+        auto object = _M_objects.find(__object);
+
+        if (dc == _M_dcs.end() || object == _M_objects.end())
+        {
+            _S_lastError = ERROR_INVALID_HANDLE;
+            return nullptr;
+        }
+
+        HGDIOBJ* slot = _S_slot(dc->second, object->second.type);
+        return slot ? std::exchange(*slot, __object) : nullptr;
+    }
+
+    static HGDIOBJ* _S_slot(_DeviceContext& __dc, UINT __type) noexcept
+    {
+        switch (__type)
+        {
+        case OBJ_PEN:   return &__dc.pen;
+        case OBJ_BRUSH: return &__dc.brush;
+        case OBJ_FONT:  return &__dc.font;
+        default:        return nullptr;
+        }
+    }
+
+private:
+
+    HGDIOBJ _M_next() noexcept
+    {
+        HGDIOBJ handle = reinterpret_cast<HGDIOBJ>(_M_nextHandle);
+        _M_nextHandle += 4;
+
+        return handle;
+    }
+
+    mutable std::mutex _M_mutex;
+
+    std::unordered_map<HGDIOBJ, _GdiObject> _M_objects;
+    std::unordered_map<HDC, _DeviceContext> _M_dcs;
+
+    std::uintptr_t _M_nextHandle = 0x40000000;
+
+    HGDIOBJ _M_defaultPen;
+    HGDIOBJ _M_defaultBrush;
+    HGDIOBJ _M_defaultFont;
+};
+
+static _Gdi& _S_gdi()
+{
+    static _Gdi* const _S_instance = new _Gdi;
+    return *_S_instance;
+}
+
+/**
+ * @brief A snapshot of a device context resolved against the window, draws
+ *        into the framebuffer with 1 pixel wide pens and solid brushes.
+ */
+class _Canvas
+{
+public:
+
+    /// In the coordinates of the device context.
+    POINT position;
+
+    /**
+     * @return std::nullopt if the device context or its window does not
+     *         exist.
+     */
+    static std::optional<_Canvas> open(WindowServer& __server, HDC __hdc)
+    {
+        _DeviceContext dc{};
+
+        if (not _S_gdi().with(__hdc, [&](_DeviceContext& __dc) { dc = __dc; }))
+        {
+            return std::nullopt;
+        }
+
+        _Canvas canvas;
+
+        canvas.position = dc.position;
+        canvas._M_rop2 = dc.rop2;
+
+        canvas._M_clip = Rect(Point(), __server.options().screen);
+
+        if (dc.hwnd)
+        {
+            std::optional<_State> w = _S_window(__server, dc.hwnd);
+
+            if (not w)
+            {
+                return std::nullopt;
+            }
+
+            canvas._M_origin = w->rect.point();
+            canvas._M_clip = w->rect;
+        }
+
+        if (std::optional<_GdiObject> pen = _S_gdi().object(dc.pen))
+        {
+            const UINT style = pen->extended ? pen->extendedPen.elpPenStyle & 0xF : pen->pen.lopnStyle;
+
+            canvas._M_pen = style == PS_NULL
+                ? std::nullopt
+                : std::optional(pen->extended ? pen->extendedPen.elpColor : pen->pen.lopnColor);
+        }
+
+        if (std::optional<_GdiObject> brush = _S_gdi().object(dc.brush); brush && brush->brush.lbStyle != BS_NULL)
+        {
+            canvas._M_brush = brush->brush.lbColor;
+        }
+
+        return canvas;
+    }
+
+    void plot(WindowServer::Surface& __surface, int __x, int __y, COLORREF __color) const noexcept
+    {
+        const int x = _M_origin.x() + __x;
+        const int y = _M_origin.y() + __y;
+
+        if (x < _M_clip.x() || y < _M_clip.y() || x >= _M_clip.x() + _M_clip.w() || y >= _M_clip.y() + _M_clip.h()
+            || not __surface.contains(x, y))
+        {
+            return;
+        }
+
+        std::uint32_t& pixel = __surface.at(x, y);
+        pixel = _S_mix(_M_rop2, __color & 0x00ffffff, pixel);
+    }
+
+    /**
+     * @brief Draws from the first point to the last one, the last one
+     *        excluded as in GDI.
+     */
+    void line(WindowServer::Surface& __surface, POINT __from, POINT __to) const noexcept
+    {
+        if (not _M_pen)
+        {
+            return;
+        }
+
+        const int dx = std::abs(__to.x - __from.x);
+        const int dy = -std::abs(__to.y - __from.y);
+
+        const int sx = __from.x < __to.x ? 1 : -1;
+        const int sy = __from.y < __to.y ? 1 : -1;
+
+        int x = __from.x;
+        int y = __from.y;
+
+        for (int error = dx + dy; x != __to.x || y != __to.y; )
+        {
+            plot(__surface, x, y, *_M_pen);
+
+            const int e2 = error * 2;
+
+            if (e2 >= dy)
+            {
+                error += dy;
+                x += sx;
+            }
+
+            if (e2 <= dx)
+            {
+                error += dx;
+                y += sy;
+            }
+        }
+    }
+
+    void polyline(WindowServer::Surface& __surface, const std::vector<POINT>& __points) const noexcept
+    {
+        for (std::size_t i = 1; i < __points.size(); ++i)
+        {
+            line(__surface, __points[i - 1], __points[i]);
+        }
+    }
+
+    /**
+     * @brief Fills the pixels inside with the brush, those at the border with
+     *        the pen if the filter lets them.
+     * 
+     * @param __inside Whether the pixel (x, y) is inside the shape.
+     * @param __fill   Whether the interior is filled.
+     * @param __filter Whether the border pixel (x, y) is drawn.
+     */
+    template<typename _Inside, typename _Filter>
+    void shape(
+        WindowServer::Surface& __surface,
+        const RECT& __box,
+        _Inside&& __inside,
+        bool __fill,
+        _Filter&& __filter) const noexcept
+    {
+        /// Only the part of the box in the clip.
+        const int left = std::max<int>(__box.left, _M_clip.x() - _M_origin.x());
+        const int top = std::max<int>(__box.top, _M_clip.y() - _M_origin.y());
+        const int right = std::min<int>(__box.right, _M_clip.x() + _M_clip.w() - _M_origin.x());
+        const int bottom = std::min<int>(__box.bottom, _M_clip.y() + _M_clip.h() - _M_origin.y());
+
+        for (int y = top; y < bottom; ++y)
+        {
+            for (int x = left; x < right; ++x)
+            {
+                if (not __inside(x, y))
+                {
+                    continue;
+                }
+
+                const bool border = not __inside(x - 1, y) || not __inside(x + 1, y) || not __inside(x, y - 1) || not __inside(x, y + 1);
+
+                if (border && _M_pen && __filter(x, y))
+                {
+                    plot(__surface, x, y, *_M_pen);
+                }
+                else if (__fill && _M_brush && (not border || not _M_pen))
+                {
+                    plot(__surface, x, y, *_M_brush);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Inverts the colors of the rect, ignoring the mix mode.
+     */
+    void invert(WindowServer::Surface& __surface, const RECT& __rect) const noexcept
+    {
+        const int mode = std::exchange(const_cast<_Canvas*>(this)->_M_rop2, R2_COPYPEN);
+
+        for (int y = __rect.top; y < __rect.bottom; ++y)
+        {
+            for (int x = __rect.left; x < __rect.right; ++x)
+            {
+                const int sx = _M_origin.x() + x;
+                const int sy = _M_origin.y() + y;
+
+                if (__surface.contains(sx, sy))
+                {
+                    plot(__surface, x, y, ~__surface.at(sx, sy));
+                }
+            }
+        }
+
+        const_cast<_Canvas*>(this)->_M_rop2 = mode;
+    }
+
+    [[nodiscard]] bool contains(int __x, int __y) const noexcept
+    {
+        const int x = _M_origin.x() + __x;
+        const int y = _M_origin.y() + __y;
+
+        return x >= _M_clip.x() && y >= _M_clip.y() && x < _M_clip.x() + _M_clip.w() && y < _M_clip.y() + _M_clip.h();
+    }
+
+    [[nodiscard]] const Point& origin() const noexcept
+    { return _M_origin; }
+
+private:
+
+    /**
+     * @brief Mixes the pen and the screen with the binary raster operation,
+     *        R2_BLACK (1) to R2_WHITE (16), whose code minus 1 is the truth
+     *        table indexed by (pen << 1 | screen).
+     */
+    static std::uint32_t _S_mix(int __rop2, std::uint32_t __pen, std::uint32_t __screen) noexcept
+    {
+        const unsigned table = static_cast<unsigned>(std::clamp(__rop2, 1, 16) - 1);
+
+        std::uint32_t result = 0;
+
+        if (table & 0b0001) { result |= ~__pen & ~__screen; }
+        if (table & 0b0010) { result |= ~__pen & __screen; }
+        if (table & 0b0100) { result |= __pen & ~__screen; }
+        if (table & 0b1000) { result |= __pen & __screen; }
+
+        return result & 0x00ffffff;
+    }
+
+    Point _M_origin;
+    Rect _M_clip;
+
+    int _M_rop2 = R2_COPYPEN;
+
+    std::optional<COLORREF> _M_pen;
+    std::optional<COLORREF> _M_brush;
+};
+
+/**
+ * @brief Opens the canvas of the device context and paints on it.
+ */
+template<typename _Fn>
+static BOOL _S_draw(WindowServer& __server, HDC __hdc, _Fn&& __fn)
+{
+    std::optional<_Canvas> canvas = _Canvas::open(__server, __hdc);
+
+    if (not canvas)
+    {
+        return false;
+    }
+
+    __server.paint([&](WindowServer::Surface& __surface) { __fn(*canvas, __surface); });
+    return true;
+}
+
+static constexpr double _S_pi = 3.14159265358979323846;
+
+/// Pixel centers against the ellipse inscribed in the box.
+static bool _S_inEllipse(const RECT& __box, double __x, double __y) noexcept
+{
+    const double rx = (__box.right - __box.left) / 2.0;
+    const double ry = (__box.bottom - __box.top) / 2.0;
+
+    if (rx <= 0 || ry <= 0)
+    {
+        return false;
+    }
+
+    const double dx = (__x + 0.5 - (__box.left + rx)) / rx;
+    const double dy = (__y + 0.5 - (__box.top + ry)) / ry;
+
+    return dx * dx + dy * dy <= 1.0;
+}
+
+/// The counterclockwise angle of the point around the center, in [0, 2 pi).
+static double _S_angle(double __x, double __y, double __cx, double __cy) noexcept
+{
+    const double angle = std::atan2(__cy - __y, __x - __cx);
+    return angle < 0 ? angle + 2 * _S_pi : angle;
+}
+
+/**
+ * @brief The arc from the radial of the first point counterclockwise to the
+ *        radial of the second one, as used by Arc(), Chord() and Pie().
+ */
+struct _Arc
+{
+    double cx;
+    double cy;
+
+    double start;
+    double sweep;
+
+    _Arc(const RECT& __box, int __x1, int __y1, int __x2, int __y2) noexcept
+        : cx((__box.left + __box.right) / 2.0)
+        , cy((__box.top + __box.bottom) / 2.0)
+        , start(_S_angle(__x1, __y1, cx, cy))
+    {
+        sweep = _S_angle(__x2, __y2, cx, cy) - start;
+
+        /// The same radials make a whole ellipse.
+        if (sweep <= 0)
+        {
+            sweep += 2 * _S_pi;
+        }
+    }
+
+    [[nodiscard]] bool contains(int __x, int __y) const noexcept
+    {
+        double offset = _S_angle(__x + 0.5, __y + 0.5, cx, cy) - start;
+
+        if (offset < 0)
+        {
+            offset += 2 * _S_pi;
+        }
+
+        return offset <= sweep;
+    }
+};
+
+HDC GetDC(HWND __hwnd)
+{
+    _Sim_Begin_
+
+    if (__hwnd && __hwnd != _S_desktop && not _S_exists(server, __hwnd))
+    {
+        return nullptr;
+    }
+
+    return _S_gdi().open(__hwnd == _S_desktop ? nullptr : __hwnd);
+}
+
+int ReleaseDC(HWND, HDC __hdc)
+{
+    _Sim_Begin_
+    return _S_gdi().close(__hdc);
+}
+
+HWND WindowFromDC(HDC __hdc)
+{
+    _Sim_Begin_
+
+    HWND hwnd = nullptr;
+    _S_gdi().with(__hdc, [&](_DeviceContext& __dc) { hwnd = __dc.hwnd; });
+
+    return hwnd;
+}
+
+int GetDeviceCaps(HDC __hdc, int __index)
+{
+    _Sim_Begin_
+
+    if (not _S_gdi().with(__hdc, [](_DeviceContext&) { }))
+    {
+        return 0;
+    }
+
+    switch (__index)
+    {
+    case DESKTOPHORZRES: return server.options().screen.w();
+    case DESKTOPVERTRES: return server.options().screen.h();
+    default:             return 0;
+    }
+}
+
+HGDIOBJ SelectObject(HDC __hdc, HGDIOBJ __object)
+{
+    _Sim_Begin_
+    return _S_gdi().select(__hdc, __object);
+}
+
+HGDIOBJ GetCurrentObject(HDC __hdc, UINT __type)
+{
+    _Sim_Begin_
+
+    HGDIOBJ object = nullptr;
+
+    _S_gdi().with(__hdc, [&](_DeviceContext& __dc) {
+        if (HGDIOBJ* slot = _Gdi::_S_slot(__dc, __type))
+        {
+            object = *slot;
+        }
+    });
+
+    return object;
+}
+
+BOOL DeleteObject(HGDIOBJ __object)
+{
+    _Sim_Begin_
+    return _S_gdi().remove(__object);
+}
+
+int GetObjectA(HANDLE __object, int __size, LPVOID __buffer)
+{
+    _Sim_Begin_
+
+    std::optional<_GdiObject> object = _S_gdi().object(__object);
+
+    if (not object)
+    {
+        _S_lastError = ERROR_INVALID_HANDLE;
+        return 0;
+    }
+
+    std::vector<std::byte> data;
+
+    auto append = [&](const void* __data, std::size_t __length) {
+        const std::byte* bytes = static_cast<const std::byte*>(__data);
+        data.insert(data.end(), bytes, bytes + __length);
+    };
+
+    switch (object->type)
+    {
+    case OBJ_PEN:
+        if (object->extended)
+        {
+            append(&object->extendedPen, offsetof(EXTLOGPEN, elpStyleEntry));
+            append(object->styleEntries.data(), std::max<std::size_t>(object->styleEntries.size(), 1) * sizeof(DWORD));
+        }
+        else
+        {
+            append(&object->pen, sizeof(LOGPEN));
+        }
+        break;
+
+    case OBJ_BRUSH:
+        append(&object->brush, sizeof(LOGBRUSH));
+        break;
+
+    case OBJ_FONT:
+        append(&object->font, sizeof(LOGFONTA));
+        break;
+    }
+
+    if (__buffer == nullptr)
+    {
+        return static_cast<int>(data.size());
+    }
+
+    const std::size_t length = std::min<std::size_t>(data.size(), static_cast<std::size_t>(std::max(__size, 0)));
+    std::memcpy(__buffer, data.data(), length);
+
+    return static_cast<int>(length);
+}
+
+HPEN CreatePen(int __style, int __width, COLORREF __color)
+{
+    _Sim_Begin_
+
+    _GdiObject pen{ OBJ_PEN };
+    pen.pen = LOGPEN{ static_cast<UINT>(__style), POINT{ __width, 0 }, __color };
+
+    return static_cast<HPEN>(_S_gdi().create(std::move(pen)));
+}
+
+HPEN ExtCreatePen(DWORD __style, DWORD __width, const LOGBRUSH* __brush, DWORD __count, const DWORD* __styles)
+{
+    _Sim_Begin_
+
+    if (__brush == nullptr || (__count && __styles == nullptr) || __count > 16)
+    {
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return nullptr;
+    }
+
+    _GdiObject pen{ OBJ_PEN };
+    pen.extended = true;
+
+    pen.extendedPen.elpPenStyle = __style;
+    pen.extendedPen.elpWidth = __width;
+    pen.extendedPen.elpBrushStyle = __brush->lbStyle;
+    pen.extendedPen.elpColor = __brush->lbColor;
+    pen.extendedPen.elpHatch = __brush->lbHatch;
+    pen.extendedPen.elpNumEntries = __count;
+
+    pen.styleEntries.assign(__styles, __styles + __count);
+
+    return static_cast<HPEN>(_S_gdi().create(std::move(pen)));
+}
+
+HBRUSH CreateBrushIndirect(const LOGBRUSH* __brush)
+{
+    _Sim_Begin_
+
+    if (__brush == nullptr)
+    {
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return nullptr;
+    }
+
+    _GdiObject brush{ OBJ_BRUSH };
+    brush.brush = *__brush;
+
+    return static_cast<HBRUSH>(_S_gdi().create(std::move(brush)));
+}
+
+HBRUSH CreateSolidBrush(COLORREF __color)
+{
+    _Sim_Begin_
+
+    _GdiObject brush{ OBJ_BRUSH };
+    brush.brush = LOGBRUSH{ BS_SOLID, __color, 0 };
+
+    return static_cast<HBRUSH>(_S_gdi().create(std::move(brush)));
+}
+
+HBRUSH CreateHatchBrush(int __hatch, COLORREF __color)
+{
+    _Sim_Begin_
+
+    _GdiObject brush{ OBJ_BRUSH };
+    brush.brush = LOGBRUSH{ BS_HATCHED, __color, static_cast<ULONG_PTR>(__hatch) };
+
+    return static_cast<HBRUSH>(_S_gdi().create(std::move(brush)));
+}
+
+HFONT CreateFontIndirectA(const LOGFONTA* __font)
+{
+    _Sim_Begin_
+
+    if (__font == nullptr)
+    {
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return nullptr;
+    }
+
+    _GdiObject font{ OBJ_FONT };
+    font.font = *__font;
+
+    return static_cast<HFONT>(_S_gdi().create(std::move(font)));
+}
+
+HFONT CreateFontA(
+    int __height, int __width, int __escapement, int __orientation, int __weight,
+    DWORD __italic, DWORD __underline, DWORD __strikeOut, DWORD __charSet,
+    DWORD __outPrecision, DWORD __clipPrecision, DWORD __quality, DWORD __pitchAndFamily, LPCSTR __faceName)
+{
+    _Sim_Begin_
+
+    _GdiObject font{ OBJ_FONT };
+
+    font.font.lfHeight = __height;
+    font.font.lfWidth = __width;
+    font.font.lfEscapement = __escapement;
+    font.font.lfOrientation = __orientation;
+    font.font.lfWeight = __weight;
+    font.font.lfItalic = static_cast<BYTE>(__italic);
+    font.font.lfUnderline = static_cast<BYTE>(__underline);
+    font.font.lfStrikeOut = static_cast<BYTE>(__strikeOut);
+    font.font.lfCharSet = static_cast<BYTE>(__charSet);
+    font.font.lfOutPrecision = static_cast<BYTE>(__outPrecision);
+    font.font.lfClipPrecision = static_cast<BYTE>(__clipPrecision);
+    font.font.lfQuality = static_cast<BYTE>(__quality);
+    font.font.lfPitchAndFamily = static_cast<BYTE>(__pitchAndFamily);
+
+    _S_copy<char>(__faceName ? __faceName : "", font.font.lfFaceName, LF_FACESIZE);
+
+    return static_cast<HFONT>(_S_gdi().create(std::move(font)));
+}
+
+int EnumFontFamiliesExA(HDC, LOGFONTA* __font, FONTENUMPROCA __proc, LPARAM __lParam, DWORD)
+{
+    _Sim_Begin_
+
+    static const std::string_view _S_families[] = { "Arial", "Consolas", "Segoe UI", "Times New Roman" };
+
+    int result = 1;
+
+    for (std::string_view family : _S_families)
+    {
+        /// An empty face name enumerates all families.
+        if (__font && __font->lfFaceName[0] && family != __font->lfFaceName)
+        {
+            continue;
+        }
+
+        LOGFONTA font{};
+        font.lfHeight = 16;
+        font.lfWeight = 400;
+        font.lfCharSet = DEFAULT_CHARSET;
+
+        _S_copy<char>(family, font.lfFaceName, LF_FACESIZE);
+
+        TEXTMETRICA metric{};
+        metric.tmHeight = 16;
+        metric.tmAscent = 13;
+        metric.tmDescent = 3;
+        metric.tmWeight = 400;
+
+        if ((result = __proc(&font, &metric, TRUETYPE_FONTTYPE, __lParam)) == 0)
+        {
+            break;
+        }
+    }
+
+    return result;
+}
+
+COLORREF SetPixel(HDC __hdc, int __x, int __y, COLORREF __color)
+{
+    _Sim_Begin_
+
+    COLORREF result = CLR_INVALID;
+
+    _S_draw(server, __hdc, [&](const _Canvas& __canvas, WindowServer::Surface& __surface) {
+        if (__canvas.contains(__x, __y))
+        {
+            __canvas.plot(__surface, __x, __y, __color);
+            result = __color & 0x00ffffff;
+        }
+    });
+
+    return result;
+}
+
+COLORREF GetPixel(HDC __hdc, int __x, int __y)
+{
+    _Sim_Begin_
+
+    std::optional<_Canvas> canvas = _Canvas::open(server, __hdc);
+
+    if (not canvas || not canvas->contains(__x, __y))
+    {
+        return CLR_INVALID;
+    }
+
+    return server.pixel(Point(canvas->origin().x() + __x, canvas->origin().y() + __y));
+}
+
+/**
+ * @brief Replaces a member of the device context.
+ * 
+ * @return The previous value, __invalid if there is no such device context.
+ */
+template<typename _Tp, typename _Value>
+static _Tp _S_exchange(HDC __hdc, _Tp _DeviceContext::* __member, _Value __value, _Tp __invalid)
+{
+    _Tp previous = __invalid;
+    _S_gdi().with(__hdc, [&](_DeviceContext& __dc) { previous = std::exchange(__dc.*__member, static_cast<_Tp>(__value)); });
+
+    return previous;
+}
+
+template<typename _Tp>
+static _Tp _S_get(HDC __hdc, _Tp _DeviceContext::* __member, _Tp __invalid)
+{
+    _Tp value = __invalid;
+    _S_gdi().with(__hdc, [&](_DeviceContext& __dc) { value = __dc.*__member; });
+
+    return value;
+}
+
+COLORREF SetTextColor(HDC __hdc, COLORREF __color)
+{
+    _Sim_Begin_
+    return _S_exchange(__hdc, &_DeviceContext::textColor, __color, CLR_INVALID);
+}
+
+COLORREF GetTextColor(HDC __hdc)
+{
+    _Sim_Begin_
+    return _S_get(__hdc, &_DeviceContext::textColor, CLR_INVALID);
+}
+
+COLORREF SetBkColor(HDC __hdc, COLORREF __color)
+{
+    _Sim_Begin_
+    return _S_exchange(__hdc, &_DeviceContext::bkColor, __color, CLR_INVALID);
+}
+
+COLORREF GetBkColor(HDC __hdc)
+{
+    _Sim_Begin_
+    return _S_get(__hdc, &_DeviceContext::bkColor, CLR_INVALID);
+}
+
+int SetBkMode(HDC __hdc, int __mode)
+{
+    _Sim_Begin_
+    return _S_exchange(__hdc, &_DeviceContext::bkMode, __mode, 0);
+}
+
+int GetBkMode(HDC __hdc)
+{
+    _Sim_Begin_
+    return _S_get(__hdc, &_DeviceContext::bkMode, 0);
+}
+
+int SetROP2(HDC __hdc, int __mode)
+{
+    _Sim_Begin_
+    return _S_exchange(__hdc, &_DeviceContext::rop2, __mode, 0);
+}
+
+int GetROP2(HDC __hdc)
+{
+    _Sim_Begin_
+    return _S_get(__hdc, &_DeviceContext::rop2, 0);
+}
+
+BOOL SetMiterLimit(HDC __hdc, float __limit, float* __old)
+{
+    _Sim_Begin_
+
+    const float previous = _S_exchange(__hdc, &_DeviceContext::miterLimit, __limit, -1.0f);
+
+    if (previous < 0)
+    {
+        return false;
+    }
+
+    if (__old)
+    {
+        *__old = previous;
+    }
+
+    return true;
+}
+
+BOOL GetMiterLimit(HDC __hdc, float* __limit)
+{
+    _Sim_Begin_
+
+    const float limit = _S_get(__hdc, &_DeviceContext::miterLimit, -1.0f);
+
+    if (limit < 0)
+    {
+        return false;
+    }
+
+    *__limit = limit;
+    return true;
+}
+
+/// The text is not rasterized, only the device context is checked.
+
+BOOL TextOutA(HDC __hdc, int, int, LPCSTR, int)
+{
+    _Sim_Begin_
+    return _S_gdi().with(__hdc, [](_DeviceContext&) { });
+}
+
+BOOL TextOutW(HDC __hdc, int, int, LPCWSTR, int)
+{
+    _Sim_Begin_
+    return _S_gdi().with(__hdc, [](_DeviceContext&) { });
+}
+
+/// Returns the height of a line of the selected font.
+static int _S_lineHeight(HDC __hdc)
+{
+    HGDIOBJ font = nullptr;
+
+    if (not _S_gdi().with(__hdc, [&](_DeviceContext& __dc) { font = __dc.font; }))
+    {
+        return 0;
+    }
+
+    std::optional<_GdiObject> object = _S_gdi().object(font);
+    return object && object->font.lfHeight ? std::abs(object->font.lfHeight) : 16;
+}
+
+int DrawTextA(HDC __hdc, LPCSTR, int, RECT*, UINT)
+{
+    _Sim_Begin_
+    return _S_lineHeight(__hdc);
+}
+
+int DrawTextW(HDC __hdc, LPCWSTR, int, RECT*, UINT)
+{
+    _Sim_Begin_
+    return _S_lineHeight(__hdc);
+}
+
+BOOL MoveToEx(HDC __hdc, int __x, int __y, POINT* __old)
+{
+    _Sim_Begin_
+
+    const POINT previous = _S_exchange(__hdc, &_DeviceContext::position, POINT{ __x, __y }, POINT{ INT32_MIN, INT32_MIN });
+
+    if (previous.x == INT32_MIN)
+    {
+        return false;
+    }
+
+    if (__old)
+    {
+        *__old = previous;
+    }
+
+    return true;
+}
+
+BOOL GetCurrentPositionEx(HDC __hdc, POINT* __point)
+{
+    _Sim_Begin_
+    return _S_gdi().with(__hdc, [&](_DeviceContext& __dc) { *__point = __dc.position; });
+}
+
+BOOL LineTo(HDC __hdc, int __x, int __y)
+{
+    _Sim_Begin_
+
+    const BOOL result = _S_draw(server, __hdc, [&](const _Canvas& __canvas, WindowServer::Surface& __surface) {
+        __canvas.line(__surface, __canvas.position, POINT{ __x, __y });
+    });
+
+    if (result)
+    {
+        _S_gdi().with(__hdc, [&](_DeviceContext& __dc) { __dc.position = POINT{ __x, __y }; });
+    }
+
+    return result;
+}
+
+BOOL Polyline(HDC __hdc, const POINT* __points, int __count)
+{
+    _Sim_Begin_
+
+    if (__points == nullptr || __count < 2)
+    {
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return false;
+    }
+
+    const std::vector<POINT> points(__points, __points + __count);
+
+    return _S_draw(server, __hdc, [&](const _Canvas& __canvas, WindowServer::Surface& __surface) {
+        __canvas.polyline(__surface, points);
+    });
+}
+
+BOOL Polygon(HDC __hdc, const POINT* __points, int __count)
+{
+    _Sim_Begin_
+
+    if (__points == nullptr || __count < 2)
+    {
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return false;
+    }
+
+    const std::vector<POINT> points(__points, __points + __count);
+
+    RECT box{ INT32_MAX, INT32_MAX, INT32_MIN, INT32_MIN };
+
+    for (const POINT& p : points)
+    {
+        box = RECT{ std::min(box.left, p.x), std::min(box.top, p.y), std::max(box.right, p.x + 1), std::max(box.bottom, p.y + 1) };
+    }
+
+    /// Even-odd rule at the pixel centers.
+    auto inside = [&](int __x, int __y) {
+        const double x = __x + 0.5;
+        const double y = __y + 0.5;
+
+        bool result = false;
+
+        for (std::size_t i = 0, j = points.size() - 1; i < points.size(); j = i++)
+        {
+            const POINT& a = points[i];
+            const POINT& b = points[j];
+
+            if ((a.y > y) != (b.y > y) && x < (b.x - a.x) * (y - a.y) / static_cast<double>(b.y - a.y) + a.x)
+            {
+                result = not result;
+            }
+        }
+
+        return result;
+    };
+
+    return _S_draw(server, __hdc, [&](const _Canvas& __canvas, WindowServer::Surface& __surface) {
+        __canvas.shape(__surface, box, inside, true, [](int, int) { return false; });
+
+        std::vector<POINT> outline = points;
+        outline.push_back(points.front());
+
+        __canvas.polyline(__surface, outline);
+    });
+}
+
+/// Samples the cubic Bézier curves into lines.
+BOOL PolyBezier(HDC __hdc, const POINT* __points, DWORD __count)
+{
+    _Sim_Begin_
+
+    if (__points == nullptr || __count < 4 || (__count - 1) % 3 != 0)
+    {
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return false;
+    }
+
+    constexpr int steps = 32;
+
+    std::vector<POINT> points{ __points[0] };
+
+    for (DWORD i = 0; i + 3 < __count; i += 3)
+    {
+        const POINT* p = __points + i;
+
+        for (int s = 1; s <= steps; ++s)
+        {
+            const double t = static_cast<double>(s) / steps;
+            const double u = 1 - t;
+
+            const double a = u * u * u;
+            const double b = 3 * u * u * t;
+            const double c = 3 * u * t * t;
+            const double d = t * t * t;
+
+            points.push_back(POINT{
+                static_cast<LONG>(std::lround(a * p[0].x + b * p[1].x + c * p[2].x + d * p[3].x)),
+                static_cast<LONG>(std::lround(a * p[0].y + b * p[1].y + c * p[2].y + d * p[3].y)) });
+        }
+    }
+
+    return _S_draw(server, __hdc, [&](const _Canvas& __canvas, WindowServer::Surface& __surface) {
+        __canvas.polyline(__surface, points);
+    });
+}
+
+BOOL Rectangle(HDC __hdc, int __left, int __top, int __right, int __bottom)
+{
+    _Sim_Begin_
+
+    const RECT box{ __left, __top, __right, __bottom };
+
+    return _S_draw(server, __hdc, [&](const _Canvas& __canvas, WindowServer::Surface& __surface) {
+        __canvas.shape(
+            __surface,
+            box,
+            [&](int __x, int __y) { return __x >= box.left && __x < box.right && __y >= box.top && __y < box.bottom; },
+            true,
+            [](int, int) { return true; });
+    });
+}
+
+BOOL RoundRect(HDC __hdc, int __left, int __top, int __right, int __bottom, int __width, int __height)
+{
+    _Sim_Begin_
+
+    const RECT box{ __left, __top, __right, __bottom };
+
+    const double rx = std::min(__width, __right - __left) / 2.0;
+    const double ry = std::min(__height, __bottom - __top) / 2.0;
+
+    /// Inside the rect, and inside the ellipses of the corners.
+    auto inside = [&](int __x, int __y) {
+        if (__x < box.left || __x >= box.right || __y < box.top || __y >= box.bottom)
+        {
+            return false;
+        }
+
+        if (rx <= 0 || ry <= 0)
+        {
+            return true;
+        }
+
+        const double x = __x + 0.5;
+        const double y = __y + 0.5;
+
+        const double dx = std::max({ box.left + rx - x, x - (box.right - rx), 0.0 }) / rx;
+        const double dy = std::max({ box.top + ry - y, y - (box.bottom - ry), 0.0 }) / ry;
+
+        return dx * dx + dy * dy <= 1.0;
+    };
+
+    return _S_draw(server, __hdc, [&](const _Canvas& __canvas, WindowServer::Surface& __surface) {
+        __canvas.shape(__surface, box, inside, true, [](int, int) { return true; });
+    });
+}
+
+BOOL Ellipse(HDC __hdc, int __left, int __top, int __right, int __bottom)
+{
+    _Sim_Begin_
+
+    const RECT box{ __left, __top, __right, __bottom };
+
+    return _S_draw(server, __hdc, [&](const _Canvas& __canvas, WindowServer::Surface& __surface) {
+        __canvas.shape(
+            __surface,
+            box,
+            [&](int __x, int __y) { return _S_inEllipse(box, __x, __y); },
+            true,
+            [](int, int) { return true; });
+    });
+}
+
+BOOL Arc(HDC __hdc, int __left, int __top, int __right, int __bottom, int __x1, int __y1, int __x2, int __y2)
+{
+    _Sim_Begin_
+
+    const RECT box{ __left, __top, __right, __bottom };
+    const _Arc arc(box, __x1, __y1, __x2, __y2);
+
+    return _S_draw(server, __hdc, [&](const _Canvas& __canvas, WindowServer::Surface& __surface) {
+        __canvas.shape(
+            __surface,
+            box,
+            [&](int __x, int __y) { return _S_inEllipse(box, __x, __y); },
+            false,
+            [&](int __x, int __y) { return arc.contains(__x, __y); });
+    });
+}
+
+BOOL Chord(HDC __hdc, int __left, int __top, int __right, int __bottom, int __x1, int __y1, int __x2, int __y2)
+{
+    _Sim_Begin_
+
+    const RECT box{ __left, __top, __right, __bottom };
+    const _Arc arc(box, __x1, __y1, __x2, __y2);
+
+    /// The chord joins the ends of the arc on the ellipse.
+    const double rx = (box.right - box.left) / 2.0;
+    const double ry = (box.bottom - box.top) / 2.0;
+
+    const double ax = arc.cx + rx * std::cos(arc.start);
+    const double ay = arc.cy - ry * std::sin(arc.start);
+    const double bx = arc.cx + rx * std::cos(arc.start + arc.sweep);
+    const double by = arc.cy - ry * std::sin(arc.start + arc.sweep);
+
+    const double mx = arc.cx + rx * std::cos(arc.start + arc.sweep / 2);
+    const double my = arc.cy - ry * std::sin(arc.start + arc.sweep / 2);
+
+    auto side = [&](double __x, double __y) { return (bx - ax) * (__y - ay) - (by - ay) * (__x - ax); };
+
+    const bool arcSide = side(mx, my) >= 0;
+
+    return _S_draw(server, __hdc, [&](const _Canvas& __canvas, WindowServer::Surface& __surface) {
+        __canvas.shape(
+            __surface,
+            box,
+            [&](int __x, int __y) { return _S_inEllipse(box, __x, __y) && (side(__x + 0.5, __y + 0.5) >= 0) == arcSide; },
+            true,
+            [](int, int) { return true; });
+    });
+}
+
+BOOL Pie(HDC __hdc, int __left, int __top, int __right, int __bottom, int __x1, int __y1, int __x2, int __y2)
+{
+    _Sim_Begin_
+
+    const RECT box{ __left, __top, __right, __bottom };
+    const _Arc arc(box, __x1, __y1, __x2, __y2);
+
+    return _S_draw(server, __hdc, [&](const _Canvas& __canvas, WindowServer::Surface& __surface) {
+        __canvas.shape(
+            __surface,
+            box,
+            [&](int __x, int __y) { return _S_inEllipse(box, __x, __y) && arc.contains(__x, __y); },
+            true,
+            [](int, int) { return true; });
+    });
+}
+
+/// A line from the current position to the start of the arc, then the arc.
+BOOL AngleArc(HDC __hdc, int __x, int __y, DWORD __radius, float __start, float __sweep)
+{
+    _Sim_Begin_
+
+    const double start = __start * _S_pi / 180;
+    const double sweep = __sweep * _S_pi / 180;
+
+    const int steps = std::max(8, static_cast<int>(std::abs(sweep) * __radius / 4));
+
+    std::vector<POINT> points;
+
+    if (not _S_gdi().with(__hdc, [&](_DeviceContext& __dc) { points.push_back(__dc.position); }))
+    {
+        return false;
+    }
+
+    for (int s = 0; s <= steps; ++s)
+    {
+        const double angle = start + sweep * s / steps;
+
+        points.push_back(POINT{
+            static_cast<LONG>(std::lround(__x + __radius * std::cos(angle))),
+            static_cast<LONG>(std::lround(__y - __radius * std::sin(angle))) });
+    }
+
+    const BOOL result = _S_draw(server, __hdc, [&](const _Canvas& __canvas, WindowServer::Surface& __surface) {
+        __canvas.polyline(__surface, points);
+    });
+
+    if (result)
+    {
+        _S_gdi().with(__hdc, [&](_DeviceContext& __dc) { __dc.position = points.back(); });
+    }
+
+    return result;
+}
+
+BOOL InvertRect(HDC __hdc, const RECT* __rect)
+{
+    _Sim_Begin_
+
+    if (__rect == nullptr)
+    {
+        _S_lastError = ERROR_INVALID_PARAMETER;
+        return false;
+    }
+
+    return _S_draw(server, __hdc, [&](const _Canvas& __canvas, WindowServer::Surface& __surface) {
+        __canvas.invert(__surface, *__rect);
+    });
+}
+
+#endif  // OPENWIN_SIMULATED_BACKEND
\ No newline at end of file
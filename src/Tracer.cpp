@@ -0,0 +1,400 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* Tracer.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 15:02:16
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Implement Tracer.h
+*/
+
+#include <openWin/Tracer.h>
+
+#include "Built-in/_Windows.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace win;
+
+std::atomic<std::uint32_t> Tracer::_S_generation = 0;
+
+struct _TraceEvent
+{
+    /// CallSite::none for an end event.
+    CallSiteId site;
+    const void* handle;
+
+    std::int64_t time;
+};
+
+class _TraceShard;
+
+/**
+ * @brief The file of the current trace and all the live shards.
+ * 
+ * @note  Never destroyed, threads may exit during shutdown.
+ */
+struct _TraceWriter
+{
+    /// Guards everything below, taken before the lock of any shard.
+    std::mutex mutex;
+
+    std::FILE* file = nullptr;
+    std::uint32_t generation = 0;
+
+    std::chrono::steady_clock::time_point epoch;
+
+    std::vector<_TraceShard*> shards;
+
+    void write(const std::string& __text, std::uint32_t __generation)
+    {
+        if (file && generation == __generation && not __text.empty())
+        {
+            std::fwrite(__text.data(), 1, __text.size(), file);
+        }
+    }
+
+    [[nodiscard]] static _TraceWriter& instance() noexcept
+    {
+        static _TraceWriter* const _S_writer = new _TraceWriter;
+        return *_S_writer;
+    }
+};
+
+/**
+ * @brief The events of one thread, formatted to JSON in batches so that the
+ *        file is written once per batch instead of once per event.
+ */
+class _TraceShard
+{
+public:
+
+    static constexpr std::size_t batchSize = 4096;
+
+    _TraceShard()
+        : _M_tid(GetCurrentThreadId())
+    {
+        _M_events.reserve(batchSize);
+
+        _TraceWriter& writer = _TraceWriter::instance();
+
+        std::lock_guard<std::mutex> _L_guard(writer.mutex);
+        writer.shards.push_back(this);
+    }
+
+    ~_TraceShard()
+    {
+        _TraceWriter& writer = _TraceWriter::instance();
+
+        std::lock_guard<std::mutex> _L_guard(writer.mutex);
+
+        std::erase(writer.shards, this);
+
+        std::string text;
+        std::uint32_t generation = take(text, writer.epoch);
+
+        writer.write(text, generation);
+    }
+
+    _TraceShard(const _TraceShard&) = delete;
+    _TraceShard& operator=(const _TraceShard&) = delete;
+
+    /**
+     * @return true if the batch is full.
+     */
+    [[nodiscard]] bool push(std::uint32_t __generation, const _TraceEvent& __event) noexcept
+    {
+        _M_lock();
+
+        if (_M_generation != __generation)
+        {
+            _M_events.clear();
+            _M_path.clear();
+
+            _M_generation = __generation;
+        }
+
+        try
+        {
+            _M_events.push_back(__event);
+        }
+        catch (...)
+        {
+            /// Out of memory, the event is lost.
+        }
+
+        const bool full = _M_events.size() >= batchSize;
+
+        _M_unlock();
+        return full;
+    }
+
+    /**
+     * @brief Formats and removes the buffered events.
+     * 
+     * @return The generation of the trace the events belong to.
+     */
+    std::uint32_t take(std::string& __text, std::chrono::steady_clock::time_point __epoch)
+    {
+        _M_lock();
+
+        const std::uint32_t generation = _M_generation;
+
+        try
+        {
+            _M_format(__text, __epoch);
+        }
+        catch (...)
+        { }
+
+        _M_events.clear();
+
+        _M_unlock();
+        return generation;
+    }
+
+private:
+
+    void _M_format(std::string& __text, std::chrono::steady_clock::time_point __epoch)
+    {
+        static const DWORD _S_pid = GetCurrentProcessId();
+
+        const std::int64_t epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            __epoch.time_since_epoch()).count();
+
+        char buffer[96];
+
+        for (const _TraceEvent& event : _M_events)
+        {
+            const std::int64_t time = std::max<std::int64_t>(event.time - epoch, 0);
+
+            if (event.site != CallSite::none)
+            {
+                _M_path.push_back(event.site);
+
+                __text += "{\"name\":\"";
+                _S_escape(__text, event.site);
+                __text += "\",\"cat\":\"openWin\",\"ph\":\"B\"";
+            }
+            else
+            {
+                __text += "{\"ph\":\"E\"";
+            }
+
+            std::snprintf(buffer, sizeof(buffer), ",\"ts\":%lld.%03lld,\"pid\":%lu,\"tid\":%lu",
+                static_cast<long long>(time / 1000), static_cast<long long>(time % 1000),
+                static_cast<unsigned long>(_S_pid), static_cast<unsigned long>(_M_tid));
+
+            __text += buffer;
+
+            if (event.site != CallSite::none)
+            {
+                std::snprintf(buffer, sizeof(buffer), ",\"args\":{\"handle\":\"%p\",\"path\":\"", event.handle);
+
+                __text += buffer;
+
+                for (CallSiteId work : _M_path)
+                {
+                    _S_escape(__text, work);
+                    __text += '/';
+                }
+
+                __text += "\"}";
+            }
+            else if (not _M_path.empty())
+            {
+                _M_path.pop_back();
+            }
+
+            __text += "},\n";
+        }
+    }
+
+    static void _S_escape(std::string& __text, CallSiteId __site)
+    {
+        const char* name = CallSite::name(__site);
+
+        if (name == nullptr)
+        {
+            char buffer[16];
+            std::snprintf(buffer, sizeof(buffer), "#%08lx", static_cast<unsigned long>(__site));
+
+            __text += buffer;
+            return;
+        }
+
+        _S_escape(__text, name);
+    }
+
+    static void _S_escape(std::string& __text, const char* __str)
+    {
+        for (; *__str; ++__str)
+        {
+            if (*__str == '"' || *__str == '\\')
+            {
+                __text += '\\';
+            }
+
+            if (static_cast<unsigned char>(*__str) >= 0x20)
+            {
+                __text += *__str;
+            }
+        }
+    }
+
+    void _M_lock() noexcept
+    {
+        while (_M_flag.test_and_set(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void _M_unlock() noexcept
+    {
+        _M_flag.clear(std::memory_order_release);
+    }
+
+    std::atomic_flag _M_flag = ATOMIC_FLAG_INIT;
+
+    std::vector<_TraceEvent> _M_events;
+    std::uint32_t _M_generation = 0;
+
+    /// The calls begun and not ended yet, replayed from the events.
+    std::vector<CallSiteId> _M_path;
+
+    const DWORD _M_tid;
+};
+
+static _TraceShard& _S_localShard()
+{
+    thread_local _TraceShard _S_shard;
+    return _S_shard;
+}
+
+static void _S_push(const _TraceEvent& __event) noexcept
+{
+    const std::uint32_t generation = Tracer::generation();
+
+    try
+    {
+        _TraceShard& shard = _S_localShard();
+
+        if (shard.push(generation, __event))
+        {
+            _TraceWriter& writer = _TraceWriter::instance();
+
+            std::string text;
+            text.reserve(_TraceShard::batchSize * 160);
+
+            std::lock_guard<std::mutex> _L_guard(writer.mutex);
+
+            writer.write(text, shard.take(text, writer.epoch));
+        }
+    }
+    catch (...)
+    { }
+}
+
+bool Tracer::start(const std::string& __path)
+{
+    stop();
+
+    _TraceWriter& writer = _TraceWriter::instance();
+
+    std::lock_guard<std::mutex> _L_guard(writer.mutex);
+
+    writer.file = std::fopen(__path.c_str(), "wb");
+
+    if (writer.file == nullptr)
+    {
+        return false;
+    }
+
+    std::setvbuf(writer.file, nullptr, _IOFBF, 1 << 20);
+    std::fputs("[\n", writer.file);
+
+    writer.epoch = std::chrono::steady_clock::now();
+    writer.generation = _S_generation.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    return true;
+}
+
+void Tracer::stop()
+{
+    _TraceWriter& writer = _TraceWriter::instance();
+
+    std::lock_guard<std::mutex> _L_guard(writer.mutex);
+
+    if (writer.file == nullptr)
+    {
+        return;
+    }
+
+    std::string text;
+
+    for (_TraceShard* shard : writer.shards)
+    {
+        writer.write(text, shard->take(text, writer.epoch));
+        text.clear();
+    }
+
+    _S_generation.fetch_add(1, std::memory_order_relaxed);
+
+    /// Ends with a metadata event, so that no event is followed by a dangling
+    /// comma.
+
+    std::fputs("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":", writer.file);
+    std::fprintf(writer.file, "%lu", static_cast<unsigned long>(GetCurrentProcessId()));
+    std::fputs(",\"args\":{\"name\":\"openWin\"}}\n]\n", writer.file);
+
+    std::fclose(writer.file);
+    writer.file = nullptr;
+}
+
+void Tracer::flush()
+{
+    _TraceWriter& writer = _TraceWriter::instance();
+
+    std::lock_guard<std::mutex> _L_guard(writer.mutex);
+
+    if (writer.file == nullptr)
+    {
+        return;
+    }
+
+    std::string text;
+
+    for (_TraceShard* shard : writer.shards)
+    {
+        writer.write(text, shard->take(text, writer.epoch));
+        text.clear();
+    }
+
+    std::fflush(writer.file);
+}
+
+void Tracer::begin(CallSiteId __site, const void* __handle) noexcept
+{
+    _S_push({ __site, __handle,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count() });
+}
+
+void Tracer::end() noexcept
+{
+    _S_push({ CallSite::none, nullptr,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count() });
+}
\ No newline at end of file
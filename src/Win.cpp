@@ -20,58 +20,238 @@
 #include "Built-in/_Windows.h"
 #include "Built-in/_MacrosForErrorHandling.h"
 
+#include <unordered_map>
+
 using namespace win;
 
 static inline HWND $(Win::Handle __handle) noexcept
 { return reinterpret_cast<HWND>(__handle); }
 
+/**
+ * @return true for the messages known to carry no pointer in their lParam,
+ *         the others are journaled without it and not replayed.
+ */
+static inline bool _S_isScalarMessage(Win::Message::msg_type __msg) noexcept
+{
+    switch (__msg)
+    {
+    case WM_CLOSE:
+    case WM_QUIT:
+    case WM_KEYDOWN:
+    case WM_KEYUP:
+    case WM_CHAR:
+    case WM_CUT:
+    case WM_COPY:
+    case WM_PASTE:
+    case WM_CLEAR:
+    case WM_UNDO:
+    case WM_HOTKEY:
+        return true;
 
-Win::Win() noexcept
-    : _M_handle(nullptr)
-    , _M_errorStream(new ErrorStream)
-{ }
-
-Win::Win(Win::Handle __handle) noexcept
-    : _M_handle(__handle)
-    , _M_errorStream(new ErrorStream)
-{ }
+    default:
+        return false;
+    }
+}
 
-Win& Win::operator=(Win::Handle __handle) noexcept
+/**
+ * @brief The error streams attached to window handles in the calling thread.
+ * 
+ *        The ones attached by a failure are released by the next outermost
+ *        call on the window that succeeds, and are bounded in number: beyond
+ *        _S_maxAutomatic, those of the destroyed windows are released first,
+ *        then any of them down to half.
+ */
+class _AttachedErrorStreams
 {
-    _M_handle = __handle;
-    return *this;
-}
+public:
 
-Win::Win(const Win& __win) noexcept
-    : Win(__win._M_handle)
-{ }
+    static constexpr std::size_t _S_maxAutomatic = 256;
 
-Win& Win::operator=(const Win& __win) noexcept
-{
-    _M_handle = __win._M_handle;
-    return *this;
-}
+    [[nodiscard]] static _AttachedErrorStreams& local() noexcept
+    {
+        thread_local _AttachedErrorStreams _S_streams;
+        return _S_streams;
+    }
 
-Win::Win(Win&& __win) noexcept
-    : _M_handle(__win._M_handle)
-    , _M_errorStream(__win._M_errorStream)
-{
-    __win._M_errorStream = nullptr;
-}
+    [[nodiscard]] ErrorStream* find(Win::Handle __handle) noexcept
+    {
+        if (_M_streams.empty())
+        {
+            return nullptr;
+        }
 
-Win& Win::operator=(Win&& __win) noexcept
-{
-    _M_handle = __win._M_handle;
-    std::swap(_M_errorStream, __win._M_errorStream);
-    return *this;
-}
+        auto it = _M_streams.find(__handle);
+        return it != _M_streams.end() ? &it->second.stream : nullptr;
+    }
 
-Win::~Win() noexcept
-{
-    if (_M_errorStream)
+    /**
+     * @brief Attaches a stream requested by the user, kept until detached.
+     */
+    ErrorStream& attach(Win::Handle __handle)
+    {
+        _Entry& entry = _M_streams[__handle];
+
+        if (entry.automatic)
+        {
+            entry.automatic = false;
+            --_M_automatic;
+        }
+
+        return entry.stream;
+    }
+
+    void attach(Win::Handle __handle, const ErrorStream& __stream)
+    {
+        attach(__handle) = __stream;
+    }
+
+    /**
+     * @brief Attaches the errors of a failed call.
+     */
+    void attachFailure(Win::Handle __handle, const ErrorStream& __stream)
+    {
+        auto [it, inserted] = _M_streams.try_emplace(__handle);
+
+        it->second.stream = __stream;
+
+        if (inserted)
+        {
+            it->second.automatic = true;
+
+            if (++_M_automatic > _S_maxAutomatic)
+            {
+                _M_shrink(__handle);
+            }
+        }
+    }
+
+    /**
+     * @brief Releases the stream if it was attached by a failure.
+     */
+    void onSuccess(Win::Handle __handle) noexcept
+    {
+        auto it = _M_streams.find(__handle);
+
+        if (it != _M_streams.end() && it->second.automatic)
+        {
+            _M_streams.erase(it);
+            --_M_automatic;
+        }
+    }
+
+    void detach(Win::Handle __handle) noexcept
+    {
+        auto it = _M_streams.find(__handle);
+
+        if (it != _M_streams.end())
+        {
+            _M_automatic -= it->second.automatic;
+            _M_streams.erase(it);
+        }
+    }
+
+private:
+
+    struct _Entry
+    {
+        ErrorStream stream;
+        bool automatic = false;
+    };
+
+    void _M_shrink(Win::Handle __keep) noexcept
+    {
+        const auto release = [this, __keep](auto&& __pred) {
+            for (auto it = _M_streams.begin(); it != _M_streams.end() && _M_automatic > _S_maxAutomatic / 2; )
+            {
+                if (it->second.automatic && it->first != __keep && __pred(it->first))
+                {
+                    it = _M_streams.erase(it);
+                    --_M_automatic;
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        };
+
+        release([](Win::Handle __handle) noexcept { return not IsWindow($(__handle)); });
+        release([](Win::Handle) noexcept { return true; });
+    }
+
+    std::unordered_map<Win::Handle, _Entry> _M_streams;
+
+    /// The number of the streams attached by a failure.
+    std::size_t _M_automatic = 0;
+};
+
+/**
+ * @brief Selects the error stream for a guarded call of Win: the stream
+ *        attached to the window if there is one, otherwise the global stream
+ *        of the calling thread.
+ * 
+ *        When an outermost call fails on the global stream, its errors are
+ *        moved into a new stream attached to the window, so that success()
+ *        and failed() of the window report them.
+ */
+class _WinErrorStreamBinder
+{
+public:
+
+    explicit _WinErrorStreamBinder(Win::Handle __handle) noexcept
+        : _M_handle(__handle)
+        , _M_stream(_AttachedErrorStreams::local().find(__handle))
+    {
+        if (_M_stream == nullptr)
+        {
+            _M_stream = ErrorStream::global();
+            _M_global = true;
+        }
+    }
+
+    ~_WinErrorStreamBinder()
     {
-        delete _M_errorStream;
+        if (_M_stream->depth() != 0)
+        {
+            return;
+        }
+
+        if (_M_global)
+        {
+            if (_M_stream->failed())
+            {
+                _AttachedErrorStreams::local().attachFailure(_M_handle, *_M_stream);
+            }
+        }
+        else if (_M_stream->success())
+        {
+            _AttachedErrorStreams::local().onSuccess(_M_handle);
+        }
     }
+
+    _WinErrorStreamBinder(const _WinErrorStreamBinder&) = delete;
+    _WinErrorStreamBinder& operator=(const _WinErrorStreamBinder&) = delete;
+
+    [[nodiscard]] ErrorStream* stream() const noexcept
+    { return _M_stream; }
+
+private:
+
+    Win::Handle _M_handle;
+    ErrorStream* _M_stream;
+
+    bool _M_global = false;
+};
+
+
+Win::Win(Win::Handle __handle) noexcept
+    : _M_handle(__handle)
+{ }
+
+Win& Win::operator=(Win::Handle __handle) noexcept
+{
+    _M_handle = __handle;
+    return *this;
 }
 
 void Win::setHandle(Win::Handle __handle) noexcept
@@ -86,27 +266,50 @@ Win::Handle Win::handle() const noexcept
 
 void Win::setErrorStream(const ErrorStream& __es)
 {
-    *_M_errorStream = __es;
+    _AttachedErrorStreams::local().attach(_M_handle, __es);
 }
 
 ErrorStream& Win::errorStream() noexcept
 {
-    return *_M_errorStream;
+    return _AttachedErrorStreams::local().attach(_M_handle);
 }
 
 const ErrorStream& Win::errorStream() const noexcept
 {
-    return *_M_errorStream;
+    static const ErrorStream _S_empty;
+
+    const ErrorStream* es = _AttachedErrorStreams::local().find(_M_handle);
+    return es != nullptr ? *es : _S_empty;
+}
+
+bool Win::hasErrorStream() const noexcept
+{
+    return _AttachedErrorStreams::local().find(_M_handle) != nullptr;
+}
+
+void Win::detachErrorStream() const noexcept
+{
+    _AttachedErrorStreams::local().detach(_M_handle);
 }
 
 bool Win::success() const noexcept
 {
-    return _M_errorStream->success();
+#if defined(OPENWIN_LEAN_ERRORS)
+    return LeanErrorStream::local()->success();
+#else
+    const ErrorStream* es = _AttachedErrorStreams::local().find(_M_handle);
+    return es == nullptr || es->success();
+#endif
 }
 
 bool Win::failed() const noexcept
 {
-    return _M_errorStream->failed();
+#if defined(OPENWIN_LEAN_ERRORS)
+    return LeanErrorStream::local()->failed();
+#else
+    const ErrorStream* es = _AttachedErrorStreams::local().find(_M_handle);
+    return es != nullptr && es->failed();
+#endif
 }
 
 Win Win::findByPoint(const Point& __point) noexcept
@@ -236,19 +439,16 @@ Win Win::currentCaptureWindowFromThread(Win::ThreadId __threadId) noexcept
 void Win::swap(Win& __other) & noexcept
 {
     std::swap(_M_handle, __other._M_handle);
-    std::swap(_M_errorStream, __other._M_errorStream);
 }
 
 void Win::swap(Win& __other) && noexcept
 {
     __other._M_handle = _M_handle;
-    std::swap(_M_errorStream, __other._M_errorStream);
 }
 
 void Win::swap(Win&& __other) noexcept
 {
     _M_handle = __other._M_handle;
-    std::swap(_M_errorStream, __other._M_errorStream);
 }
 
 int Win::compare(const Win& __other) const noexcept
@@ -297,6 +497,7 @@ bool Win::isNotResponding() const noexcept
 void Win::setEnable(bool __enable) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetEnable, __enable)
     EnableWindow($(_M_handle), __enable);
 }
 
@@ -309,6 +510,7 @@ bool Win::isEnabled() const noexcept
 void Win::setActive() const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetActive)
     SetActiveWindow($(_M_handle));
 }
 
@@ -336,6 +538,7 @@ bool Win::isNoActive() const noexcept
 void Win::setForeground(bool __lock) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetForeground, __lock)
 
     bool ret = SetForegroundWindow($(_M_handle));
     _Win_Test_(ret)
@@ -355,18 +558,21 @@ bool Win::isForeground() const noexcept
 void Win::lockSetForeground() noexcept
 {
     _Win_Static_Begin_
+    _Win_Static_Journal_(LockSetForeground)
     LockSetForegroundWindow(LSFW_LOCK);
 }
 
 void Win::unlockSetForeground() noexcept
 {
     _Win_Static_Begin_
+    _Win_Static_Journal_(UnlockSetForeground)
     LockSetForegroundWindow(LSFW_UNLOCK);
 }
 
 void Win::setFocus() const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetFocus)
     SetFocus($(_M_handle));
 }
 
@@ -379,6 +585,7 @@ bool Win::hasFocus() const noexcept
 void Win::setCapture(bool __enable) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetCapture, __enable)
     if (__enable)
         SetCapture($(_M_handle));
     else
@@ -428,6 +635,7 @@ float Win::systemDpi() noexcept
 void Win::setParent(const Win& __newParent) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetParent, static_cast<std::int64_t>(reinterpret_cast<std::uintptr_t>(__newParent._M_handle)))
 
     if (__newParent.isEmpty())
     {
@@ -447,6 +655,7 @@ void Win::setParent(const Win& __newParent) const noexcept
 void Win::setParent(std::nullptr_t) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetParent, 0)
 
     _M_delExtendStyle(WS_CHILD);
 
@@ -555,6 +764,7 @@ bool Win::isChildOf(const Win& __parent) const noexcept
 int Win::setTile(Win::Orientation __orientation) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetTile, __orientation)
     return static_cast<int>(
         TileWindows(
             $(_M_handle),
@@ -567,6 +777,7 @@ int Win::setTile(Win::Orientation __orientation) const noexcept
 int Win::setTile(Win::Orientation __orientation, const Rect& __clientRect) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetTileIn, __orientation, __clientRect.x(), __clientRect.y(), __clientRect.w(), __clientRect.h())
     RECT r;
 
     r.left = __clientRect.x();
@@ -644,6 +855,7 @@ WinList Win::listFromThread(Win::ThreadId __threadId) noexcept
 void Win::setZOrderTop() const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetZOrderTop)
     SetWindowPos(
         $(_M_handle),
         HWND_TOP,
@@ -654,6 +866,7 @@ void Win::setZOrderTop() const noexcept
 void Win::setZOrderBottom() const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetZOrderBottom)
     SetWindowPos(
         $(_M_handle),
         HWND_BOTTOM,
@@ -664,6 +877,7 @@ void Win::setZOrderBottom() const noexcept
 void Win::setTopmost(bool __enable) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetTopmost, __enable)
     SetWindowPos(
         $(_M_handle),
         __enable ? HWND_TOPMOST : HWND_NOTOPMOST,
@@ -765,12 +979,14 @@ bool Win::isMDIChild() const noexcept
 void Win::show() const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(Show)
     ShowWindow($(_M_handle), SW_SHOW);
 }
 
 void Win::hide() const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(Hide)
     ShowWindow($(_M_handle), SW_HIDE);
 }
 
@@ -783,18 +999,21 @@ bool Win::isVisible() const noexcept
 void Win::showPopups() const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(ShowPopups)
     ShowOwnedPopups($(_M_handle), true);
 }
 
 void Win::hidePopups() const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(HidePopups)
     ShowOwnedPopups($(_M_handle), false);
 }
 
 void Win::setDisplayProtection(bool __enable) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetDisplayProtection, __enable)
 
     if (__enable)
     {
@@ -831,12 +1050,14 @@ bool Win::isDisplayProtected() const noexcept
 void Win::maximize() const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(Maximize)
     ShowWindow($(_M_handle), SW_MAXIMIZE);
 }
 
 void Win::minimize() const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(Minimize)
     ShowWindow(
         $(_M_handle),
         isCreatedByCurrentThread() ? SW_MINIMIZE : SW_FORCEMINIMIZE);
@@ -845,6 +1066,7 @@ void Win::minimize() const noexcept
 void Win::restore() const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(Restore)
     ShowWindow($(_M_handle), SW_RESTORE);
 }
 
@@ -892,12 +1114,14 @@ bool Win::isArranged() const noexcept
 void Win::setTitle(const Win::String& __title) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetTitleA, std::string_view(__title))
     SetWindowTextA($(_M_handle), __title.c_str());
 }
 
 void Win::setTitle(const Win::WString& __title) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetTitleW, std::wstring_view(__title))
     SetWindowTextW($(_M_handle), __title.c_str());
 }
 
@@ -1010,6 +1234,7 @@ Win::WString Win::WIN_FW(path)() const noexcept
 void Win::setRect(const Rect& __rect) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetRect, __rect.x(), __rect.y(), __rect.w(), __rect.h())
 
     Size sz(__rect.size().physics(dpi()));
 
@@ -1056,6 +1281,7 @@ Rect Win::clientRect() const noexcept
 void Win::setPos(const Point& __point) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetPos, __point.x(), __point.y())
 
     Point p(__point.physics(dpi()));
 
@@ -1077,7 +1303,10 @@ void Win::setPos(const Point& __point, const pg::BasicPathGenerator<Point>& __pg
 
     for (auto iter = __pg.build(pos(), __point); iter->remains(); iter->advance())
     {
-        Point cur(iter->current().physics(_dpi));
+        const Point step(iter->current());
+        _Win_Journal_Step_(SetPos, step.x(), step.y())
+
+        Point cur(step.physics(_dpi));
 
         bool ret = SetWindowPos(
             $(_M_handle),
@@ -1173,6 +1402,7 @@ void Win::move(int __addX, int __addY, const pg::BasicPathGenerator<Point>& __pg
 void Win::setSize(const Size& __size) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetSize, __size.w(), __size.h())
 
     Size sz(__size.physics(dpi()));
 
@@ -1194,7 +1424,10 @@ void Win::setSize(const Size& __size, const pg::BasicPathGenerator<Size>& __pg)
 
     for (auto iter = __pg.build(size(), __size); iter->remains(); iter->advance())
     {
-        Size cur(iter->current().physics(_dpi));
+        const Size step(iter->current());
+        _Win_Journal_Step_(SetSize, step.w(), step.h())
+
+        Size cur(step.physics(_dpi));
 
         bool ret = SetWindowPos(
             $(_M_handle),
@@ -1232,6 +1465,7 @@ Size Win::screenSize() noexcept
 void Win::setWidth(int __width) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetWidth, __width)
 
     auto _dpi = dpi();
 
@@ -1255,7 +1489,10 @@ void Win::setWidth(int __width, const pg::BasicPathGenerator<int>& __pg) const n
 
     for (auto iter = __pg.build(width(), __width); iter->remains(); iter->advance())
     {
-        int cur(static_cast<int>(iter->current() / _dpi));
+        const int step = iter->current();
+        _Win_Journal_Step_(SetWidth, step)
+
+        int cur(static_cast<int>(step / _dpi));
 
         bool ret = SetWindowPos(
             $(_M_handle),
@@ -1273,6 +1510,7 @@ void Win::setWidth(int __width, const pg::BasicPathGenerator<int>& __pg) const n
 void Win::setHeight(int __height) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetHeight, __height)
 
     auto _dpi = dpi();
 
@@ -1296,7 +1534,10 @@ void Win::setHeight(int __height, const pg::BasicPathGenerator<int>& __pg) const
 
     for (auto iter = __pg.build(height(), __height); iter->remains(); iter->advance())
     {
-        int cur(static_cast<int>(iter->current() / _dpi));
+        const int step = iter->current();
+        _Win_Journal_Step_(SetHeight, step)
+
+        int cur(static_cast<int>(step / _dpi));
 
         bool ret = SetWindowPos(
             $(_M_handle),
@@ -1392,6 +1633,7 @@ void Win::setZoom(double __scaleX, double __scaleY, const pg::BasicPathGenerator
 void Win::setOpacity(int __value) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetOpacity, __value)
 
     becomeLayered();
     _Win_Return_on_failed_
@@ -1412,10 +1654,13 @@ void Win::setOpacity(int __value, const pg::BasicPathGenerator<int>& __pg) const
 
     for (auto iter = __pg.build(opacity(), __value); iter->remains(); iter->advance())
     {
+        const int step = iter->current();
+        _Win_Journal_Step_(SetOpacity, step)
+
         bool ret = SetLayeredWindowAttributes(
             $(_M_handle),
             0,
-            static_cast<BYTE>(std::max(0, std::min(0xff, iter->current()))),
+            static_cast<BYTE>(std::max(0, std::min(0xff, step))),
             LWA_ALPHA);
 
         _Win_Test_(ret)
@@ -1438,9 +1683,86 @@ int Win::opacity() const noexcept
     return buffer;
 }
 
+void Win::animateTo(
+    const Rect& __rect,
+    int __opacity,
+    const pg::BasicPathGenerator<AnimationValue>& __pg) const noexcept
+{
+    _Win_Begin_
+
+    const Rect from(rect());
+    const int fromOpacity = opacity();
+
+    _Win_Return_on_failed_
+
+    const bool fading = __opacity != fromOpacity;
+
+    if (fading)
+    {
+        becomeLayered();
+        _Win_Return_on_failed_
+    }
+
+    const float _dpi = dpi();
+
+    /// What the window shows now, in physical units.
+    Rect shown(from.physics(_dpi));
+    int shownOpacity = fromOpacity;
+
+    auto iter = __pg.build(
+        AnimationValue{ from.x(), from.y(), from.w(), from.h(), fromOpacity },
+        AnimationValue{ __rect.x(), __rect.y(), __rect.w(), __rect.h(), __opacity });
+
+    for (; iter->remains(); iter->advance())
+    {
+        const AnimationValue cur(iter->current());
+        _Win_Journal_Step_(AnimationFrame, cur[0], cur[1], cur[2], cur[3], cur[4])
+
+        const Rect target(Rect(cur[0], cur[1], cur[2], cur[3]).physics(_dpi));
+
+        if (not (target == shown))
+        {
+            bool ret = SetWindowPos(
+                $(_M_handle),
+                0,
+                target.x(),
+                target.y(),
+                target.w(),
+                target.h(),
+                SWP_NOZORDER | SWP_NOACTIVATE);
+
+            _Win_Test_(ret)
+
+            shown = target;
+        }
+
+        const int alpha = std::max(0, std::min(0xff, cur[4]));
+
+        if (fading && alpha != shownOpacity)
+        {
+            bool ret = SetLayeredWindowAttributes(
+                $(_M_handle),
+                0,
+                static_cast<BYTE>(alpha),
+                LWA_ALPHA);
+
+            _Win_Test_(ret)
+
+            shownOpacity = alpha;
+        }
+    }
+}
+
+void Win::animateTo(const Rect& __rect, const pg::BasicPathGenerator<AnimationValue>& __pg) const noexcept
+{
+    _Win_Begin_Nocheck_
+    animateTo(__rect, opacity(), __pg);
+}
+
 void Win::setTransparencyColor(const Color& __color) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetTransparencyColor, __color.r(), __color.g(), __color.b())
 
     static_assert(sizeof(Color) == sizeof(COLORREF), "sizeof(Color) != sizeof(COLORREF)");
 
@@ -1511,6 +1833,7 @@ Point Win::toClientCoordinates(const Point& __screenPoint) const noexcept
 void Win::_M_addStyle(std::int32_t __style) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(AddStyle, __style)
 
     auto currentStyle = GetWindowLong($(_M_handle), GWL_STYLE);
     _Win_Check_
@@ -1527,6 +1850,7 @@ void Win::_M_addStyle(std::int32_t __style) const noexcept
 void Win::_M_delStyle(std::int32_t __style) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(DelStyle, __style)
 
     auto currentStyle = GetWindowLong($(_M_handle), GWL_EXSTYLE);
     _Win_Check_
@@ -1550,6 +1874,7 @@ bool Win::_M_hasStyle(std::int32_t __style) const noexcept
 void Win::_M_addExtendStyle(std::int32_t __style) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(AddExtendStyle, __style)
 
     auto currentStyle = GetWindowLong($(_M_handle), GWL_EXSTYLE);
     _Win_Check_
@@ -1566,6 +1891,7 @@ void Win::_M_addExtendStyle(std::int32_t __style) const noexcept
 void Win::_M_delExtendStyle(std::int32_t __style) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(DelExtendStyle, __style)
 
     auto currentStyle = GetWindowLong($(_M_handle), GWL_EXSTYLE);
     _Win_Check_
@@ -1738,6 +2064,7 @@ void Win::setTitlebarButtons(
     bool __enable) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetTitlebarButtons, __titlebarButtons, __enable)
 
     if (__enable)
     {
@@ -1871,6 +2198,7 @@ bool Win::isDoubleBufferDrawing() const noexcept
 void Win::setAcceptFiles(bool __enable) const noexcept
 {
     _Win_Begin_Nocheck_
+    _Win_Journal_(SetAcceptFiles, __enable)
 
     if (__enable)
         DragAcceptFiles($(_M_handle), true),
@@ -1889,6 +2217,7 @@ bool Win::isAcceptingFiles() const noexcept
 void Win::flash(bool __enable) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(Flash, __enable)
 
     if (__enable)
     {
@@ -1912,6 +2241,7 @@ void Win::flash(bool __enable) const noexcept
 void Win::flash(int __count, Win::Timeout __timeout, bool __caption) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(FlashCount, __count, __timeout, __caption)
 
     FLASHWINFO info{
             static_cast<decltype(info.cbSize)>(
@@ -1929,6 +2259,7 @@ void Win::flash(int __count, Win::Timeout __timeout, bool __caption) const noexc
 void Win::flash(Win::FlashFlag, Win::Timeout __timeout, bool __caption) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(FlashUntilIsForeground, __timeout, __caption)
 
     FLASHWINFO info{
             static_cast<decltype(info.cbSize)>(
@@ -1975,6 +2306,7 @@ void Win::update(const Rect& __clientRect, bool __eraseBackground) const noexcep
 void Win::lockUpdate() const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(LockUpdate)
 
     bool ret = LockWindowUpdate($(_M_handle));
     _Win_Test_(ret)
@@ -1983,6 +2315,7 @@ void Win::lockUpdate() const noexcept
 void Win::unlockUpdate() noexcept
 {
     _Win_Static_Begin_
+    _Win_Static_Journal_(UnlockUpdate)
 
     bool ret = LockWindowUpdate(nullptr);
     _Win_Test_(ret)
@@ -2023,6 +2356,7 @@ bool Win::isCreatedByCurrentProcess() const noexcept
 void Win::close(Win::Timeout __timeout) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(Close, __timeout)
 
     if (__timeout == 0)
         PostMessage($(_M_handle), WM_CLOSE, 0, 0);
@@ -2033,12 +2367,14 @@ void Win::close(Win::Timeout __timeout) const noexcept
 void Win::destroy() const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(Destroy)
     DestroyWindow($(_M_handle));
 }
 
 void Win::killThread(int __exitCode) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(KillThread, __exitCode)
 
     HANDLE hProcess = OpenThread(THREAD_TERMINATE, false, threadId());
     _Win_Test_(hProcess)
@@ -2052,6 +2388,7 @@ void Win::killThread(int __exitCode) const noexcept
 void Win::killProcess(int __exitCode) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(KillProcess, __exitCode)
 
     HANDLE hProcess = OpenProcess(PROCESS_TERMINATE, false, processId());
     _Win_Test_(hProcess)
@@ -2069,6 +2406,13 @@ void Win::_M_sendMessageA(
     Win::Timeout __timeout) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(
+        SendMessageA,
+        __msg,
+        static_cast<std::int64_t>(__wParam),
+        _S_isScalarMessage(__msg) ? __lParam : 0,
+        __timeout,
+        not _S_isScalarMessage(__msg))
     
     if (__timeout == Win::InfiniteTimeout)
     {
@@ -2100,6 +2444,13 @@ void Win::_M_sendMessageW(
     Win::Timeout __timeout) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(
+        SendMessageW,
+        __msg,
+        static_cast<std::int64_t>(__wParam),
+        _S_isScalarMessage(__msg) ? __lParam : 0,
+        __timeout,
+        not _S_isScalarMessage(__msg))
 
     if (__timeout == Win::InfiniteTimeout)
     {
@@ -2272,6 +2623,7 @@ void Win::send(char __word, Win::Timeout __timeout) const noexcept
 void Win::post(char __word) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(PostChar, __word)
 
     WM_CHAR_LPARAM lParam;
     lParam._uint_v = 0;
@@ -2294,6 +2646,7 @@ void Win::send(wchar_t __word, Win::Timeout __timeout) const noexcept
 void Win::post(wchar_t __word) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(PostWideChar, __word)
 
     WM_CHAR_LPARAM lParam;
     lParam._uint_v = 0;
@@ -2352,6 +2705,7 @@ void Win::send(Key __key, Win::KeyAction __action, Win::Timeout __timeout) const
 void Win::post(Key __key, Win::KeyAction __action) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(PostKey, __key, __action)
 
     WM_CHAR_LPARAM lParam;
 
@@ -2465,6 +2819,7 @@ void Win::sendUndoMsg(Win::Timeout __timeout) const noexcept
 void Win::setShortcut(Shortcut __shortcut, bool __enable) const noexcept
 {
     _Win_Begin_
+    _Win_Journal_(SetShortcut, __shortcut.modifiers, __shortcut.key, __enable)
 
     if (__enable)
     {
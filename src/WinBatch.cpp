@@ -0,0 +1,281 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WinBatch.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 20:41:20
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Implement WinBatch.h
+*/
+
+#include <openWin/WinBatch.h>
+
+#include "Built-in/_Windows.h"
+#include "Built-in/_MacrosForErrorHandling.h"
+
+using namespace win;
+
+static inline HWND $(Win::Handle __handle) noexcept
+{ return reinterpret_cast<HWND>(__handle); }
+
+WinBatch::WinBatch(std::size_t __reserve)
+{
+    _M_changes.reserve(__reserve);
+    _M_indexes.reserve(__reserve);
+}
+
+WinBatch::change& WinBatch::_M_change(const Win& __win)
+{
+    auto [it, inserted] = _M_indexes.try_emplace(__win.handle(), _M_changes.size());
+
+    if (inserted)
+    {
+        _M_changes.push_back(change{ __win.handle(), Point(), Size(), zorder::Top, nullptr, false, 0 });
+    }
+
+    return _M_changes[it->second];
+}
+
+WinBatch& WinBatch::setRect(const Win& __win, const Rect& __rect)
+{
+    change& c = _M_change(__win);
+
+    c.pos = __rect.point();
+    c.size = __rect.size();
+    c.parts = static_cast<std::uint8_t>((c.parts & ~ScaledPosPart) | PosPart | SizePart);
+
+    return *this;
+}
+
+WinBatch& WinBatch::setPos(const Win& __win, const Point& __point)
+{
+    change& c = _M_change(__win);
+
+    c.pos = __point;
+    c.parts |= PosPart | ScaledPosPart;
+
+    return *this;
+}
+
+WinBatch& WinBatch::setSize(const Win& __win, const Size& __size)
+{
+    change& c = _M_change(__win);
+
+    c.size = __size;
+    c.parts |= SizePart;
+
+    return *this;
+}
+
+WinBatch& WinBatch::setZOrderTop(const Win& __win)
+{
+    change& c = _M_change(__win);
+
+    c.order = zorder::Top;
+    c.parts |= ZOrderPart;
+
+    return *this;
+}
+
+WinBatch& WinBatch::setZOrderBottom(const Win& __win)
+{
+    change& c = _M_change(__win);
+
+    c.order = zorder::Bottom;
+    c.parts |= ZOrderPart;
+
+    return *this;
+}
+
+WinBatch& WinBatch::setTopmost(const Win& __win, bool __enable)
+{
+    change& c = _M_change(__win);
+
+    c.order = __enable ? zorder::Topmost : zorder::NoTopmost;
+    c.parts |= ZOrderPart;
+
+    return *this;
+}
+
+WinBatch& WinBatch::setZOrderBelow(const Win& __win, const Win& __above)
+{
+    change& c = _M_change(__win);
+
+    c.order = zorder::Below;
+    c.above = __above.handle();
+    c.parts |= ZOrderPart;
+
+    return *this;
+}
+
+WinBatch& WinBatch::setVisible(const Win& __win, bool __enable)
+{
+    change& c = _M_change(__win);
+
+    c.visible = __enable;
+    c.parts |= VisibilityPart;
+
+    return *this;
+}
+
+void WinBatch::cancel() noexcept
+{
+    _M_changes.clear();
+    _M_indexes.clear();
+}
+
+std::size_t WinBatch::commit() noexcept
+{
+    _Win_Static_Begin_
+
+    struct position
+    {
+        HWND hwnd;
+        HWND after;
+        int x, y, cx, cy;
+        UINT flags;
+    };
+
+    constexpr UINT unchanged = SWP_NOACTIVATE | SWP_NOZORDER | SWP_NOMOVE | SWP_NOSIZE;
+
+    std::vector<position> positions;
+    positions.reserve(_M_changes.size());
+
+    _M_skipped = 0;
+
+    for (const change& c : _M_changes)
+    {
+        position p{ $(c.handle), nullptr, 0, 0, 0, 0, unchanged };
+
+        if (c.parts & (PosPart | SizePart))
+        {
+            RECT current;
+
+            if (not GetWindowRect(p.hwnd, &current))
+            {
+                ++_M_skipped;
+                continue;
+            }
+
+            const UINT dpi = GetDpiForWindow(p.hwnd);
+            const float scale = dpi ? dpi / 96.0F : 1.00F;
+
+            p.x = current.left;
+            p.y = current.top;
+            p.cx = current.right - current.left;
+            p.cy = current.bottom - current.top;
+
+            if (c.parts & PosPart)
+            {
+                const Point target(c.parts & ScaledPosPart ? c.pos.physics(scale) : c.pos);
+
+                if (target.x() != p.x || target.y() != p.y)
+                {
+                    p.x = target.x();
+                    p.y = target.y();
+                    p.flags &= ~SWP_NOMOVE;
+                }
+            }
+
+            if (c.parts & SizePart)
+            {
+                const Size target(c.size.physics(scale));
+
+                if (target.width() != p.cx || target.height() != p.cy)
+                {
+                    p.cx = target.width();
+                    p.cy = target.height();
+                    p.flags &= ~SWP_NOSIZE;
+                }
+            }
+        }
+
+        if (c.parts & ZOrderPart)
+        {
+            const bool topmost = GetWindowLongPtrW(p.hwnd, GWL_EXSTYLE) & WS_EX_TOPMOST;
+
+            switch (c.order)
+            {
+            case zorder::Top:
+                p.after = GetWindow(p.hwnd, GW_HWNDPREV) ? HWND_TOP : nullptr;
+                break;
+
+            case zorder::Bottom:
+                p.after = GetWindow(p.hwnd, GW_HWNDNEXT) ? HWND_BOTTOM : nullptr;
+                break;
+
+            case zorder::Topmost:
+                p.after = topmost ? nullptr : HWND_TOPMOST;
+                break;
+
+            case zorder::NoTopmost:
+                p.after = topmost ? HWND_NOTOPMOST : nullptr;
+                break;
+
+            case zorder::Below:
+                p.after = GetWindow(p.hwnd, GW_HWNDPREV) != $(c.above) ? $(c.above) : nullptr;
+                break;
+            }
+
+            if (p.after)
+            {
+                p.flags &= ~SWP_NOZORDER;
+            }
+        }
+
+        if (c.parts & VisibilityPart)
+        {
+            if (static_cast<bool>(IsWindowVisible(p.hwnd)) != c.visible)
+            {
+                p.flags |= c.visible ? SWP_SHOWWINDOW : SWP_HIDEWINDOW;
+            }
+        }
+
+        if (p.flags == unchanged)
+        {
+            ++_M_skipped;
+            continue;
+        }
+
+        positions.push_back(p);
+    }
+
+    cancel();
+
+    if (positions.empty())
+    {
+        _Win_Return_Nocheck_with_(0)
+    }
+
+    HDWP hdwp = BeginDeferWindowPos(static_cast<int>(positions.size()));
+
+    for (std::size_t i = 0; hdwp && i < positions.size(); ++i)
+    {
+        const position& p = positions[i];
+
+        hdwp = DeferWindowPos(hdwp, p.hwnd, p.after, p.x, p.y, p.cx, p.cy, p.flags);
+    }
+
+    if (hdwp && EndDeferWindowPos(hdwp))
+    {
+        return positions.size();
+    }
+
+    /// A window refused to be deferred and the whole batch was abandoned,
+    /// positions them one by one instead.
+
+    std::size_t changed = 0;
+
+    for (const position& p : positions)
+    {
+        changed += static_cast<bool>(SetWindowPos(p.hwnd, p.after, p.x, p.y, p.cx, p.cy, p.flags));
+    }
+
+    return changed;
+}
\ No newline at end of file
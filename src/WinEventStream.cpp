@@ -0,0 +1,205 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WinEventStream.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 19:12:31
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Implement WinEventStream.h, except the WinEvent hooks which are in
+*        WinEventStreamSystem.cpp.
+*/
+
+#include <openWin/WinEventStream.h>
+
+#include <utility>
+
+using namespace win;
+
+WinEventStream::WinEventStream(Callback __callback)
+    : WinEventStream(std::move(__callback), Options())
+{ }
+
+WinEventStream::WinEventStream(Callback __callback, const Options& __options, std::unique_ptr<Source> __source)
+    : _M_callback(std::move(__callback))
+    , _M_options(__options)
+    , _M_source(std::move(__source))
+    , _M_queue(__options.capacity)
+{ }
+
+WinEventStream::~WinEventStream()
+{
+    stop();
+}
+
+bool WinEventStream::start()
+{
+    if (running())
+    {
+        return true;
+    }
+
+    _M_stop.store(false, std::memory_order_relaxed);
+    _M_thread = std::thread(&WinEventStream::_M_run, this);
+
+    if (_M_source == nullptr || not _M_source->start(*this))
+    {
+        stop();
+        return false;
+    }
+
+    return true;
+}
+
+void WinEventStream::stop()
+{
+    if (not running())
+    {
+        return;
+    }
+
+    if (_M_source)
+    {
+        _M_source->stop();
+    }
+
+    _M_stop.store(true, std::memory_order_release);
+
+    _M_signal.fetch_add(1, std::memory_order_release);
+    _M_signal.notify_one();
+
+    _M_thread.join();
+}
+
+void WinEventStream::post(WinEvent::Kind __kind, Win::Handle __handle) noexcept
+{
+    if (not (_M_options.kinds & WinEvent::bit(__kind)))
+    {
+        return;
+    }
+
+    _M_received.fetch_add(1, std::memory_order_relaxed);
+
+    if (not _M_queue.tryPush(WinEvent{ __kind, __handle, Clock::now(), 1 }))
+    {
+        _M_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    _M_signal.fetch_add(1, std::memory_order_release);
+    _M_signal.notify_one();
+}
+
+void WinEventStream::_M_run()
+{
+    for (;;)
+    {
+        const std::uint32_t signal = _M_signal.load(std::memory_order_acquire);
+
+        if (_M_drain())
+        {
+            /// Lets the events that come in a burst, like the moves of a
+            /// dragged window, join the batch.
+            if (_M_options.batchInterval > Clock::duration::zero()
+                && not _M_stop.load(std::memory_order_acquire))
+            {
+                std::this_thread::sleep_for(_M_options.batchInterval);
+                _M_drain();
+            }
+
+            _M_dispatch();
+            continue;
+        }
+
+        if (_M_stop.load(std::memory_order_acquire))
+        {
+            break;
+        }
+
+        _M_signal.wait(signal, std::memory_order_acquire);
+    }
+}
+
+bool WinEventStream::_M_drain()
+{
+    constexpr std::uint32_t none = UINT32_MAX;
+
+    bool drained = false;
+    WinEvent event;
+
+    while (_M_queue.tryPop(event))
+    {
+        drained = true;
+
+        if (not _M_options.coalesce)
+        {
+            _M_batch.push_back(event);
+            continue;
+        }
+
+        if (event.kind == WinEvent::Created || event.kind == WinEvent::Destroyed)
+        {
+            /// The handle may be reused by a new window after this.
+            _M_coalesced.erase(event.handle);
+            _M_batch.push_back(event);
+            continue;
+        }
+
+        auto [it, inserted] = _M_coalesced.try_emplace(event.handle);
+
+        if (inserted)
+        {
+            it->second.fill(none);
+        }
+
+        std::uint32_t& slot = it->second[event.kind - WinEvent::Moved];
+
+        if (slot != none)
+        {
+            /// Moved to the place of this one, not to be delivered before the
+            /// events of other windows received in between.
+            event.count += std::exchange(_M_batch[slot].count, 0);
+        }
+
+        slot = static_cast<std::uint32_t>(_M_batch.size());
+        _M_batch.push_back(event);
+    }
+
+    return drained;
+}
+
+void WinEventStream::_M_dispatch()
+{
+    if (_M_options.coalesce)
+    {
+        std::erase_if(_M_batch, [](const WinEvent& __event) noexcept { return __event.count == 0; });
+    }
+
+    if (_M_batch.empty())
+    {
+        return;
+    }
+
+    try
+    {
+        if (_M_callback)
+        {
+            _M_callback(std::span<const WinEvent>(_M_batch));
+        }
+    }
+    catch (...)
+    {
+        /// The batch is dropped, the stream goes on.
+    }
+
+    _M_delivered.fetch_add(_M_batch.size(), std::memory_order_relaxed);
+    _M_batches.fetch_add(1, std::memory_order_relaxed);
+
+    _M_batch.clear();
+    _M_coalesced.clear();
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WinEventStreamSystem.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 19:12:35
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief The WinEvent hook source of WinEventStream.
+*/
+
+#include <openWin/WinEventStream.h>
+
+#include <future>
+
+#include "Built-in/_Windows.h"
+#include "Built-in/_MacrosForErrorHandling.h"
+
+using namespace win;
+
+/**
+ * @brief Installs out-of-context WinEvent hooks on a thread of its own, the
+ *        hook procedure is called by the message loop of that thread.
+ */
+class _SystemEventSource : public WinEventStream::Source
+{
+public:
+
+    virtual ~_SystemEventSource()
+    {
+        stop();
+    }
+
+    virtual bool start(WinEventStream& __stream) override
+    {
+        if (_M_thread.joinable())
+        {
+            return true;
+        }
+
+        std::promise<bool> installed;
+        std::future<bool> result = installed.get_future();
+
+        _M_thread = std::thread(&_SystemEventSource::_M_run, this, &__stream, std::move(installed));
+
+        if (not result.get())
+        {
+            _M_thread.join();
+            return false;
+        }
+
+        return true;
+    }
+
+    virtual void stop() override
+    {
+        if (not _M_thread.joinable())
+        {
+            return;
+        }
+
+        PostThreadMessageW(_M_threadId.load(std::memory_order_acquire), WM_QUIT, 0, 0);
+        _M_thread.join();
+    }
+
+private:
+
+    static void CALLBACK _S_hook(
+        HWINEVENTHOOK, DWORD __event, HWND __hwnd, LONG __idObject, LONG __idChild, DWORD, DWORD)
+    {
+        if (__hwnd == nullptr || __idObject != OBJID_WINDOW || __idChild != CHILDID_SELF)
+        {
+            return;
+        }
+
+        WinEvent::Kind kind;
+
+        switch (__event)
+        {
+        case EVENT_OBJECT_CREATE:         kind = WinEvent::Created;      break;
+        case EVENT_OBJECT_DESTROY:        kind = WinEvent::Destroyed;    break;
+        case EVENT_OBJECT_LOCATIONCHANGE: kind = WinEvent::Moved;        break;
+        case EVENT_OBJECT_NAMECHANGE:     kind = WinEvent::TitleChanged; break;
+        case EVENT_SYSTEM_FOREGROUND:     kind = WinEvent::Foreground;   break;
+        default:                          return;
+        }
+
+        /// Only top-level windows, a destroyed window cannot be asked anymore.
+        if (kind != WinEvent::Destroyed && GetAncestor(__hwnd, GA_ROOT) != __hwnd)
+        {
+            return;
+        }
+
+        if (_S_stream)
+        {
+            _S_stream->post(kind, __hwnd);
+        }
+    }
+
+    void _M_run(WinEventStream* __stream, std::promise<bool> __installed)
+    {
+        _S_stream = __stream;
+        _M_threadId.store(GetCurrentThreadId(), std::memory_order_release);
+
+        /// Creates the message queue before anyone can post WM_QUIT.
+        MSG msg;
+        PeekMessageW(&msg, nullptr, WM_USER, WM_USER, PM_NOREMOVE);
+
+        const DWORD flags = WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNTHREAD;
+
+        const HWINEVENTHOOK hooks[] = {
+            SetWinEventHook(EVENT_OBJECT_CREATE, EVENT_OBJECT_DESTROY, nullptr, &_S_hook, 0, 0, flags),
+            SetWinEventHook(EVENT_OBJECT_LOCATIONCHANGE, EVENT_OBJECT_NAMECHANGE, nullptr, &_S_hook, 0, 0, flags),
+            SetWinEventHook(EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND, nullptr, &_S_hook, 0, 0, flags)
+        };
+
+        bool installed = true;
+
+        for (HWINEVENTHOOK hook : hooks)
+        {
+            installed = installed && hook != nullptr;
+        }
+
+        if (not installed)
+        {
+            for (HWINEVENTHOOK hook : hooks)
+            {
+                if (hook)
+                {
+                    UnhookWinEvent(hook);
+                }
+            }
+
+            _S_stream = nullptr;
+            __installed.set_value(false);
+            return;
+        }
+
+        __installed.set_value(true);
+
+        while (GetMessageW(&msg, nullptr, 0, 0) > 0)
+        {
+            DispatchMessageW(&msg);
+        }
+
+        for (HWINEVENTHOOK hook : hooks)
+        {
+            UnhookWinEvent(hook);
+        }
+
+        _S_stream = nullptr;
+    }
+
+    /// The stream of the hook thread, the hook procedure has no user data.
+    static thread_local WinEventStream* _S_stream;
+
+    std::atomic<DWORD> _M_threadId = 0;
+
+    std::thread _M_thread;
+};
+
+thread_local WinEventStream* _SystemEventSource::_S_stream = nullptr;
+
+std::unique_ptr<WinEventStream::Source> WinEventStream::Source::system()
+{
+    return std::make_unique<_SystemEventSource>();
+}
\ No newline at end of file
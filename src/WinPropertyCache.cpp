@@ -0,0 +1,324 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WinPropertyCache.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 20:03:55
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Implement WinPropertyCache.h
+*/
+
+#include <openWin/WinPropertyCache.h>
+
+#include <mutex>
+
+using namespace win;
+
+/**
+ * @brief Asks the getters of Win, the errors go to the error stream as usual.
+ */
+class _SystemPropertyBackend : public WinPropertyCache::Backend
+{
+public:
+
+    virtual std::optional<Win::String> title(Win::Handle __handle) override
+    { return _S_get(__handle, &Win::title); }
+
+    virtual std::optional<Win::String> className(Win::Handle __handle) override
+    { return _S_get(__handle, &Win::className); }
+
+    virtual std::optional<Win::String> path(Win::Handle __handle) override
+    { return _S_get(__handle, &Win::path); }
+
+    virtual std::optional<float> dpi(Win::Handle __handle) override
+    { return _S_get(__handle, &Win::dpi); }
+
+    virtual std::optional<win::Rect> rect(Win::Handle __handle) override
+    { return _S_get(__handle, &Win::rect); }
+
+private:
+
+    template<typename _Tp>
+    [[nodiscard]] static std::optional<_Tp> _S_get(Win::Handle __handle, _Tp (Win::*__getter)() const noexcept)
+    {
+        const Win win(__handle);
+
+        _Tp value = (win.*__getter)();
+
+        if (win.failed())
+        {
+            return std::nullopt;
+        }
+
+        return value;
+    }
+};
+
+WinPropertyCache::Backend& WinPropertyCache::Backend::system() noexcept
+{
+    static _SystemPropertyBackend* const _S_backend = new _SystemPropertyBackend;
+    return *_S_backend;
+}
+
+WinPropertyCache::WinPropertyCache()
+    : WinPropertyCache(Options())
+{ }
+
+WinPropertyCache::WinPropertyCache(const Options& __options, Backend& __backend)
+    : _M_options(__options)
+    , _M_backend(__backend)
+{ }
+
+template<typename _Tp, typename _Fetch>
+_Tp WinPropertyCache::_M_get(Win::Handle __handle, Property __property, _Tp entry::* __member, _Fetch __fetch)
+{
+    counters& counter = _M_counters[__property];
+
+    const Clock::time_point now = _M_backend.now();
+
+    std::uint64_t generation = 0;
+
+    {
+        std::shared_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+        if (auto it = _M_entries.find(__handle); it != _M_entries.end())
+        {
+            const entry& e = it->second;
+
+            generation = e.generation;
+
+            if (e.valid & _S_bit(__property))
+            {
+                if (isImmutable(__property)
+                    || _M_options.ttl <= Clock::duration::zero()
+                    || now - e.fetched[__property] < _M_options.ttl)
+                {
+                    counter.hits.fetch_add(1, std::memory_order_relaxed);
+                    return e.*__member;
+                }
+
+                counter.expirations.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    counter.misses.fetch_add(1, std::memory_order_relaxed);
+
+    if (generation == 0)
+    {
+        /// An entry before the fetch, for the invalidations during the fetch
+        /// to change its generation.
+
+        std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+        auto it = _M_entries.find(__handle);
+
+        if (it == _M_entries.end())
+        {
+            if (_M_entries.size() >= _M_options.capacity && not _M_entries.empty())
+            {
+                _M_entries.erase(_M_entries.begin());
+            }
+
+            it = _M_entries.try_emplace(__handle).first;
+            it->second.generation = ++_M_generation;
+        }
+
+        generation = it->second.generation;
+    }
+
+    /// Fetches without the lock, the backend may be slow.
+    std::optional<_Tp> value = (_M_backend.*__fetch)(__handle);
+
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    auto it = _M_entries.find(__handle);
+
+    /// Forgotten, evicted or invalidated meanwhile.
+    if (it == _M_entries.end() || it->second.generation != generation)
+    {
+        return value ? std::move(*value) : _Tp();
+    }
+
+    entry& e = it->second;
+
+    if (not value)
+    {
+        /// Not cached, and the entry made for the fetch is not kept empty.
+        if (e.valid == 0)
+        {
+            _M_entries.erase(it);
+        }
+
+        return _Tp();
+    }
+
+    e.*__member = *value;
+    e.fetched[__property] = now;
+    e.valid |= _S_bit(__property);
+
+    return std::move(*value);
+}
+
+Win::String WinPropertyCache::title(Win::Handle __handle)
+{
+    return _M_get(__handle, Title, &entry::title, &Backend::title);
+}
+
+Win::String WinPropertyCache::className(Win::Handle __handle)
+{
+    return _M_get(__handle, ClassName, &entry::className, &Backend::className);
+}
+
+Win::String WinPropertyCache::path(Win::Handle __handle)
+{
+    return _M_get(__handle, Path, &entry::path, &Backend::path);
+}
+
+float WinPropertyCache::dpi(Win::Handle __handle)
+{
+    return _M_get(__handle, Dpi, &entry::dpi, &Backend::dpi);
+}
+
+win::Rect WinPropertyCache::rect(Win::Handle __handle)
+{
+    return _M_get(__handle, Rect, &entry::rect, &Backend::rect);
+}
+
+void WinPropertyCache::_M_invalidate(Win::Handle __handle, std::uint8_t __properties)
+{
+    auto it = _M_entries.find(__handle);
+
+    if (it == _M_entries.end())
+    {
+        return;
+    }
+
+    entry& e = it->second;
+
+    e.generation = ++_M_generation;
+
+    for (std::uint8_t i = 0; i < PropertyCount; ++i)
+    {
+        if (__properties & e.valid & _S_bit(static_cast<Property>(i)))
+        {
+            _M_counters[i].invalidations.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    e.valid &= static_cast<std::uint8_t>(~__properties);
+}
+
+void WinPropertyCache::_M_forget(Win::Handle __handle)
+{
+    _M_invalidate(__handle, static_cast<std::uint8_t>((1 << PropertyCount) - 1));
+
+    _M_entries.erase(__handle);
+}
+
+void WinPropertyCache::invalidate(Win::Handle __handle, Property __property)
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+    _M_invalidate(__handle, _S_bit(__property));
+}
+
+void WinPropertyCache::invalidate(Win::Handle __handle)
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+    _M_invalidate(__handle, _S_bit(Title) | _S_bit(Dpi) | _S_bit(Rect));
+}
+
+void WinPropertyCache::forget(Win::Handle __handle)
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+    _M_forget(__handle);
+}
+
+void WinPropertyCache::clear()
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    _M_entries.clear();
+}
+
+void WinPropertyCache::apply(std::span<const WinEvent> __events)
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    for (const WinEvent& event : __events)
+    {
+        switch (event.kind)
+        {
+        case WinEvent::Created:
+        case WinEvent::Destroyed:
+            _M_forget(event.handle);
+            break;
+
+        case WinEvent::Moved:
+            /// The dpi changes when the window moves to another monitor.
+            _M_invalidate(event.handle, _S_bit(Rect) | _S_bit(Dpi));
+            break;
+
+        case WinEvent::TitleChanged:
+            _M_invalidate(event.handle, _S_bit(Title));
+            break;
+
+        default:
+            break;
+        }
+    }
+}
+
+WinPropertyCache::Stats WinPropertyCache::stats(Property __property) const noexcept
+{
+    const counters& counter = _M_counters[__property];
+
+    Stats result;
+
+    result.hits = counter.hits.load(std::memory_order_relaxed);
+    result.misses = counter.misses.load(std::memory_order_relaxed);
+    result.expirations = counter.expirations.load(std::memory_order_relaxed);
+    result.invalidations = counter.invalidations.load(std::memory_order_relaxed);
+
+    return result;
+}
+
+WinPropertyCache::Stats WinPropertyCache::stats() const noexcept
+{
+    Stats result;
+
+    for (std::uint8_t i = 0; i < PropertyCount; ++i)
+    {
+        const Stats part = stats(static_cast<Property>(i));
+
+        result.hits += part.hits;
+        result.misses += part.misses;
+        result.expirations += part.expirations;
+        result.invalidations += part.invalidations;
+    }
+
+    return result;
+}
+
+void WinPropertyCache::resetStats() noexcept
+{
+    for (counters& counter : _M_counters)
+    {
+        counter.hits.store(0, std::memory_order_relaxed);
+        counter.misses.store(0, std::memory_order_relaxed);
+        counter.expirations.store(0, std::memory_order_relaxed);
+        counter.invalidations.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::size_t WinPropertyCache::size() const
+{
+    std::shared_lock<std::shared_mutex> _L_lock(_M_mutex);
+    return _M_entries.size();
+}
\ No newline at end of file
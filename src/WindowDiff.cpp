@@ -0,0 +1,172 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WindowDiff.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 18:36:55
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Implement WindowDiff.h
+*/
+
+#include <openWin/WindowDiff.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+using namespace win;
+
+/**
+ * @return For each element, whether it belongs to a longest strictly
+ *         increasing subsequence.
+ */
+static std::vector<bool> _S_longestIncreasing(const std::vector<std::size_t>& __sequence)
+{
+    const std::size_t npos = WindowDiff::npos;
+
+    /// tails[k] is the index of the smallest tail of the increasing
+    /// subsequences of length k + 1.
+    std::vector<std::size_t> tails;
+    std::vector<std::size_t> parents(__sequence.size(), npos);
+
+    for (std::size_t i = 0; i < __sequence.size(); ++i)
+    {
+        auto it = std::lower_bound(tails.begin(), tails.end(), __sequence[i],
+            [&](std::size_t __tail, std::size_t __value) { return __sequence[__tail] < __value; });
+
+        if (it != tails.begin())
+        {
+            parents[i] = *std::prev(it);
+        }
+
+        if (it == tails.end())
+        {
+            tails.push_back(i);
+        }
+        else
+        {
+            *it = i;
+        }
+    }
+
+    std::vector<bool> result(__sequence.size(), false);
+
+    for (std::size_t i = tails.empty() ? npos : tails.back(); i != npos; i = parents[i])
+    {
+        result[i] = true;
+    }
+
+    return result;
+}
+
+WindowDiff WindowDiff::between(const WindowSnapshot& __before, const WindowSnapshot& __after)
+{
+    std::unordered_map<Win::Handle, std::size_t> indexes;
+    indexes.reserve(__before.size());
+
+    for (std::size_t i = 0; i < __before.size(); ++i)
+    {
+        indexes.emplace(__before.handle(i), i);
+    }
+
+    const bool rects = __before.has(WindowSnapshot::Rect) && __after.has(WindowSnapshot::Rect);
+    const bool titles = __before.has(WindowSnapshot::Title) && __after.has(WindowSnapshot::Title);
+
+    std::vector<Entry> entries;
+    entries.reserve(std::max(__before.size(), __after.size()));
+
+    /// The positions in entries of the windows in both snapshots, in the
+    /// order of after.
+    std::vector<std::size_t> survivors;
+
+    std::vector<bool> matched(__before.size(), false);
+
+    for (std::size_t j = 0; j < __after.size(); ++j)
+    {
+        auto it = indexes.find(__after.handle(j));
+
+        if (it == indexes.end() || matched[it->second])
+        {
+            entries.push_back({ __after.handle(j), Created, npos, j });
+            continue;
+        }
+
+        matched[it->second] = true;
+
+        Entry entry{ __after.handle(j), 0, it->second, j };
+
+        if (rects && not (__before.rect(entry.before) == __after.rect(entry.after)))
+        {
+            entry.changes |= Moved;
+        }
+
+        if (titles && __before.title(entry.before) != __after.title(entry.after))
+        {
+            entry.changes |= Retitled;
+        }
+
+        survivors.push_back(entries.size());
+        entries.push_back(entry);
+    }
+
+    for (std::size_t i = 0; i < __before.size(); ++i)
+    {
+        if (not matched[i])
+        {
+            entries.push_back({ __before.handle(i), Destroyed, i, npos });
+        }
+    }
+
+    /// The survivors are stacked as after, the ones not in the longest run
+    /// that keeps the order of before have moved in the z-order.
+
+    std::vector<std::size_t> order(survivors.size());
+
+    for (std::size_t k = 0; k < survivors.size(); ++k)
+    {
+        order[k] = entries[survivors[k]].before;
+    }
+
+    const std::vector<bool> stable = _S_longestIncreasing(order);
+
+    for (std::size_t k = 0; k < survivors.size(); ++k)
+    {
+        if (not stable[k])
+        {
+            entries[survivors[k]].changes |= ZOrderChanged;
+        }
+    }
+
+    std::erase_if(entries, [](const Entry& __entry) { return __entry.changes == 0; });
+
+    WindowDiff result;
+    result._M_entries = std::move(entries);
+
+    return result;
+}
+
+std::size_t WindowDiff::count(Changes __changes) const noexcept
+{
+    return static_cast<std::size_t>(std::count_if(_M_entries.begin(), _M_entries.end(),
+        [__changes](const Entry& __entry) { return __entry.has(__changes); }));
+}
+
+WinList WindowDiff::wins(Changes __changes) const
+{
+    WinList result;
+
+    for (const Entry& entry : _M_entries)
+    {
+        if (entry.has(__changes))
+        {
+            result.push_back(Win(entry.handle));
+        }
+    }
+
+    return result;
+}
\ No newline at end of file
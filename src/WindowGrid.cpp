@@ -0,0 +1,261 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WindowGrid.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 17, 2026, 02:14:41
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Implement WindowGrid.h
+*/
+
+#include <openWin/WindowGrid.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace win;
+
+/// Where Windows parks the minimized top-level windows.
+static constexpr int _S_minimizedPosition = -32000;
+
+WindowGrid::WindowGrid(const WindowSnapshot& __snapshot)
+    : _M_size(__snapshot.size())
+{
+    if (not __snapshot.has(WindowSnapshot::Rect))
+    {
+        return;
+    }
+
+    const bool visibleOnly = __snapshot.has(WindowSnapshot::Visible);
+
+    _M_boxes.resize(_M_size);
+
+    std::vector<std::uint32_t> indexes;
+    indexes.reserve(_M_size);
+
+    _Box bounds{ 0, 0, 0, 0 };
+
+    for (std::size_t i = 0; i < _M_size; ++i)
+    {
+        const Rect rect(__snapshot.rect(i));
+
+        _M_boxes[i] = { rect.x(), rect.y(), rect.x() + rect.w(), rect.y() + rect.h() };
+
+        if (rect.w() <= 0 || rect.h() <= 0
+            || (visibleOnly && not __snapshot.isVisible(i))
+            || (rect.x() <= _S_minimizedPosition && rect.y() <= _S_minimizedPosition))
+        {
+            continue;
+        }
+
+        if (indexes.empty())
+        {
+            bounds = _M_boxes[i];
+        }
+        else
+        {
+            bounds.left = std::min(bounds.left, _M_boxes[i].left);
+            bounds.top = std::min(bounds.top, _M_boxes[i].top);
+            bounds.right = std::max(bounds.right, _M_boxes[i].right);
+            bounds.bottom = std::max(bounds.bottom, _M_boxes[i].bottom);
+        }
+
+        indexes.push_back(static_cast<std::uint32_t>(i));
+    }
+
+    _M_indexed = indexes.size();
+
+    if (indexes.empty())
+    {
+        return;
+    }
+
+    _M_bounds = Rect(bounds.left, bounds.top, bounds.right - bounds.left, bounds.bottom - bounds.top);
+
+    /// About 4 cells per window, shaped like the bounds.
+
+    const double width = _M_bounds.w();
+    const double height = _M_bounds.h();
+
+    const double cells = static_cast<double>(indexes.size()) * 4.0;
+    const double columns = std::clamp(std::round(std::sqrt(cells * width / height)), 1.0, double(maxCells));
+    const double rows = std::clamp(std::round(cells / columns), 1.0, double(maxCells));
+
+    _M_cellWidth = static_cast<int>(std::ceil(width / columns));
+    _M_cellHeight = static_cast<int>(std::ceil(height / rows));
+
+    _M_columns = static_cast<std::uint32_t>((_M_bounds.w() + _M_cellWidth - 1) / _M_cellWidth);
+    _M_rows = static_cast<std::uint32_t>((_M_bounds.h() + _M_cellHeight - 1) / _M_cellHeight);
+
+    const std::size_t cellCount = std::size_t(_M_columns) * _M_rows;
+
+    /// Counts the windows of each cell, then places them.
+
+    _M_starts.assign(cellCount + 1, 0);
+
+    std::vector<std::uint32_t> small;
+    small.reserve(indexes.size());
+
+    for (std::uint32_t index : indexes)
+    {
+        std::uint32_t firstColumn, firstRow, lastColumn, lastRow;
+        _M_cellRange(_M_boxes[index], firstColumn, firstRow, lastColumn, lastRow);
+
+        const std::size_t covered = std::size_t(lastColumn - firstColumn + 1) * (lastRow - firstRow + 1);
+
+        if (cellCount > 1 && covered * 2 > cellCount)
+        {
+            _M_large.push_back(index);
+            continue;
+        }
+
+        small.push_back(index);
+
+        for (std::uint32_t row = firstRow; row <= lastRow; ++row)
+        {
+            for (std::uint32_t column = firstColumn; column <= lastColumn; ++column)
+            {
+                ++_M_starts[std::size_t(row) * _M_columns + column + 1];
+            }
+        }
+    }
+
+    for (std::size_t i = 1; i <= cellCount; ++i)
+    {
+        _M_starts[i] += _M_starts[i - 1];
+    }
+
+    _M_items.resize(_M_starts.back());
+
+    std::vector<std::uint32_t> cursors(_M_starts.begin(), _M_starts.end() - 1);
+
+    for (std::uint32_t index : small)
+    {
+        std::uint32_t firstColumn, firstRow, lastColumn, lastRow;
+        _M_cellRange(_M_boxes[index], firstColumn, firstRow, lastColumn, lastRow);
+
+        for (std::uint32_t row = firstRow; row <= lastRow; ++row)
+        {
+            for (std::uint32_t column = firstColumn; column <= lastColumn; ++column)
+            {
+                _M_items[cursors[std::size_t(row) * _M_columns + column]++] = index;
+            }
+        }
+    }
+}
+
+std::size_t WindowGrid::findByPoint(const Point& __point) const noexcept
+{
+    const int x = __point.x() - _M_bounds.x();
+    const int y = __point.y() - _M_bounds.y();
+
+    if (_M_columns == 0 || x < 0 || y < 0 || x >= _M_bounds.w() || y >= _M_bounds.h())
+    {
+        return _M_size;
+    }
+
+    const std::size_t cell = std::size_t(y / _M_cellHeight) * _M_columns + std::size_t(x / _M_cellWidth);
+
+    const std::uint32_t* items = _M_items.data() + _M_starts[cell];
+    const std::uint32_t* const itemsEnd = _M_items.data() + _M_starts[cell + 1];
+
+    const std::uint32_t* large = _M_large.data();
+    const std::uint32_t* const largeEnd = _M_large.data() + _M_large.size();
+
+    /// Merges the two lists, both ascending, so that the first hit is the
+    /// topmost.
+    while (items != itemsEnd || large != largeEnd)
+    {
+        const std::uint32_t index = (large == largeEnd || (items != itemsEnd && *items < *large))
+            ? *items++
+            : *large++;
+
+        if (_M_boxes[index].contains(__point.x(), __point.y()))
+        {
+            return index;
+        }
+    }
+
+    return _M_size;
+}
+
+void WindowGrid::findByPoint(std::span<const Point> __points, std::span<std::size_t> __indexes) const noexcept
+{
+    const std::size_t count = std::min(__points.size(), __indexes.size());
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        __indexes[i] = findByPoint(__points[i]);
+    }
+}
+
+std::vector<std::size_t> WindowGrid::findByPoint(std::span<const Point> __points) const
+{
+    std::vector<std::size_t> result(__points.size());
+    findByPoint(__points, result);
+
+    return result;
+}
+
+std::vector<std::size_t> WindowGrid::findByRect(const Rect& __rect) const
+{
+    std::vector<std::size_t> result;
+
+    const _Box box{ __rect.x(), __rect.y(), __rect.x() + __rect.w(), __rect.y() + __rect.h() };
+
+    const _Box bounds{
+        _M_bounds.x(), _M_bounds.y(), _M_bounds.x() + _M_bounds.w(), _M_bounds.y() + _M_bounds.h() };
+
+    if (_M_columns == 0 || not box.intersects(bounds))
+    {
+        return result;
+    }
+
+    std::uint32_t firstColumn, firstRow, lastColumn, lastRow;
+    _M_cellRange(box, firstColumn, firstRow, lastColumn, lastRow);
+
+    for (std::uint32_t row = firstRow; row <= lastRow; ++row)
+    {
+        const std::size_t first = std::size_t(row) * _M_columns + firstColumn;
+
+        result.insert(
+            result.end(),
+            _M_items.begin() + _M_starts[first],
+            _M_items.begin() + _M_starts[first + (lastColumn - firstColumn) + 1]);
+    }
+
+    result.insert(result.end(), _M_large.begin(), _M_large.end());
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+
+    std::erase_if(result, [this, &box](std::size_t __index) {
+        return not _M_boxes[__index].intersects(box);
+    });
+
+    return result;
+}
+
+void WindowGrid::_M_cellRange(
+    const _Box& __box,
+    std::uint32_t& __firstColumn,
+    std::uint32_t& __firstRow,
+    std::uint32_t& __lastColumn,
+    std::uint32_t& __lastRow) const noexcept
+{
+    const auto clamp = [](std::int64_t __value, std::uint32_t __count) noexcept -> std::uint32_t {
+        return static_cast<std::uint32_t>(std::clamp<std::int64_t>(__value, 0, std::int64_t(__count) - 1));
+    };
+
+    __firstColumn = clamp((std::int64_t(__box.left) - _M_bounds.x()) / _M_cellWidth, _M_columns);
+    __firstRow = clamp((std::int64_t(__box.top) - _M_bounds.y()) / _M_cellHeight, _M_rows);
+
+    __lastColumn = clamp((std::int64_t(__box.right) - 1 - _M_bounds.x()) / _M_cellWidth, _M_columns);
+    __lastRow = clamp((std::int64_t(__box.bottom) - 1 - _M_bounds.y()) / _M_cellHeight, _M_rows);
+}
\ No newline at end of file
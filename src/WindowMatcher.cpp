@@ -0,0 +1,301 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WindowMatcher.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 17, 2026, 02:51:24
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Implement WindowMatcher.h
+*/
+
+#include <openWin/WindowMatcher.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace win;
+
+static void _S_fold(std::string_view __text, std::string& __folded)
+{
+    __folded.resize(__text.size());
+
+    std::transform(__text.begin(), __text.end(), __folded.begin(), [](char __c) noexcept -> char {
+        return __c >= 'A' && __c <= 'Z' ? static_cast<char>(__c - 'A' + 'a') : __c;
+    });
+}
+
+WindowMatcher::WindowMatcher(std::vector<Pattern> __patterns)
+    : _M_patterns(std::move(__patterns))
+{
+    std::vector<std::pair<std::string_view, PatternId>> titleSubstrings;
+    std::vector<std::pair<std::string_view, PatternId>> classNameSubstrings;
+
+    std::string folded;
+
+    for (std::size_t i = 0; i < _M_patterns.size(); ++i)
+    {
+        const Pattern& pattern = _M_patterns[i];
+        const auto id = static_cast<PatternId>(i);
+
+        _FieldPatterns& patterns = _M_of(pattern.field);
+        _M_fields |= pattern.field == WindowSnapshot::ClassName ? WindowSnapshot::ClassName : WindowSnapshot::Title;
+
+        switch (pattern.kind)
+        {
+        case Exact:
+            patterns.exact[pattern.text].push_back(id);
+            break;
+
+        case CaseInsensitive:
+            _S_fold(pattern.text, folded);
+            patterns.folded[folded].push_back(id);
+            break;
+
+        case Substring:
+            if (pattern.text.empty())
+            {
+                patterns.everywhere.push_back(id);
+            }
+            else
+            {
+                (pattern.field == WindowSnapshot::ClassName ? classNameSubstrings : titleSubstrings)
+                    .emplace_back(pattern.text, id);
+            }
+            break;
+
+        case Regex:
+            patterns.regexes.emplace_back(id, std::regex(pattern.text, std::regex::ECMAScript | std::regex::optimize));
+            break;
+        }
+    }
+
+    if (not titleSubstrings.empty())
+    {
+        _M_titles.substrings.build(titleSubstrings);
+    }
+
+    if (not classNameSubstrings.empty())
+    {
+        _M_classNames.substrings.build(classNameSubstrings);
+    }
+}
+
+void WindowMatcher::_Automaton::build(const std::vector<std::pair<std::string_view, PatternId>>& __patterns)
+{
+    static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+    /// Class 0 is for the bytes in no pattern, which lead back to the root.
+
+    for (const auto& [text, id] : __patterns)
+    {
+        for (char c : text)
+        {
+            std::uint16_t& cls = classes[static_cast<unsigned char>(c)];
+
+            if (cls == 0)
+            {
+                cls = static_cast<std::uint16_t>(classCount++);
+            }
+        }
+    }
+
+    /// The trie.
+
+    next.assign(classCount, none);
+
+    std::vector<std::vector<PatternId>> ends(1);
+
+    for (const auto& [text, id] : __patterns)
+    {
+        std::uint32_t state = 0;
+
+        for (char c : text)
+        {
+            std::uint32_t& to = next[std::size_t(state) * classCount + classes[static_cast<unsigned char>(c)]];
+
+            if (to == none)
+            {
+                to = static_cast<std::uint32_t>(ends.size());
+
+                ends.emplace_back();
+                next.resize(next.size() + classCount, none);
+            }
+
+            /// The reference may dangle after the resize.
+            state = next[std::size_t(state) * classCount + classes[static_cast<unsigned char>(c)]];
+        }
+
+        ends[state].push_back(id);
+    }
+
+    /// The failure links, in breadth-first order so that the states they point
+    /// to are complete, folded into the transitions.
+
+    const std::size_t stateCount = ends.size();
+
+    std::vector<std::uint32_t> fail(stateCount, 0);
+    std::vector<std::uint32_t> queue;
+
+    queue.reserve(stateCount);
+
+    for (std::uint32_t cls = 0; cls < classCount; ++cls)
+    {
+        std::uint32_t& to = next[cls];
+
+        if (to == none)
+        {
+            to = 0;
+        }
+        else
+        {
+            queue.push_back(to);
+        }
+    }
+
+    for (std::size_t head = 0; head < queue.size(); ++head)
+    {
+        const std::uint32_t state = queue[head];
+
+        const std::vector<PatternId>& inherited = ends[fail[state]];
+        ends[state].insert(ends[state].end(), inherited.begin(), inherited.end());
+
+        for (std::uint32_t cls = 0; cls < classCount; ++cls)
+        {
+            const std::uint32_t fallback = next[std::size_t(fail[state]) * classCount + cls];
+            std::uint32_t& to = next[std::size_t(state) * classCount + cls];
+
+            if (to == none)
+            {
+                to = fallback;
+            }
+            else
+            {
+                fail[to] = fallback;
+                queue.push_back(to);
+            }
+        }
+    }
+
+    outputStarts.assign(stateCount + 1, 0);
+
+    for (std::size_t state = 0; state < stateCount; ++state)
+    {
+        std::sort(ends[state].begin(), ends[state].end());
+
+        outputStarts[state + 1] = outputStarts[state] + static_cast<std::uint32_t>(ends[state].size());
+        outputs.insert(outputs.end(), ends[state].begin(), ends[state].end());
+    }
+}
+
+void WindowMatcher::_Automaton::match(std::string_view __text, std::vector<PatternId>& __ids) const
+{
+    std::uint32_t state = 0;
+
+    for (char c : __text)
+    {
+        state = next[std::size_t(state) * classCount + classes[static_cast<unsigned char>(c)]];
+
+        __ids.insert(__ids.end(), outputs.begin() + outputStarts[state], outputs.begin() + outputStarts[state + 1]);
+    }
+}
+
+void WindowMatcher::match(std::string_view __text, WindowSnapshot::Field __field, std::vector<PatternId>& __ids) const
+{
+    const _FieldPatterns& patterns = _M_of(__field);
+
+    const std::size_t first = __ids.size();
+
+    if (auto iter = patterns.exact.find(__text); iter != patterns.exact.end())
+    {
+        __ids.insert(__ids.end(), iter->second.begin(), iter->second.end());
+    }
+
+    if (not patterns.folded.empty())
+    {
+        std::string folded;
+        _S_fold(__text, folded);
+
+        if (auto iter = patterns.folded.find(folded); iter != patterns.folded.end())
+        {
+            __ids.insert(__ids.end(), iter->second.begin(), iter->second.end());
+        }
+    }
+
+    if (not patterns.substrings.empty())
+    {
+        patterns.substrings.match(__text, __ids);
+    }
+
+    __ids.insert(__ids.end(), patterns.everywhere.begin(), patterns.everywhere.end());
+
+    for (const auto& [id, regex] : patterns.regexes)
+    {
+        if (std::regex_search(__text.begin(), __text.end(), regex))
+        {
+            __ids.push_back(id);
+        }
+    }
+
+    std::sort(__ids.begin() + first, __ids.end());
+    __ids.erase(std::unique(__ids.begin() + first, __ids.end()), __ids.end());
+}
+
+std::vector<std::vector<std::size_t>> WindowMatcher::match(const WindowSnapshot& __snapshot) const
+{
+    std::vector<std::vector<std::size_t>> result(_M_patterns.size());
+    std::vector<PatternId> ids;
+
+    const bool titles = (_M_fields & WindowSnapshot::Title) && __snapshot.has(WindowSnapshot::Title);
+    const bool classNames = (_M_fields & WindowSnapshot::ClassName) && __snapshot.has(WindowSnapshot::ClassName);
+
+    for (std::size_t i = 0; i < __snapshot.size(); ++i)
+    {
+        ids.clear();
+
+        if (titles)
+        {
+            match(__snapshot.title(i), WindowSnapshot::Title, ids);
+        }
+
+        if (classNames)
+        {
+            match(__snapshot.className(i), WindowSnapshot::ClassName, ids);
+        }
+
+        for (PatternId id : ids)
+        {
+            result[id].push_back(i);
+        }
+    }
+
+    return result;
+}
+
+std::vector<WinList> WindowMatcher::find() const
+{
+    return _M_wins(WindowSnapshot::capture(_M_fields));
+}
+
+std::vector<WinList> WindowMatcher::find(WindowSnapshot::Source& __source) const
+{
+    return _M_wins(WindowSnapshot::capture(__source, _M_fields));
+}
+
+std::vector<WinList> WindowMatcher::_M_wins(const WindowSnapshot& __snapshot) const
+{
+    std::vector<WinList> result;
+    result.reserve(_M_patterns.size());
+
+    for (const std::vector<std::size_t>& indexes : match(__snapshot))
+    {
+        result.push_back(__snapshot.wins(indexes));
+    }
+
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,1275 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WindowServer.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 23:05:44
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Implement sim/WindowServer.h, the system functions on top of it are in
+*        SimulatedWindows.cpp.
+*/
+
+#include <openWin/sim/WindowServer.h>
+
+#include <algorithm>
+#include <thread>
+
+using namespace win;
+using namespace win::sim;
+
+/// The Win32 messages handled by the server.
+static constexpr std::uint32_t _S_setText = 0x000C;
+static constexpr std::uint32_t _S_getText = 0x000D;
+static constexpr std::uint32_t _S_getTextLength = 0x000E;
+static constexpr std::uint32_t _S_close = 0x0010;
+static constexpr std::uint32_t _S_quit = 0x0012;
+static constexpr std::uint32_t _S_hotKey = 0x0312;
+
+/// MOD_NOREPEAT
+static constexpr std::uint32_t _S_noRepeat = 0x4000;
+
+static const WindowServer::Handle _S_threadMessages = reinterpret_cast<WindowServer::Handle>(-1);
+
+static bool _S_contains(const Rect& __rect, const Point& __point) noexcept
+{
+    return __point.x() >= __rect.x() && __point.x() < __rect.x() + __rect.w()
+        && __point.y() >= __rect.y() && __point.y() < __rect.y() + __rect.h();
+}
+
+
+/**
+ * @brief The names of the calls, shared by all servers so that the IDs can
+ *        be cached by the callers.
+ */
+class _CallRegistry
+{
+public:
+
+    std::size_t find(std::string_view __call) const
+    {
+        std::lock_guard<std::mutex> _L_lock(_M_mutex);
+
+        auto it = std::find(_M_names.begin(), _M_names.end(), __call);
+        return it != _M_names.end() ? static_cast<std::size_t>(it - _M_names.begin()) : capacity;
+    }
+
+    std::size_t add(std::string_view __call)
+    {
+        std::lock_guard<std::mutex> _L_lock(_M_mutex);
+
+        auto it = std::find(_M_names.begin(), _M_names.end(), __call);
+
+        if (it != _M_names.end())
+        {
+            return static_cast<std::size_t>(it - _M_names.begin());
+        }
+
+        /// The last ID is shared by the calls beyond the capacity.
+        if (_M_names.size() == capacity - 1)
+        {
+            return capacity - 1;
+        }
+
+        _M_names.emplace_back(__call);
+        return _M_names.size() - 1;
+    }
+
+    static constexpr std::size_t capacity = 512;
+
+private:
+
+    mutable std::mutex _M_mutex;
+    std::vector<std::string> _M_names;
+};
+
+static _CallRegistry& _S_callRegistry()
+{
+    static _CallRegistry* const _S_registry = new _CallRegistry;
+    return *_S_registry;
+}
+
+static std::atomic<std::uint64_t> _S_generations = 0;
+
+static std::atomic<WindowServer*> _S_currentServer = nullptr;
+
+
+WindowServer::WindowServer()
+    : WindowServer(Options())
+{ }
+
+WindowServer::WindowServer(const Options& __options)
+    : _M_options(__options)
+    , _M_nextHandle(0x10010)
+    , _M_generation(++_S_generations)
+    , _M_framebuffer(static_cast<std::size_t>(std::max(0, __options.screen.w())) * std::max(0, __options.screen.h()), __options.background)
+    , _M_latency(__options.latency.count())
+    , _M_latencies(new std::atomic<std::int64_t>[maxCalls])
+    , _M_calls(new std::atomic<std::uint64_t>[maxCalls])
+{
+    static_assert(maxCalls == _CallRegistry::capacity);
+
+    for (std::size_t i = 0; i < maxCalls; ++i)
+    {
+        _M_latencies[i].store(-1, std::memory_order_relaxed);
+        _M_calls[i].store(0, std::memory_order_relaxed);
+    }
+
+    _M_processes.emplace(_M_currentProcess, _M_options.processPath);
+    _M_children.emplace(nullptr, std::vector<Handle>());
+}
+
+WindowServer::~WindowServer()
+{
+    WindowServer* self = this;
+    _S_currentServer.compare_exchange_strong(self, nullptr, std::memory_order_acq_rel);
+}
+
+WindowServer& WindowServer::current() noexcept
+{
+    if (WindowServer* server = _S_currentServer.load(std::memory_order_acquire))
+    {
+        return *server;
+    }
+
+    static WindowServer* const _S_defaultServer = new WindowServer;
+    return *_S_defaultServer;
+}
+
+WindowServer* WindowServer::setCurrent(WindowServer* __server) noexcept
+{
+    return _S_currentServer.exchange(__server, std::memory_order_acq_rel);
+}
+
+/* ================== windows ================== */
+
+WindowServer::Handle WindowServer::create(Window __window)
+{
+    const ThreadId caller = currentThread();
+
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    if (__window.parent && _M_find(__window.parent) == nullptr)
+    {
+        return nullptr;
+    }
+
+    if (__window.threadId == 0)
+    {
+        __window.threadId = caller;
+    }
+
+    thread& t = _M_thread(__window.threadId);
+
+    if (__window.processId == 0)
+    {
+        __window.processId = t.process;
+    }
+
+    __window.handle = reinterpret_cast<Handle>(_M_nextHandle);
+    _M_nextHandle += 4;
+
+    if (__window.normalRect == Rect())
+    {
+        __window.normalRect = __window.rect;
+    }
+
+    _M_insert(_M_siblings(__window), __window);
+    _M_children.emplace(__window.handle, std::vector<Handle>());
+
+    std::vector<raised> events{ { CreateEvent, __window.handle } };
+
+    if (__window.visible())
+    {
+        events.push_back({ ShowEvent, __window.handle });
+    }
+
+    const Handle handle = __window.handle;
+    _M_windows.emplace(handle, std::move(__window));
+
+    _M_raise(events, caller);
+    return handle;
+}
+
+bool WindowServer::destroy(Handle __handle)
+{
+    const ThreadId caller = currentThread();
+
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    if (_M_find(__handle) == nullptr)
+    {
+        return false;
+    }
+
+    std::vector<raised> events;
+    _M_destroy(__handle, events);
+
+    _M_raise(events, caller);
+    return true;
+}
+
+bool WindowServer::contains(Handle __handle) const
+{
+    std::shared_lock<std::shared_mutex> _L_lock(_M_mutex);
+    return _M_find(__handle) != nullptr;
+}
+
+std::optional<WindowServer::Window> WindowServer::window(Handle __handle) const
+{
+    std::shared_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    if (const Window* w = _M_find(__handle))
+    {
+        return *w;
+    }
+
+    return std::nullopt;
+}
+
+bool WindowServer::update(Handle __handle, const std::function<void(Window&)>& __change)
+{
+    const ThreadId caller = currentThread();
+
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    Window* w = _M_find(__handle);
+
+    if (w == nullptr)
+    {
+        return false;
+    }
+
+    const Rect rect = w->rect;
+    const bool visible = w->visible();
+    const bool topmost = w->topmost();
+
+    const std::wstring title = w->title;
+
+    const Handle parent = w->parent;
+
+    __change(*w);
+
+    /// The parent is changed by setParent() only.
+    w->handle = __handle;
+    w->parent = parent;
+
+    std::vector<raised> events;
+
+    if (w->topmost() != topmost)
+    {
+        std::vector<Handle>& siblings = _M_siblings(*w);
+
+        std::erase(siblings, __handle);
+        _M_insert(siblings, *w);
+    }
+
+    if (not (w->rect == rect))
+    {
+        if (w->rect.point() != rect.point())
+        {
+            for (Handle child : _M_children[__handle])
+            {
+                _M_offset(child, w->rect.x() - rect.x(), w->rect.y() - rect.y());
+            }
+        }
+
+        events.push_back({ LocationChangeEvent, __handle });
+    }
+
+    if (w->title != title)
+    {
+        events.push_back({ NameChangeEvent, __handle });
+    }
+
+    if (w->visible() != visible)
+    {
+        events.push_back({ visible ? HideEvent : ShowEvent, __handle });
+    }
+
+    _M_raise(events, caller);
+    return true;
+}
+
+bool WindowServer::setParent(Handle __handle, Handle __parent)
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    Window* w = _M_find(__handle);
+
+    if (w == nullptr || (__parent && _M_find(__parent) == nullptr))
+    {
+        return false;
+    }
+
+    /// A window cannot become a child of its own descendant.
+    for (const Window* p = _M_find(__parent); p; p = _M_find(p->parent))
+    {
+        if (p->handle == __handle)
+        {
+            return false;
+        }
+    }
+
+    std::erase(_M_siblings(*w), __handle);
+
+    w->parent = __parent;
+    _M_insert(_M_siblings(*w), *w);
+
+    return true;
+}
+
+std::vector<WindowServer::Handle> WindowServer::windows(Handle __parent) const
+{
+    std::shared_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    auto it = _M_children.find(__parent);
+    return it != _M_children.end() ? it->second : std::vector<Handle>();
+}
+
+bool WindowServer::place(Handle __handle, Handle __after)
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    Window* w = _M_find(__handle);
+
+    if (w == nullptr || __after == __handle)
+    {
+        return w != nullptr;
+    }
+
+    std::vector<Handle>& siblings = _M_siblings(*w);
+    std::erase(siblings, __handle);
+
+    if (__after == nullptr)
+    {
+        _M_insert(siblings, *w);
+        return true;
+    }
+
+    auto it = std::find(siblings.begin(), siblings.end(), __after);
+
+    if (it == siblings.end())
+    {
+        _M_insert(siblings, *w);
+        return false;
+    }
+
+    /// Keeps the window in its group.
+    auto first = std::find_if(siblings.begin(), siblings.end(), [&](Handle __h) {
+        return _M_find(__h)->topmost() == w->topmost();
+    });
+
+    auto last = std::find_if(first, siblings.end(), [&](Handle __h) {
+        return _M_find(__h)->topmost() != w->topmost();
+    });
+
+    siblings.insert(std::clamp(it + 1, first, last), __handle);
+    return true;
+}
+
+bool WindowServer::placeBottom(Handle __handle)
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    Window* w = _M_find(__handle);
+
+    if (w == nullptr)
+    {
+        return false;
+    }
+
+    std::vector<Handle>& siblings = _M_siblings(*w);
+
+    std::erase(siblings, __handle);
+    w->exStyle &= ~topmostExStyle;
+
+    siblings.push_back(__handle);
+    return true;
+}
+
+bool WindowServer::setTopmost(Handle __handle, bool __topmost)
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    Window* w = _M_find(__handle);
+
+    if (w == nullptr)
+    {
+        return false;
+    }
+
+    std::vector<Handle>& siblings = _M_siblings(*w);
+    std::erase(siblings, __handle);
+
+    if (__topmost)
+    {
+        w->exStyle |= topmostExStyle;
+    }
+    else
+    {
+        w->exStyle &= ~topmostExStyle;
+    }
+
+    _M_insert(siblings, *w);
+    return true;
+}
+
+WindowServer::Handle WindowServer::windowAt(const Point& __point) const
+{
+    std::shared_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    Handle result = nullptr;
+
+    for (const std::vector<Handle>* siblings = &_M_children.at(nullptr); siblings; )
+    {
+        const std::vector<Handle>* next = nullptr;
+
+        for (Handle h : *siblings)
+        {
+            const Window& w = _M_windows.at(h);
+
+            if (w.visible() && not (w.style & minimizedStyle) && _S_contains(w.rect, __point))
+            {
+                result = h;
+                next = &_M_children.at(h);
+                break;
+            }
+        }
+
+        siblings = next;
+    }
+
+    return result;
+}
+
+WindowServer::Handle WindowServer::find(const std::wstring* __className, const std::wstring* __title) const
+{
+    std::shared_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    for (Handle h : _M_children.at(nullptr))
+    {
+        const Window& w = _M_windows.at(h);
+
+        if ((__className == nullptr || w.className == *__className) && (__title == nullptr || w.title == *__title))
+        {
+            return h;
+        }
+    }
+
+    return nullptr;
+}
+
+/* ================== input ================== */
+
+WindowServer::Handle WindowServer::foreground() const
+{
+    std::shared_lock<std::shared_mutex> _L_lock(_M_mutex);
+    return _M_foreground;
+}
+
+bool WindowServer::setForeground(Handle __handle)
+{
+    const ThreadId caller = currentThread();
+
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    Window* w = _M_find(__handle);
+
+    if (w == nullptr || (_M_foregroundLock && _M_foregroundLock != caller))
+    {
+        return false;
+    }
+
+    while (Window* p = _M_find(w->parent))
+    {
+        w = p;
+    }
+
+    std::vector<Handle>& siblings = _M_siblings(*w);
+
+    std::erase(siblings, w->handle);
+    _M_insert(siblings, *w);
+
+    thread& t = _M_thread(w->threadId);
+
+    t.input.active = w->handle;
+    t.input.focus = __handle;
+
+    if (_M_foreground != w->handle)
+    {
+        _M_foreground = w->handle;
+        _M_raise({ { ForegroundEvent, w->handle } }, caller);
+    }
+
+    return true;
+}
+
+void WindowServer::lockForeground(bool __lock)
+{
+    const ThreadId caller = currentThread();
+
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+    _M_foregroundLock = __lock ? caller : 0;
+}
+
+WindowServer::Input WindowServer::input(ThreadId __threadId) const
+{
+    std::shared_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    auto it = _M_threads.find(__threadId);
+    return it != _M_threads.end() ? it->second->input : Input();
+}
+
+bool WindowServer::setFocus(Handle __handle)
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    const Window* w = _M_find(__handle);
+
+    if (w == nullptr)
+    {
+        return false;
+    }
+
+    _M_thread(w->threadId).input.focus = __handle;
+    return true;
+}
+
+bool WindowServer::setActive(Handle __handle)
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    const Window* w = _M_find(__handle);
+
+    if (w == nullptr)
+    {
+        return false;
+    }
+
+    _M_thread(w->threadId).input.active = __handle;
+    return true;
+}
+
+bool WindowServer::setCapture(Handle __handle)
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    const Window* w = _M_find(__handle);
+
+    if (w == nullptr)
+    {
+        return false;
+    }
+
+    _M_thread(w->threadId).input.capture = __handle;
+    return true;
+}
+
+void WindowServer::releaseCapture()
+{
+    const ThreadId caller = currentThread();
+
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+    _M_thread(caller).input.capture = nullptr;
+}
+
+Point WindowServer::cursor() const
+{
+    std::shared_lock<std::shared_mutex> _L_lock(_M_mutex);
+    return _M_cursor;
+}
+
+void WindowServer::setCursor(const Point& __point)
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+    _M_cursor = __point;
+}
+
+/* ================== threads and processes ================== */
+
+WindowServer::ThreadId WindowServer::currentThread()
+{
+    struct binding
+    {
+        std::uint64_t generation = 0;
+        ThreadId id = 0;
+    };
+
+    thread_local binding _S_binding;
+
+    if (_S_binding.generation == _M_generation)
+    {
+        return _S_binding.id;
+    }
+
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    const ThreadId id = _M_nextId;
+    _M_nextId += 4;
+
+    _M_thread(id);
+
+    _S_binding = { _M_generation, id };
+    return id;
+}
+
+WindowServer::ProcessId WindowServer::createProcess(std::wstring __path)
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    const ProcessId id = _M_nextId;
+    _M_nextId += 4;
+
+    _M_processes.emplace(id, std::move(__path));
+    return id;
+}
+
+WindowServer::ThreadId WindowServer::createThread(ProcessId __processId)
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    if (__processId && not _M_processes.contains(__processId))
+    {
+        return 0;
+    }
+
+    const ThreadId id = _M_nextId;
+    _M_nextId += 4;
+
+    _M_thread(id).process = __processId ? __processId : _M_currentProcess;
+    return id;
+}
+
+std::optional<std::wstring> WindowServer::processPath(ProcessId __processId) const
+{
+    std::shared_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    auto it = _M_processes.find(__processId);
+    return it != _M_processes.end() ? std::optional(it->second) : std::nullopt;
+}
+
+std::optional<WindowServer::ProcessId> WindowServer::processOf(ThreadId __threadId) const
+{
+    std::shared_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    auto it = _M_threads.find(__threadId);
+    return it != _M_threads.end() ? std::optional(it->second->process) : std::nullopt;
+}
+
+bool WindowServer::terminateProcess(ProcessId __processId)
+{
+    const ThreadId caller = currentThread();
+
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    if (not _M_processes.contains(__processId))
+    {
+        return false;
+    }
+
+    std::vector<Handle> handles;
+
+    for (const auto& [h, w] : _M_windows)
+    {
+        if (w.processId == __processId)
+        {
+            handles.push_back(h);
+        }
+    }
+
+    std::vector<raised> events;
+
+    for (Handle h : handles)
+    {
+        if (_M_find(h))
+        {
+            _M_destroy(h, events);
+        }
+    }
+
+    if (__processId != _M_currentProcess)
+    {
+        _M_processes.erase(__processId);
+    }
+
+    _M_raise(events, caller);
+    return true;
+}
+
+bool WindowServer::terminateThread(ThreadId __threadId)
+{
+    const ThreadId caller = currentThread();
+
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    if (not _M_threads.contains(__threadId))
+    {
+        return false;
+    }
+
+    std::vector<Handle> handles;
+
+    for (const auto& [h, w] : _M_windows)
+    {
+        if (w.threadId == __threadId)
+        {
+            handles.push_back(h);
+        }
+    }
+
+    std::vector<raised> events;
+
+    for (Handle h : handles)
+    {
+        if (_M_find(h))
+        {
+            _M_destroy(h, events);
+        }
+    }
+
+    _M_raise(events, caller);
+    return true;
+}
+
+/* ================== messages ================== */
+
+bool WindowServer::post(Handle __handle, std::uint32_t __message, std::uintptr_t __wParam, std::intptr_t __lParam)
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    const Window* w = _M_find(__handle);
+
+    if (w == nullptr)
+    {
+        return false;
+    }
+
+    thread& t = _M_thread(w->threadId);
+
+    t.queue.push_back({ Message{ __handle, __message, __wParam, __lParam, Clock::now() }, nullptr });
+    t.arrived.notify_all();
+
+    return true;
+}
+
+bool WindowServer::postThread(ThreadId __threadId, std::uint32_t __message, std::uintptr_t __wParam, std::intptr_t __lParam)
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    auto it = _M_threads.find(__threadId);
+
+    if (it == _M_threads.end())
+    {
+        return false;
+    }
+
+    it->second->queue.push_back({ Message{ nullptr, __message, __wParam, __lParam, Clock::now() }, nullptr });
+    it->second->arrived.notify_all();
+
+    return true;
+}
+
+bool WindowServer::_S_matches(const Message& __message, Handle __filter, std::uint32_t __min, std::uint32_t __max) noexcept
+{
+    if (__message.message == _S_quit)
+    {
+        return true;
+    }
+
+    if (__filter == _S_threadMessages ? __message.window != nullptr : __filter && __message.window != __filter)
+    {
+        return false;
+    }
+
+    return (__min == 0 && __max == 0) || (__message.message >= __min && __message.message <= __max);
+}
+
+bool WindowServer::get(Message& __message, Handle __filter, std::uint32_t __min, std::uint32_t __max)
+{
+    const ThreadId caller = currentThread();
+
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    thread& t = _M_thread(caller);
+
+    for (;;)
+    {
+        auto it = std::find_if(t.queue.begin(), t.queue.end(), [&](const thread::entry& __e) {
+            return __e.call || _S_matches(__e.message, __filter, __min, __max);
+        });
+
+        if (it == t.queue.end())
+        {
+            t.arrived.wait(_L_lock);
+            continue;
+        }
+
+        thread::entry e = std::move(*it);
+        t.queue.erase(it);
+
+        if (e.call)
+        {
+            _L_lock.unlock();
+            e.call();
+            _L_lock.lock();
+
+            continue;
+        }
+
+        __message = e.message;
+        return __message.message != _S_quit;
+    }
+}
+
+bool WindowServer::peek(Message& __message, Handle __filter, std::uint32_t __min, std::uint32_t __max, bool __remove)
+{
+    const ThreadId caller = currentThread();
+
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    thread& t = _M_thread(caller);
+
+    for (;;)
+    {
+        auto it = std::find_if(t.queue.begin(), t.queue.end(), [&](const thread::entry& __e) {
+            return __e.call || _S_matches(__e.message, __filter, __min, __max);
+        });
+
+        if (it == t.queue.end())
+        {
+            return false;
+        }
+
+        if (it->call)
+        {
+            std::function<void()> call = std::move(it->call);
+            t.queue.erase(it);
+
+            _L_lock.unlock();
+            call();
+            _L_lock.lock();
+
+            continue;
+        }
+
+        __message = it->message;
+
+        if (__remove)
+        {
+            t.queue.erase(it);
+        }
+
+        return true;
+    }
+}
+
+std::optional<std::intptr_t> WindowServer::send(
+    Handle __handle,
+    std::uint32_t __message,
+    std::uintptr_t __wParam,
+    std::intptr_t __lParam,
+    bool __failIfHung)
+{
+    Procedure procedure;
+
+    {
+        std::shared_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+        const Window* w = _M_find(__handle);
+
+        if (w == nullptr || (__failIfHung && w->hung))
+        {
+            return std::nullopt;
+        }
+
+        procedure = w->procedure;
+    }
+
+    return procedure
+        ? procedure(__handle, __message, __wParam, __lParam)
+        : defaultProcedure(__handle, __message, __wParam, __lParam);
+}
+
+std::intptr_t WindowServer::dispatch(const Message& __message)
+{
+    if (__message.window == nullptr)
+    {
+        return 0;
+    }
+
+    return send(__message.window, __message.message, __message.wParam, __message.lParam).value_or(0);
+}
+
+std::intptr_t WindowServer::defaultProcedure(Handle __handle, std::uint32_t __message, std::uintptr_t __wParam, std::intptr_t __lParam)
+{
+    switch (__message)
+    {
+    case _S_setText:
+    {
+        const wchar_t* text = reinterpret_cast<const wchar_t*>(__lParam);
+        return update(__handle, [&](Window& __w) { __w.title = text ? text : L""; });
+    }
+
+    case _S_getText:
+    {
+        std::optional<Window> w = window(__handle);
+
+        if (not w || __wParam == 0)
+        {
+            return 0;
+        }
+
+        const std::size_t length = std::min<std::size_t>(w->title.size(), __wParam - 1);
+        wchar_t* buffer = reinterpret_cast<wchar_t*>(__lParam);
+
+        std::copy_n(w->title.data(), length, buffer);
+        buffer[length] = L'\0';
+
+        return static_cast<std::intptr_t>(length);
+    }
+
+    case _S_getTextLength:
+    {
+        std::optional<Window> w = window(__handle);
+        return w ? static_cast<std::intptr_t>(w->title.size()) : 0;
+    }
+
+    case _S_close:
+        destroy(__handle);
+        return 0;
+
+    default:
+        return 0;
+    }
+}
+
+/* ================== hot keys and events ================== */
+
+bool WindowServer::registerHotKey(Handle __handle, int __id, std::uint32_t __modifiers, std::uint32_t __key)
+{
+    const ThreadId caller = currentThread();
+
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    const Window* w = _M_find(__handle);
+
+    if (__handle && w == nullptr)
+    {
+        return false;
+    }
+
+    __modifiers &= ~_S_noRepeat;
+
+    for (const hotKey& k : _M_hotKeys)
+    {
+        if ((k.modifiers == __modifiers && k.key == __key) || (k.handle == __handle && k.id == __id))
+        {
+            return false;
+        }
+    }
+
+    _M_hotKeys.push_back({ __handle, __id, __modifiers, __key, w ? w->threadId : caller });
+    return true;
+}
+
+bool WindowServer::unregisterHotKey(Handle __handle, int __id)
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    return std::erase_if(_M_hotKeys, [&](const hotKey& __k) {
+        return __k.handle == __handle && __k.id == __id;
+    });
+}
+
+bool WindowServer::pressHotKey(std::uint32_t __modifiers, std::uint32_t __key)
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    __modifiers &= ~_S_noRepeat;
+
+    for (const hotKey& k : _M_hotKeys)
+    {
+        if (k.modifiers == __modifiers && k.key == __key)
+        {
+            thread& t = _M_thread(k.thread);
+
+            t.queue.push_back({
+                Message{
+                    k.handle,
+                    _S_hotKey,
+                    static_cast<std::uintptr_t>(k.id),
+                    static_cast<std::intptr_t>((__key << 16) | __modifiers),
+                    Clock::now() },
+                nullptr });
+
+            t.arrived.notify_all();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::uint64_t WindowServer::hook(std::uint32_t __min, std::uint32_t __max, EventHook __hook, bool __skipOwnThread)
+{
+    const ThreadId caller = currentThread();
+
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+
+    const std::uint64_t id = _M_nextHook++;
+    _M_hooks.push_back({ id, __min, __max, std::move(__hook), caller, __skipOwnThread });
+
+    return id;
+}
+
+bool WindowServer::unhook(std::uint64_t __id)
+{
+    std::unique_lock<std::shared_mutex> _L_lock(_M_mutex);
+    return std::erase_if(_M_hooks, [&](const eventHook& __h) { return __h.id == __id; });
+}
+
+/* ================== framebuffer ================== */
+
+std::uint32_t WindowServer::pixel(const Point& __point) const
+{
+    std::lock_guard<std::mutex> _L_lock(_M_framebufferMutex);
+
+    if (not _S_contains(Rect(Point(0, 0), _M_options.screen), __point))
+    {
+        return 0;
+    }
+
+    return _M_framebuffer[static_cast<std::size_t>(__point.y()) * _M_options.screen.w() + __point.x()];
+}
+
+std::vector<std::uint32_t> WindowServer::capture(const Rect& __rect) const
+{
+    std::vector<std::uint32_t> result(static_cast<std::size_t>(std::max(0, __rect.w())) * std::max(0, __rect.h()), 0);
+
+    std::lock_guard<std::mutex> _L_lock(_M_framebufferMutex);
+
+    for (int y = 0; y < __rect.h(); ++y)
+    {
+        for (int x = 0; x < __rect.w(); ++x)
+        {
+            const Point p(__rect.x() + x, __rect.y() + y);
+
+            if (_S_contains(Rect(Point(0, 0), _M_options.screen), p))
+            {
+                result[static_cast<std::size_t>(y) * __rect.w() + x] =
+                    _M_framebuffer[static_cast<std::size_t>(p.y()) * _M_options.screen.w() + p.x()];
+            }
+        }
+    }
+
+    return result;
+}
+
+/* ================== latency and call counts ================== */
+
+std::size_t WindowServer::callId(std::string_view __call)
+{
+    return _S_callRegistry().add(__call);
+}
+
+void WindowServer::enter(std::size_t __callId) noexcept
+{
+    _M_calls[__callId].fetch_add(1, std::memory_order_relaxed);
+
+    std::int64_t latency = _M_latencies[__callId].load(std::memory_order_relaxed);
+
+    if (latency < 0)
+    {
+        latency = _M_latency.load(std::memory_order_relaxed);
+    }
+
+    if (latency <= 0)
+    {
+        return;
+    }
+
+    /// Spun rather than slept, a sleep may overshoot by a whole timer tick.
+    const Clock::time_point deadline = Clock::now() + std::chrono::nanoseconds(latency);
+
+    while (Clock::now() < deadline)
+    {
+        std::this_thread::yield();
+    }
+}
+
+void WindowServer::setLatency(std::chrono::nanoseconds __latency) noexcept
+{
+    _M_latency.store(__latency.count(), std::memory_order_relaxed);
+}
+
+void WindowServer::setLatency(std::string_view __call, std::chrono::nanoseconds __latency)
+{
+    _M_latencies[callId(__call)].store(__latency.count() < 0 ? -1 : __latency.count(), std::memory_order_relaxed);
+}
+
+std::uint64_t WindowServer::calls(std::string_view __call) const
+{
+    const std::size_t id = _S_callRegistry().find(__call);
+    return id < maxCalls ? _M_calls[id].load(std::memory_order_relaxed) : 0;
+}
+
+std::uint64_t WindowServer::calls() const noexcept
+{
+    std::uint64_t total = 0;
+
+    for (std::size_t i = 0; i < maxCalls; ++i)
+    {
+        total += _M_calls[i].load(std::memory_order_relaxed);
+    }
+
+    return total;
+}
+
+void WindowServer::resetCalls() noexcept
+{
+    for (std::size_t i = 0; i < maxCalls; ++i)
+    {
+        _M_calls[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+/* ================== private ================== */
+
+WindowServer::thread& WindowServer::_M_thread(ThreadId __threadId)
+{
+    auto [it, inserted] = _M_threads.try_emplace(__threadId);
+
+    if (inserted)
+    {
+        it->second = std::make_unique<thread>();
+        it->second->process = _M_currentProcess;
+    }
+
+    return *it->second;
+}
+
+WindowServer::Window* WindowServer::_M_find(Handle __handle) noexcept
+{
+    auto it = _M_windows.find(__handle);
+    return it != _M_windows.end() ? &it->second : nullptr;
+}
+
+const WindowServer::Window* WindowServer::_M_find(Handle __handle) const noexcept
+{
+    auto it = _M_windows.find(__handle);
+    return it != _M_windows.end() ? &it->second : nullptr;
+}
+
+std::vector<WindowServer::Handle>& WindowServer::_M_siblings(const Window& __window)
+{
+    return _M_children[__window.parent];
+}
+
+void WindowServer::_M_insert(std::vector<Handle>& __siblings, const Window& __window)
+{
+    auto it = __siblings.begin();
+
+    if (not __window.topmost())
+    {
+        it = std::find_if(__siblings.begin(), __siblings.end(), [&](Handle __h) {
+            return __h != __window.handle && not _M_windows.at(__h).topmost();
+        });
+    }
+
+    __siblings.insert(it, __window.handle);
+}
+
+void WindowServer::_M_offset(Handle __handle, int __dx, int __dy)
+{
+    Window& w = _M_windows.at(__handle);
+
+    w.rect = Rect(w.rect.x() + __dx, w.rect.y() + __dy, w.rect.w(), w.rect.h());
+
+    for (Handle child : _M_children[__handle])
+    {
+        _M_offset(child, __dx, __dy);
+    }
+}
+
+void WindowServer::_M_destroy(Handle __handle, std::vector<raised>& __events)
+{
+    /// Children and owned windows go first, as in Win32.
+    const std::vector<Handle> children = _M_children[__handle];
+
+    for (Handle child : children)
+    {
+        _M_destroy(child, __events);
+    }
+
+    std::vector<Handle> owned;
+
+    for (const auto& [h, w] : _M_windows)
+    {
+        if (w.owner == __handle)
+        {
+            owned.push_back(h);
+        }
+    }
+
+    for (Handle h : owned)
+    {
+        if (_M_find(h))
+        {
+            _M_destroy(h, __events);
+        }
+    }
+
+    _M_erase(__handle);
+    __events.push_back({ DestroyEvent, __handle });
+}
+
+void WindowServer::_M_erase(Handle __handle)
+{
+    std::erase(_M_siblings(_M_windows.at(__handle)), __handle);
+
+    _M_children.erase(__handle);
+    _M_windows.erase(__handle);
+
+    if (_M_foreground == __handle)
+    {
+        _M_foreground = nullptr;
+    }
+
+    for (auto& [id, t] : _M_threads)
+    {
+        for (Handle* h : { &t->input.focus, &t->input.active, &t->input.capture })
+        {
+            if (*h == __handle)
+            {
+                *h = nullptr;
+            }
+        }
+    }
+
+    std::erase_if(_M_hotKeys, [&](const hotKey& __k) { return __k.handle == __handle; });
+}
+
+void WindowServer::_M_raise(const std::vector<raised>& __events, ThreadId __from)
+{
+    for (const raised& r : __events)
+    {
+        for (const eventHook& h : _M_hooks)
+        {
+            if (r.event < h.min || r.event > h.max || (h.skipOwnThread && h.thread == __from))
+            {
+                continue;
+            }
+
+            thread& t = _M_thread(h.thread);
+
+            t.queue.push_back({ Message(), [hook = h.hook, r] { hook(r.event, r.handle); } });
+            t.arrived.notify_all();
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,418 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WindowSnapshot.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 16:31:09
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Implement WindowSnapshot.h, except the Win32 parts which are in
+*        WindowSnapshotSystem.cpp.
+*/
+
+#include <openWin/WindowSnapshot.h>
+
+#include <algorithm>
+#include <sstream>
+
+using namespace win;
+
+WindowSnapshot WindowSnapshot::capture(Source& __source, Fields __fields)
+{
+    WindowSnapshot result;
+    result._M_fields = __fields & All;
+
+    __source.enumerate(result._M_handles);
+
+    const std::size_t count = result._M_handles.size();
+
+    if (__fields & Title)
+    {
+        result._M_titles.reserve(count);
+    }
+
+    if (__fields & ClassName)
+    {
+        result._M_classNames.reserve(count);
+    }
+
+    if (__fields & Rect)
+    {
+        result._M_rects.reserve(count);
+    }
+
+    if (__fields & ProcessId)
+    {
+        result._M_processIds.reserve(count);
+    }
+
+    if (__fields & ThreadId)
+    {
+        result._M_threadIds.reserve(count);
+    }
+
+    if (__fields & Visible)
+    {
+        result._M_visible.reserve(count);
+    }
+
+    /// Usually shorter than 32 characters each.
+    if (__fields & (Title | ClassName))
+    {
+        result._M_arena.reserve(count * 32);
+    }
+
+    for (Win::Handle handle : result._M_handles)
+    {
+        if (__fields & Title)
+        {
+            const std::size_t offset = result._M_arena.size();
+            __source.appendTitle(handle, result._M_arena);
+
+            result._M_titles.push_back({
+                static_cast<std::uint32_t>(offset),
+                static_cast<std::uint32_t>(result._M_arena.size() - offset) });
+        }
+
+        if (__fields & ClassName)
+        {
+            const std::size_t offset = result._M_arena.size();
+            __source.appendClassName(handle, result._M_arena);
+
+            result._M_classNames.push_back({
+                static_cast<std::uint32_t>(offset),
+                static_cast<std::uint32_t>(result._M_arena.size() - offset) });
+        }
+
+        if (__fields & Rect)
+        {
+            result._M_rects.push_back(__source.rect(handle));
+        }
+
+        if (__fields & (ProcessId | ThreadId))
+        {
+            Win::ProcessId processId = 0;
+            Win::ThreadId threadId = 0;
+
+            __source.ids(handle, processId, threadId);
+
+            if (__fields & ProcessId)
+            {
+                result._M_processIds.push_back(processId);
+            }
+
+            if (__fields & ThreadId)
+            {
+                result._M_threadIds.push_back(threadId);
+            }
+        }
+
+        if (__fields & Visible)
+        {
+            result._M_visible.push_back(__source.isVisible(handle));
+        }
+    }
+
+    return result;
+}
+
+WindowSnapshot::Record WindowSnapshot::fetch(Source& __source, Win::Handle __handle, Fields __fields)
+{
+    Record result;
+    result.handle = __handle;
+
+    if (__fields & Title)
+    {
+        __source.appendTitle(__handle, result.title);
+    }
+
+    if (__fields & ClassName)
+    {
+        __source.appendClassName(__handle, result.className);
+    }
+
+    if (__fields & Rect)
+    {
+        result.rect = __source.rect(__handle);
+    }
+
+    if (__fields & (ProcessId | ThreadId))
+    {
+        __source.ids(__handle, result.processId, result.threadId);
+    }
+
+    if (__fields & Visible)
+    {
+        result.visible = __source.isVisible(__handle);
+    }
+
+    return result;
+}
+
+void WindowSnapshot::append(const Record& __record)
+{
+    _M_handles.push_back(__record.handle);
+
+    if (_M_fields & Title)
+    {
+        _M_appendText(_M_titles, __record.title);
+    }
+
+    if (_M_fields & ClassName)
+    {
+        _M_appendText(_M_classNames, __record.className);
+    }
+
+    if (_M_fields & Rect)
+    {
+        _M_rects.push_back(__record.rect);
+    }
+
+    if (_M_fields & ProcessId)
+    {
+        _M_processIds.push_back(__record.processId);
+    }
+
+    if (_M_fields & ThreadId)
+    {
+        _M_threadIds.push_back(__record.threadId);
+    }
+
+    if (_M_fields & Visible)
+    {
+        _M_visible.push_back(__record.visible);
+    }
+}
+
+std::size_t WindowSnapshot::indexOf(Win::Handle __handle) const noexcept
+{
+    return static_cast<std::size_t>(
+        std::find(_M_handles.begin(), _M_handles.end(), __handle) - _M_handles.begin());
+}
+
+WinList WindowSnapshot::wins() const
+{
+    return WinList(_M_handles.begin(), _M_handles.end());
+}
+
+WinList WindowSnapshot::wins(std::span<const std::size_t> __indexes) const
+{
+    WinList result;
+    result.reserve(__indexes.size());
+
+    for (std::size_t index : __indexes)
+    {
+        result.push_back(Win(_M_handles[index]));
+    }
+
+    return result;
+}
+
+void WindowSnapshot::_M_appendText(std::vector<textspan>& __spans, std::string_view __text)
+{
+    __spans.push_back({
+        static_cast<std::uint32_t>(_M_arena.size()),
+        static_cast<std::uint32_t>(__text.size()) });
+
+    _M_arena.append(__text);
+}
+
+/**
+ * The text format:
+ * 
+ *     openWin-snapshot 1 <fields> <count>
+ *     <handle> <x> <y> <width> <height> <process id> <thread id> <visible>
+ *     <title>
+ *     <class name>
+ *     ...
+ * 
+ * Handles are in hexadecimal, the texts are escaped with \\, \n and \r.
+ */
+
+static constexpr std::string_view _S_header = "openWin-snapshot";
+
+static void _S_writeEscaped(std::ostream& __os, std::string_view __text)
+{
+    for (char ch : __text)
+    {
+        switch (ch)
+        {
+        case '\\': __os << "\\\\"; break;
+        case '\n': __os << "\\n"; break;
+        case '\r': __os << "\\r"; break;
+        default:   __os.put(ch); break;
+        }
+    }
+
+    __os.put('\n');
+}
+
+static std::string _S_unescape(std::string_view __line)
+{
+    std::string result;
+    result.reserve(__line.size());
+
+    for (std::size_t i = 0; i < __line.size(); ++i)
+    {
+        if (__line[i] == '\\' && i + 1 < __line.size())
+        {
+            switch (__line[++i])
+            {
+            case 'n': result += '\n'; break;
+            case 'r': result += '\r'; break;
+            default:  result += __line[i]; break;
+            }
+        }
+        else
+        {
+            result += __line[i];
+        }
+    }
+
+    return result;
+}
+
+void WindowSnapshot::write(std::ostream& __os) const
+{
+    __os << _S_header << " 1 " << _M_fields << ' ' << size() << '\n';
+
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        const win::Rect r = rect(i);
+
+        __os << std::hex << reinterpret_cast<std::uintptr_t>(_M_handles[i]) << std::dec
+             << ' ' << r.x() << ' ' << r.y() << ' ' << r.width() << ' ' << r.height()
+             << ' ' << processId(i) << ' ' << threadId(i) << ' ' << isVisible(i) << '\n';
+
+        _S_writeEscaped(__os, title(i));
+        _S_writeEscaped(__os, className(i));
+    }
+}
+
+WindowSnapshot WindowSnapshot::read(std::istream& __is)
+{
+    WindowSnapshot result;
+
+    std::string line;
+
+    if (not std::getline(__is, line))
+    {
+        return result;
+    }
+
+    std::istringstream header(line);
+
+    std::string magic;
+    int version = 0;
+    std::size_t count = 0;
+
+    if (not (header >> magic >> version >> result._M_fields >> count)
+        || magic != _S_header || version != 1)
+    {
+        return WindowSnapshot();
+    }
+
+    result._M_fields &= All;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::uintptr_t handle = 0;
+        int x = 0, y = 0, width = 0, height = 0;
+        int visible = 0;
+
+        Record record;
+
+        if (not std::getline(__is, line))
+        {
+            return WindowSnapshot();
+        }
+
+        std::istringstream fields(line);
+
+        if (not (fields >> std::hex >> handle >> std::dec >> x >> y >> width >> height
+                        >> record.processId >> record.threadId >> visible))
+        {
+            return WindowSnapshot();
+        }
+
+        if (not std::getline(__is, record.title) || not std::getline(__is, record.className))
+        {
+            return WindowSnapshot();
+        }
+
+        record.handle = reinterpret_cast<Win::Handle>(handle);
+        record.title = _S_unescape(record.title);
+        record.className = _S_unescape(record.className);
+        record.rect = win::Rect(x, y, width, height);
+        record.visible = visible != 0;
+
+        result.append(record);
+    }
+
+    return result;
+}
+
+WindowSnapshot::ReplaySource::ReplaySource(WindowSnapshot __snapshot)
+{
+    setSnapshot(std::move(__snapshot));
+}
+
+void WindowSnapshot::ReplaySource::setSnapshot(WindowSnapshot __snapshot)
+{
+    _M_snapshot = std::move(__snapshot);
+
+    _M_indexes.clear();
+    _M_indexes.reserve(_M_snapshot.size());
+
+    for (std::size_t i = 0; i < _M_snapshot.size(); ++i)
+    {
+        _M_indexes.emplace(_M_snapshot.handle(i), i);
+    }
+}
+
+void WindowSnapshot::ReplaySource::enumerate(std::vector<Win::Handle>& __handles)
+{
+    __handles.insert(__handles.end(), _M_snapshot._M_handles.begin(), _M_snapshot._M_handles.end());
+}
+
+void WindowSnapshot::ReplaySource::appendTitle(Win::Handle __handle, std::string& __arena)
+{
+    if (auto it = _M_indexes.find(__handle); it != _M_indexes.end())
+    {
+        __arena.append(_M_snapshot.title(it->second));
+    }
+}
+
+void WindowSnapshot::ReplaySource::appendClassName(Win::Handle __handle, std::string& __arena)
+{
+    if (auto it = _M_indexes.find(__handle); it != _M_indexes.end())
+    {
+        __arena.append(_M_snapshot.className(it->second));
+    }
+}
+
+win::Rect WindowSnapshot::ReplaySource::rect(Win::Handle __handle)
+{
+    auto it = _M_indexes.find(__handle);
+    return it != _M_indexes.end() ? _M_snapshot.rect(it->second) : win::Rect();
+}
+
+void WindowSnapshot::ReplaySource::ids(Win::Handle __handle, Win::ProcessId& __processId, Win::ThreadId& __threadId)
+{
+    if (auto it = _M_indexes.find(__handle); it != _M_indexes.end())
+    {
+        __processId = _M_snapshot.processId(it->second);
+        __threadId = _M_snapshot.threadId(it->second);
+    }
+}
+
+bool WindowSnapshot::ReplaySource::isVisible(Win::Handle __handle)
+{
+    auto it = _M_indexes.find(__handle);
+    return it != _M_indexes.end() && _M_snapshot.isVisible(it->second);
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WindowSnapshotSystem.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 16, 2026, 16:58:40
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief The Win32 source of WindowSnapshot.
+*/
+
+#include <openWin/WindowSnapshot.h>
+
+#include "Built-in/_Windows.h"
+#include "Built-in/_MacrosForErrorHandling.h"
+
+using namespace win;
+
+static inline HWND $(Win::Handle __handle) noexcept
+{ return reinterpret_cast<HWND>(__handle); }
+
+/**
+ * @brief Fetches the fields the same way as the getters of Win, but without a
+ *        guard per call and straight into the arena of the snapshot.
+ */
+class _SystemSnapshotSource : public WindowSnapshot::Source
+{
+public:
+
+    virtual void enumerate(std::vector<Win::Handle>& __handles) override
+    {
+        EnumWindows(
+            static_cast<WNDENUMPROC>(
+                [](HWND hWnd, LPARAM lParam) -> BOOL
+                {
+                    reinterpret_cast<std::vector<Win::Handle>*>(lParam)->push_back(hWnd);
+                    return true;
+                }),
+            reinterpret_cast<LPARAM>(&__handles));
+    }
+
+    /**
+     * @brief Reads the title with InternalGetWindowText, which neither sends
+     *        WM_GETTEXT nor WM_GETTEXTLENGTH, so a hung window cannot block.
+     */
+    virtual void appendTitle(Win::Handle __handle, std::string& __arena) override
+    {
+        wchar_t buffer[1 << 10];
+
+        const int length = InternalGetWindowText($(__handle), buffer, static_cast<int>(std::size(buffer)));
+
+        if (length <= 0)
+        {
+            return;
+        }
+
+        const int size = WideCharToMultiByte(CP_ACP, 0, buffer, length, nullptr, 0, nullptr, nullptr);
+
+        if (size <= 0)
+        {
+            return;
+        }
+
+        const std::size_t offset = __arena.size();
+        __arena.resize(offset + static_cast<std::size_t>(size));
+
+        WideCharToMultiByte(CP_ACP, 0, buffer, length, __arena.data() + offset, size, nullptr, nullptr);
+    }
+
+    virtual void appendClassName(Win::Handle __handle, std::string& __arena) override
+    {
+        char buffer[1 << 8];
+
+        const unsigned int length = RealGetWindowClassA($(__handle), buffer, sizeof(buffer));
+
+        __arena.append(buffer, length);
+    }
+
+    [[nodiscard]] virtual win::Rect rect(Win::Handle __handle) override
+    {
+        RECT buffer{};
+
+        GetWindowRect($(__handle), &buffer);
+
+        const UINT dpi = GetDpiForWindow($(__handle));
+
+        return win::Rect(
+            buffer.left,
+            buffer.top,
+            buffer.right - buffer.left,
+            buffer.bottom - buffer.top).mapto(dpi ? dpi / 96.0F : 1.00F);
+    }
+
+    virtual void ids(Win::Handle __handle, Win::ProcessId& __processId, Win::ThreadId& __threadId) override
+    {
+        DWORD processId = 0;
+
+        __threadId = GetWindowThreadProcessId($(__handle), &processId);
+        __processId = processId;
+    }
+
+    [[nodiscard]] virtual bool isVisible(Win::Handle __handle) override
+    {
+        return IsWindowVisible($(__handle));
+    }
+};
+
+WindowSnapshot::Source& WindowSnapshot::Source::system() noexcept
+{
+    static _SystemSnapshotSource _S_source;
+    return _S_source;
+}
+
+WindowSnapshot WindowSnapshot::capture(Fields __fields) noexcept
+{
+    /// Windows destroyed during the capture only leave empty fields, this is
+    /// not reported as an error.
+    _Win_Static_Begin_Nocheck_
+    return capture(Source::system(), __fields);
+}
\ No newline at end of file
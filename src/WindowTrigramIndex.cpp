@@ -0,0 +1,727 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* WindowTrigramIndex.cpp In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 17, 2026, 03:27:58
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Implement WindowTrigramIndex.h
+*/
+
+#include <openWin/WindowTrigramIndex.h>
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <queue>
+
+using namespace win;
+
+/**
+ * @brief The candidates with the most trigram hits that may match the words
+ *        of the query with typos, whose edit distances are the slowest part of
+ *        a search.
+ */
+static constexpr std::size_t _S_typoCandidates = 256;
+
+/**
+ * @return true for the folded ASCII letters and digits, and the bytes of the
+ *         other characters.
+ */
+static constexpr bool _S_isWordByte(char __c) noexcept
+{
+    return (__c >= 'a' && __c <= 'z') || (__c >= '0' && __c <= '9') || static_cast<unsigned char>(__c) >= 0x80;
+}
+
+/**
+ * @return How well the folded query matches the text as a subsequence, from
+ *         0 to 0.5: mostly the share of its letters at the start of a word or
+ *         right after the letter before, as in an acronym, then how tight the
+ *         match is.
+ */
+static double _S_matchSubsequence(std::string_view __text, std::string_view __query) noexcept
+{
+    constexpr std::size_t npos = std::string_view::npos;
+
+    const auto wordStart = [&](std::size_t __i) noexcept {
+        return __i == 0 || not _S_isWordByte(__text[__i - 1]);
+    };
+
+    /// The letters at the starts of words first, then the earliest letters if
+    /// that leaves some of the query unmatched.
+    for (const bool acronym : { true, false })
+    {
+        std::size_t first = npos;
+        std::size_t last = npos;
+        std::size_t good = 0;
+
+        std::size_t j = 0;
+
+        for (; j < __query.size(); ++j)
+        {
+            const char c = __query[j];
+
+            std::size_t pos;
+
+            if (last != npos && last + 1 < __text.size() && __text[last + 1] == c)
+            {
+                pos = last + 1;
+            }
+            else
+            {
+                pos = __text.find(c, last == npos ? 0 : last + 1);
+
+                for (std::size_t next = pos; acronym && next != npos; next = __text.find(c, next + 1))
+                {
+                    if (wordStart(next))
+                    {
+                        pos = next;
+                        break;
+                    }
+                }
+            }
+
+            if (pos == npos)
+            {
+                break;
+            }
+
+            good += (last != npos && pos == last + 1) || wordStart(pos);
+
+            if (first == npos)
+            {
+                first = pos;
+            }
+
+            last = pos;
+        }
+
+        if (j == __query.size())
+        {
+            const double size = static_cast<double>(__query.size());
+            return 0.5 * (0.8 * static_cast<double>(good) / size + 0.2 * size / static_cast<double>(last - first + 1));
+        }
+    }
+
+    return 0.0;
+}
+
+/**
+ * @return How well the text matches the folded query, from 0 to 1.
+ */
+static double _S_matchText(std::string_view __text, std::string_view __query) noexcept
+{
+    if (__text.empty() || __query.empty())
+    {
+        return 0.0;
+    }
+
+    if (const std::size_t pos = __text.find(__query); pos != std::string_view::npos)
+    {
+        if (pos == 0)
+        {
+            return __text.size() == __query.size() ? 1.0 : 0.9;
+        }
+
+        const auto before = static_cast<unsigned char>(__text[pos - 1]);
+
+        /// At the start of a word.
+        return std::isalnum(before) ? 0.7 : 0.8;
+    }
+
+    return _S_matchSubsequence(__text, __query);
+}
+
+/**
+ * @return The optimal string alignment distance of two words, counting a swap
+ *         of two adjacent letters as one edit, or __max + 1 if over __max.
+ */
+static std::size_t _S_distance(std::string_view __lhs, std::string_view __rhs, std::size_t __max) noexcept
+{
+    if ((__lhs.size() > __rhs.size() ? __lhs.size() - __rhs.size() : __rhs.size() - __lhs.size()) > __max)
+    {
+        return __max + 1;
+    }
+
+    /// Each letter of one word missing from the other takes an edit at least.
+    const auto letters = [](std::string_view __word) noexcept {
+        std::uint64_t mask = 0;
+
+        for (char c : __word)
+        {
+            mask |= std::uint64_t(1) << (static_cast<unsigned char>(c) & 63);
+        }
+
+        return mask;
+    };
+
+    const std::uint64_t lhs = letters(__lhs);
+    const std::uint64_t rhs = letters(__rhs);
+
+    if (static_cast<std::size_t>(std::popcount(lhs & ~rhs)) > __max || static_cast<std::size_t>(std::popcount(rhs & ~lhs)) > __max)
+    {
+        return __max + 1;
+    }
+
+    /// Three rows of the table, the words are short.
+    constexpr std::size_t capacity = 32;
+
+    if (__rhs.size() >= capacity)
+    {
+        return __lhs == __rhs ? 0 : __max + 1;
+    }
+
+    std::size_t rows[3][capacity];
+
+    std::size_t* before = rows[0];
+    std::size_t* previous = rows[1];
+    std::size_t* current = rows[2];
+
+    for (std::size_t j = 0; j <= __rhs.size(); ++j)
+    {
+        previous[j] = j;
+    }
+
+    for (std::size_t i = 1; i <= __lhs.size(); ++i)
+    {
+        current[0] = i;
+
+        std::size_t least = current[0];
+
+        for (std::size_t j = 1; j <= __rhs.size(); ++j)
+        {
+            const std::size_t cost = __lhs[i - 1] == __rhs[j - 1] ? 0 : 1;
+
+            current[j] = std::min({ previous[j] + 1, current[j - 1] + 1, previous[j - 1] + cost });
+
+            if (i > 1 && j > 1 && __lhs[i - 1] == __rhs[j - 2] && __lhs[i - 2] == __rhs[j - 1])
+            {
+                current[j] = std::min(current[j], before[j - 2] + 1);
+            }
+
+            least = std::min(least, current[j]);
+        }
+
+        if (least > __max)
+        {
+            return __max + 1;
+        }
+
+        std::swap(before, previous);
+        std::swap(previous, current);
+    }
+
+    return std::min(previous[__rhs.size()], __max + 1);
+}
+
+/**
+ * @brief Calls __func with each word of the folded text.
+ */
+template<typename _Func>
+static void _S_forEachWord(std::string_view __text, _Func&& __func)
+{
+    for (std::size_t i = 0; i < __text.size(); )
+    {
+        if (not _S_isWordByte(__text[i]))
+        {
+            ++i;
+            continue;
+        }
+
+        std::size_t j = i;
+
+        while (j < __text.size() && _S_isWordByte(__text[j]))
+        {
+            ++j;
+        }
+
+        __func(__text.substr(i, j - i));
+        i = j;
+    }
+}
+
+/**
+ * @return How well the words of the folded query match words of the text
+ *         with typos, from 0 to 0.4: one edit in words of 4 letters and up,
+ *         two in words of 8 and up, and 0 if a word matches none.
+ */
+static double _S_matchWords(std::string_view __text, std::string_view __query) noexcept
+{
+    if (__text.empty())
+    {
+        return 0.0;
+    }
+
+    double total = 0.0;
+    std::size_t words = 0;
+    bool all = true;
+
+    _S_forEachWord(__query, [&](std::string_view __word) {
+        if (not all)
+        {
+            return;
+        }
+
+        if (__text.find(__word) != std::string_view::npos)
+        {
+            total += 1.0;
+            ++words;
+            return;
+        }
+
+        const std::size_t max = __word.size() >= 8 ? 2 : __word.size() >= 4 ? 1 : 0;
+
+        std::size_t best = max + 1;
+
+        _S_forEachWord(__text, [&](std::string_view __other) {
+            if (best != 0)
+            {
+                best = std::min(best, _S_distance(__word, __other, max));
+            }
+        });
+
+        if (best > max)
+        {
+            all = false;
+            return;
+        }
+
+        total += 1.0 - static_cast<double>(best) / static_cast<double>(__word.size());
+        ++words;
+    });
+
+    return all && words ? 0.4 * total / static_cast<double>(words) : 0.0;
+}
+
+double WindowTrigramIndex::defaultScore(const Candidate& __candidate) noexcept
+{
+    double best = std::max({
+        _S_matchText(__candidate.title, __candidate.query),
+        _S_matchText(__candidate.path, __candidate.query) * 0.8,
+        _S_matchText(__candidate.className, __candidate.query) * 0.6 });
+
+    /// The words of the query with typos, for the windows sharing enough of
+    /// its trigrams to be worth it.
+    if (best == 0.0 && __candidate.typos && __candidate.hits * 4 >= __candidate.trigrams)
+    {
+        best = std::max({
+            _S_matchWords(__candidate.title, __candidate.query),
+            _S_matchWords(__candidate.path, __candidate.query) * 0.8,
+            _S_matchWords(__candidate.className, __candidate.query) * 0.6 });
+    }
+
+    if (__candidate.trigrams == 0)
+    {
+        return best;
+    }
+
+    /// Without a match of the query or its words, at least half of the
+    /// trigrams must be there.
+    if (best == 0.0 && __candidate.hits * 2 < __candidate.trigrams)
+    {
+        return 0.0;
+    }
+
+    return best + 0.3 * __candidate.hits / __candidate.trigrams;
+}
+
+std::string WindowTrigramIndex::_S_fold(std::string_view __text)
+{
+    std::string result(__text);
+
+    for (char& c : result)
+    {
+        if (c >= 'A' && c <= 'Z')
+        {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+    }
+
+    return result;
+}
+
+void WindowTrigramIndex::_S_trigrams(std::string_view __folded, std::vector<std::uint32_t>& __trigrams)
+{
+    for (std::size_t i = 2; i < __folded.size(); ++i)
+    {
+        __trigrams.push_back(
+            std::uint32_t(static_cast<unsigned char>(__folded[i - 2])) << 16 |
+            std::uint32_t(static_cast<unsigned char>(__folded[i - 1])) << 8 |
+            std::uint32_t(static_cast<unsigned char>(__folded[i])));
+    }
+}
+
+std::uint32_t WindowTrigramIndex::_S_prefixKey(std::string_view __prefix) noexcept
+{
+    std::uint32_t key = static_cast<std::uint32_t>(__prefix.size()) << 24;
+
+    for (std::size_t i = 0; i < __prefix.size(); ++i)
+    {
+        key |= std::uint32_t(static_cast<unsigned char>(__prefix[i])) << (8 * (__prefix.size() - 1 - i));
+    }
+
+    return key;
+}
+
+void WindowTrigramIndex::_S_prefixes(std::string_view __folded, std::vector<std::uint32_t>& __keys)
+{
+    _S_forEachWord(__folded, [&](std::string_view __word) {
+        __keys.push_back(_S_prefixKey(__word.substr(0, 1)));
+
+        if (__word.size() >= 2)
+        {
+            __keys.push_back(_S_prefixKey(__word.substr(0, 2)));
+        }
+    });
+}
+
+void WindowTrigramIndex::assign(const WindowSnapshot& __snapshot)
+{
+    clear();
+
+    for (const WindowSnapshot::Entry& entry : __snapshot)
+    {
+        insert(
+            entry.handle(),
+            entry.title(),
+            entry.className(),
+            _M_pathProvider ? _M_pathProvider(entry) : std::string());
+    }
+}
+
+void WindowTrigramIndex::apply(const WindowDiff& __diff, const WindowSnapshot& __after)
+{
+    for (const WindowDiff::Entry& entry : __diff)
+    {
+        if (entry.has(WindowDiff::Destroyed))
+        {
+            erase(entry.handle);
+        }
+        else if (entry.has(WindowDiff::Created))
+        {
+            const WindowSnapshot::Entry window(__after[entry.after]);
+
+            insert(
+                entry.handle,
+                window.title(),
+                window.className(),
+                _M_pathProvider ? _M_pathProvider(window) : std::string());
+        }
+        else if (entry.has(WindowDiff::Retitled))
+        {
+            setTitle(entry.handle, __after.title(entry.after));
+        }
+    }
+}
+
+void WindowTrigramIndex::insert(
+    Win::Handle __handle,
+    std::string_view __title,
+    std::string_view __className,
+    std::string_view __path)
+{
+    std::uint32_t slot;
+
+    if (auto iter = _M_slots.find(__handle); iter != _M_slots.end())
+    {
+        slot = iter->second;
+        _M_unindex(slot);
+    }
+    else if (not _M_free.empty())
+    {
+        slot = _M_free.back();
+        _M_free.pop_back();
+
+        _M_slots.emplace(__handle, slot);
+    }
+    else
+    {
+        slot = static_cast<std::uint32_t>(_M_documents.size());
+        _M_documents.emplace_back();
+
+        _M_slots.emplace(__handle, slot);
+    }
+
+    _Document& document = _M_documents[slot];
+
+    document.handle = __handle;
+    document.title = _S_fold(__title);
+    document.className = _S_fold(__className);
+    document.path = _S_fold(__path);
+
+    _M_index(slot);
+}
+
+void WindowTrigramIndex::setTitle(Win::Handle __handle, std::string_view __title)
+{
+    auto iter = _M_slots.find(__handle);
+
+    if (iter == _M_slots.end())
+    {
+        return;
+    }
+
+    _M_unindex(iter->second);
+
+    _M_documents[iter->second].title = _S_fold(__title);
+
+    _M_index(iter->second);
+}
+
+void WindowTrigramIndex::erase(Win::Handle __handle)
+{
+    auto iter = _M_slots.find(__handle);
+
+    if (iter == _M_slots.end())
+    {
+        return;
+    }
+
+    _M_unindex(iter->second);
+
+    _M_documents[iter->second] = _Document();
+    _M_free.push_back(iter->second);
+
+    _M_slots.erase(iter);
+}
+
+void WindowTrigramIndex::clear() noexcept
+{
+    _M_documents.clear();
+    _M_free.clear();
+    _M_slots.clear();
+    _M_postings.clear();
+}
+
+void WindowTrigramIndex::_M_index(std::uint32_t __slot)
+{
+    _Document& document = _M_documents[__slot];
+
+    document.trigrams.clear();
+
+    _S_trigrams(document.title, document.trigrams);
+    _S_trigrams(document.className, document.trigrams);
+    _S_trigrams(document.path, document.trigrams);
+
+    _S_prefixes(document.title, document.trigrams);
+    _S_prefixes(document.className, document.trigrams);
+    _S_prefixes(document.path, document.trigrams);
+
+    std::sort(document.trigrams.begin(), document.trigrams.end());
+    document.trigrams.erase(std::unique(document.trigrams.begin(), document.trigrams.end()), document.trigrams.end());
+
+    document.positions.resize(document.trigrams.size());
+
+    for (std::size_t i = 0; i < document.trigrams.size(); ++i)
+    {
+        std::vector<std::uint32_t>& slots = _M_postings[document.trigrams[i]];
+
+        document.positions[i] = static_cast<std::uint32_t>(slots.size());
+        slots.push_back(__slot);
+    }
+}
+
+void WindowTrigramIndex::_M_unindex(std::uint32_t __slot)
+{
+    _Document& document = _M_documents[__slot];
+
+    for (std::size_t i = 0; i < document.trigrams.size(); ++i)
+    {
+        const std::uint32_t trigram = document.trigrams[i];
+
+        auto iter = _M_postings.find(trigram);
+        std::vector<std::uint32_t>& slots = iter->second;
+
+        const std::uint32_t position = document.positions[i];
+        const std::uint32_t moved = slots.back();
+
+        slots[position] = moved;
+        slots.pop_back();
+
+        if (moved != __slot)
+        {
+            _Document& other = _M_documents[moved];
+
+            const auto at = std::lower_bound(other.trigrams.begin(), other.trigrams.end(), trigram);
+            other.positions[static_cast<std::size_t>(at - other.trigrams.begin())] = position;
+        }
+
+        if (slots.empty())
+        {
+            _M_postings.erase(iter);
+        }
+    }
+
+    document.trigrams.clear();
+    document.positions.clear();
+}
+
+std::vector<WindowTrigramIndex::Result> WindowTrigramIndex::search(std::string_view __query, std::size_t __limit) const
+{
+    std::vector<Result> results;
+
+    const std::string query(_S_fold(__query));
+
+    if (query.empty() || __limit == 0)
+    {
+        return results;
+    }
+
+    /// The __limit best scores so far, the lowest on top.
+    std::priority_queue<double, std::vector<double>, std::greater<double>> best;
+
+    const auto score = [&](std::uint32_t __slot, std::uint32_t __hits, std::uint32_t __trigrams, bool __typos) {
+        const _Document& document = _M_documents[__slot];
+
+        const Candidate candidate{
+            document.handle, document.title, document.className, document.path, query, __hits, __trigrams, __typos };
+
+        const double value = _M_scorer ? _M_scorer(candidate) : defaultScore(candidate);
+
+        if (value > 0.0)
+        {
+            results.push_back({ document.handle, value });
+
+            if (best.size() < __limit)
+            {
+                best.push(value);
+            }
+            else if (value > best.top())
+            {
+                best.pop();
+                best.push(value);
+            }
+        }
+    };
+
+    if (query.size() < 3)
+    {
+        if (std::all_of(query.begin(), query.end(), _S_isWordByte))
+        {
+            if (auto iter = _M_postings.find(_S_prefixKey(query)); iter != _M_postings.end())
+            {
+                for (std::uint32_t slot : iter->second)
+                {
+                    score(slot, 0, 0, true);
+                }
+            }
+        }
+        else
+        {
+            /// No word starts with it.
+            for (std::uint32_t slot = 0; slot < _M_documents.size(); ++slot)
+            {
+                if (not _M_documents[slot].empty())
+                {
+                    score(slot, 0, 0, true);
+                }
+            }
+        }
+    }
+    else
+    {
+        std::vector<std::uint32_t> trigrams;
+        _S_trigrams(query, trigrams);
+
+        std::sort(trigrams.begin(), trigrams.end());
+        trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+        const std::uint32_t count = static_cast<std::uint32_t>(trigrams.size());
+
+        /// The trigrams of the query found in each document.
+        std::vector<std::uint32_t> hits(_M_documents.size(), 0);
+        std::vector<std::uint32_t> touched;
+
+        for (std::uint32_t trigram : trigrams)
+        {
+            auto iter = _M_postings.find(trigram);
+
+            if (iter == _M_postings.end())
+            {
+                continue;
+            }
+
+            for (std::uint32_t slot : iter->second)
+            {
+                if (hits[slot]++ == 0)
+                {
+                    touched.push_back(slot);
+                }
+            }
+        }
+
+        /// The documents by hits, the most first: the bucket b holds the ones
+        /// with count - b hits.
+        std::vector<std::uint32_t> buckets(count + 1, 0);
+
+        for (std::uint32_t slot : touched)
+        {
+            ++buckets[count - hits[slot] + 1];
+        }
+
+        for (std::uint32_t b = 1; b <= count; ++b)
+        {
+            buckets[b] += buckets[b - 1];
+        }
+
+        std::vector<std::uint32_t> order(touched.size());
+
+        {
+            std::vector<std::uint32_t> next(buckets.begin(), buckets.end() - 1);
+
+            for (std::uint32_t slot : touched)
+            {
+                order[next[count - hits[slot]]++] = slot;
+            }
+        }
+
+        for (std::uint32_t b = 0; b < count; ++b)
+        {
+            const std::uint32_t bucketHits = count - b;
+
+            /// Without all the trigrams, no text holds the query, and the
+            /// subsequence or the words score 0.5 at most.
+            if (not _M_scorer && bucketHits < count && best.size() == __limit
+                && best.top() >= 0.5 + 0.3 * bucketHits / count)
+            {
+                break;
+            }
+
+            /// The typos for the first candidates only, those of the bucket
+            /// crossing the cap by handle, whatever the order of the slots.
+            if (buckets[b] < _S_typoCandidates && buckets[b + 1] > _S_typoCandidates)
+            {
+                std::sort(order.begin() + buckets[b], order.begin() + buckets[b + 1], [this](std::uint32_t __lhs, std::uint32_t __rhs) {
+                    return std::less<Win::Handle>()(_M_documents[__lhs].handle, _M_documents[__rhs].handle);
+                });
+            }
+
+            for (std::uint32_t i = buckets[b]; i < buckets[b + 1]; ++i)
+            {
+                score(order[i], bucketHits, count, i < _S_typoCandidates);
+            }
+        }
+    }
+
+    const auto better = [](const Result& __lhs, const Result& __rhs) noexcept {
+        return __lhs.score > __rhs.score;
+    };
+
+    if (results.size() > __limit)
+    {
+        std::partial_sort(results.begin(), results.begin() + __limit, results.end(), better);
+        results.resize(__limit);
+    }
+    else
+    {
+        std::sort(results.begin(), results.end(), better);
+    }
+
+    return results;
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+/**
+* Copyright (c) 2024-2025 Yang Huanhuan (3347484963@qq.com).
+* 
+* This software is provided "as is", without warranty of any kind, express or implied.
+*/
+
+/**
+* AllocationCounter.h In the openWin (https://github.com/huanhuanonly/openWin)
+* 
+* Created on October 17, 2026, 05:12:40
+* 
+* --- This file is a part of openWin ---
+* 
+* @brief Replaces the global operator new and operator delete to count the
+*        allocations of a test, included by the file with its main() only.
+*/
+
+#pragma once
+
+#ifndef OPENWIN_TEST_ALLOCATIONCOUNTER_H
+#define OPENWIN_TEST_ALLOCATIONCOUNTER_H
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/// The number of calls to operator new so far.
+static std::atomic<std::size_t> allocations = 0;
+
+void* operator new(std::size_t __size)
+{
+    ++allocations;
+
+    if (void* ptr = std::malloc(__size ? __size : 1))
+    {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* __ptr) noexcept
+{
+    std::free(__ptr);
+}
+
+void operator delete(void* __ptr, std::size_t) noexcept
+{
+    std::free(__ptr);
+}
+
+#endif  // OPENWIN_TEST_ALLOCATIONCOUNTER_H
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include <openWin.h>
+
+#include <condition_variable>
+#include <mutex>
+
+using namespace win;
+
+static int failures = 0;
+
+static void check(const char* __name, bool __ok)
+{
+    std::cout << (__ok ? "[ OK ] " : "[FAIL] ") << __name << '\n';
+    failures += not __ok;
+}
+
+static Win::Handle handle(std::uintptr_t __id)
+{
+    return reinterpret_cast<Win::Handle>(__id);
+}
+
+/**
+ * @brief Windows 1 to 32, where the rect of the hung one blocks until it is
+ *        released, as a window that does not answer.
+ */
+class HangingSource : public WindowSnapshot::Source
+{
+public:
+
+    static constexpr std::uintptr_t count = 32;
+
+    explicit HangingSource(Win::Handle __hung) noexcept
+        : _M_hung(__hung)
+    { }
+
+    virtual void enumerate(std::vector<Win::Handle>& __handles) override
+    {
+        for (std::uintptr_t i = 1; i <= count; ++i)
+        {
+            __handles.push_back(handle(i));
+        }
+    }
+
+    virtual void appendTitle(Win::Handle __handle, std::string& __arena) override
+    { __arena += "Window " + std::to_string(reinterpret_cast<std::uintptr_t>(__handle)); }
+
+    virtual void appendClassName(Win::Handle, std::string& __arena) override
+    { __arena += "Hanging"; }
+
+    /// The last call of a fetch of the titles and rects.
+    [[nodiscard]] virtual Rect rect(Win::Handle __handle) override
+    {
+        if (__handle == _M_hung)
+        {
+            {
+                std::unique_lock<std::mutex> _L_lock(_M_mutex);
+                _M_releasedCondition.wait(_L_lock, [this] { return _M_released; });
+            }
+
+            _M_returned.fetch_add(1);
+        }
+
+        return Rect(0, 0, 100, static_cast<int>(reinterpret_cast<std::uintptr_t>(__handle)));
+    }
+
+    virtual void ids(Win::Handle, Win::ProcessId& __processId, Win::ThreadId& __threadId) override
+    {
+        __processId = 1;
+        __threadId = 1;
+    }
+
+    [[nodiscard]] virtual bool isVisible(Win::Handle) override
+    { return true; }
+
+    /**
+     * @brief Lets the hung window answer, and waits until the workers stuck
+     *        on it are out of the source.
+     */
+    void release(std::size_t __stuck)
+    {
+        {
+            std::lock_guard<std::mutex> _L_lock(_M_mutex);
+            _M_released = true;
+        }
+
+        _M_releasedCondition.notify_all();
+
+        while (_M_returned.load() < __stuck)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+
+    const Win::Handle _M_hung;
+
+    std::mutex _M_mutex;
+    std::condition_variable _M_releasedCondition;
+    bool _M_released = false;
+
+    std::atomic<std::size_t> _M_returned = 0;
+};
+
+int main()
+{
+    using namespace std::chrono_literals;
+
+    HangingSource source(handle(7));
+
+    std::size_t stuck = 0;
+
+    BulkFetcher::Options options;
+    options.workers = 4;
+    options.windowTimeout = 50ms;
+    options.totalTimeout = 2s;
+
+    constexpr WindowSnapshot::Fields fields = WindowSnapshot::Title | WindowSnapshot::Rect;
+
+    {
+        BulkFetcher fetcher(options, source);
+
+        auto start = BulkFetcher::Clock::now();
+        const BulkFetcher::Result result = fetcher.fetch(fields);
+        const auto elapsed = BulkFetcher::Clock::now() - start;
+
+        std::cout << "fetched " << result.snapshot.size() << " windows in "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " ms\n";
+
+        check("the fetch returns after the window timeout", elapsed >= options.windowTimeout && elapsed < options.windowTimeout + 400ms);
+        check("only the hung window times out", result.timedOutCount() == 1 && result.timedOut[6] && result.snapshot.handle(6) == handle(7));
+        check("the hung window has no fields", result.snapshot.title(6).empty() && result.snapshot.rect(6) == Rect());
+        check("the other windows are fetched", result.snapshot.size() == HangingSource::count
+              && result.snapshot.title(31) == "Window 32" && result.snapshot.rect(31) == Rect(0, 0, 100, 32));
+        check("the worker stuck on it is abandoned", fetcher.abandonedWorkers() == 1);
+
+        /// The replacement keeps the pool at full size.
+
+        std::vector<Win::Handle> others;
+
+        for (std::uintptr_t i = 8; i <= HangingSource::count; ++i)
+        {
+            others.push_back(handle(i));
+        }
+
+        start = BulkFetcher::Clock::now();
+        const BulkFetcher::Result next = fetcher.fetch(others, fields);
+
+        check("a later fetch completes", next.complete() && next.snapshot.size() == others.size() && next.snapshot.title(0) == "Window 8");
+        check("without waiting", BulkFetcher::Clock::now() - start < options.windowTimeout);
+        check("and abandons nothing", fetcher.abandonedWorkers() == 1);
+
+        /// The hung window again, while the first worker is still stuck.
+
+        const Win::Handle hung[] = { handle(7) };
+        const BulkFetcher::Result again = fetcher.fetch(hung, fields);
+
+        check("it times out again", again.timedOutCount() == 1 && fetcher.abandonedWorkers() == 2);
+
+        stuck = fetcher.abandonedWorkers();
+    }
+
+    source.release(stuck);
+
+    return failures;
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include <openWin.h>
+
+#include <thread>
+
+using namespace win;
+
+static int failures = 0;
+
+static void check(const char* __name, bool __ok)
+{
+    std::cout << (__ok ? "[ OK ] " : "[FAIL] ") << __name << '\n';
+    failures += not __ok;
+}
+
+/**
+ * @brief Keeps the records, all failures come from the main thread.
+ */
+struct CollectingSink : ErrorSink
+{
+    std::vector<ErrorRecord> records;
+
+    virtual void write(ErrorRecord&& __record) override
+    { records.push_back(std::move(__record)); }
+};
+
+static void fail(std::uint32_t __code, std::size_t __times)
+{
+    ErrorStream stream;
+    stream.begin("repeats");
+
+    for (std::size_t i = 0; i < __times; ++i)
+    {
+        stream.onFailed(__code);
+    }
+
+    stream.end();
+}
+
+int main()
+{
+    CollectingSink sink;
+    ErrorSink* const previous = ErrorSink::setCurrent(&sink);
+
+    check("nothing is collapsed by default", ErrorStream::repeatWindow().count() == 0);
+
+    fail(5, 100);
+    check("every failure is sent", sink.records.size() == 100);
+
+    /// Collapsed.
+
+    sink.records.clear();
+    ErrorStream::setRepeatWindow(std::chrono::seconds(10));
+
+    fail(5, 10000);
+    fail(6, 3);
+
+    check("the first failures are sent at once",
+          sink.records.size() == 2 && sink.records[0].code == 5 && sink.records[1].code == 6);
+
+    ErrorStream::flushRepeats();
+
+    std::uint64_t repeats5 = 0, repeats6 = 0;
+
+    for (const ErrorRecord& record : sink.records)
+    {
+        if (record.code == 5)
+        {
+            repeats5 += record.count;
+        }
+        else if (record.code == 6)
+        {
+            repeats6 += record.count;
+        }
+    }
+
+    check("the repeats are counted into one record each",
+          sink.records.size() == 4 && repeats5 == 1 + 9999 && repeats6 == 1 + 2);
+
+    /// A failure after the window sends the repeats of the window before.
+
+    sink.records.clear();
+    ErrorStream::setRepeatWindow(std::chrono::milliseconds(20));
+
+    fail(7, 3);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    fail(7, 1);
+
+    check("a failure after the window sends the repeats",
+          sink.records.size() == 3 && sink.records[1].count == 2 && sink.records[2].count == 1);
+
+    ErrorStream::flushRepeats();
+    ErrorStream::setRepeatWindow(std::chrono::milliseconds(0));
+
+    /// The rate limit.
+
+    sink.records.clear();
+    ErrorStream::setRateLimit(50.0, 3);
+
+    const std::uint64_t limited = ErrorStream::rateLimited();
+
+    fail(8, 10);
+
+    check("the burst is let through", sink.records.size() == 3);
+    check("the others are discarded", ErrorStream::rateLimited() - limited == 7);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    fail(9, 1);
+
+    check("the next record counts the discarded ones",
+          sink.records.size() == 4 && sink.records.back().code == 9 && sink.records.back().limited == 7);
+
+    ErrorStream::setRateLimit(0);
+
+    ErrorSink::setCurrent(previous);
+    return failures;
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include <openWin.h>
+
+#include <cassert>
+#include <chrono>
+
+#include "AllocationCounter.h"
+
+using namespace win;
+
+/**
+ * @return The allocations of the calls, after a first call that may set up
+ *         the thread.
+ */
+template<typename _Func>
+std::size_t measure(const char* __name, std::size_t __calls, _Func __func)
+{
+    __func();
+
+    std::size_t before = allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < __calls; ++i)
+    {
+        __func();
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << __name << ": "
+        << static_cast<double>(allocations - before) / __calls << " allocations/call, "
+        << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / __calls << " ns/call\n";
+
+    return allocations - before;
+}
+
+int main()
+{
+    constexpr std::size_t calls = 1'000'000;
+
+#if defined(OPENWIN_SIMULATED_BACKEND)
+    sim::WindowServer server;
+    sim::WindowServer::setCurrent(&server);
+
+    server.setForeground(server.create());
+#endif
+
+    /// The calls must succeed, or the failure path is measured instead.
+    Win win = Win::currentForegroundWindow();
+
+    std::size_t guarded = 0;
+
+    measure("Win::isEmpty()   (unguarded)", calls, [&] { void(win.isEmpty()); });
+
+    guarded += measure("Win::isValid()   (one guard)", calls, [&] { void(win.isValid()); });
+    guarded += measure("Win::isVisible() (one guard)", calls, [&] { void(win.isVisible()); });
+    guarded += measure("Win::isParent()  (nested)   ", calls, [&] { void(win.isParent()); });
+
+    if (win.failed())
+    {
+        std::cout << "The calls failed, the numbers above are for the failure path.\n";
+        return 1;
+    }
+
+    /// The guards of the calls that succeed must not allocate.
+    assert(guarded == 0);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include <openWin.h>
+
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+using namespace win;
+
+static int failures = 0;
+
+static void check(const char* __name, bool __ok)
+{
+    std::cout << (__ok ? "[ OK ] " : "[FAIL] ") << __name << '\n';
+    failures += not __ok;
+}
+
+/**
+ * @brief Formats "<prefix> <code>", no text for the code 0, and counts the
+ *        calls for each code.
+ */
+struct CountingFormatter
+{
+    std::string prefix = "error";
+
+    std::mutex mutex;
+    std::map<std::uint32_t, int> calls;
+
+    ErrorTextCache::Formatter formatter()
+    {
+        return [this, prefix = prefix](std::uint32_t __code, std::uint32_t) {
+            {
+                std::lock_guard<std::mutex> _L_lock(mutex);
+                ++calls[__code];
+            }
+
+            return __code ? prefix + ' ' + std::to_string(__code) : std::string();
+        };
+    }
+
+    int total()
+    {
+        std::lock_guard<std::mutex> _L_lock(mutex);
+
+        int result = 0;
+
+        for (const auto& [code, count] : calls)
+        {
+            result += count;
+        }
+
+        return result;
+    }
+};
+
+template<typename _Func>
+static double measure(std::size_t __calls, _Func __func)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < __calls; ++i)
+    {
+        __func(i);
+    }
+
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(__calls);
+}
+
+int main()
+{
+    CountingFormatter counter;
+    ErrorTextCache cache(counter.formatter(), 4);
+
+    /// One format per code.
+
+    for (int i = 0; i < 100; ++i)
+    {
+        void(cache.text(5));
+        void(cache.text(1400));
+    }
+
+    check("the text of the code", std::strcmp(cache.text(5), "error 5") == 0);
+    check("one format per code", counter.calls[5] == 1 && counter.calls[1400] == 1);
+    check("the hits and misses", cache.hits() == 199 && cache.misses() == 2);
+
+    void(cache.text(0));
+    void(cache.text(0));
+
+    check("a code without text is cached too", cache.text(0) == nullptr && counter.calls[0] == 1);
+
+    /// The capacity.
+
+    void(cache.text(6));
+    check("the cache is full", cache.size() == 4 && cache.capacity() == 4);
+
+    void(cache.text(7));
+    void(cache.text(7));
+
+    check("a full cache does not keep new codes", cache.size() == 4 && counter.calls[7] == 2);
+    check("a full cache keeps its texts", std::strcmp(cache.text(7), "error 7") == 0 && std::strcmp(cache.text(5), "error 5") == 0 && counter.calls[5] == 1);
+
+    /// Invalidation.
+
+    cache.clear();
+
+    check("clear() empties the cache", cache.size() == 0);
+
+    cache.preload({ 5, 6, 1400 });
+
+    check("preload() formats each code once", counter.calls[5] == 2 && counter.calls[6] == 2 && counter.calls[1400] == 2);
+
+    void(cache.text(5));
+    void(cache.text(6));
+
+    check("the preloaded codes are hits", counter.calls[5] == 2 && counter.calls[6] == 2);
+
+    CountingFormatter other;
+    other.prefix = "failure";
+
+    cache.setFormatter(other.formatter());
+
+    check("setFormatter() clears the cache", cache.size() == 0);
+    check("setFormatter() formats again", std::strcmp(cache.text(5), "failure 5") == 0 && other.calls[5] == 1 && counter.calls[5] == 2);
+
+    /// The cost of a hit and of a miss.
+
+    constexpr std::size_t calls = 1'000'000;
+
+    CountingFormatter bench;
+    ErrorTextCache large(bench.formatter());
+
+    large.preload({ 2, 5, 6, 87, 1400 });
+
+    static constexpr std::uint32_t codes[] = { 2, 5, 6, 87, 1400 };
+
+    const double hit = measure(calls, [&](std::size_t __i) { void(large.text(codes[__i % 5])); });
+
+    /// Beyond the capacity, every lookup formats.
+    ErrorTextCache empty(bench.formatter(), 0);
+
+    const double miss = measure(calls / 10, [&](std::size_t __i) { void(empty.text(codes[__i % 5])); });
+
+    std::cout << "hit: " << hit << " ns, miss: " << miss << " ns\n";
+
+    check("the benchmark formatted only the misses", bench.total() == 5 + static_cast<int>(calls / 10));
+    check("a hit is cheaper than a miss", hit < miss);
+
+    return failures;
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include <openWin.h>
+
+#include <cassert>
+#include <thread>
+
+using namespace win;
+
+/**
+ * @brief Plays a linear animation of 60 steps of 16 ms on a simulated clock,
+ *        where every step takes 3 ms and every sleep overshoots by 2 ms.
+ */
+static void simulate(const char* __name, bool __deadlines)
+{
+    using namespace std::chrono_literals;
+
+    FramePacer::SimulatedTimeSource clock(2ms);
+
+    pg::Linear<int> linear(1.0F, 16);
+    linear.setTimeSource(clock);
+
+    const FramePacer::Clock::time_point start = clock.now();
+
+    int last = 0;
+
+    if (__deadlines)
+    {
+        for (auto iter = linear.build(0, 60); iter->remains(); iter->advance())
+        {
+            last = iter->current();
+            clock.advance(3ms);
+        }
+    }
+    else
+    {
+        /// What advance() did before: step, then sleep a whole period.
+        for (auto iter = linear.build(0, 60); iter->remains(); iter->step())
+        {
+            last = iter->current();
+            clock.advance(3ms);
+            clock.sleepUntil(clock.now() + 16ms);
+        }
+    }
+
+    std::cout << __name << ": " << std::chrono::duration_cast<std::chrono::milliseconds>(clock.now() - start).count()
+              << " ms for 960 ms, ended at " << last << '\n';
+}
+
+int main()
+{
+    simulate("sleep a period after each step", false);
+    simulate("sleep until the deadlines     ", true);
+
+    /// The real clock.
+
+    pg::Linear<int> linear(1.0F, 16);
+
+    auto iter = linear.build(0, 60);
+
+    for (; iter->remains(); iter->advance())
+    { }
+
+    const FramePacer::Stats& stats = iter->pacer()->stats();
+
+    std::cout << "frames = " << stats.frames << ", skipped = " << stats.skipped
+              << ", mean lateness = " << std::chrono::duration<double, std::micro>(stats.meanLateness()).count() << " us"
+              << ", max lateness = " << std::chrono::duration<double, std::micro>(stats.maxLateness).count() << " us"
+              << ", jitter = " << stats.jitter() << " us\n";
+
+#if defined(OPENWIN_SIMULATED_BACKEND)
+    /// The timer of a thread is created in its first animation, which must
+    /// not fail because of it.
+
+    sim::WindowServer server;
+    sim::WindowServer::setCurrent(&server);
+
+    Win win(server.create());
+
+    std::thread([&] {
+        win.animateTo(Rect(100, 100, 800, 600), 200, pg::Linear<Win::AnimationValue>(8.0F, 16));
+        assert(not win.failed());
+    }).join();
+
+    assert(win.rect() == Rect(100, 100, 800, 600));
+
+    sim::WindowServer::setCurrent(nullptr);
+#endif
+
+    return 0;
+}
\ No newline at end of file
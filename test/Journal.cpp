@@ -0,0 +1,106 @@
+#include <openWin.h>
+
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+
+using namespace win;
+
+/**
+ * @brief Sends the messages of its own, as the subclasses of Win may.
+ */
+struct Messenger : Win
+{
+    using Win::Win;
+
+    using Win::_M_sendMessageW;
+};
+
+int main()
+{
+    if constexpr (not Journal::available())
+    {
+        std::cout << "Build with OPENWIN_JOURNALING to record journals.\n";
+        return 0;
+    }
+
+    sim::WindowServer server;
+    sim::WindowServer::setCurrent(&server);
+
+    sim::WindowServer::Window initial;
+    initial.title = L"Untitled - Notepad";
+    initial.rect = Rect(0, 0, 800, 600);
+
+    Win recorded(server.create(initial));
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "openWin-test.journal";
+
+    Journal::start(path.string());
+
+    recorded.setRect(Rect(100, 100, 640, 480));
+    recorded.setTitle("notes.txt - Notepad");
+    recorded.setPos(Point(400, 300), pg::Linear<Point>(50.0F));
+    recorded.setOpacity(200);
+    recorded.becomeTool();
+    recorded.post('a');
+
+    /// WM_SETTEXT, not replayed as the text is gone by then.
+    Messenger(recorded.handle())._M_sendMessageW(0x000C, 0, reinterpret_cast<std::intptr_t>(L"Sent"), Win::InfiniteTimeout);
+    assert(recorded.title_w() == L"Sent");
+
+    recorded.setTitle(L"笔记.txt - Notepad");
+    recorded.send('b');
+
+    Journal::stop();
+
+    std::ifstream file(path, std::ios::binary);
+    const std::vector<Journal::Record> records(Journal::read(file));
+
+    file.close();
+    std::filesystem::remove(path);
+
+    for (const Journal::Record& record : records)
+    {
+        std::cout << std::chrono::duration_cast<std::chrono::microseconds>(record.time).count() << " us\t"
+                  << Journal::name(record.op) << '(';
+
+        for (std::size_t i = 0; i < record.count; ++i)
+        {
+            std::cout << (i ? ", " : "") << record.args[i];
+        }
+
+        std::cout << record.text << ")\n";
+    }
+
+    /// Replays on a window created again, which gets another handle.
+
+    const auto sent = std::find_if(records.begin(), records.end(), [](const Journal::Record& __record) {
+        return __record.op == Journal::Op::SendMessageW;
+    });
+
+    assert(sent != records.end() && sent->arg(2) == 0 && sent->arg(4) == 1);
+
+    Win replayed(server.create(initial));
+
+    JournalReplayer::apply(*sent, replayed);
+    assert(replayed.title_w() == L"Untitled - Notepad");
+
+    JournalReplayer replayer(records);
+    replayer.setResolver([&](Win::Handle) { return replayed; });
+
+    FramePacer::SimulatedTimeSource clock;
+    const auto took = replayer.replay(JournalReplayer::OriginalSpeed, clock);
+
+    std::cout << "replayed in " << std::chrono::duration_cast<std::chrono::microseconds>(took).count() << " us\n";
+
+    assert(took == std::chrono::duration_cast<FramePacer::Clock::duration>(records.back().time - records.front().time));
+
+    assert(replayed.rect() == recorded.rect());
+    assert(replayed.title_w() == recorded.title_w());
+    assert(replayed.opacity() == recorded.opacity());
+    assert(replayed.isTool() == recorded.isTool());
+
+    sim::WindowServer::setCurrent(nullptr);
+    return 0;
+}
\ No newline at end of file
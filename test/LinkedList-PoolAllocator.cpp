@@ -0,0 +1,52 @@
+#include <openWin.h>
+
+#include <chrono>
+
+#include "AllocationCounter.h"
+
+using namespace win;
+
+template<typename _List>
+void workpath(const char* __name, std::size_t __rounds)
+{
+    _List list;
+
+    std::size_t before = allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < __rounds; ++i)
+    {
+        list.append(__name);
+        list.append(__name);
+        list.removeLast();
+        list.removeLast();
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << __name << ": "
+        << static_cast<double>(allocations - before) / __rounds << " allocations/round, "
+        << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / __rounds << " ns/round\n";
+}
+
+int main()
+{
+    constexpr std::size_t rounds = 1'000'000;
+
+    workpath<ds::LinkedList<const char*>>("std::allocator", rounds);
+    workpath<ds::LinkedList<const char*, ds::PoolAllocator<const char*>>>("ds::PoolAllocator", rounds);
+
+    Win win = Win::currentForegroundWindow();
+
+    std::size_t before = allocations;
+
+    for (std::size_t i = 0; i < rounds; ++i)
+    {
+        void(win.isValid());
+    }
+
+    std::cout << "Win::isValid(): "
+        << static_cast<double>(allocations - before) / rounds << " allocations/call\n";
+
+    return 0;
+}
\ No newline at end of file
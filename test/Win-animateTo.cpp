@@ -0,0 +1,75 @@
+#include <openWin.h>
+
+#include <cassert>
+
+using namespace win;
+
+/**
+ * @return The frames of the animation that change the rect and the opacity.
+ */
+static std::pair<std::size_t, std::size_t> changes(const pg::BasicPathGenerator<Win::AnimationValue>& __pg, const Win::AnimationValue& __from, const Win::AnimationValue& __to)
+{
+    std::pair<std::size_t, std::size_t> result;
+
+    Win::AnimationValue shown(__from);
+
+    for (auto iter = __pg.build(__from, __to); iter->remains(); iter->step())
+    {
+        const Win::AnimationValue cur(iter->current());
+
+        result.first += not std::equal(cur.begin(), cur.begin() + 4, shown.begin());
+        result.second += cur[4] != shown[4];
+
+        shown = cur;
+    }
+
+    return result;
+}
+
+int main()
+{
+    sim::WindowServer server;
+    sim::WindowServer::setCurrent(&server);
+
+    sim::WindowServer::Window initial;
+    initial.rect = Rect(0, 0, 640, 480);
+
+    Win win(server.create(std::move(initial)));
+
+    FramePacer::SimulatedTimeSource clock;
+
+    pg::Linear<Win::AnimationValue> linear(8.0F, 16);
+    linear.setTimeSource(clock);
+
+    const auto [moves, fades] = changes(linear, { 0, 0, 640, 480, 0xff }, { 100, 100, 800, 600, 160 });
+
+    server.resetCalls();
+
+    win.animateTo(Rect(100, 100, 800, 600), 160, linear);
+
+    std::cout << win << '\n';
+    std::cout << "SetWindowPos: " << server.calls("SetWindowPos") << " for " << moves << " frames\n";
+    std::cout << "SetLayeredWindowAttributes: " << server.calls("SetLayeredWindowAttributes") << " for " << fades << " frames\n";
+
+    assert(not win.failed());
+    assert(win.rect() == Rect(100, 100, 800, 600));
+    assert(win.opacity() == 160);
+
+    /// At most one call per frame that changes something.
+    assert(server.calls("SetWindowPos") > 0 && server.calls("SetWindowPos") <= moves);
+    assert(server.calls("SetLayeredWindowAttributes") > 0 && server.calls("SetLayeredWindowAttributes") <= fades);
+
+    /// Nothing to change, nothing is set.
+
+    server.resetCalls();
+
+    win.animateTo(Rect(100, 100, 800, 600), 160, linear);
+
+    assert(not win.failed());
+    assert(server.calls("SetWindowPos") == 0);
+    assert(server.calls("SetLayeredWindowAttributes") == 0);
+    assert(server.calls("SetWindowLongA") == 0);
+
+    sim::WindowServer::setCurrent(nullptr);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include <openWin.h>
+
+using namespace win;
+
+static int failures = 0;
+
+static void check(const char* __name, bool __ok)
+{
+    std::cout << (__ok ? "[ OK ] " : "[FAIL] ") << __name << '\n';
+    failures += not __ok;
+}
+
+int main()
+{
+#if defined(OPENWIN_SIMULATED_BACKEND)
+    sim::WindowServer server;
+    sim::WindowServer::setCurrent(&server);
+
+    Win win(server.create());
+
+    server.destroy(win.handle());
+    void(win.rect());
+
+    check("a failed call attaches a stream", win.hasErrorStream() && win.failed());
+
+    /// A new window that happens to get the handle.
+    win = server.create();
+    void(win.rect());
+
+    check("a call that succeeds releases it", not win.hasErrorStream() && win.success());
+
+    void(win.errorStream());
+    void(win.rect());
+
+    check("a stream requested is kept", win.hasErrorStream() && win.success());
+
+    win.detachErrorStream();
+
+    /// Polling windows closed long ago.
+
+    for (std::uintptr_t i = 1; i <= 10000; ++i)
+    {
+        Win closed(reinterpret_cast<Win::Handle>(0x7000000 + i));
+        void(closed.rect());
+    }
+
+    std::size_t attached = 0;
+
+    for (std::uintptr_t i = 1; i <= 10000; ++i)
+    {
+        attached += Win(reinterpret_cast<Win::Handle>(0x7000000 + i)).hasErrorStream();
+    }
+
+    std::cout << attached << " streams attached of 10000 failed windows\n";
+
+    check("the streams attached by failures are bounded", attached <= 256);
+    check("the last failure is kept", Win(reinterpret_cast<Win::Handle>(0x7000000 + 10000)).failed());
+
+    const Win unknown(reinterpret_cast<Win::Handle>(0x7FFFFFF));
+    check("errorStream() const attaches nothing", unknown.errorStream().success() && not unknown.hasErrorStream());
+
+    sim::WindowServer::setCurrent(nullptr);
+#endif
+
+    return failures;
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include <openWin.h>
+
+#include <cassert>
+#include <coroutine>
+#include <mutex>
+
+using namespace win;
+
+struct Task
+{
+    struct promise_type
+    {
+        Task get_return_object() { return {}; }
+
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+
+        void return_void() { }
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+/// The continuations run on the frame thread.
+static std::mutex mutex;
+static std::vector<std::string> events;
+
+static void record(std::string __event)
+{
+    std::lock_guard<std::mutex> _L_lock(mutex);
+    events.push_back(std::move(__event));
+}
+
+Task shake(Win __win, std::promise<bool>& __done)
+{
+    const Point from = __win.pos();
+
+    bool finished = true;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        finished = co_await __win.setPosAsync(Point(from.x() + 40, from.y()), pg::Linear<Point>(4.0F, 16)) && finished;
+        finished = co_await __win.setPosAsync(from, pg::Linear<Point>(4.0F, 16)) && finished;
+    }
+
+    finished = co_await __win.setZoomAsync(40, pg::Linear<Size>(4.0F, 16)) && finished;
+    finished = co_await __win.setZoomAsync(-40, pg::Linear<Size>(4.0F, 16)) && finished;
+
+    finished = co_await __win.setOpacityAsync(0xff, pg::Linear<int>(4.0F, 16)) && finished;
+
+    __done.set_value(finished);
+}
+
+int main()
+{
+    sim::WindowServer server;
+    sim::WindowServer::setCurrent(&server);
+
+    sim::WindowServer::Window initial;
+    initial.rect = Rect(100, 100, 640, 480);
+
+    Win win(server.create(std::move(initial)));
+
+    /// Completion values.
+
+    std::promise<bool> done;
+    shake(win, done);
+
+    assert(done.get_future().get());
+    assert(win.rect() == Rect(100, 100, 640, 480));
+    assert(win.opacity() == 0xff);
+
+    /// A second animation on the channel cancels the first one, whose
+    /// continuations run first, in the order they were added.
+
+    Animation fade = win.setOpacityAsync(0x40, pg::Linear<int>(1.0F, 16));
+
+    fade.then([](bool __finished) { record(__finished ? "fade finished" : "fade cancelled"); });
+    fade.then([](bool) { record("fade second"); });
+
+    Animation restore = win.setOpacityAsync(0xff, pg::Linear<int>(8.0F, 16));
+
+    restore.then([](bool __finished) { record(__finished ? "restore finished" : "restore cancelled"); });
+
+    std::future<bool> restored = restore.future();
+
+    assert(fade.cancelled());
+    assert(not fade.future().get());
+    assert(restored.get());
+
+    /// A continuation added once it is done runs at once.
+    restore.then([](bool __finished) { record(__finished ? "late finished" : "late cancelled"); });
+
+    for (const std::string& event : events)
+    {
+        std::cout << event << '\n';
+    }
+
+    assert((events == std::vector<std::string>{ "fade cancelled", "fade second", "restore finished", "late finished" }));
+    assert(win.opacity() == 0xff);
+
+    /// The position and the opacity are separate channels.
+
+    Animation move = win.setPosAsync(Point(0, 0), pg::Linear<Point>(8.0F, 16));
+    Animation fadeOut = win.setOpacityAsync(0x80, pg::Linear<int>(8.0F, 16));
+
+    assert(move.future().get() && fadeOut.future().get());
+    assert(win.pos() == Point(0, 0) && win.opacity() == 0x80);
+
+    sim::WindowServer::setCurrent(nullptr);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include <openWin.h>
+
+#include <future>
+
+using namespace win;
+
+static int failures = 0;
+
+static void check(const char* __name, bool __ok)
+{
+    std::cout << (__ok ? "[ OK ] " : "[FAIL] ") << __name << '\n';
+    failures += not __ok;
+}
+
+static Win::Handle window(std::uintptr_t __id)
+{
+    return reinterpret_cast<Win::Handle>(__id);
+}
+
+/**
+ * @brief Delivers the events in one batch, by emitting them while the
+ *        dispatcher is held in the callback of a first event.
+ */
+static std::vector<WinEvent> batch(std::initializer_list<std::pair<WinEvent::Kind, Win::Handle>> __events, bool __coalesce = true)
+{
+    std::vector<std::vector<WinEvent>> batches;
+
+    std::promise<void> entered, release;
+    std::shared_future<void> released(release.get_future().share());
+
+    auto source = std::make_unique<WinEventStream::SyntheticSource>();
+    WinEventStream::SyntheticSource& synthetic = *source;
+
+    WinEventStream::Options options;
+    options.batchInterval = {};
+    options.coalesce = __coalesce;
+
+    WinEventStream stream(
+        [&](std::span<const WinEvent> __batch) {
+            batches.emplace_back(__batch.begin(), __batch.end());
+
+            if (batches.size() == 1)
+            {
+                entered.set_value();
+                released.wait();
+            }
+        },
+        options,
+        std::move(source));
+
+    stream.start();
+
+    synthetic.emit(WinEvent::Created, window(0xFFFF));
+    entered.get_future().wait();
+
+    for (const auto& [kind, handle] : __events)
+    {
+        synthetic.emit(kind, handle);
+    }
+
+    release.set_value();
+    stream.stop();
+
+    return batches.size() == 2 ? batches.back() : std::vector<WinEvent>();
+}
+
+static bool equal(const std::vector<WinEvent>& __batch, std::initializer_list<std::tuple<WinEvent::Kind, Win::Handle, std::uint32_t>> __expected)
+{
+    return std::equal(__batch.begin(), __batch.end(), __expected.begin(), __expected.end(), [](const WinEvent& __event, const auto& __expected) {
+        return __event.kind == std::get<0>(__expected) && __event.handle == std::get<1>(__expected) && __event.count == std::get<2>(__expected);
+    });
+}
+
+int main()
+{
+    const Win::Handle a = window(0xA), b = window(0xB);
+
+    check("the foreground window is the last one",
+          equal(batch({ { WinEvent::Foreground, a }, { WinEvent::Foreground, b }, { WinEvent::Foreground, a } }),
+                { { WinEvent::Foreground, b, 1 }, { WinEvent::Foreground, a, 2 } }));
+
+    check("moves are merged at the place of the last",
+          equal(batch({ { WinEvent::Moved, a }, { WinEvent::Moved, b }, { WinEvent::Moved, a }, { WinEvent::TitleChanged, b }, { WinEvent::Moved, a } }),
+                { { WinEvent::Moved, b, 1 }, { WinEvent::TitleChanged, b, 1 }, { WinEvent::Moved, a, 3 } }));
+
+    check("a handle is not merged across its destruction",
+          equal(batch({ { WinEvent::Moved, a }, { WinEvent::Destroyed, a }, { WinEvent::Created, a }, { WinEvent::Moved, a } }),
+                { { WinEvent::Moved, a, 1 }, { WinEvent::Destroyed, a, 1 }, { WinEvent::Created, a, 1 }, { WinEvent::Moved, a, 1 } }));
+
+    check("nothing is merged without coalescing",
+          equal(batch({ { WinEvent::Moved, a }, { WinEvent::Moved, a } }, false),
+                { { WinEvent::Moved, a, 1 }, { WinEvent::Moved, a, 1 } }));
+
+    /// stop() returns after the emit() calls of other threads.
+
+    std::atomic<std::uint64_t> delivered = 0;
+
+    auto source = std::make_unique<WinEventStream::SyntheticSource>();
+    WinEventStream::SyntheticSource& synthetic = *source;
+
+    WinEventStream::Options options;
+    options.coalesce = false;
+
+    auto stream = std::make_unique<WinEventStream>(
+        [&](std::span<const WinEvent> __batch) {
+            for (const WinEvent& event : __batch)
+            {
+                delivered += event.count;
+            }
+        },
+        options,
+        std::move(source));
+
+    stream->start();
+
+    std::atomic<bool> emitting = true;
+    std::vector<std::thread> threads;
+
+    for (std::uintptr_t i = 1; i <= 4; ++i)
+    {
+        threads.emplace_back([&, i] {
+            while (emitting.load(std::memory_order_relaxed))
+            {
+                synthetic.emit(WinEvent::Moved, window(i));
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    stream->stop();
+
+    const std::uint64_t received = stream->received();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    check("no event is received after stop()", stream->received() == received);
+    check("the events received are delivered or dropped", delivered + stream->dropped() == received);
+
+    emitting = false;
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    return failures;
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include <openWin.h>
+
+using namespace win;
+
+/**
+ * @brief Counts the calls and serves properties that change on demand, with a
+ *        clock moved by hand.
+ */
+class FakeBackend : public WinPropertyCache::Backend
+{
+public:
+
+    virtual std::optional<Win::String> title(Win::Handle) override
+    { ++calls; during(); return titleValue; }
+
+    virtual std::optional<Win::String> className(Win::Handle) override
+    { ++calls; during(); return failing ? std::nullopt : std::optional<Win::String>("FakeClass"); }
+
+    virtual std::optional<Win::String> path(Win::Handle) override
+    { ++calls; return "C:\\fake.exe"; }
+
+    virtual std::optional<float> dpi(Win::Handle) override
+    { ++calls; return 1.0F; }
+
+    virtual std::optional<Rect> rect(Win::Handle) override
+    { ++calls; return rectValue; }
+
+    virtual WinPropertyCache::Clock::time_point now() override
+    { return time; }
+
+    int calls = 0;
+
+    /// Called in the middle of a fetch of the title or the class name.
+    std::function<void()> during = [] { };
+
+    /// The class name cannot be read.
+    bool failing = false;
+
+    Win::String titleValue = "first";
+    Rect rectValue{};
+
+    WinPropertyCache::Clock::time_point time{};
+};
+
+static int failures = 0;
+
+static void check(const char* __name, bool __ok)
+{
+    std::cout << (__ok ? "[ OK ] " : "[FAIL] ") << __name << '\n';
+    failures += not __ok;
+}
+
+int main()
+{
+    using namespace std::chrono_literals;
+
+    FakeBackend backend;
+
+    WinPropertyCache::Options options;
+    options.ttl = 100ms;
+
+    WinPropertyCache cache(options, backend);
+
+    Win::Handle handle = reinterpret_cast<Win::Handle>(0x1234);
+
+    void(cache.title(handle));
+    void(cache.className(handle));
+    void(cache.title(handle));
+    void(cache.className(handle));
+
+    check("cached values are served without the backend", backend.calls == 2);
+
+    backend.time += 150ms;
+    backend.titleValue = "second";
+
+    check("mutable properties expire", cache.title(handle) == "second");
+    check("immutable properties never expire", (void(cache.className(handle)), backend.calls == 3));
+
+    backend.titleValue = "third";
+
+    const WinEvent events[] = { { WinEvent::TitleChanged, handle, {}, 1 } };
+    cache.apply(events);
+
+    check("an event invalidates the property", cache.title(handle) == "third");
+
+    cache.apply(std::initializer_list<WinEvent>{ { WinEvent::Destroyed, handle, {}, 1 } });
+
+    check("a destroyed window is forgotten", cache.size() == 0);
+
+    WinPropertyCache::Stats stats = cache.stats();
+
+    std::cout << "hits = " << stats.hits << ", misses = " << stats.misses
+              << ", expirations = " << stats.expirations << ", invalidations = " << stats.invalidations << '\n';
+
+    check("statistics", stats.hits == 3 && stats.misses == 4 && stats.expirations == 1 && stats.invalidations == 3);
+
+    /// Failures are never cached, even for the immutable properties.
+
+    const Win::Handle dying = reinterpret_cast<Win::Handle>(0x5678);
+
+    backend.failing = true;
+    backend.calls = 0;
+
+    check("a failure reads as empty", cache.className(dying).empty());
+
+    backend.failing = false;
+
+    check("a failure is not cached", cache.className(dying) == "FakeClass" && backend.calls == 2);
+
+    /// The invalidations during a fetch.
+
+    const Win::Handle other = reinterpret_cast<Win::Handle>(0x9ABC);
+
+    cache.forget(handle);
+    backend.during = [&] { cache.invalidate(other); };
+
+    void(cache.title(handle));
+    backend.calls = 0;
+    void(cache.title(handle));
+
+    check("another window invalidated meanwhile keeps the value", backend.calls == 0);
+
+    cache.forget(handle);
+    backend.during = [&] { cache.invalidate(handle); };
+
+    void(cache.title(handle));
+    backend.during = [] { };
+    backend.calls = 0;
+    void(cache.title(handle));
+
+    check("the window invalidated meanwhile drops the value", backend.calls == 1);
+
+    /// The real thing: the properties of the foreground window, twice.
+
+    WinPropertyCache system;
+    Win foreground = Win::currentForegroundWindow();
+
+    for (int i = 0; i < 2; ++i)
+    {
+        std::cout << system.title(foreground.handle()) << " | " << system.className(foreground.handle()) << '\n';
+    }
+
+    std::cout << "hit rate = " << system.stats().hitRate() << '\n';
+
+    return failures;
+}
\ No newline at end of file
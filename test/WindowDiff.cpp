@@ -0,0 +1,86 @@
+#include <openWin.h>
+
+using namespace win;
+
+static int failures = 0;
+
+static void check(const char* __name, bool __ok)
+{
+    std::cout << (__ok ? "[ OK ] " : "[FAIL] ") << __name << '\n';
+    failures += not __ok;
+}
+
+static Win::Handle handle(std::uintptr_t __id)
+{
+    return reinterpret_cast<Win::Handle>(__id);
+}
+
+static WindowSnapshot::Record window(std::uintptr_t __id, std::string __title, Rect __rect)
+{
+    WindowSnapshot::Record record;
+    record.handle = handle(__id);
+    record.title = std::move(__title);
+    record.rect = __rect;
+
+    return record;
+}
+
+static const WindowDiff::Entry* find(const WindowDiff& __diff, std::uintptr_t __id)
+{
+    for (const WindowDiff::Entry& entry : __diff)
+    {
+        if (entry.handle == handle(__id))
+        {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+int main()
+{
+    WindowSnapshot before(WindowSnapshot::Title | WindowSnapshot::Rect);
+    before.append(window(1, "Untitled - Notepad", Rect(0, 0, 800, 600)));
+    before.append(window(2, "Calculator", Rect(10, 10, 330, 500)));
+    before.append(window(3, "Terminal", Rect(50, 50, 850, 650)));
+    before.append(window(4, "Settings", Rect(0, 0, 1024, 768)));
+
+    check("no change between the same windows", WindowDiff::between(before, before).empty());
+
+    /// 1 is retitled, 5 is created, 3 is moved and raised above 2, 4 is destroyed.
+
+    WindowSnapshot after(WindowSnapshot::Title | WindowSnapshot::Rect);
+    after.append(window(1, "notes.txt - Notepad", Rect(0, 0, 800, 600)));
+    after.append(window(5, "Paint", Rect(100, 100, 900, 700)));
+    after.append(window(3, "Terminal", Rect(60, 60, 860, 660)));
+    after.append(window(2, "Calculator", Rect(10, 10, 330, 500)));
+
+    const WindowDiff diff(WindowDiff::between(before, after));
+
+    const WindowDiff::Entry* retitled = find(diff, 1);
+    const WindowDiff::Entry* created = find(diff, 5);
+    const WindowDiff::Entry* moved = find(diff, 3);
+    const WindowDiff::Entry* destroyed = find(diff, 4);
+
+    check("the retitled window", retitled && retitled->changes == WindowDiff::Retitled && retitled->before == 0 && retitled->after == 0);
+    check("the created window", created && created->changes == WindowDiff::Created && created->before == WindowDiff::npos && created->after == 1);
+    check("the moved window", moved && moved->has(WindowDiff::Moved) && not moved->has(WindowDiff::Retitled) && moved->before == 2 && moved->after == 2);
+    check("the destroyed window", destroyed && destroyed->changes == WindowDiff::Destroyed && destroyed->before == 3 && destroyed->after == WindowDiff::npos);
+    check("one window changed in the z-order", diff.count(WindowDiff::ZOrderChanged) == 1);
+
+    check("the windows are in the order of after, then the destroyed ones",
+          diff.size() >= 4 && diff.entries().front().handle == handle(1) && diff.entries().back().handle == handle(4));
+
+    /// Without titles in both snapshots, a new title is not a change.
+
+    WindowSnapshot rects(WindowSnapshot::Rect);
+    rects.append(window(1, "", Rect(0, 0, 800, 600)));
+    rects.append(window(2, "", Rect(10, 10, 330, 500)));
+    rects.append(window(3, "", Rect(50, 50, 850, 650)));
+    rects.append(window(4, "", Rect(0, 0, 1024, 768)));
+
+    check("no retitle without titles", WindowDiff::between(rects, before).empty());
+
+    return failures;
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include <openWin.h>
+
+#include <cassert>
+#include <chrono>
+#include <random>
+
+using namespace win;
+
+/**
+ * @brief The topmost window containing the point, by scanning all windows.
+ */
+static std::size_t scan(const WindowSnapshot& __snapshot, const Point& __point)
+{
+    for (std::size_t i = 0; i < __snapshot.size(); ++i)
+    {
+        const Rect rect(__snapshot.rect(i));
+
+        if (__snapshot.isVisible(i) && rect.x() > -32000
+            && __point.x() >= rect.x() && __point.x() < rect.x() + rect.w()
+            && __point.y() >= rect.y() && __point.y() < rect.y() + rect.h())
+        {
+            return i;
+        }
+    }
+
+    return __snapshot.size();
+}
+
+static WindowSnapshot::Record window(Win::Handle __handle, Rect __rect, bool __visible)
+{
+    WindowSnapshot::Record record;
+    record.handle = __handle;
+    record.rect = __rect;
+    record.visible = __visible;
+
+    return record;
+}
+
+int main()
+{
+    std::mt19937 engine(2026);
+
+    WindowSnapshot snapshot(WindowSnapshot::Rect | WindowSnapshot::Visible);
+
+    /// A maximized window, small tool windows, hidden and minimized ones.
+
+    snapshot.append(window(nullptr, Rect(0, 0, 2560, 1400), true));
+
+    for (int i = 0; i < 500; ++i)
+    {
+        std::uniform_int_distribution<int> x(-100, 2500), y(-100, 1400), size(20, 900);
+
+        snapshot.append(window(
+            reinterpret_cast<Win::Handle>(std::uintptr_t(i + 1)),
+            Rect(x(engine), y(engine), size(engine), size(engine)),
+            i % 7 != 0));
+    }
+
+    snapshot.append(window(nullptr, Rect(-32000, -32000, 160, 28), true));
+
+    const WindowGrid grid(snapshot);
+
+    std::cout << "indexed " << grid.indexed() << " of " << grid.size() << " windows in "
+              << grid.columns() << " x " << grid.rows() << " cells, bounds = " << grid.bounds() << '\n';
+
+    std::vector<Point> points;
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        std::uniform_int_distribution<int> x(-300, 3000), y(-300, 1700);
+        points.emplace_back(x(engine), y(engine));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    const std::vector<std::size_t> found(grid.findByPoint(points));
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "WindowGrid: " << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / points.size()
+              << " ns/point\n";
+
+    start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        assert(found[i] == scan(snapshot, points[i]));
+    }
+
+    elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "scan:       " << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / points.size()
+              << " ns/point\n";
+
+    const std::vector<std::size_t> over(grid.findByRect(Rect(1000, 500, 200, 200)));
+
+    assert(std::is_sorted(over.begin(), over.end()));
+    assert(not over.empty() && over.front() == 0);
+
+    std::cout << over.size() << " windows over " << Rect(1000, 500, 200, 200) << '\n';
+
+    assert(grid.findByPoint(Point(-31990, -31990)) == grid.size());
+
+    return 0;
+}
\ No newline at end of file
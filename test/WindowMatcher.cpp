@@ -0,0 +1,177 @@
+#include <openWin.h>
+
+#include <cassert>
+#include <chrono>
+#include <random>
+
+using namespace win;
+
+/**
+ * @brief Matches one text against each pattern in turn.
+ */
+static std::vector<WindowMatcher::PatternId> naive(const WindowMatcher& __matcher, std::string_view __text)
+{
+    std::vector<WindowMatcher::PatternId> ids;
+
+    for (WindowMatcher::PatternId id = 0; id < __matcher.size(); ++id)
+    {
+        const WindowMatcher::Pattern& pattern = __matcher.pattern(id);
+
+        bool matched = false;
+
+        switch (pattern.kind)
+        {
+        case WindowMatcher::Exact:
+            matched = __text == pattern.text;
+            break;
+
+        case WindowMatcher::CaseInsensitive:
+            matched = __text.size() == pattern.text.size()
+                && std::equal(__text.begin(), __text.end(), pattern.text.begin(), [](char __a, char __b) {
+                       return std::tolower(static_cast<unsigned char>(__a)) == std::tolower(static_cast<unsigned char>(__b));
+                   });
+            break;
+
+        case WindowMatcher::Substring:
+            matched = __text.find(pattern.text) != std::string_view::npos;
+            break;
+
+        case WindowMatcher::Regex:
+            matched = std::regex_search(__text.begin(), __text.end(), std::regex(pattern.text));
+            break;
+        }
+
+        if (matched && pattern.field == WindowSnapshot::Title)
+        {
+            ids.push_back(id);
+        }
+    }
+
+    return ids;
+}
+
+static sim::WindowServer::Window titled(std::wstring __title)
+{
+    sim::WindowServer::Window window;
+    window.title = std::move(__title);
+
+    return window;
+}
+
+int main()
+{
+    const std::vector<std::string> words{
+        "Notepad", "Visual", "Studio", "Code", "Chrome", "Firefox", "Explorer", "Terminal",
+        "Settings", "Calculator", "Paint", "Word", "Excel", "Outlook", "Teams", "Slack",
+        "Spotify", "Discord", "Steam", "OBS", "Git", "Bash", "main.cpp", "README.md",
+        "-", "|", "(Administrator)", "[Running]", "Untitled", "Inbox" };
+
+    std::vector<WindowMatcher::Pattern> patterns;
+
+    for (std::size_t i = 0; i < 10; ++i)
+    {
+        patterns.push_back({ words[i] + " - " + words[i + 1], WindowMatcher::Exact });
+        patterns.push_back({ words[i + 10] + " - " + words[i + 12], WindowMatcher::CaseInsensitive });
+        patterns.push_back({ words[i + 5] + ' ' + words[i + 8], WindowMatcher::Substring });
+    }
+
+    for (const char* substring : { "Code", "Studio Code", "de", "md", "(Admin", "Steam", "Bash", "Inbox" })
+    {
+        patterns.push_back({ substring, WindowMatcher::Substring });
+    }
+
+    patterns.push_back({ R"(^\d+ unread)", WindowMatcher::Regex });
+    patterns.push_back({ "Chrome$", WindowMatcher::Regex });
+
+    patterns.push_back({ "Notepad", WindowMatcher::Exact, WindowSnapshot::ClassName });
+
+    const WindowMatcher matcher(patterns);
+
+    /// A corpus of titles made of the words.
+
+    std::mt19937 engine(2026);
+    std::uniform_int_distribution<std::size_t> word(0, words.size() - 1), length(1, 6);
+
+    std::vector<std::string> corpus;
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::string title = i % 50 == 0 ? std::to_string(i % 97) + " unread" : words[word(engine)];
+
+        for (std::size_t n = length(engine); n > 0; --n)
+        {
+            title += (n % 2 ? " - " : " ");
+            title += words[word(engine)];
+        }
+
+        if (i % 3 == 0)
+        {
+            std::transform(title.begin(), title.end(), title.begin(), [](char __c) {
+                return static_cast<char>(std::toupper(static_cast<unsigned char>(__c)));
+            });
+        }
+
+        corpus.push_back(std::move(title));
+    }
+
+    std::vector<WindowMatcher::PatternId> ids;
+    std::size_t matches = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (const std::string& title : corpus)
+    {
+        ids.clear();
+        matcher.match(title, WindowSnapshot::Title, ids);
+
+        matches += ids.size();
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "WindowMatcher: " << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / corpus.size()
+              << " ns/title, " << matches << " matches of " << matcher.size() << " patterns\n";
+
+    start = std::chrono::steady_clock::now();
+
+    for (const std::string& title : corpus)
+    {
+        ids.clear();
+        matcher.match(title, WindowSnapshot::Title, ids);
+
+        assert(ids == naive(matcher, title));
+    }
+
+    elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "naive:         " << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / corpus.size()
+              << " ns/title\n";
+
+    /// All patterns in one enumeration of the simulated desktop.
+
+    sim::WindowServer server;
+    sim::WindowServer::setCurrent(&server);
+
+    sim::WindowServer::Window readme(titled(L"README.md - Notepad"));
+    readme.className = L"Notepad";
+
+    Win notepad(server.create(std::move(readme)));
+    Win code(server.create(titled(L"main.cpp - Visual Studio Code")));
+    Win mail(server.create(titled(L"12 unread - Inbox")));
+
+    const std::vector<WinList> found(matcher.find());
+
+    for (std::size_t i = 0; i < found.size(); ++i)
+    {
+        if (not found[i].empty())
+        {
+            std::cout << '"' << matcher.pattern(static_cast<WindowMatcher::PatternId>(i)).text << "\": "
+                      << found[i].size() << " windows\n";
+        }
+    }
+
+    assert(found.back().size() == 1 && found.back().front().handle() == notepad.handle());
+
+    sim::WindowServer::setCurrent(nullptr);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include <openWin.h>
+
+#include <cassert>
+
+using namespace win;
+
+int main()
+{
+    sim::WindowServer server;
+    sim::WindowServer::setCurrent(&server);
+
+    server.setLatency("SetWindowPos", std::chrono::microseconds(50));
+
+    std::vector<Win> windows;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        sim::WindowServer::Window window;
+        window.title = L"Window " + std::to_wstring(i);
+        window.rect = Rect(i * 10, i * 10, 400, 300);
+
+        windows.emplace_back(server.create(std::move(window)));
+    }
+
+    sim::WindowServer::Window initial;
+    initial.title = L"Untitled - Notepad";
+    initial.rect = Rect(0, 0, 800, 600);
+
+    Win notepad(server.create(std::move(initial)));
+
+    notepad.setPos(100, 100);
+    notepad.setTitle("notes.txt - Notepad");
+
+    std::cout << notepad << '\n';
+
+    assert(notepad.pos() == Point(100, 100));
+    assert(notepad.title() == "notes.txt - Notepad");
+
+    const auto begin = std::chrono::steady_clock::now();
+
+    WinBatch batch;
+
+    for (std::size_t i = 0; i < windows.size(); ++i)
+    {
+        batch.setRect(windows[i], Rect(static_cast<int>(i) * 120, 0, 120, 1080));
+    }
+
+    batch.commit();
+
+    std::cout << "WinBatch: " << std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - begin).count() << " us\n";
+
+    std::cout << "SetWindowPos:      " << server.calls("SetWindowPos") << '\n';
+    std::cout << "EndDeferWindowPos: " << server.calls("EndDeferWindowPos") << '\n';
+    std::cout << "all:               " << server.calls() << '\n';
+
+    assert(windows[3].rect() == Rect(360, 0, 120, 1080));
+
+    sim::WindowServer::setCurrent(nullptr);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include <openWin.h>
+
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+using namespace win;
+
+template<typename _Func>
+void measure(const char* __name, std::size_t __rounds, _Func __func)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < __rounds; ++i)
+    {
+        __func();
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << __name << ": "
+        << std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() / __rounds << " us/round\n";
+}
+
+/**
+ * @brief Compares the snapshots field by field.
+ */
+static bool equal(const WindowSnapshot& __lhs, const WindowSnapshot& __rhs)
+{
+    if (__lhs.size() != __rhs.size() || __lhs.fields() != __rhs.fields())
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < __lhs.size(); ++i)
+    {
+        if (__lhs.handle(i) != __rhs.handle(i)
+            || __lhs.title(i) != __rhs.title(i)
+            || __lhs.className(i) != __rhs.className(i)
+            || not (__lhs.rect(i) == __rhs.rect(i))
+            || __lhs.processId(i) != __rhs.processId(i)
+            || __lhs.threadId(i) != __rhs.threadId(i)
+            || __lhs.isVisible(i) != __rhs.isVisible(i))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main()
+{
+    constexpr std::size_t rounds = 100;
+
+#if defined(OPENWIN_SIMULATED_BACKEND)
+    /// A desktop of a few thousand windows, some hidden.
+
+    constexpr std::size_t windows = 3000;
+
+    sim::WindowServer server;
+    sim::WindowServer::setCurrent(&server);
+
+    const wchar_t* const classNames[] = { L"Notepad", L"Chrome_WidgetWin_1", L"CabinetWClass", L"ConsoleWindowClass" };
+
+    for (std::size_t i = 0; i < windows; ++i)
+    {
+        sim::WindowServer::Window window;
+        window.title = L"Window " + std::to_wstring(i) + (i % 3 ? L" - Document" : L"");
+        window.className = classNames[i % 4];
+        window.rect = Rect(static_cast<int>(i % 40) * 30, static_cast<int>(i % 25) * 20, 400 + static_cast<int>(i % 7) * 50, 300);
+
+        if (i % 5 == 0)
+        {
+            window.style &= ~sim::WindowServer::visibleStyle;
+        }
+
+        void(server.create(std::move(window)));
+    }
+#endif
+
+    measure("Win::list() + getters      ", rounds, [] {
+        for (const Win& win : Win::list())
+        {
+            void(win.title());
+            void(win.className());
+            void(win.rect());
+            void(win.processId());
+            void(win.isVisible());
+        }
+    });
+
+    measure("WindowSnapshot::capture()  ", rounds, [] {
+        void(WindowSnapshot::capture());
+    });
+
+    /// Records the desktop as a fixture and replays it without Win32.
+
+    WindowSnapshot snapshot = WindowSnapshot::capture();
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "openWin-desktop.snapshot";
+
+    {
+        std::ofstream fixture(path, std::ios::binary);
+        snapshot.write(fixture);
+    }
+
+    WindowSnapshot replayed;
+
+    {
+        std::ifstream fixture(path, std::ios::binary);
+        replayed = WindowSnapshot::read(fixture);
+    }
+
+    std::filesystem::remove(path);
+
+    assert(equal(replayed, snapshot));
+
+    WindowSnapshot::ReplaySource source(std::move(replayed));
+
+    measure("WindowSnapshot (replayed)  ", rounds, [&] {
+        void(WindowSnapshot::capture(source));
+    });
+
+    assert(equal(WindowSnapshot::capture(source), snapshot));
+
+    auto visible = snapshot.select([](const WindowSnapshot::Entry& __entry) {
+        return __entry.isVisible() && not __entry.title().empty();
+    });
+
+    std::cout << visible.size() << " of " << snapshot.size() << " windows are visible\n";
+
+    for (std::size_t index : std::span(visible).first(std::min<std::size_t>(visible.size(), 10)))
+    {
+        std::cout << snapshot[index].handle() << " | " << snapshot[index].title()
+                  << " | " << snapshot[index].className() << '\n';
+    }
+
+#if defined(OPENWIN_SIMULATED_BACKEND)
+    assert(snapshot.size() == windows);
+    assert(visible.size() == windows - windows / 5);
+
+    sim::WindowServer::setCurrent(nullptr);
+#endif
+
+    return 0;
+}
\ No newline at end of file
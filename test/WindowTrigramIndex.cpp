@@ -0,0 +1,215 @@
+#include <openWin.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+using namespace win;
+
+static int failures = 0;
+
+static void check(const char* __name, bool __ok)
+{
+    std::cout << (__ok ? "[ OK ] " : "[FAIL] ") << __name << '\n';
+    failures += not __ok;
+}
+
+/// 1 ms in the release builds, the debug and sanitized ones are slower.
+#if defined(NDEBUG)
+static constexpr std::chrono::microseconds bound(1000);
+#else
+static constexpr std::chrono::microseconds bound(5000);
+#endif
+
+static WindowSnapshot::Record window(std::uintptr_t __handle, std::string __title, std::string __className)
+{
+    WindowSnapshot::Record record;
+    record.handle = reinterpret_cast<Win::Handle>(__handle);
+    record.title = std::move(__title);
+    record.className = std::move(__className);
+
+    return record;
+}
+
+/**
+ * @brief Prints the best three windows, and checks that the fastest of five
+ *        searches is within the bound.
+ */
+static void print(const WindowTrigramIndex& __index, const WindowSnapshot& __snapshot, std::string_view __query)
+{
+    std::vector<WindowTrigramIndex::Result> results;
+
+    auto elapsed = std::chrono::steady_clock::duration::max();
+
+    for (int i = 0; i < 5; ++i)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        results = __index.search(__query);
+
+        elapsed = std::min(elapsed, std::chrono::steady_clock::now() - start);
+    }
+
+    std::cout << '"' << __query << "\" in "
+              << std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() << " us\n";
+
+    check("within the bound", elapsed < bound);
+
+    results.resize(std::min<std::size_t>(results.size(), 3));
+
+    for (const WindowTrigramIndex::Result& result : results)
+    {
+        std::cout << "    " << result.score << '\t' << __snapshot.title(__snapshot.indexOf(result.handle)) << '\n';
+    }
+}
+
+int main()
+{
+    const std::vector<std::string> words{
+        "Notepad", "Visual", "Studio", "Code", "Chrome", "Firefox", "Explorer", "Terminal",
+        "Settings", "Calculator", "Paint", "Word", "Excel", "Outlook", "Teams", "Slack",
+        "main.cpp", "README.md", "Inbox", "Untitled", "report.docx", "budget.xlsx" };
+
+    std::mt19937 engine(2026);
+    std::uniform_int_distribution<std::size_t> word(0, words.size() - 1), length(2, 6);
+
+    const auto title = [&] {
+        std::string result = words[word(engine)];
+
+        for (std::size_t n = length(engine); n > 0; --n)
+        {
+            result += n == 1 ? " - " : " ";
+            result += words[word(engine)];
+        }
+
+        return result;
+    };
+
+    WindowSnapshot before(WindowSnapshot::Title | WindowSnapshot::ClassName);
+
+    for (std::uintptr_t handle = 1; handle <= 5000; ++handle)
+    {
+        before.append(window(handle, title(), words[handle % words.size()] + "Window"));
+    }
+
+    before.append(window(5001, "main.cpp - openWin - Visual Studio Code", "Chrome_WidgetWin_1"));
+
+    WindowTrigramIndex index;
+    index.assign(before);
+
+    print(index, before, "visual studio code");
+    print(index, before, "vscode");
+    print(index, before, "viusal stduio");
+    print(index, before, "no");
+
+    check("a substring ranks first", index.search("main.cpp - openwin").front().handle == reinterpret_cast<Win::Handle>(5001));
+
+    /// The starts of the words, as an acronym.
+    {
+        const std::vector<WindowTrigramIndex::Result> results(index.search("vscode", 50));
+
+        const auto vscode = std::find_if(results.begin(), results.end(), [](const WindowTrigramIndex::Result& __result) {
+            return __result.handle == reinterpret_cast<Win::Handle>(5001);
+        });
+
+        check("an acronym ranks in the first three", vscode - results.begin() < 3);
+
+        bool below = true;
+
+        for (const WindowTrigramIndex::Result& result : results)
+        {
+            if (before.title(before.indexOf(result.handle)).find("Visual Code") != std::string_view::npos)
+            {
+                below = below && result.score < vscode->score;
+            }
+        }
+
+        check("above the tighter subsequences", below);
+    }
+
+    /// The short queries match the starts of words.
+    {
+        const std::vector<WindowTrigramIndex::Result> results(index.search("no", 50));
+
+        bool notepad = results.size() == 50;
+
+        for (const WindowTrigramIndex::Result& result : results)
+        {
+            notepad = notepad && before.title(before.indexOf(result.handle)).find("Notepad") != std::string_view::npos;
+        }
+
+        check("a short query", notepad);
+    }
+
+    /// Two typos, a swap of letters in each word.
+    {
+        bool typos = index.search("viusal stduio").size() == 10;
+
+        for (const WindowTrigramIndex::Result& result : index.search("viusal stduio", 50))
+        {
+            const std::string_view title(before.title(before.indexOf(result.handle)));
+
+            typos = typos && title.find("Visual") != std::string_view::npos && title.find("Studio") != std::string_view::npos;
+        }
+
+        check("the words with typos", typos);
+    }
+
+    check("a typo ranks first", index.search("main.cpp openwni").front().handle == reinterpret_cast<Win::Handle>(5001));
+
+    /// Half of the windows closed or retitled, and others opened.
+
+    WindowSnapshot after(WindowSnapshot::Title | WindowSnapshot::ClassName);
+
+    for (std::uintptr_t handle = 1; handle <= 5001; ++handle)
+    {
+        if (handle % 4 == 0)
+        {
+            continue;
+        }
+
+        const WindowSnapshot::Entry entry(before[handle - 1]);
+
+        after.append(window(
+            handle, handle % 4 == 1 ? title() : std::string(entry.title()), std::string(entry.className())));
+    }
+
+    for (std::uintptr_t handle = 6000; handle < 7000; ++handle)
+    {
+        after.append(window(handle, title(), "Opened"));
+    }
+
+    const WindowDiff diff(WindowDiff::between(before, after));
+
+    auto start = std::chrono::steady_clock::now();
+
+    index.apply(diff, after);
+
+    std::cout << "applied " << diff.size() << " changes in "
+              << std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()
+              << " us\n";
+
+    WindowTrigramIndex rebuilt;
+    rebuilt.assign(after);
+
+    bool same = index.size() == rebuilt.size();
+
+    for (const char* query : { "visual studio code", "excel budget", "teams inbox", "rep", "outlok", "vscode", "ex" })
+    {
+        const auto lhs = index.search(query, 50);
+        const auto rhs = rebuilt.search(query, 50);
+
+        same = same && lhs.size() == rhs.size();
+
+        for (std::size_t i = 0; same && i < lhs.size(); ++i)
+        {
+            same = lhs[i].score == rhs[i].score;
+        }
+    }
+
+    check("the index scores as the rebuilt one", same);
+
+    print(index, after, "excel budget");
+
+    return failures;
+}
\ No newline at end of file